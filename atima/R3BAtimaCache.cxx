@@ -16,14 +16,58 @@
 #include "FairLogger.h"
 
 #include <algorithm>
+#include <cstring>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 constexpr UInt_t MagicWord = 0xF0F00000;
 
 namespace R3BAtima
 {
+    namespace
+    {
+        // Grid cell of a value and its position inside the cell, 0..1
+        void locate(const Cache::RangeSelector& range, const Double_t value, Int_t& cell, Double_t& frac)
+        {
+            const Double_t pos = (value - range.MinValue) / (range.MaxValue - range.MinValue) * range.Steps;
+            cell = std::min(std::max(0, (Int_t)pos), range.Steps - 1);
+            frac = pos - cell;
+        }
+
+        // Takes the values of the cache file one after the other from memory
+        class FileBuffer
+        {
+          public:
+            explicit FileBuffer(std::ifstream& in)
+                : fPos(0)
+            {
+                in.seekg(0, std::ifstream::end);
+                const std::streamoff size = in.tellg();
+                if (size <= 0)
+                    return;
+                fData.resize(size);
+                in.seekg(0);
+                in.read(fData.data(), size);
+                fData.resize(in.gcount());
+            }
+
+            template <typename T>
+            Bool_t get(T* values, const size_t n = 1)
+            {
+                if (fPos + n * sizeof(T) > fData.size())
+                    return kFALSE;
+                std::memcpy(values, fData.data() + fPos, n * sizeof(T));
+                fPos += n * sizeof(T);
+                return kTRUE;
+            }
+
+          private:
+            std::vector<char> fData;
+            size_t fPos;
+        };
+    } // namespace
 
     Cache::Cache(const Double_t pMass_u,
                  const Double_t pCharge_e,
@@ -74,19 +118,38 @@ namespace R3BAtima
             distance_mm < fDistances.MinValue || distance_mm > fDistances.MaxValue)
             LOG(FATAL) << "R3BAtima::Cache: given value outside of calculated range!";
 
+        Int_t iE, iD;
+        Double_t fE, fD;
+        locate(fEnergies, energy_MeV_per_u, iE, fE);
+        locate(fDistances, distance_mm, iD, fD);
+
+        const Int_t nDistances = fDistances.Steps + 1;
+        const Double_t* p00 = &fTable[(iE * nDistances + iD) * NValues];
+        const Double_t* p01 = p00 + NValues;
+        const Double_t* p10 = p00 + nDistances * NValues;
+        const Double_t* p11 = p10 + NValues;
+        const Double_t w00 = (1. - fE) * (1. - fD);
+        const Double_t w01 = (1. - fE) * fD;
+        const Double_t w10 = fE * (1. - fD);
+        const Double_t w11 = fE * fD;
+
+        Double_t v[NValues];
+        for (Int_t k = 0; k < NValues; ++k)
+            v[k] = w00 * p00[k] + w01 * p01[k] + w10 * p10[k] + w11 * p11[k];
+
         TransportResult res;
 
         res.EnergyIn_MeV_per_u = energy_MeV_per_u;
-        res.ELoss_MeV_per_u = fG_ELoss.Interpolate(energy_MeV_per_u, distance_mm);
+        res.ELoss_MeV_per_u = v[0];
         res.EnergyOut_MeV_per_u = res.EnergyIn_MeV_per_u - res.ELoss_MeV_per_u;
-        res.EStrag_MeV_per_u = fG_EStrag.Interpolate(energy_MeV_per_u, distance_mm);
-        res.AngStrag_mRad = fG_AngStrag.Interpolate(energy_MeV_per_u, distance_mm);
-        res.Range_mg_per_cm2 = fG_Range.Interpolate(energy_MeV_per_u, distance_mm);
-        res.RemainingRange_mg_per_cm2 = fG_RemainigRange.Interpolate(energy_MeV_per_u, distance_mm);
-        res.dEdXIn_MeVcm2_per_mg = fG_dEdXIn.Interpolate(energy_MeV_per_u, distance_mm);
-        res.dEdXOut_MeVcm2_per_mg = fG_dEdXOut.Interpolate(energy_MeV_per_u, distance_mm);
-        res.ToF_ns = fG_ToF.Interpolate(energy_MeV_per_u, distance_mm);
-        res.InterpolatedTargetThickness = fG_InterpolatedTargetThickness.Interpolate(energy_MeV_per_u, distance_mm);
+        res.EStrag_MeV_per_u = v[1];
+        res.AngStrag_mRad = v[2];
+        res.Range_mg_per_cm2 = v[3];
+        res.RemainingRange_mg_per_cm2 = v[4];
+        res.dEdXIn_MeVcm2_per_mg = v[5];
+        res.dEdXOut_MeVcm2_per_mg = v[6];
+        res.ToF_ns = v[7];
+        res.InterpolatedTargetThickness = v[8];
 
         return res;
     }
@@ -98,15 +161,17 @@ namespace R3BAtima
         if (!fstream.good())
             return kFALSE;
 
-        UInt_t Version;
-        fstream.read(reinterpret_cast<char*>(&Version), sizeof(Version));
-        if (Version != MagicWord)
+        // The whole file at once, the table is most of it
+        FileBuffer buffer(fstream);
+
+        UInt_t Version = 0;
+        if (!buffer.get(&Version) || Version != MagicWord)
             return kFALSE;
 
         Double_t projM, projCharge;
 
-        fstream.read(reinterpret_cast<char*>(&projM), sizeof(projM));
-        fstream.read(reinterpret_cast<char*>(&projCharge), sizeof(projCharge));
+        if (!buffer.get(&projM) || !buffer.get(&projCharge))
+            return kFALSE;
 
         if (projM != fProjMass || projCharge != fProjCharge)
             return kFALSE;
@@ -114,16 +179,13 @@ namespace R3BAtima
         Double_t mass, charge, ratio;
 
         Int_t nComps;
-        fstream.read(reinterpret_cast<char*>(&nComps), sizeof(nComps));
-
-        if (nComps != fTargetMaterial.Compounds.size())
+        if (!buffer.get(&nComps) || nComps != fTargetMaterial.Compounds.size())
             return kFALSE;
 
         for (auto i = 0; i < nComps; ++i)
         {
-            fstream.read(reinterpret_cast<char*>(&mass), sizeof(mass));
-            fstream.read(reinterpret_cast<char*>(&charge), sizeof(charge));
-            fstream.read(reinterpret_cast<char*>(&ratio), sizeof(ratio));
+            if (!buffer.get(&mass) || !buffer.get(&charge) || !buffer.get(&ratio))
+                return kFALSE;
 
             if (fTargetMaterial.Compounds[i].Mass_u != mass || fTargetMaterial.Compounds[i].Charge_e != charge ||
                 fTargetMaterial.Compounds[i].Ratio != ratio)
@@ -133,16 +195,14 @@ namespace R3BAtima
         Double_t minVal, maxVal;
         Int_t steps;
 
-        fstream.read(reinterpret_cast<char*>(&minVal), sizeof(minVal));
-        fstream.read(reinterpret_cast<char*>(&maxVal), sizeof(maxVal));
-        fstream.read(reinterpret_cast<char*>(&steps), sizeof(steps));
+        if (!buffer.get(&minVal) || !buffer.get(&maxVal) || !buffer.get(&steps))
+            return kFALSE;
 
         if (minVal != fEnergies.MinValue || maxVal != fEnergies.MaxValue || steps != fEnergies.Steps)
             return kFALSE;
 
-        fstream.read(reinterpret_cast<char*>(&minVal), sizeof(minVal));
-        fstream.read(reinterpret_cast<char*>(&maxVal), sizeof(maxVal));
-        fstream.read(reinterpret_cast<char*>(&steps), sizeof(steps));
+        if (!buffer.get(&minVal) || !buffer.get(&maxVal) || !buffer.get(&steps))
+            return kFALSE;
 
         if (minVal != fDistances.MinValue || maxVal != fDistances.MaxValue || steps != fDistances.Steps)
             return kFALSE;
@@ -150,70 +210,18 @@ namespace R3BAtima
         Double_t density;
         Bool_t isGas;
 
-        fstream.read(reinterpret_cast<char*>(&density), sizeof(density));
-        fstream.read(reinterpret_cast<char*>(&isGas), sizeof(isGas));
+        if (!buffer.get(&density) || !buffer.get(&isGas))
+            return kFALSE;
 
         if (density != fTargetMaterial.Density || isGas != fTargetMaterial.IsGas)
             return kFALSE;
 
-        const auto maxStep = (fEnergies.Steps + 1) * (fDistances.Steps + 1);
-
-        fG_ELoss.Set(maxStep);
-        fG_EStrag.Set(maxStep);
-        fG_AngStrag.Set(maxStep);
-        fG_Range.Set(maxStep);
-        fG_RemainigRange.Set(maxStep);
-        fG_dEdXIn.Set(maxStep);
-        fG_dEdXOut.Set(maxStep);
-        fG_ToF.Set(maxStep);
-        fG_InterpolatedTargetThickness.Set(maxStep);
-
-        Int_t nPoints = 0;
-        Double_t energy = fEnergies.MinValue;
-        for (int i = 0; i <= fEnergies.Steps; ++i)
-        {
-            Double_t distance = fDistances.MinValue;
-            for (int j = 0; j <= fDistances.Steps; ++j)
-            {
-
-                TransportResult res;
-
-                fstream.read(reinterpret_cast<char*>(&res.ELoss_MeV_per_u), sizeof(res.ELoss_MeV_per_u));
-                fstream.read(reinterpret_cast<char*>(&res.EStrag_MeV_per_u), sizeof(res.EStrag_MeV_per_u));
-                fstream.read(reinterpret_cast<char*>(&res.AngStrag_mRad), sizeof(res.AngStrag_mRad));
-                fstream.read(reinterpret_cast<char*>(&res.Range_mg_per_cm2), sizeof(res.Range_mg_per_cm2));
-                fstream.read(reinterpret_cast<char*>(&res.RemainingRange_mg_per_cm2),
-                             sizeof(res.RemainingRange_mg_per_cm2));
-                fstream.read(reinterpret_cast<char*>(&res.dEdXIn_MeVcm2_per_mg), sizeof(res.dEdXIn_MeVcm2_per_mg));
-                fstream.read(reinterpret_cast<char*>(&res.dEdXOut_MeVcm2_per_mg), sizeof(res.dEdXOut_MeVcm2_per_mg));
-                fstream.read(reinterpret_cast<char*>(&res.ToF_ns), sizeof(res.ToF_ns));
-                fstream.read(reinterpret_cast<char*>(&res.InterpolatedTargetThickness),
-                             sizeof(res.InterpolatedTargetThickness));
-
-                fG_ELoss.SetPoint(nPoints, energy, distance, res.ELoss_MeV_per_u);
-                fG_EStrag.SetPoint(nPoints, energy, distance, res.EStrag_MeV_per_u);
-                fG_AngStrag.SetPoint(nPoints, energy, distance, res.AngStrag_mRad);
-                fG_Range.SetPoint(nPoints, energy, distance, res.Range_mg_per_cm2);
-                fG_RemainigRange.SetPoint(nPoints, energy, distance, res.RemainingRange_mg_per_cm2);
-                fG_dEdXIn.SetPoint(nPoints, energy, distance, res.dEdXIn_MeVcm2_per_mg);
-                fG_dEdXOut.SetPoint(nPoints, energy, distance, res.dEdXOut_MeVcm2_per_mg);
-                fG_ToF.SetPoint(nPoints, energy, distance, res.ToF_ns);
-                fG_InterpolatedTargetThickness.SetPoint(nPoints, energy, distance, res.InterpolatedTargetThickness);
-
-                ++nPoints;
-                distance += (fDistances.MaxValue - fDistances.MinValue) / fDistances.Steps;
-            }
-            energy += (fEnergies.MaxValue - fEnergies.MinValue) / fEnergies.Steps;
-        }
-
-        if (!fstream.good())
+        fTable.resize((fEnergies.Steps + 1) * (fDistances.Steps + 1) * NValues);
+        if (!buffer.get(fTable.data(), fTable.size()))
             return kFALSE;
 
         Version = 0;
-
-        fstream.read(reinterpret_cast<char*>(&Version), sizeof(Version));
-
-        if (Version != MagicWord)
+        if (!buffer.get(&Version) || Version != MagicWord)
             return kFALSE;
 
         return kTRUE;
@@ -253,25 +261,7 @@ namespace R3BAtima
         fstream.write(reinterpret_cast<const char*>(&fTargetMaterial.Density), sizeof(fTargetMaterial.Density));
         fstream.write(reinterpret_cast<const char*>(&fTargetMaterial.IsGas), sizeof(fTargetMaterial.IsGas));
 
-        Int_t nPoints = 0;
-        for (int i = 0; i <= fEnergies.Steps; ++i)
-        {
-            for (int j = 0; j <= fDistances.Steps; ++j)
-            {
-                fstream.write(reinterpret_cast<char*>(&fG_ELoss.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_EStrag.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_AngStrag.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_Range.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_RemainigRange.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_dEdXIn.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_dEdXOut.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_ToF.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_InterpolatedTargetThickness.GetZ()[nPoints]),
-                              sizeof(Double_t));
-
-                ++nPoints;
-            }
-        }
+        fstream.write(reinterpret_cast<const char*>(fTable.data()), fTable.size() * sizeof(Double_t));
 
         fstream.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
     }
@@ -281,50 +271,31 @@ namespace R3BAtima
         UInt_t currStep = 0;
         const auto maxStep = (fEnergies.Steps + 1) * (fDistances.Steps + 1);
 
-        fG_ELoss.Clear();
-        fG_ELoss.Set(maxStep);
-        fG_EStrag.Clear();
-        fG_EStrag.Set(maxStep);
-        fG_AngStrag.Clear();
-        fG_AngStrag.Set(maxStep);
-        fG_Range.Clear();
-        fG_Range.Set(maxStep);
-        fG_RemainigRange.Clear();
-        fG_RemainigRange.Set(maxStep);
-        fG_dEdXIn.Clear();
-        fG_dEdXIn.Set(maxStep);
-        fG_dEdXOut.Clear();
-        fG_dEdXOut.Set(maxStep);
-        fG_ToF.Clear();
-        fG_ToF.Set(maxStep);
-        fG_InterpolatedTargetThickness.Clear();
-        fG_InterpolatedTargetThickness.Set(maxStep);
-
-        auto energy = fEnergies.MinValue;
+        fTable.assign(maxStep * NValues, 0.);
+
         for (int i = 0; i <= fEnergies.Steps; ++i)
         {
-            auto distance = fDistances.MinValue;
+            // On the grid the lookup assumes, without summing up rounding errors
+            const auto energy = fEnergies.MinValue + (fEnergies.MaxValue - fEnergies.MinValue) * i / fEnergies.Steps;
             for (int j = 0; j <= fDistances.Steps; ++j)
             {
+                const auto distance =
+                    fDistances.MinValue + (fDistances.MaxValue - fDistances.MinValue) * j / fDistances.Steps;
                 auto res = Calculate_mm(fProjMass, fProjCharge, energy, fTargetMaterial, distance);
 
-                fG_ELoss.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.ELoss_MeV_per_u);
-                fG_EStrag.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.EStrag_MeV_per_u);
-                fG_AngStrag.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.AngStrag_mRad);
-                fG_Range.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.Range_mg_per_cm2);
-                fG_RemainigRange.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.RemainingRange_mg_per_cm2);
-                fG_dEdXIn.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.dEdXIn_MeVcm2_per_mg);
-                fG_dEdXOut.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.dEdXOut_MeVcm2_per_mg);
-                fG_ToF.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.ToF_ns);
-                fG_InterpolatedTargetThickness.SetPoint(
-                    currStep, res.EnergyIn_MeV_per_u, distance, res.InterpolatedTargetThickness);
-
-                distance += (fDistances.MaxValue - fDistances.MinValue) / fDistances.Steps;
+                Double_t* v = &fTable[currStep * NValues];
+                v[0] = res.ELoss_MeV_per_u;
+                v[1] = res.EStrag_MeV_per_u;
+                v[2] = res.AngStrag_mRad;
+                v[3] = res.Range_mg_per_cm2;
+                v[4] = res.RemainingRange_mg_per_cm2;
+                v[5] = res.dEdXIn_MeVcm2_per_mg;
+                v[6] = res.dEdXOut_MeVcm2_per_mg;
+                v[7] = res.ToF_ns;
+                v[8] = res.InterpolatedTargetThickness;
 
                 std::cout << "\rR3BAtima::Cache: Creating Cache: " << ++currStep << "/" << maxStep << std::flush;
             }
-
-            energy += (fEnergies.MaxValue - fEnergies.MinValue) / fEnergies.Steps;
         }
         std::cout << std::endl;
     }
@@ -14,13 +14,19 @@
 #ifndef R3BATIMACACHE_H
 #define R3BATIMACACHE_H
 
-#include "TGraph2D.h"
 #include "TString.h"
 
 #include "R3BAtima.h"
 
+#include <vector>
+
 namespace R3BAtima
 {
+    /**
+     * Atima results on a regular grid of energies and distances. Values in
+     * between are interpolated bilinearly from the four surrounding points.
+     * Lookups do not change the cache, it can be shared between threads.
+     */
     class Cache
     {
       public:
@@ -65,15 +71,11 @@ namespace R3BAtima
         TargetMaterial fTargetMaterial; //!
         RangeSelector fDistances;
 
-        mutable TGraph2D fG_ELoss;
-        mutable TGraph2D fG_EStrag;
-        mutable TGraph2D fG_AngStrag;
-        mutable TGraph2D fG_Range;
-        mutable TGraph2D fG_RemainigRange;
-        mutable TGraph2D fG_dEdXIn;
-        mutable TGraph2D fG_dEdXOut;
-        mutable TGraph2D fG_ToF;
-        mutable TGraph2D fG_InterpolatedTargetThickness;
+        // ELoss, EStrag, AngStrag, Range, RemainingRange, dEdXIn, dEdXOut, ToF and
+        // InterpolatedTargetThickness of every grid point, distances inner.
+        // The same layout as in the file.
+        static constexpr Int_t NValues = 9;
+        std::vector<Double_t> fTable;
     };
 } // namespace R3BAtima
 #endif
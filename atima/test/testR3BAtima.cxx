@@ -49,6 +49,36 @@ namespace
         EXPECT_EQ(cache1(100., 20.).ELoss_MeV_per_u, cache2(100., 20.).ELoss_MeV_per_u);
     }
 
+    TEST(testR3BAtima, cacheGridPoints)
+    {
+        const auto cache = R3BAtima::Cache(1., 1., { 100., 200., 10 }, R3BAtima::TargetMaterial::LH2, { 10., 50., 4 });
+        for (auto energy : { 100., 130., 200. })
+        {
+            for (auto distance : { 10., 20., 50. })
+            {
+                const auto res = R3BAtima::Calculate_mm(1., 1., energy, R3BAtima::TargetMaterial::LH2, distance);
+                const auto cached = cache(energy, distance);
+                EXPECT_NEAR(cached.ELoss_MeV_per_u, res.ELoss_MeV_per_u, 1e-9);
+                EXPECT_NEAR(cached.Range_mg_per_cm2, res.Range_mg_per_cm2, 1e-9);
+                EXPECT_NEAR(cached.ToF_ns, res.ToF_ns, 1e-9);
+            }
+        }
+    }
+
+    TEST(testR3BAtima, cacheBilinear)
+    {
+        const auto cache = R3BAtima::Cache(1., 1., { 100., 200., 10 }, R3BAtima::TargetMaterial::LH2, { 10., 50., 4 });
+        // Middle of a cell, the mean of its corners
+        const auto mean = (cache(120., 30.).ELoss_MeV_per_u + cache(130., 30.).ELoss_MeV_per_u +
+                           cache(120., 40.).ELoss_MeV_per_u + cache(130., 40.).ELoss_MeV_per_u) /
+                          4.;
+        EXPECT_NEAR(cache(125., 35.).ELoss_MeV_per_u, mean, 1e-9);
+        // Linear along a cell edge
+        EXPECT_NEAR(cache(120., 32.5).EStrag_MeV_per_u,
+                    0.75 * cache(120., 30.).EStrag_MeV_per_u + 0.25 * cache(120., 40.).EStrag_MeV_per_u,
+                    1e-9);
+    }
+
 } // namespace
 
 int main(int argc, char** argv)
@@ -25,6 +25,7 @@
 
 #pragma link C++ class R3BCalifaMapped2CrystalCal+;
 #pragma link C++ class R3BCalifaMapped2CrystalCalPar+;
+#pragma link C++ class R3BCalifaPeakFitter;
 #pragma link C++ class R3BCalifaCrystalCal2TotCalPar+;
 #pragma link C++ class R3BCalifaCrystalCalDataAnalysis+;
 #pragma link C++ class R3BCalifaCrystalCal2CrystalCalPID+;
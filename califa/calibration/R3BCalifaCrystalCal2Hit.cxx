@@ -29,6 +29,7 @@
 
 #include "R3BCalifaCrystalCalData.h"
 #include "R3BCalifaGeometry.h"
+#include <cmath>
 #include <list>
 #include <vector>
 
@@ -51,6 +52,7 @@ R3BCalifaCrystalCal2Hit::R3BCalifaCrystalCal2Hit()
     , fCalifaGeo(NULL)
     , fNbCrystalsGammaRange(2432) // during 2019 it was 5000
     , fOnline(kFALSE)
+    , fNeighbourWords(0)
 {
     SetSquareWindowAlg(fDeltaPolar, fDeltaAzimuthal);
     fCalifatoTargetPos.SetXYZ(0., 0., 0.);
@@ -123,20 +125,100 @@ InitStatus R3BCalifaCrystalCal2Hit::Init()
         fCalifatoTargetPos = fTargetPos - fCalifaPos;
     }
 
+    BuildCrystalTables();
+
     return kSUCCESS;
 }
 
+void R3BCalifaCrystalCal2Hit::BuildCrystalTables()
+{
+    // Same mapping of the second range of double reading crystals as in R3BCalifaGeometry
+    const Int_t nIds = fCalifaGeo->GetNumCrystals();
+    const Int_t nPhysical = R3BCalifaGeometry::kNumPhysicalCrystals;
+    fCrystalIndex.assign(nIds + 1, -1);
+    fCrystalPositions.clear();
+    // Entry in fCrystalPositions, -1 if not looked up yet, -2 if not in the geometry
+    std::vector<Int_t> physicalIndex(nPhysical + 1, -1);
+    Int_t nMissing = 0;
+    for (Int_t id = 1; id <= nIds; id++)
+    {
+        const Int_t physical = id > nIds / 2 ? id - nIds / 2 : id;
+        if (physical < 1 || physical > nPhysical || physicalIndex[physical] == -2)
+            continue;
+        if (physicalIndex[physical] == -1)
+        {
+            // Partial geometries (e.g. the half barrel of 2021) miss many crystals, so do not let GetAngles log them
+            if (!fCalifaGeo->HasPosition(physical))
+            {
+                physicalIndex[physical] = -2;
+                nMissing++;
+                continue;
+            }
+            physicalIndex[physical] = fCrystalPositions.size();
+            fCrystalPositions.push_back(fCalifaGeo->GetAngles(physical));
+        }
+        fCrystalIndex[id] = physicalIndex[physical];
+    }
+    if (nMissing > 0)
+    {
+        LOG(INFO) << "R3BCalifaCrystalCal2Hit::BuildCrystalTables() : " << nMissing
+                  << " crystals are not in the geometry version " << fGeometryVersion;
+    }
+
+    BuildNeighbourTable();
+}
+
+void R3BCalifaCrystalCal2Hit::BuildNeighbourTable()
+{
+    // The energy scaled window has to be evaluated per hit
+    fNeighbours.clear();
+    fNeighbourWords = 0;
+    if (fClusterAlgorithmSelector == INVALID || fClusterAlgorithmSelector == ROUND_SCALED)
+    {
+        LOG(INFO) << "R3BCalifaCrystalCal2Hit::BuildNeighbourTable() : " << fCrystalPositions.size()
+                  << " crystal positions, no neighbour table for algorithm " << fClusterAlgorithmSelector;
+        return;
+    }
+
+    const size_t n = fCrystalPositions.size();
+    const size_t words = (n + 63) / 64;
+    fNeighbours.assign(n * words, 0);
+    size_t nPairs = 0;
+    // All these conditions are symmetric
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = i; j < n; j++)
+        {
+            if (MatchPositions(fCrystalPositions[i], fCrystalPositions[j]))
+            {
+                fNeighbours[i * words + j / 64] |= 1ULL << (j % 64);
+                fNeighbours[j * words + i / 64] |= 1ULL << (i % 64);
+                nPairs += (i == j) ? 1 : 2;
+            }
+        }
+    }
+    fNeighbourWords = words;
+    LOG(INFO) << "R3BCalifaCrystalCal2Hit::BuildNeighbourTable() : " << n << " crystal positions, "
+              << (n ? (Double_t)nPairs / n : 0.) << " neighbours per crystal on average";
+}
+
+void R3BCalifaCrystalCal2Hit::ClusterAlgorithmChanged()
+{
+    // The neighbour table of the previous algorithm must not be used any more
+    fNeighbours.clear();
+    fNeighbourWords = 0;
+    if (fCalifaGeo)
+        BuildNeighbourTable();
+}
+
 InitStatus R3BCalifaCrystalCal2Hit::ReInit()
 {
     SetParContainers();
     return kSUCCESS;
 }
 
-bool R3BCalifaCrystalCal2Hit::Match(R3BCalifaCrystalCalData* ref, R3BCalifaCrystalCalData* hit)
+bool R3BCalifaCrystalCal2Hit::MatchPositions(const TVector3& vref, const TVector3& vhit) const
 {
-    if (ref == hit)
-        return 1;
-
     auto circleAbs = [](double dphi) {
         double d = fmod(fabs(dphi), 2 * M_PI);
         return d < M_PI ? d : 2 * M_PI - d;
@@ -145,27 +227,17 @@ bool R3BCalifaCrystalCal2Hit::Match(R3BCalifaCrystalCalData* ref, R3BCalifaCryst
     // energy crystal and the others. This is done by using the TVector3 classes and
     // not with different DeltaAngle on theta and phi, to get a proper solid angle
     // and not a "square" one.                    Enrico Fiori
-    TVector3 vref = this->GetAnglesVector(ref->GetCrystalId());
-    TVector3 vhit = this->GetAnglesVector(hit->GetCrystalId());
-    bool takeCrystalInCluster = false;
 
     // Check if the angle between the two vectors is less than the reference angle.
     switch (fClusterAlgorithmSelector)
     {
-        case RECT:
-        { // rectangular window
-            if (TMath::Abs(vref.Theta() - vhit.Theta()) < fDeltaPolar &&
-                circleAbs(vref.Phi() - vhit.Phi()) < fDeltaAzimuthal)
-            {
-                takeCrystalInCluster = true;
-            }
-            break;
-        }
+        case RECT: // rectangular window
+            return TMath::Abs(vref.Theta() - vhit.Theta()) < fDeltaPolar &&
+                   circleAbs(vref.Phi() - vhit.Phi()) < fDeltaAzimuthal;
         case ALL:
-            takeCrystalInCluster = true;
-            break;
+            return true;
         case NONE:
-            break;
+            return false;
         case ROUND: // round window
             // The angle is scaled to a reference distance (e.g. here is
             // set to 35 cm) to take into account Califa's non-spherical
@@ -174,33 +246,47 @@ bool R3BCalifaCrystalCal2Hit::Match(R3BCalifaCrystalCalData* ref, R3BCalifaCryst
             // 35 cm corresponds to ~6cm, setting a fDeltaAngleClust=10
             // means that the gamma rays will be allowed to travel 6 cm in
             // the CsI, no matter the position of the crystal they hit.
-            if (((vref.Angle(vhit)) * ((vref.Mag() + vhit.Mag()) / (35. * 2.))) < fDeltaAngleClust)
-            {
-                takeCrystalInCluster = true;
-            }
-            break;
-        case ROUND_SCALED: // round window scaled with energy
-            // The same as before but the angular window is scaled
-            // according to the energy of the hit in the higher energy
-            // crystal. It needs a parameter that should be calibrated.
-            {
-                Double_t fDeltaAngleClustScaled = fDeltaAngleClust * (ref->GetEnergy() * energyFactor);
-                if (((vref.Angle(vhit)) * ((vref.Mag() + vhit.Mag()) / (35. * 2.))) < fDeltaAngleClustScaled)
-                {
-                    takeCrystalInCluster = true;
-                }
-            }
-            break;
+            return ((vref.Angle(vhit)) * ((vref.Mag() + vhit.Mag()) / (35. * 2.))) < fDeltaAngleClust;
         case CONE:
-            takeCrystalInCluster = vref.Angle(vhit) < fDeltaAngleClust;
-            break;
+            return vref.Angle(vhit) < fDeltaAngleClust;
         case PETAL:
-            takeCrystalInCluster = AngleToPetalId(vref) == AngleToPetalId(vhit);
+            return AngleToPetalId(vref) == AngleToPetalId(vhit);
+        case ROUND_SCALED:
         case INVALID:
         default:
             throw std::runtime_error("R3BCalifaCrystalCal2Hit: no clustering"
                                      " algorithm selected.");
-            break;
+    }
+}
+
+bool R3BCalifaCrystalCal2Hit::Match(R3BCalifaCrystalCalData* ref, R3BCalifaCrystalCalData* hit)
+{
+    if (ref == hit)
+        return 1;
+
+    bool takeCrystalInCluster = false;
+    const Int_t iref = GetCrystalIndex(ref->GetCrystalId());
+    const Int_t ihit = GetCrystalIndex(hit->GetCrystalId());
+    if (fNeighbourWords && iref >= 0 && ihit >= 0)
+    {
+        // Table lookup, see BuildCrystalTables
+        takeCrystalInCluster = (fNeighbours[iref * fNeighbourWords + ihit / 64] >> (ihit % 64)) & 1;
+    }
+    else if (fClusterAlgorithmSelector == ROUND_SCALED) // round window scaled with energy
+    {
+        // The same as ROUND but the angular window is scaled
+        // according to the energy of the hit in the higher energy
+        // crystal. It needs a parameter that should be calibrated.
+        const TVector3 vref = GetAnglesVector(ref->GetCrystalId());
+        const TVector3 vhit = GetAnglesVector(hit->GetCrystalId());
+        Double_t fDeltaAngleClustScaled = fDeltaAngleClust * (ref->GetEnergy() * energyFactor);
+        takeCrystalInCluster =
+            ((vref.Angle(vhit)) * ((vref.Mag() + vhit.Mag()) / (35. * 2.))) < fDeltaAngleClustScaled;
+    }
+    else
+    {
+        takeCrystalInCluster =
+            MatchPositions(GetAnglesVector(ref->GetCrystalId()), GetAnglesVector(hit->GetCrystalId()));
     }
     LOG(DEBUG) << "returning R3BCalifaCrystalCal2Hit::Match(" << ref->GetCrystalId() << ", " << hit->GetCrystalId()
                << ")=" << takeCrystalInCluster << " with alg " << fClusterAlgorithmSelector;
@@ -321,7 +407,11 @@ void R3BCalifaCrystalCal2Hit::SetDRThreshold(Double_t DRthresholdEne)
     LOG(INFO) << "R3BCalifaCrystalCal2Hit::SetDRThreshold to " << fDRThreshold << " keV.";
 }
 
-TVector3 R3BCalifaCrystalCal2Hit::GetAnglesVector(int id) { return fCalifaGeo->GetAngles(id); }
+TVector3 R3BCalifaCrystalCal2Hit::GetAnglesVector(int id)
+{
+    const Int_t index = GetCrystalIndex(id);
+    return index < 0 ? fCalifaGeo->GetAngles(id) : fCrystalPositions[index];
+}
 
 R3BCalifaHitData* R3BCalifaCrystalCal2Hit::AddHit(UInt_t Nbcrystals,
                                                   Double_t ene,
@@ -20,6 +20,8 @@
 
 #include <TVector3.h>
 
+#include <vector>
+
 class TClonesArray;
 class R3BTGeoPar;
 
@@ -59,6 +61,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
         fClusterAlgorithmSelector = RECT;
         fDeltaPolar = xDeltaPolar;
         fDeltaAzimuthal = xDeltaAzimuthal;
+        ClusterAlgorithmChanged();
     }
 
     /** Public method SetRoundWindowAlg
@@ -70,6 +73,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
     {
         fClusterAlgorithmSelector = ROUND;
         fDeltaAngleClust = xDeltaAngleClust;
+        ClusterAlgorithmChanged();
     }
 
     /** Public method SetRoundEnergyScaledAlg
@@ -83,6 +87,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
         fClusterAlgorithmSelector = ROUND_SCALED;
         fDeltaAngleClust = xDeltaAngleClust;
         energyFactor = xenergyFactor;
+        ClusterAlgorithmChanged();
     }
 
     /** Public method SetConeAlg
@@ -94,13 +99,18 @@ class R3BCalifaCrystalCal2Hit : public FairTask
     {
         fClusterAlgorithmSelector = CONE;
         fDeltaAngleClust = xDeltaAngleClust;
+        ClusterAlgorithmChanged();
     }
 
     /** Public method SetPetalAlg
      **
      ** Select the petal clustering algorithm (2018 experiments)
      **/
-    virtual void SetPetalAlg() { fClusterAlgorithmSelector = PETAL; }
+    virtual void SetPetalAlg()
+    {
+        fClusterAlgorithmSelector = PETAL;
+        ClusterAlgorithmChanged();
+    }
 
     /** Public method SetCrystalThreshold
      **
@@ -125,7 +135,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
     /** Accessor to select online mode **/
     void SetOnline(Bool_t option) { fOnline = option; }
 
-    static int AngleToPetalId(TVector3& vec)
+    static int AngleToPetalId(const TVector3& vec)
     {
         // internal [double] petal number, not corresponding to anything real
         // only relevant for 2019 beam times
@@ -158,7 +168,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
     /** Virtual method ReInit **/
     virtual InitStatus ReInit();
 
-    /** Method GetAnglesVector (calls R3BCalifaGeometry::GetAngles(id)) **/
+    /** Method GetAnglesVector (position table, or R3BCalifaGeometry::GetAngles(id) for unknown ids) **/
     TVector3 GetAnglesVector(int id);
     TVector3 fTargetPos;
     TVector3 fCalifaPos;
@@ -199,6 +209,48 @@ class R3BCalifaCrystalCal2Hit : public FairTask
 
     R3BCalifaGeometry* fCalifaGeo;
 
+    // Crystal positions and clustering neighbours, computed once per run in Init. Both ranges of a double reading
+    // crystal share one entry.
+    std::vector<Int_t> fCrystalIndex;        //! Entry in fCrystalPositions for each crystal id, -1 if not known
+    std::vector<TVector3> fCrystalPositions; //!
+    std::vector<ULong64_t> fNeighbours;      //! Bit matrix: bit j of row i is set if crystal j matches crystal i
+    size_t fNeighbourWords;                  //! 64 bit words per row of fNeighbours, 0 if there is no matrix
+
+    /** Protected method BuildCrystalTables
+     **
+     ** Fills the position table and, for algorithms that only depend on the crystal positions, the neighbour matrix
+     **/
+    void BuildCrystalTables();
+
+    /** Protected method BuildNeighbourTable
+     **
+     ** Fills the neighbour matrix for the selected algorithm from the position table
+     **/
+    void BuildNeighbourTable();
+
+    /** Protected method ClusterAlgorithmChanged
+     **
+     ** Drops the neighbour matrix of the previous algorithm, and rebuilds it if Init has been called already
+     **/
+    void ClusterAlgorithmChanged();
+
+    /** Protected method MatchPositions
+     **
+     ** Cluster condition of the algorithms that only depend on the crystal positions
+     **/
+    bool MatchPositions(const TVector3& vref, const TVector3& vhit) const;
+
+    Int_t GetCrystalIndex(Int_t id) const
+    {
+        return (id >= 0 && id < (Int_t)fCrystalIndex.size()) ? fCrystalIndex[id] : -1;
+    }
+
+    /** Protected method Match
+     **
+     ** Decides if hit is in the cluster started by ref
+     **/
+    virtual bool Match(R3BCalifaCrystalCalData* ref, R3BCalifaCrystalCalData* hit);
+
   private:
     /** Private method AddHit
      **
@@ -212,12 +264,6 @@ class R3BCalifaCrystalCal2Hit : public FairTask
                              Double_t aAngle,
                              ULong64_t time);
 
-    /** Private method Match
-     **
-     ** Decides if hit is in the cluster started by ref
-     **/
-    virtual bool Match(R3BCalifaCrystalCalData* ref, R3BCalifaCrystalCalData* hit);
-
     ClassDef(R3BCalifaCrystalCal2Hit, 2);
 };
 
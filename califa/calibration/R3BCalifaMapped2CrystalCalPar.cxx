@@ -12,13 +12,10 @@
  ******************************************************************************/
 
 #include "TClonesArray.h"
-#include "TF1.h"
-#include "TGraph.h"
 #include "TH1F.h"
 #include "TMath.h"
 #include "TObjArray.h"
 #include "TRandom.h"
-#include "TSpectrum.h"
 #include "TVector3.h"
 
 #include "FairLogger.h"
@@ -30,9 +27,11 @@
 #include "R3BCalifaMapped2CrystalCalPar.h"
 #include "R3BCalifaMappedData.h"
 #include "R3BCalifaMappingPar.h"
+#include "R3BCalifaPeakFitter.h"
 
 #include <iostream>
 #include <stdlib.h>
+#include <vector>
 
 R3BCalifaMapped2CrystalCalPar::R3BCalifaMapped2CrystalCalPar()
     : R3BCalifaMapped2CrystalCalPar("R3B CALIFA Calibration Parameters Finder ", 1)
@@ -56,6 +55,7 @@ R3BCalifaMapped2CrystalCalPar::R3BCalifaMapped2CrystalCalPar(const char* name, I
     , fNumPeaks(0)
     , fSigma(0)
     , fThreshold(0)
+    , fNumThreads(0)
     , fEnergyPeaks(NULL)
     , fDebugMode(0)
 {
@@ -218,106 +218,48 @@ void R3BCalifaMapped2CrystalCalPar::FinishTask()
 
 void R3BCalifaMapped2CrystalCalPar::SearchPeaks()
 {
-    Int_t nfound = 0;
     Int_t numPars = 2; // Number of parameters=2 by default
     if (fNumParam)
     {
         numPars = fNumParam;
     }
+    else
+    {
+        LOG(WARNING) << "R3BCalifaMapped2CrystalCalPar:: No imput number of fit parameters, therefore, by default "
+                        "NumberParameters=2";
+    }
+    if (numPars > 5)
+    {
+        LOG(WARNING) << "R3BCalifaMapped2CrystalCalPar:: The number of fit parameters can not be higher than 5";
+        return;
+    }
 
     fCal_Par->SetNumCrystals(fNumCrystals);
     fCal_Par->SetNumParametersFit(fNumParam);
     fCal_Par->GetCryCalParams()->Set(numPars * fNumCrystals);
 
-    TSpectrum* ss = new TSpectrum(fNumPeaks);
+    std::vector<TH1*> histograms(fNumCrystals, nullptr);
+    for (Int_t i = 0; i < fNumCrystals; i++)
+        if (fMap_Par->GetInUse(i + 1) == 1 && fh_Map_energy_crystal[i]->GetEntries() > fMinStadistics)
+            histograms[i] = fh_Map_energy_crystal[i];
 
-    Int_t fright, fleft;
+    // The crystals are fitted in parallel, the results are merged in crystal order
+    R3BCalifaPeakFitter fitter(*fEnergyPeaks, fSigma, fThreshold, numPars);
+    fitter.SetNumThreads(fNumThreads);
+    fitter.SetDrawPeaks(fDebugMode);
+    std::vector<Double_t> params;
+    const std::vector<Int_t> nfound = fitter.Fit(histograms, params);
+    LOG(INFO) << "R3BCalifaMapped2CrystalCalPar::SearchPeaks() using " << fitter.GetNumThreads() << " threads";
 
     for (Int_t i = 0; i < fNumCrystals; i++)
         if (fMap_Par->GetInUse(i + 1) == 1)
         {
-
-            if (fh_Map_energy_crystal[i]->GetEntries() > fMinStadistics)
+            LOG(DEBUG) << "CrystalId=" << i + 1 << " " << nfound[i] << " " << fThreshold;
+            if (nfound[i] > 0)
             {
-
-                if (fDebugMode)
-                    nfound = ss->Search(fh_Map_energy_crystal[i], fSigma, "", fThreshold); // number of peaks
-                else
-                    nfound = ss->Search(fh_Map_energy_crystal[i], fSigma, "goff", fThreshold);
-                LOG(DEBUG) << "CrystalId=" << i + 1 << " " << nfound << " " << fThreshold;
-                fChannelPeaks = (Double_t*)ss->GetPositionX();
-
-                Int_t idx[nfound];
-                TMath::Sort(nfound, fChannelPeaks, idx, kTRUE);
-
-                // Calibrated Spectrum
-                Double_t X[nfound + 1];
-                Double_t Y[nfound + 1];
-
-                for (Int_t j = 0; j < nfound; j++)
-                {
-                    X[j] = fChannelPeaks[idx[nfound - j - 1]];
-                    Y[j] = fEnergyPeaks->GetAt(nfound - j - 1);
-                    LOG(DEBUG) << "CrystalId=" << i + 1 << " " << j + 1 << " " << X[j + 1];
-                }
-                X[nfound] = 0.;
-                Y[nfound] = 0.;
-
-                if (i < fMap_Par->GetNumCrystals() / 2)
-                {
-                    fright = fMapHistos_right;
-                    fleft = fMapHistos_left;
-                }
-                else
-                {
-                    fright = fMapHistos_rightp;
-                    fleft = fMapHistos_leftp;
-                }
-
-                TF1* f1 = nullptr;
-                if (fNumParam)
-                {
-
-                    if (fNumParam == 1)
-                    {
-                        f1 = new TF1("f1", "[0]*x", fleft, fright);
-                    }
-                    if (fNumParam == 2)
-                    {
-                        f1 = new TF1("f1", "[0]+[1]*x", fleft, fright);
-                    }
-                    if (fNumParam == 3)
-                    {
-                        f1 = new TF1("f1", "[0]+[1]*x+[2]*pow(x,2)", fleft, fright);
-                    }
-                    if (fNumParam == 4)
-                    {
-                        f1 = new TF1("f1", "[0]+[1]*x+[2]*pow(x,2)+[3]*pow(x,3)", fleft, fright);
-                    }
-                    if (fNumParam == 5)
-                    {
-                        f1 = new TF1("f1", "[0]+[1]*x+[2]*pow(x,2)+[3]*pow(x,3)+[4]*pow(x,4)", fleft, fright);
-                    }
-                    if (fNumParam > 5)
-                    {
-                        LOG(WARNING)
-                            << "R3BCalifaMapped2CrystalCalPar:: The number of fit parameters can not be higher than 5";
-                    }
-                }
-                else
-                {
-                    LOG(WARNING)
-                        << "R3BCalifaMapped2CrystalCalPar:: No imput number of fit parameters, therefore, by default "
-                           "NumberParameters=2";
-                    f1 = new TF1("f1", "[0]+[1]*x", fleft, fright);
-                }
-
-                TGraph* graph = new TGraph(fNumPeaks + 1, X, Y);
-                graph->Fit("f1", "Q"); // Quiet mode (minimum printing)
-
                 for (Int_t h = 0; h < numPars; h++)
                 {
-                    fCal_Par->SetCryCalParams(f1->GetParameter(h), numPars * i + h);
+                    fCal_Par->SetCryCalParams(params[numPars * i + h], numPars * i + h);
                 }
             }
             else
@@ -326,7 +268,6 @@ void R3BCalifaMapped2CrystalCalPar::SearchPeaks()
             }
         }
 
-    delete ss;
     fCal_Par->setChanged();
     return;
 }
@@ -86,6 +86,8 @@ class R3BCalifaMapped2CrystalCalPar : public FairTask
     void SetMinStadistics(Int_t minstad) { fMinStadistics = minstad; }
 
     void SetDebugMode(Bool_t debug) { fDebugMode = debug; }
+    /** Number of threads for the peak search, 0 means one per core. The debug mode runs single threaded **/
+    void SetNumThreads(UInt_t nThreads) { fNumThreads = nThreads; }
 
     void SetEnergyPeaks(TArrayF* thePeaks)
     {
@@ -111,8 +113,9 @@ class R3BCalifaMapped2CrystalCalPar : public FairTask
     Double_t fSigma;
     Double_t fThreshold;
 
+    UInt_t fNumThreads;
+
     TArrayF* fEnergyPeaks;
-    Double_t* fChannelPeaks;
 
     R3BCalifaMappingPar* fMap_Par;     /**< Parameter container with mapping. >*/
     R3BCalifaCrystalCalPar* fCal_Par;  /**< Container for Cal parameters. >*/
@@ -121,7 +124,7 @@ class R3BCalifaMapped2CrystalCalPar : public FairTask
     TH1F** fh_Map_energy_crystal;
 
   public:
-    ClassDef(R3BCalifaMapped2CrystalCalPar, 2);
+    ClassDef(R3BCalifaMapped2CrystalCalPar, 3);
 };
 
 #endif
@@ -0,0 +1,165 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BCalifaPeakFitter.h"
+
+#include "TArrayF.h"
+#include "TDecompSVD.h"
+#include "TH1.h"
+#include "TMath.h"
+#include "TMatrixD.h"
+#include "TROOT.h"
+#include "TSpectrum.h"
+#include "TVectorD.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+R3BCalifaPeakFitter::R3BCalifaPeakFitter(const TArrayF& energies, Double_t sigma, Double_t threshold, Int_t numParams)
+    : fEnergies(energies.GetArray(), energies.GetArray() + energies.GetSize())
+    , fSigma(sigma)
+    , fThreshold(threshold)
+    , fNumParams(numParams)
+    , fNumThreads(0)
+    , fDrawPeaks(kFALSE)
+{
+}
+
+UInt_t R3BCalifaPeakFitter::GetNumThreads() const
+{
+    if (fDrawPeaks)
+    {
+        return 1;
+    }
+    if (fNumThreads > 0)
+    {
+        return fNumThreads;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::vector<Int_t> R3BCalifaPeakFitter::Fit(const std::vector<TH1*>& histograms, std::vector<Double_t>& params) const
+{
+    const size_t n = histograms.size();
+    std::vector<Int_t> nPeaks(n, 0);
+    params.assign(n * fNumParams, 0.);
+
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+        TSpectrum spectrum(fEnergies.size());
+        for (size_t i = next++; i < n; i = next++)
+        {
+            if (histograms[i])
+            {
+                nPeaks[i] = Fit(histograms[i], spectrum, &params[fNumParams * i]);
+            }
+        }
+    };
+
+    const UInt_t nThreads = std::min<size_t>(GetNumThreads(), n);
+    if (nThreads <= 1)
+    {
+        work();
+        return nPeaks;
+    }
+
+    ROOT::EnableThreadSafety();
+    std::vector<std::thread> workers;
+    for (UInt_t t = 1; t < nThreads; ++t)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    return nPeaks;
+}
+
+Int_t R3BCalifaPeakFitter::Fit(TH1* histogram, TSpectrum& spectrum, Double_t* params) const
+{
+    const Int_t nfound = spectrum.Search(histogram, fSigma, fDrawPeaks ? "" : "goff", fThreshold);
+    if (nfound < 1)
+    {
+        return 0;
+    }
+
+    const Double_t* channels = spectrum.GetPositionX();
+    std::vector<Int_t> idx(nfound);
+    TMath::Sort(nfound, channels, idx.data(), kTRUE);
+
+    // Lowest channel to the last energy, the origin is fixed by the last point
+    std::vector<Double_t> x(nfound + 1);
+    std::vector<Double_t> y(nfound + 1);
+    for (Int_t j = 0; j < nfound; j++)
+    {
+        x[j] = channels[idx[nfound - j - 1]];
+        y[j] = fEnergies[nfound - j - 1];
+    }
+    x[nfound] = 0.;
+    y[nfound] = 0.;
+
+    return FitLine(x, y, params) ? nfound : 0;
+}
+
+Bool_t R3BCalifaPeakFitter::FitLine(const std::vector<Double_t>& x,
+                                    const std::vector<Double_t>& y,
+                                    Double_t* params) const
+{
+    const Int_t nPoints = x.size();
+    if (fNumParams < 1 || nPoints < fNumParams)
+    {
+        return kFALSE;
+    }
+
+    // Work in x / scale to keep the higher powers well conditioned
+    Double_t scale = 0.;
+    for (auto xi : x)
+    {
+        scale = std::max(scale, std::abs(xi));
+    }
+    if (scale == 0.)
+    {
+        return kFALSE;
+    }
+
+    const Int_t firstPower = fNumParams == 1 ? 1 : 0;
+    TMatrixD a(nPoints, fNumParams);
+    TVectorD b(nPoints);
+    for (Int_t p = 0; p < nPoints; p++)
+    {
+        const Double_t u = x[p] / scale;
+        Double_t un = firstPower == 1 ? u : 1.;
+        for (Int_t k = 0; k < fNumParams; k++)
+        {
+            a(p, k) = un;
+            un *= u;
+        }
+        b(p) = y[p];
+    }
+
+    TDecompSVD svd(a);
+    if (!svd.Solve(b))
+    {
+        return kFALSE;
+    }
+
+    for (Int_t k = 0; k < fNumParams; k++)
+    {
+        params[k] = b(k) / std::pow(scale, k + firstPower);
+    }
+    return kTRUE;
+}
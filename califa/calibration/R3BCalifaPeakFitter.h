@@ -0,0 +1,72 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BCALIFAPEAKFITTER_H
+#define R3BCALIFAPEAKFITTER_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+class TArrayF;
+class TH1;
+class TSpectrum;
+
+/*
+ * Peak search and energy calibration fit of the crystal spectra, used by
+ * R3BCalifaMapped2CrystalCalPar.
+ *
+ * The peaks found in a spectrum are paired in increasing channel order with
+ * the calibration energies in reverse order, together with the origin. The
+ * calibration function is [0]*x for one parameter and a polynomial of degree
+ * n-1 for n parameters. As it is linear in its parameters, it is fitted by
+ * linear least squares, which gives the same minimum as a chi2 fit of the
+ * TGraph but needs no global TF1 and no Minuit.
+ *
+ * The spectra are independent, Fit() spreads them over several threads, each
+ * with its own TSpectrum, and writes the results into fixed slots. The
+ * result does not depend on the number of threads.
+ */
+class R3BCalifaPeakFitter
+{
+  public:
+    R3BCalifaPeakFitter(const TArrayF& energies, Double_t sigma, Double_t threshold, Int_t numParams);
+
+    /* Number of threads, 0 means one per core */
+    void SetNumThreads(UInt_t nThreads) { fNumThreads = nThreads; }
+    /* Attach the peak markers to the histograms, this runs single threaded */
+    void SetDrawPeaks(Bool_t draw) { fDrawPeaks = draw; }
+
+    Int_t GetNumParams() const { return fNumParams; }
+    UInt_t GetNumThreads() const;
+
+    /* Fit all histograms, nullptr entries are skipped. The parameters of
+     * histograms[i] go to params[GetNumParams() * i + k]. Returns per
+     * histogram the number of peaks used, 0 if it was not fitted. */
+    std::vector<Int_t> Fit(const std::vector<TH1*>& histograms, std::vector<Double_t>& params) const;
+
+    /* Fit a single histogram with a TSpectrum owned by the calling thread */
+    Int_t Fit(TH1* histogram, TSpectrum& spectrum, Double_t* params) const;
+
+  private:
+    Bool_t FitLine(const std::vector<Double_t>& x, const std::vector<Double_t>& y, Double_t* params) const;
+
+    std::vector<Double_t> fEnergies;
+    Double_t fSigma;
+    Double_t fThreshold;
+    Int_t fNumParams;
+    UInt_t fNumThreads;
+    Bool_t fDrawPeaks;
+};
+
+#endif
@@ -19,8 +19,13 @@
 #include <TString.h>
 #include <TSystem.h>
 #include <TVector3.h>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <stdlib.h>
+#include <string>
 #include <vector>
 
 #include <FairLogger.h>
@@ -31,9 +36,15 @@
 
 R3BCalifaGeometry* R3BCalifaGeometry::inst = NULL;
 
+namespace
+{
+    std::mutex gInstanceMutex;
+} // namespace
+
 R3BCalifaGeometry* R3BCalifaGeometry::Instance(Int_t version)
 {
     LOG(DEBUG) << "R3BCalifaGeometry::Instance ";
+    std::lock_guard<std::mutex> lock(gInstanceMutex);
     if (!inst)
         inst = new R3BCalifaGeometry(version);
     else if (inst->fGeometryVersion != version)
@@ -54,6 +65,12 @@ R3BCalifaGeometry::R3BCalifaGeometry()
 
 R3BCalifaGeometry::R3BCalifaGeometry(Int_t version)
     : fGeometryVersion(version)
+    , fNumCrystals(0)
+    , fIsSimulation(kFALSE)
+    , f(NULL)
+    , fGeoPath()
+    , fGeometryLoaded(kFALSE)
+    , fPositions()
 {
     LOG(DEBUG) << "Creating new R3BCalifaGeometry for version " << version;
 
@@ -84,6 +101,7 @@ R3BCalifaGeometry::R3BCalifaGeometry(Int_t version)
             LOG(ERROR) << "R3BCalifaGeometry: Unsupported geometry version: " << version;
             return;
     }
+    fGeoPath = geoPath;
 
     if (gGeoManager && strcmp(gGeoManager->GetTopVolume()->GetName(), "cave") == 0)
     {
@@ -91,23 +109,26 @@ R3BCalifaGeometry::R3BCalifaGeometry(Int_t version)
         LOG(DEBUG) << "R3BCalifaGeometry: Using existing geometry";
         LOG(INFO) << "R3BCalifaGeometry::Open geometry file " << geoPath;
         fIsSimulation = kTRUE;
+        fGeometryLoaded = kTRUE;
+        BuildPositionTable();
         return;
     }
 
-    // Stand alone mode
-    LOG(INFO) << "R3BCalifaGeometry::Open geometry file " << geoPath << " for analysis.";
-    f = new TFile(geoPath, "READ");
-    TGeoVolume* v = dynamic_cast<TGeoVolume*>(f->Get("TOP"));
-    if (!v)
+    // Stand alone mode: Use the position table next to the geometry file if it is up to date, the geometry itself
+    // is then only loaded if a function needs it.
+    TString tablePath = geoPath;
+    tablePath.ReplaceAll(".geo.root", ".positions.dat");
+    FileStat_t geoStat, tableStat;
+    if (gSystem->GetPathInfo(tablePath, tableStat) == 0 &&
+        (gSystem->GetPathInfo(geoPath, geoStat) != 0 || tableStat.fMtime >= geoStat.fMtime) &&
+        ReadPositionTable(tablePath))
     {
-        LOG(ERROR) << "R3BCalifaGeometry: Could not open CALIFA geometry file: No TOP volume";
+        LOG(INFO) << "R3BCalifaGeometry::Read crystal positions from " << tablePath << " for analysis.";
         return;
     }
-    v->SetName("cave");
-    if (!gGeoManager)
-        gGeoManager = new TGeoManager();
-    gGeoManager->SetTopVolume(v);
-    fIsSimulation = kFALSE;
+
+    if (OpenGeometry())
+        BuildPositionTable();
 }
 
 R3BCalifaGeometry::~R3BCalifaGeometry()
@@ -119,23 +140,45 @@ R3BCalifaGeometry::~R3BCalifaGeometry()
         f->Close();
 }
 
-const TVector3& R3BCalifaGeometry::GetAngles(Int_t iD)
+Bool_t R3BCalifaGeometry::OpenGeometry()
 {
-    static std::map<int, TVector3> cache;
-    Double_t local[3] = { 0, 0, 0 };
-    Double_t master[3];
-    const static TVector3 invalid(NAN, NAN, NAN);
-    const char* nameVolume;
-    if (cache.count(iD))
-        return cache[iD];
+    if (fGeometryLoaded)
+        return kTRUE;
+    if (fGeoPath.IsNull())
+        return kFALSE;
 
-    // SOLUTION FOR DOUBLE READING CHANNELS
-    if (iD > fNumCrystals / 2 && iD <= fNumCrystals)
-        iD = iD - fNumCrystals / 2; // for double reading crystals (crystals from 1 to 2432)
+    LOG(INFO) << "R3BCalifaGeometry::Open geometry file " << fGeoPath << " for analysis.";
+    f = new TFile(fGeoPath, "READ");
+    TGeoVolume* v = dynamic_cast<TGeoVolume*>(f->Get("TOP"));
+    if (!v)
+    {
+        LOG(ERROR) << "R3BCalifaGeometry: Could not open CALIFA geometry file: No TOP volume";
+        return kFALSE;
+    }
+    v->SetName("cave");
+    if (!gGeoManager)
+        gGeoManager = new TGeoManager();
+    gGeoManager->SetTopVolume(v);
+    fGeometryLoaded = kTRUE;
+    return kTRUE;
+}
 
-    if (iD >= 1 && iD <= 2432)
+void R3BCalifaGeometry::SetPosition(Int_t iD, const TVector3& position)
+{
+    // Both ranges of double reading crystals share the position
+    fPositions[iD] = position;
+    if (iD + fNumCrystals / 2 <= fNumCrystals)
+        fPositions[iD + fNumCrystals / 2] = position;
+}
+
+void R3BCalifaGeometry::BuildPositionTable()
+{
+    fPositions.assign(fNumCrystals + 1, TVector3(NAN, NAN, NAN));
+    Double_t local[3] = { 0, 0, 0 };
+    Double_t master[3];
+    for (Int_t iD = 1; iD <= kNumPhysicalCrystals && iD <= fNumCrystals; iD++)
     {
-        nameVolume = GetCrystalVolumePath(iD);
+        const char* nameVolume = GetCrystalVolumePath(iD);
 
         gGeoManager->CdTop();
 
@@ -143,21 +186,88 @@ const TVector3& R3BCalifaGeometry::GetAngles(Int_t iD)
             gGeoManager->cd(nameVolume);
         else
         {
-            LOG(ERROR) << "R3BCalifaGeometry: Invalid crystal path: " << nameVolume;
-            return invalid;
+            LOG(DEBUG) << "R3BCalifaGeometry: Invalid crystal path: " << nameVolume;
+            continue;
         }
         gGeoManager->LocalToMaster(local, master);
+        SetPosition(iD, TVector3(master));
     }
-    else
+}
+
+Bool_t R3BCalifaGeometry::ReadPositionTable(const char* fileName)
+{
+    std::ifstream in(fileName);
+    std::string line;
+    Int_t version = -1;
+    Int_t numCrystals = -1;
+    // Header: "# R3BCalifaGeometry version <version> crystals <number of ids>"
+    if (!std::getline(in, line) ||
+        sscanf(line.c_str(), "# R3BCalifaGeometry version %d crystals %d", &version, &numCrystals) != 2)
+    {
+        LOG(ERROR) << "R3BCalifaGeometry::ReadPositionTable: " << fileName << " is not a crystal position table";
+        return kFALSE;
+    }
+    if (version != fGeometryVersion || numCrystals != fNumCrystals)
+    {
+        LOG(ERROR) << "R3BCalifaGeometry::ReadPositionTable: " << fileName << " is for version " << version << " with "
+                   << numCrystals << " crystals instead of version " << fGeometryVersion << " with " << fNumCrystals;
+        return kFALSE;
+    }
+
+    fPositions.assign(fNumCrystals + 1, TVector3(NAN, NAN, NAN));
+    Int_t iD;
+    Double_t x, y, z;
+    while (in >> iD >> x >> y >> z)
+    {
+        if (iD < 1 || iD > kNumPhysicalCrystals || iD > fNumCrystals)
+        {
+            LOG(ERROR) << "R3BCalifaGeometry::ReadPositionTable: Invalid crystalId " << iD << " in " << fileName;
+            fPositions.clear();
+            return kFALSE;
+        }
+        SetPosition(iD, TVector3(x, y, z));
+    }
+    if (!in.eof())
+    {
+        LOG(ERROR) << "R3BCalifaGeometry::ReadPositionTable: Could not read " << fileName;
+        fPositions.clear();
+        return kFALSE;
+    }
+    return kTRUE;
+}
+
+Bool_t R3BCalifaGeometry::WritePositionTable(const char* fileName) const
+{
+    std::ofstream out(fileName);
+    if (!out)
+    {
+        LOG(ERROR) << "R3BCalifaGeometry::WritePositionTable: Could not open " << fileName;
+        return kFALSE;
+    }
+    out << "# R3BCalifaGeometry version " << fGeometryVersion << " crystals " << fNumCrystals << "\n";
+    out.precision(17);
+    for (Int_t iD = 1; iD <= kNumPhysicalCrystals && iD < (Int_t)fPositions.size(); iD++)
+    {
+        const TVector3& pos = fPositions[iD];
+        if (!std::isnan(pos.X()))
+            out << iD << " " << pos.X() << " " << pos.Y() << " " << pos.Z() << "\n";
+    }
+    out.close();
+    return !out.fail();
+}
+
+const TVector3& R3BCalifaGeometry::GetAngles(Int_t iD) const
+{
+    const static TVector3 invalid(NAN, NAN, NAN);
+    if (!HasPosition(iD))
     {
         LOG(ERROR) << "R3BCalifaGeometry: Invalid crystalId: " << iD;
         return invalid;
     }
-
-    return cache[iD] = master;
+    return fPositions[iD];
 }
 
-void R3BCalifaGeometry::GetAngles(Int_t iD, Double_t* polar, Double_t* azimuthal, Double_t* rho)
+void R3BCalifaGeometry::GetAngles(Int_t iD, Double_t* polar, Double_t* azimuthal, Double_t* rho) const
 {
     auto& masterV = this->GetAngles(iD);
     *polar = masterV.Theta();
@@ -235,6 +345,9 @@ double R3BCalifaGeometry::GetDistanceThroughCrystals(TVector3& startVertex,
 
     TGeoNode* n;
 
+    if (!OpenGeometry())
+        return 0.;
+
     gGeoManager->InitTrack(startVertex.X(),
                            startVertex.Y(),
                            startVertex.Z(),
@@ -16,12 +16,21 @@
 
 #include <TFile.h>
 #include <TObject.h>
+#include <TString.h>
+#include <TVector3.h>
+
+#include <cmath>
+#include <vector>
 
-class TVector3;
 class TGeoNavigator;
 
 /**
  * Geometrical queries to CALIFA
+ *
+ * The crystal positions are computed once, when the instance is created, and kept in a table indexed by crystal ID.
+ * Reading them is thread-safe. For data analysis, the table is read from <geometry>.positions.dat next to the
+ * geometry file if it exists and is up to date (see WritePositionTable), so that the geometry only needs to be
+ * loaded for GetDistanceThroughCrystals.
  */
 class R3BCalifaGeometry : public TObject
 {
@@ -42,7 +51,16 @@ class R3BCalifaGeometry : public TObject
      * On error, the x,y and z component of the TVector3 are set to NAN.
      * @param iD crystal ID (depending on geometry version)
      */
-    const TVector3& GetAngles(Int_t iD);
+    const TVector3& GetAngles(Int_t iD) const;
+
+    /**
+     * Checks whether the crystal with given ID is in the geometry, without logging an error like GetAngles.
+     * @param iD crystal ID (depending on geometry version)
+     */
+    Bool_t HasPosition(Int_t iD) const
+    {
+        return iD >= 1 && iD < (Int_t)fPositions.size() && !std::isnan(fPositions[iD].X());
+    }
 
     /**
      * Legacy: Gets position in polar coordinates of crystal with given ID.
@@ -55,7 +73,23 @@ class R3BCalifaGeometry : public TObject
      * @param azimuthal [out] Will be filled with azimuthal angle (radians) of crystal center
      * @param rho [out] Will be filled with distance (cm) of crystal center to target position (0,0,0)
      */
-    void GetAngles(Int_t iD, Double_t* polar, Double_t* azimuthal, Double_t* rho);
+    void GetAngles(Int_t iD, Double_t* polar, Double_t* azimuthal, Double_t* rho) const;
+
+    /**
+     * Writes the crystal position table, e.g. to $VMCWORKDIR/geometry/califa_2020.positions.dat
+     *
+     * @param fileName Output file
+     * @return kTRUE on success
+     */
+    Bool_t WritePositionTable(const char* fileName) const;
+
+    /**
+     * Reads the crystal position table written by WritePositionTable
+     *
+     * @param fileName Input file
+     * @return kTRUE on success, the table is empty on error
+     */
+    Bool_t ReadPositionTable(const char* fileName);
 
     /**
      * Gets volume path of crystal with given ID.
@@ -99,6 +133,14 @@ class R3BCalifaGeometry : public TObject
                                       Int_t* numCrystals = NULL,
                                       Int_t* crystalIds = NULL);
 
+    /**
+     * @return Highest crystal ID, including the second range of double reading crystals
+     */
+    Int_t GetNumCrystals() const { return fNumCrystals; }
+
+    /** Crystals 1 to 2432, without the second range of double reading crystals **/
+    static const Int_t kNumPhysicalCrystals = 2432;
+
     /**
      * @return if we are running the simulation or data analysis
      */
@@ -114,11 +156,20 @@ class R3BCalifaGeometry : public TObject
     static R3BCalifaGeometry* Instance(Int_t version);
 
   private:
+    /** Loads the geometry file if this has not happened yet, kFALSE if it is not available **/
+    Bool_t OpenGeometry();
+    void BuildPositionTable();
+    void SetPosition(Int_t iD, const TVector3& position);
+
     Int_t fGeometryVersion;
     Int_t fNumCrystals;
     Bool_t fIsSimulation;
     TFile* f;
 
+    TString fGeoPath;                 //!
+    Bool_t fGeometryLoaded;           //!
+    std::vector<TVector3> fPositions; //! Indexed by crystal ID, NAN for unknown IDs
+
     static R3BCalifaGeometry* inst;
 
     ClassDef(R3BCalifaGeometry, 8);
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Runs the peak search and calibration fit of R3BCalifaMapped2CrystalCalPar
+// on the fh_Map_energy_crystal_<id> histograms of a file, as written by the
+// task in debug mode, with one and with several threads, and compares speed
+// and results.
+// Usage: benchCalifaPeakFit <histogram file> [threads, default all cores] [sigma, default 3]
+//                           [threshold, default 0.05] [parameters, default 2] [energies, default 1332.5 1173.2]
+
+#include "R3BCalifaPeakFitter.h"
+
+#include "TArrayF.h"
+#include "TFile.h"
+#include "TH1.h"
+#include "TKey.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const char* kPrefix = "fh_Map_energy_crystal_";
+
+    Double_t Run(const char* name, R3BCalifaPeakFitter& fitter, const std::vector<TH1*>& histograms,
+                 std::vector<Double_t>& params, std::vector<Int_t>& nPeaks)
+    {
+        auto start = std::chrono::steady_clock::now();
+        nPeaks = fitter.Fit(histograms, params);
+        const Double_t s = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+        Int_t nFitted = 0;
+        for (auto n : nPeaks)
+        {
+            nFitted += n > 0;
+        }
+        std::cout << name << " (" << fitter.GetNumThreads() << " threads): " << s << " s, " << nFitted
+                  << " crystals fitted" << std::endl;
+        return s;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " <histogram file> [threads] [sigma] [threshold] [parameters] [energies...]" << std::endl;
+        return 1;
+    }
+    const UInt_t nThreads = argc > 2 ? atoi(argv[2]) : 0;
+    const Double_t sigma = argc > 3 ? atof(argv[3]) : 3.;
+    const Double_t threshold = argc > 4 ? atof(argv[4]) : 0.05;
+    const Int_t numParams = argc > 5 ? atoi(argv[5]) : 2;
+    TArrayF energies;
+    if (argc > 6)
+    {
+        energies.Set(argc - 6);
+        for (Int_t i = 6; i < argc; i++)
+        {
+            energies[i - 6] = atof(argv[i]);
+        }
+    }
+    else
+    {
+        energies.Set(2);
+        energies[0] = 1332.5;
+        energies[1] = 1173.2;
+    }
+
+    std::unique_ptr<TFile> file(TFile::Open(argv[1]));
+    if (!file || file->IsZombie())
+    {
+        std::cerr << "Cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    // Indexed by crystal id - 1 like in the task
+    std::vector<TH1*> histograms;
+    for (auto obj : *file->GetListOfKeys())
+    {
+        auto key = static_cast<TKey*>(obj);
+        if (strncmp(key->GetName(), kPrefix, strlen(kPrefix)) != 0)
+        {
+            continue;
+        }
+        const Int_t id = atoi(key->GetName() + strlen(kPrefix));
+        auto h = dynamic_cast<TH1*>(key->ReadObj());
+        if (id < 1 || !h)
+        {
+            continue;
+        }
+        h->SetDirectory(nullptr);
+        if (id > (Int_t)histograms.size())
+        {
+            histograms.resize(id, nullptr);
+        }
+        delete histograms[id - 1];
+        histograms[id - 1] = h;
+    }
+    std::cout << "Read " << histograms.size() << " crystal slots from " << argv[1] << std::endl;
+
+    R3BCalifaPeakFitter fitter(energies, sigma, threshold, numParams);
+    std::vector<Double_t> serial, parallel;
+    std::vector<Int_t> serialPeaks, parallelPeaks;
+
+    fitter.SetNumThreads(1);
+    const Double_t tSerial = Run("serial", fitter, histograms, serial, serialPeaks);
+    fitter.SetNumThreads(nThreads);
+    const Double_t tParallel = Run("parallel", fitter, histograms, parallel, parallelPeaks);
+
+    Int_t nDiff = 0;
+    for (size_t i = 0; i < serial.size(); i++)
+    {
+        if (serial[i] != parallel[i])
+        {
+            nDiff++;
+        }
+    }
+    nDiff += serialPeaks != parallelPeaks;
+    std::cout << "speedup " << tSerial / tParallel << ", " << nDiff << " differences" << std::endl;
+
+    for (auto h : histograms)
+    {
+        delete h;
+    }
+    return nDiff == 0 ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BCalifaCrystalCal2Hit.h"
+#include "R3BCalifaCrystalCalData.h"
+#include "R3BCalifaGeometry.h"
+#include "TMath.h"
+#include "TSystem.h"
+#include "TVector3.h"
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const Int_t kVersion = 2021;
+    const Int_t kNumIds = 4864;
+    const Int_t kPhysical = R3BCalifaGeometry::kNumPhysicalCrystals;
+
+    // Gives access to the tables that Init builds
+    class Cal2HitTables : public R3BCalifaCrystalCal2Hit
+    {
+      public:
+        using R3BCalifaCrystalCal2Hit::GetCrystalIndex;
+        using R3BCalifaCrystalCal2Hit::Match;
+        using R3BCalifaCrystalCal2Hit::MatchPositions;
+
+        void Build(R3BCalifaGeometry* geo)
+        {
+            SelectGeometryVersion(kVersion);
+            fCalifaGeo = geo;
+            BuildCrystalTables();
+        }
+        bool HasNeighbourTable() const { return fNeighbourWords != 0; }
+    };
+
+    // Half of the crystals in the first 30 rings are left out, like in the half barrel of 2021
+    bool IsInGeometry(Int_t id) { return (id - 1) / 64 >= 30 || (id - 1) % 64 < 32; }
+
+    // A position table of 38 rings of 64 crystals, read by R3BCalifaGeometry from $VMCWORKDIR/geometry
+    class testR3BCalifaNeighbourTable : public ::testing::Test
+    {
+      protected:
+        static void SetUpTestCase()
+        {
+            const std::string dir = ::testing::TempDir() + "califa_neighbours_" + std::to_string(gSystem->GetPid());
+            gSystem->mkdir((dir + "/geometry").c_str(), kTRUE);
+            std::ofstream out(dir + "/geometry/califa_2021_s455.positions.dat");
+            out << "# R3BCalifaGeometry version " << kVersion << " crystals " << kNumIds << "\n";
+            out.precision(17);
+            for (Int_t id = 1; id <= kPhysical; id++)
+            {
+                if (!IsInGeometry(id))
+                    continue;
+                TVector3 pos;
+                const Int_t ring = (id - 1) / 64;
+                pos.SetMagThetaPhi(30. + 0.4 * ring,
+                                   0.3 + 0.06 * ring,
+                                   -TMath::Pi() + ((id - 1) % 64 + 0.5) * TMath::TwoPi() / 64);
+                out << id << " " << pos.X() << " " << pos.Y() << " " << pos.Z() << "\n";
+            }
+            out.close();
+            gSystem->Setenv("VMCWORKDIR", dir.c_str());
+            fGeo = new R3BCalifaGeometry(kVersion);
+        }
+
+        static void TearDownTestCase()
+        {
+            delete fGeo;
+            fGeo = nullptr;
+        }
+
+        testR3BCalifaNeighbourTable()
+        {
+            // Every 5th crystal id, in both ranges of the double reading crystals
+            for (Int_t id = 1; id <= kNumIds; id += 5)
+            {
+                if (fGeo->HasPosition(id))
+                    fHits.emplace_back(new R3BCalifaCrystalCalData(id, 1000. + id, 0., 0., 0));
+            }
+            fTables.Build(fGeo);
+        }
+
+        // The neighbour table gives the same result as the cluster condition on the positions from the geometry
+        void ExpectMatchesPositions()
+        {
+            ASSERT_TRUE(fTables.HasNeighbourTable());
+            for (auto& ref : fHits)
+            {
+                const TVector3& vref = fGeo->GetAngles(ref->GetCrystalId());
+                for (auto& hit : fHits)
+                {
+                    const TVector3& vhit = fGeo->GetAngles(hit->GetCrystalId());
+                    ASSERT_EQ(fTables.Match(ref.get(), hit.get()), fTables.MatchPositions(vref, vhit))
+                        << "crystals " << ref->GetCrystalId() << " and " << hit->GetCrystalId();
+                }
+            }
+        }
+
+        static R3BCalifaGeometry* fGeo;
+        std::vector<std::unique_ptr<R3BCalifaCrystalCalData>> fHits;
+        Cal2HitTables fTables;
+    };
+
+    R3BCalifaGeometry* testR3BCalifaNeighbourTable::fGeo = nullptr;
+
+    TEST_F(testR3BCalifaNeighbourTable, PositionTable)
+    {
+        for (Int_t id = 1; id <= kPhysical; id++)
+        {
+            EXPECT_EQ(fGeo->HasPosition(id), IsInGeometry(id));
+            if (IsInGeometry(id))
+            {
+                EXPECT_GE(fTables.GetCrystalIndex(id), 0);
+                EXPECT_EQ(fTables.GetCrystalIndex(id + kNumIds / 2), fTables.GetCrystalIndex(id));
+            }
+            else
+            {
+                EXPECT_EQ(fTables.GetCrystalIndex(id), -1);
+                EXPECT_EQ(fTables.GetCrystalIndex(id + kNumIds / 2), -1);
+            }
+        }
+    }
+
+    TEST_F(testR3BCalifaNeighbourTable, SquareWindow)
+    {
+        ExpectMatchesPositions();
+        fTables.SetSquareWindowAlg(0.15, 0.3);
+        ExpectMatchesPositions();
+    }
+
+    TEST_F(testR3BCalifaNeighbourTable, RoundWindow)
+    {
+        fTables.SetRoundWindowAlg(0.2);
+        ExpectMatchesPositions();
+    }
+
+    TEST_F(testR3BCalifaNeighbourTable, Cone)
+    {
+        fTables.SetConeAlg(0.2);
+        ExpectMatchesPositions();
+    }
+
+    TEST_F(testR3BCalifaNeighbourTable, Petal)
+    {
+        fTables.SetPetalAlg();
+        ExpectMatchesPositions();
+    }
+
+    TEST_F(testR3BCalifaNeighbourTable, EnergyScaledWindowHasNoTable)
+    {
+        fTables.SetConeAlg(0.2);
+        ASSERT_TRUE(fTables.HasNeighbourTable());
+
+        // Switching after Init drops the table, the window depends on the energy of each cluster
+        const Double_t angle = 0.2;
+        const Double_t factor = 1e-4;
+        fTables.SetRoundEnergyScaledAlg(angle, factor);
+        EXPECT_FALSE(fTables.HasNeighbourTable());
+        for (auto& ref : fHits)
+        {
+            const TVector3& vref = fGeo->GetAngles(ref->GetCrystalId());
+            for (Int_t i = 0; i < (Int_t)fHits.size(); i += 7)
+            {
+                auto& hit = fHits[i];
+                if (hit == ref)
+                    continue;
+                const TVector3& vhit = fGeo->GetAngles(hit->GetCrystalId());
+                const bool expected =
+                    vref.Angle(vhit) * ((vref.Mag() + vhit.Mag()) / (35. * 2.)) < angle * (ref->GetEnergy() * factor);
+                ASSERT_EQ(fTables.Match(ref.get(), hit.get()), expected);
+            }
+        }
+
+        // And switching back builds it again
+        fTables.SetRoundWindowAlg(angle);
+        ExpectMatchesPositions();
+    }
+} // namespace
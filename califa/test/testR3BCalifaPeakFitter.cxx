@@ -0,0 +1,114 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BCalifaPeakFitter.h"
+#include "gtest/gtest.h"
+
+#include "TArrayF.h"
+#include "TH1F.h"
+#include "TSpectrum.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // 60Co-like spectrum of a crystal with the given gain in keV/channel
+    std::unique_ptr<TH1F> Spectrum(Int_t id, Double_t gain)
+    {
+        auto h = std::unique_ptr<TH1F>(new TH1F(Form("spectrum_%i", id), "", 4096, 0., 4096.));
+        h->SetDirectory(nullptr);
+        for (Int_t bin = 1; bin <= 4096; bin++)
+        {
+            const Double_t x = h->GetBinCenter(bin);
+            Double_t content = 10. * std::exp(-x / 800.);
+            for (const Double_t e : { 1173.2, 1332.5 })
+            {
+                const Double_t d = (x - e / gain) / 3.;
+                content += 1000. * std::exp(-0.5 * d * d);
+            }
+            h->SetBinContent(bin, content);
+        }
+        h->SetEntries(1e5);
+        return h;
+    }
+
+    TArrayF Energies()
+    {
+        // Paired in reverse order with the peaks sorted by channel
+        TArrayF energies(2);
+        energies[0] = 1332.5;
+        energies[1] = 1173.2;
+        return energies;
+    }
+
+    TEST(testR3BCalifaPeakFitter, FindsTheGain)
+    {
+        auto h = Spectrum(0, 2.);
+        TSpectrum spectrum(2);
+        Double_t params[2];
+
+        R3BCalifaPeakFitter fitter(Energies(), 3., 0.1, 2);
+        EXPECT_EQ(fitter.Fit(h.get(), spectrum, params), 2);
+        EXPECT_NEAR(params[0], 0., 2.);
+        EXPECT_NEAR(params[1], 2., 0.01);
+
+        R3BCalifaPeakFitter proportional(Energies(), 3., 0.1, 1);
+        EXPECT_EQ(proportional.Fit(h.get(), spectrum, params), 2);
+        EXPECT_NEAR(params[0], 2., 0.01);
+    }
+
+    TEST(testR3BCalifaPeakFitter, NotEnoughPointsIsNotFitted)
+    {
+        auto h = Spectrum(0, 2.);
+        TSpectrum spectrum(2);
+        Double_t params[5];
+
+        R3BCalifaPeakFitter fitter(Energies(), 3., 0.1, 5);
+        EXPECT_EQ(fitter.Fit(h.get(), spectrum, params), 0);
+    }
+
+    TEST(testR3BCalifaPeakFitter, ThreadsGiveIdenticalResults)
+    {
+        std::vector<std::unique_ptr<TH1F>> owner;
+        std::vector<TH1*> histograms;
+        for (Int_t i = 0; i < 64; i++)
+        {
+            if (i % 7 == 3)
+            {
+                histograms.push_back(nullptr);
+                continue;
+            }
+            owner.push_back(Spectrum(i, 1.5 + 0.01 * i));
+            histograms.push_back(owner.back().get());
+        }
+
+        R3BCalifaPeakFitter fitter(Energies(), 3., 0.1, 3);
+        fitter.SetNumThreads(1);
+        std::vector<Double_t> serial;
+        const auto serialPeaks = fitter.Fit(histograms, serial);
+
+        fitter.SetNumThreads(4);
+        std::vector<Double_t> parallel;
+        const auto parallelPeaks = fitter.Fit(histograms, parallel);
+
+        EXPECT_EQ(serialPeaks, parallelPeaks);
+        EXPECT_EQ(serial, parallel);
+        ASSERT_EQ(serial.size(), 3 * histograms.size());
+        for (size_t i = 0; i < histograms.size(); i++)
+        {
+            EXPECT_EQ(serialPeaks[i], histograms[i] ? 2 : 0);
+        }
+    }
+} // namespace
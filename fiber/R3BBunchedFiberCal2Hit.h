@@ -15,14 +15,12 @@
 #define R3BBUNCHEDFIBERCAL2HIT
 
 #include "FairTask.h"
+#include "R3BFiberHistograms.h"
 
 #include <R3BTCalEngine.h>
 
 #include <list>
 
-class TH1F;
-class TH2F;
-
 class R3BBunchedFiberCalData;
 class R3BBunchedFiberHitPar;
 class R3BBunchedFiberHitModulePar;
@@ -126,6 +124,15 @@ class R3BBunchedFiberCal2Hit : public FairTask
      * Is called by the framework after processing the event loop.
      */
     virtual void FinishTask();
+
+    /**
+     * Switches a group of diagnostic histograms on or off, e.g. "tot",
+     * "time" or "multiplicity". The "calib" group is always on when
+     * calibrating.
+     */
+    inline void SetHistogramGroup(const char* group, Bool_t enabled) { fHistograms.SetGroupEnabled(group, enabled); }
+    /** 2D histograms with more bins are stored sparse, call before Init **/
+    inline void SetHistogramSparseLimit(Long64_t nBins) { fHistograms.SetSparseLimit(nBins); }
   //  inline void SetTrigger(Int_t trigger) { fTrigger = trigger; }
   //  inline void SetTpat(Int_t tpat) { fTpat = tpat; }
     
@@ -222,48 +229,49 @@ class R3BBunchedFiberCal2Hit : public FairTask
     // [0=MAPMT,1=SPMT][Channel].
     std::vector<Channel> fChannelArray[2];
 
+    R3BFiberHistograms fHistograms; //!
     // histograms for gain matching
-    TH2F* fh_ToT_MA_Fib;
-    TH2F* fh_ToT_MA_Fib_ac;   
-    TH2F* fh_ToT_MA_Fib_max;
-    TH2F* fh_ToT_Single_Fib;
-    TH2F* fh_ToT_Single_Fib_ac;
-    TH2F* fh_dt_Fib;
-    TH2F* fh_Fib_ToF;
-    TH2F* fh_dt_Fib_ac;
-    TH2F* fh_Fib_ToF_ac;
-    TH2F* fh_ecorell;
-    TH2F* fh_tcorell;
-    TH2F* fh_hit1;
-    TH2F* fh_hit2;
-    TH2F* fh_hit1_ac;
-    TH2F* fh_hit2_ac;
-    TH2F* fh_tmapmt;
-    TH2F* fh_tsapmt;
-    TH2F* fh_tmapmt_ac;
-    TH2F* fh_tsapmt_ac;
-    TH2F* fh_dttrig_all;
-    TH2F* fh_ToT_MA_Fib_raw;
-    TH2F* fh_ToT_SA_Fib_raw;
-    TH2F* fh_x_vs_y;
-    TH2F* fh_ch_corr;
-    TH2F* fh_ToT_ifib;
-    TH2F* fh_tot_SA_ch;
-    TH2F* fh_iFib_nHit;
-    TH2F* fh_iFib_nHit_ac;
-    TH2F* fh_ToT_s_Fib[4];
-    TH2F* fh_ToT1_ToT2;
-    TH2F* fh_ToT1_ToT3;
-    TH2F* fh_ToT1_ToT4;
-    TH2F* fh_ToT1_ToT2_ac;
-    TH2F* fh_ToT1_ToT3_ac;
-    TH2F* fh_ToT1_ToT4_ac;      
-    TH1F* fh_multi;
-    TH2F* fh_lowMtot;
-    TH2F* fh_Mtot_vs_NEvents;
+    R3BLazyHist* fh_ToT_MA_Fib;
+    R3BLazyHist* fh_ToT_MA_Fib_ac;   
+    R3BLazyHist* fh_ToT_MA_Fib_max;
+    R3BLazyHist* fh_ToT_Single_Fib;
+    R3BLazyHist* fh_ToT_Single_Fib_ac;
+    R3BLazyHist* fh_dt_Fib;
+    R3BLazyHist* fh_Fib_ToF;
+    R3BLazyHist* fh_dt_Fib_ac;
+    R3BLazyHist* fh_Fib_ToF_ac;
+    R3BLazyHist* fh_ecorell;
+    R3BLazyHist* fh_tcorell;
+    R3BLazyHist* fh_hit1;
+    R3BLazyHist* fh_hit2;
+    R3BLazyHist* fh_hit1_ac;
+    R3BLazyHist* fh_hit2_ac;
+    R3BLazyHist* fh_tmapmt;
+    R3BLazyHist* fh_tsapmt;
+    R3BLazyHist* fh_tmapmt_ac;
+    R3BLazyHist* fh_tsapmt_ac;
+    R3BLazyHist* fh_dttrig_all;
+    R3BLazyHist* fh_ToT_MA_Fib_raw;
+    R3BLazyHist* fh_ToT_SA_Fib_raw;
+    R3BLazyHist* fh_x_vs_y;
+    R3BLazyHist* fh_ch_corr;
+    R3BLazyHist* fh_ToT_ifib;
+    R3BLazyHist* fh_tot_SA_ch;
+    R3BLazyHist* fh_iFib_nHit;
+    R3BLazyHist* fh_iFib_nHit_ac;
+    R3BLazyHist* fh_ToT_s_Fib[4];
+    R3BLazyHist* fh_ToT1_ToT2;
+    R3BLazyHist* fh_ToT1_ToT3;
+    R3BLazyHist* fh_ToT1_ToT4;
+    R3BLazyHist* fh_ToT1_ToT2_ac;
+    R3BLazyHist* fh_ToT1_ToT3_ac;
+    R3BLazyHist* fh_ToT1_ToT4_ac;      
+    R3BLazyHist* fh_multi;
+    R3BLazyHist* fh_lowMtot;
+    R3BLazyHist* fh_Mtot_vs_NEvents;
 
   public:
-    ClassDef(R3BBunchedFiberCal2Hit, 3)
+    ClassDef(R3BBunchedFiberCal2Hit, 4)
 };
 
 #endif
@@ -198,6 +198,12 @@ InitStatus R3BBunchedFiberCal2HitEngRun2019::Init()
     }
 */
 
+    // The calibration is done on these
+    if (fIsCalibrator)
+    {
+        fHistograms.SetGroupEnabled("calib", kTRUE);
+    }
+
     TString chistName;
     TString chistTitle;
     
@@ -207,165 +213,138 @@ InitStatus R3BBunchedFiberCal2HitEngRun2019::Init()
     
     chistName = fName + "_hit_mult";
     chistTitle = fName + " hit mult";
-    fh_multi = new TH1F(chistName.Data(), chistTitle.Data(), 200,0,200);
-    fh_multi->GetXaxis()->SetTitle("mutltiplicity");
-    fh_multi->GetYaxis()->SetTitle("Counts");  
+    fh_multi = fHistograms.Book1D("multiplicity", chistName, chistTitle + ";mutltiplicity;Counts", 200, 0, 200);
     
     // ch correl
     chistName = fName + "_ch_correl";
     chistTitle = fName + "ch correl";
-    fh_ch_corr = new TH2F(chistName.Data(), chistTitle.Data(), 10,0,10,NChaMax,0,NChaMax);
-    fh_ch_corr->GetXaxis()->SetTitle("MA channel");
-    fh_ch_corr->GetYaxis()->SetTitle("SA channel");    
+    fh_ch_corr = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";MA channel;SA channel", 10, 0, 10, NChaMax, 0, NChaMax);
     
     chistName = fName + "_ToT_FibNum";
     chistTitle = fName + "ToT FibNum";
-    fh_ToT_ifib = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 500, 0., 100.);
-    fh_ToT_ifib->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_ifib->GetYaxis()->SetTitle("ToT / ns");    
+    fh_ToT_ifib = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 500, 0., 100.);
     
     chistName = fName + "_MA_hit";
     chistTitle = fName + "MA hit";
-    fh_iFib_nHit = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax,100,0,100);
-    fh_iFib_nHit->GetXaxis()->SetTitle("Fiber number");
-    fh_iFib_nHit->GetYaxis()->SetTitle("nHit"); 
+    fh_iFib_nHit = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";Fiber number;nHit", NFibMax, 0, NFibMax, 100, 0, 100);
  
     chistName = fName + "_MA_hit_ac";
     chistTitle = fName + "MA hit ac";
-    fh_iFib_nHit_ac = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax,100,0,100);
-    fh_iFib_nHit_ac->GetXaxis()->SetTitle("Fiber number");
-    fh_iFib_nHit_ac->GetYaxis()->SetTitle("nHit"); 
+    fh_iFib_nHit_ac = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";Fiber number;nHit", NFibMax, 0, NFibMax, 100, 0, 100);
  
     
     // nhit correl
     chistName = fName + "_nhit_MAvsSA";
     chistTitle = fName + "nhit MAvsSA";
-    fh_hit1 = new TH2F(chistName.Data(), chistTitle.Data(), 200,0,200,200,0,200);
-    fh_hit1->GetXaxis()->SetTitle("nhitMA");
-    fh_hit1->GetYaxis()->SetTitle("nhit(SA1+SA2*sA3+SA4)");
+    fh_hit1 = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";nhitMA;nhit(SA1+SA2*sA3+SA4)", 200, 0, 200, 200, 0, 200);
     
     chistName = fName + "_nhit_SAvsSA";
     chistTitle = fName + "nhit SAvsSA";
-    fh_hit2 = new TH2F(chistName.Data(), chistTitle.Data(), 200,0,200,200,0,200);
-    fh_hit2->GetXaxis()->SetTitle("nhit(SA1+SA3)");
-    fh_hit2->GetYaxis()->SetTitle("nhit(SA2+SA4)");
+    fh_hit2 = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";nhit(SA1+SA3);nhit(SA2+SA4)", 200, 0, 200, 200, 0, 200);
     
     chistName = fName + "_nhit_MAvsSA_ac";
     chistTitle = fName + "nhit MAvsSA ac";
-    fh_hit1_ac = new TH2F(chistName.Data(), chistTitle.Data(), 200,0,200,200,0,200);
-    fh_hit1_ac->GetXaxis()->SetTitle("nhitMA");
-    fh_hit1_ac->GetYaxis()->SetTitle("nhit(SA1+SA2*sA3+SA4)");
+    fh_hit1_ac = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";nhitMA;nhit(SA1+SA2*sA3+SA4)", 200, 0, 200, 200, 0, 200);
     
      // ToT MAPMT:
     chistName = fName + "_ToT_MAPMT";
     chistTitle = fName + " ToT MA  of fibers";
-    fh_ToT_MA_Fib = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax,500, 0., 100.);
-    fh_ToT_MA_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_MA_Fib->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_MA_Fib = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 500, 0., 100.);
     
     chistName = fName + "_ToT_MAPMT_raw";
     chistTitle = fName + " ToT MA of fibers raw";
-    fh_ToT_MA_Fib_raw = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 500, 0., 100.);
-    fh_ToT_MA_Fib_raw->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_MA_Fib_raw->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_MA_Fib_raw = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 500, 0., 100.);
     
 
     chistName = fName + "_ToT_MAPMT_ac";
     chistTitle = fName + " ToT MA of fibers ac";
-    fh_ToT_MA_Fib_ac = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 500, 0., 100.);
-    fh_ToT_MA_Fib_ac->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_MA_Fib_ac->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_MA_Fib_ac = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 500, 0., 100.);
  
  // ToT MAPMT max:
     chistName = fName + "_ToT_MAPMT_max";
     chistTitle = fName + " max ToT of fibers";
-    fh_ToT_MA_Fib_max = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 500, 0., 100.);
-    fh_ToT_MA_Fib_max->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_MA_Fib_max->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_MA_Fib_max = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 500, 0., 100.);
  
     chistName = fName + "_ToT_SAPMT_raw";
     chistTitle = fName + " ToT SA of fibers raw";
-    fh_ToT_SA_Fib_raw = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 500, 0., 100.);
-    fh_ToT_SA_Fib_raw->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_SA_Fib_raw->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_SA_Fib_raw = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 500, 0., 100.);
     
     // ToF Tofd -> Fiber:
     chistName = fName + "_tof";
     chistTitle = fName + " ToF";
-    fh_Fib_ToF = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_Fib_ToF->GetYaxis()->SetTitle("ToF / ns");
-    fh_Fib_ToF->GetXaxis()->SetTitle("Fiber ID");
+    fh_Fib_ToF = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber ID;ToF / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
     
     chistName = fName + "_tof_ac";
     chistTitle = fName + " ToF ac";
-    fh_Fib_ToF_ac = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_Fib_ToF_ac->GetYaxis()->SetTitle("ToF / ns");
-    fh_Fib_ToF_ac->GetXaxis()->SetTitle("Fiber ID");
+    fh_Fib_ToF_ac = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;ToF / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
 
     // tmapmt:
     chistName = fName + "_MAPMT_time";
     chistTitle = fName + " MAPMT time";
-    fh_tmapmt = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_tmapmt->GetYaxis()->SetTitle("tMAPMT / ns");
-    fh_tmapmt->GetXaxis()->SetTitle("Fiber ID");
+    fh_tmapmt = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;tMAPMT / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
 
     chistName = fName + "_MAPMT_time_ac";
     chistTitle = fName + " MAPMT time ac";
-    fh_tmapmt_ac = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_tmapmt_ac->GetYaxis()->SetTitle("tMAPMT / ns");
-    fh_tmapmt_ac->GetXaxis()->SetTitle("Fiber ID");
+    fh_tmapmt_ac = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;tMAPMT / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
 
    // tsapmt:
     chistName = fName + "_SAPMT_time";
     chistTitle = fName + " SAPMT time";
-    fh_tsapmt = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_tsapmt->GetYaxis()->SetTitle("tSAPMT / ns");
-    fh_tsapmt->GetXaxis()->SetTitle("Fiber ID");
+    fh_tsapmt = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;tSAPMT / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
     
     chistName = fName + "_SAPMT_time_ac";
     chistTitle = fName + " SAPMT time ac";
-    fh_tsapmt_ac = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_tsapmt_ac->GetYaxis()->SetTitle("tSAPMT / ns");
-    fh_tsapmt_ac->GetXaxis()->SetTitle("Fiber ID");
+    fh_tsapmt_ac = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;tSAPMT / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
 
     // tcorell:
     chistName = fName + "_t_corell";
     chistTitle = fName + " t corell";
-    fh_tcorell = new TH2F(chistName.Data(), chistTitle.Data(), 2000, -1000., 1000. ,2000, -1000., 1000.);
-    fh_tcorell->GetYaxis()->SetTitle("time MA / ns");
-    fh_tcorell->GetXaxis()->SetTitle("time SA / ns ");
+    fh_tcorell = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";time SA / ns ;time MA / ns", 2000, -1000., 1000., 2000, -1000., 1000.);
 
     // ecorell:
     chistName = fName + "_SAtot_vs_MAtot";
     chistTitle = fName + " SAtot vs MAtot";
-    fh_ecorell = new TH2F(chistName.Data(), chistTitle.Data(), 50, 0., 10., 50, 0., 10.);
-    fh_ecorell->GetXaxis()->SetTitle("sqrt(tot) SA /sqrt(ns)");
-    fh_ecorell->GetYaxis()->SetTitle("sqrt(tot) MA /sqrt(ns) ");
+    fh_ecorell = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";sqrt(tot) SA /sqrt(ns);sqrt(tot) MA /sqrt(ns) ", 50, 0., 10., 50, 0., 10.);
 
     // ToT single PMT:
     chistName = fName + "_ToT_SAPMT";
     chistTitle = fName + " ToT of fibers";
-    fh_ToT_Single_Fib = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 2500, 0., 500.);
-    fh_ToT_Single_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_Single_Fib->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_Single_Fib = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 2500, 0., 500.);
     
     chistName = fName + "_ToT_SAPMT_ac";
     chistTitle = fName + " ToT SA of fibers ac";
-    fh_ToT_Single_Fib_ac = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 2500, 0., 500.);
-    fh_ToT_Single_Fib_ac->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_Single_Fib_ac->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_Single_Fib_ac = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 2500, 0., 500.);
 
     chistName = fName + "_ToT_SAPMT_ch";
     chistTitle = fName + " ToT SA of fibers ch";
-    fh_tot_SA_ch = new TH2F(chistName.Data(), chistTitle.Data(), 5,0,5, 2500, 0., 500.);
-    fh_tot_SA_ch->GetXaxis()->SetTitle("SA channel");
-    fh_tot_SA_ch->GetYaxis()->SetTitle("ToT / ns");
+    fh_tot_SA_ch = fHistograms.Book2D("tot", chistName, chistTitle + ";SA channel;ToT / ns", 5, 0, 5, 2500, 0., 500.);
   
     chistName = fName + "_x_vs_y";
     chistTitle = fName + " x_vs y";
-    fh_x_vs_y = new TH2F(chistName.Data(), chistTitle.Data(), 5000, -25., 25., 5000, -25., 25.);
-    fh_x_vs_y->GetXaxis()->SetTitle("x / cm");
-    fh_x_vs_y->GetYaxis()->SetTitle("y / cm");
+    fh_x_vs_y = fHistograms.Book2D(
+        "position", chistName, chistTitle + ";x / cm;y / cm", 5000, -25., 25., 5000, -25., 25.);
     
     // ToT SAPMT:
     for (Int_t i = 0; i < 4; i++)
@@ -374,17 +353,14 @@ InitStatus R3BBunchedFiberCal2HitEngRun2019::Init()
         snprintf(number, sizeof(number), "%d", i);
         chistName = fName + "_ToT_SAPMT" + number;
         chistTitle = fName + " ToT of single PMTs " + number;
-        fh_ToT_s_Fib[i] = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 2500, 0., 500.);
-        fh_ToT_s_Fib[i]->GetXaxis()->SetTitle("Fiber number");
-        fh_ToT_s_Fib[i]->GetYaxis()->SetTitle("ToT / ns");
+        fh_ToT_s_Fib[i] = fHistograms.Book2D(
+            "tot", chistName, chistTitle + ";Fiber number;ToT / ns", NFibMax, 0, NFibMax, 2500, 0., 500.);
     }
 
     // ToT vs ToT SPMT:
     chistName = fName + "_ToT1_ToT1ac";
     chistTitle = fName + " raw ToT1 vs ToT1ac of single PMTs";
-    fh_ToT1_ToT2 = new TH2F(chistName.Data(), chistTitle.Data(), 500, 0., 100., 500, 0., 100.);
-    fh_ToT1_ToT2->GetXaxis()->SetTitle("SPMT 1");
-    fh_ToT1_ToT2->GetYaxis()->SetTitle("SPMT 1 ac");
+    fh_ToT1_ToT2 = fHistograms.Book2D("tot", chistName, chistTitle + ";SPMT 1;SPMT 1 ac", 500, 0., 100., 500, 0., 100.);
     
     
     
@@ -392,38 +368,35 @@ InitStatus R3BBunchedFiberCal2HitEngRun2019::Init()
     // time difference SPMT - MAPMT:
     chistName = fName + "_dt";
     chistTitle = fName + " dt of fibers";
-    fh_dt_Fib = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_dt_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_dt_Fib->GetYaxis()->SetTitle("dt / ns");
+    fh_dt_Fib = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;dt / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
     
     chistName = fName + "_dt_ac";
     chistTitle = fName + " dt of fibers ac";
-    fh_dt_Fib_ac = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_dt_Fib_ac->GetXaxis()->SetTitle("Fiber number");
-    fh_dt_Fib_ac->GetYaxis()->SetTitle("dt / ns");
+    fh_dt_Fib_ac = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber number;dt / ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
     
     
     // trigger time difference SPMT - MAPMT:
     chistName = fName + "_dt_trigg";
     chistTitle = fName + " dt trig all events";
-    fh_dttrig_all = new TH2F(chistName.Data(), chistTitle.Data(), NFibMax,0,NFibMax, 5000, -10000., 10000.);
-    fh_dttrig_all->GetXaxis()->SetTitle("Fiber number");
-    fh_dttrig_all->GetYaxis()->SetTitle("dt trigger/ ns");    
+    fh_dttrig_all = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber number;dt trigger/ ns", NFibMax, 0, NFibMax, 5000, -10000., 10000.);
     
     
     chistName = fName + "_lowMtot";
     chistTitle = fName + " lowMtot";
-    fh_lowMtot = new TH2F(chistName.Data(), chistTitle.Data(), 20,0,20, NChaMax,0,NChaMax);
-    fh_lowMtot->GetXaxis()->SetTitle("Nhit MA");
-    fh_lowMtot->GetYaxis()->SetTitle("MAPMT channel");  
+    fh_lowMtot = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";Nhit MA;MAPMT channel", 20, 0, 20, NChaMax, 0, NChaMax);
     
     chistName = fName + "_Mtot_vs_NEvents";
     chistTitle = fName + " Mtot vs NEvents";
-    fh_Mtot_vs_NEvents = new TH2F(chistName.Data(), chistTitle.Data(), 100000,0,Nmax, 500,0.,100.);
-    fh_Mtot_vs_NEvents->GetXaxis()->SetTitle("Event number");
-    fh_Mtot_vs_NEvents->GetYaxis()->SetTitle("tot MA row / ns");    
+    fh_Mtot_vs_NEvents = fHistograms.Book2D(
+        "multiplicity", chistName, chistTitle + ";Event number;tot MA row / ns", 100000, 0, Nmax, 500, 0., 100.);
     
      
+    fHistograms.Report(fName);
+
     return kSUCCESS;
 }
 
@@ -988,44 +961,8 @@ void R3BBunchedFiberCal2HitEngRun2019::FinishEvent()
 
 void R3BBunchedFiberCal2HitEngRun2019::FinishTask()
 {
-	
-    fh_ToT_MA_Fib->Write();
-    fh_ToT_MA_Fib_ac->Write();
-    fh_ToT_MA_Fib_max->Write();
-    fh_ToT_Single_Fib->Write();
-    fh_ToT_Single_Fib_ac->Write();
-    fh_dt_Fib->Write();
-    fh_Fib_ToF->Write();
-    fh_dt_Fib_ac->Write();
-    fh_Fib_ToF_ac->Write();
-    fh_ecorell->Write();
-    fh_tcorell->Write();
-    fh_hit1->Write();
-    fh_hit2->Write();
-    fh_hit1_ac->Write();
-    fh_tmapmt->Write();
-    fh_tsapmt->Write();
-    fh_tmapmt_ac->Write();
-    fh_tsapmt_ac->Write();
-    fh_dttrig_all->Write();
-    fh_ToT_MA_Fib_raw->Write();
-    fh_ToT_SA_Fib_raw->Write();
-    fh_x_vs_y->Write();
-    fh_ch_corr->Write();
-    fh_ToT_ifib->Write();
-    fh_tot_SA_ch->Write();
-    fh_iFib_nHit->Write();
-    fh_iFib_nHit_ac->Write();
-    fh_multi->Write();
-    fh_lowMtot->Write();
-    fh_Mtot_vs_NEvents->Write();
-    
-        for (Int_t i = 0; i < 4; i++)
-        {
-            fh_ToT_s_Fib[i]->Write();
-        }
-        
-    
+    fHistograms.Write();
+
     if (fIsCalibrator)
     {
 
@@ -1051,7 +988,7 @@ void R3BBunchedFiberCal2HitEngRun2019::FinishTask()
              
              // time offset 
                     R3BBunchedFiberHitModulePar* par1 = fCalPar->GetModuleParAt(i);
-                    TH1D* proj1 = fh_dt_Fib->ProjectionY("", i + 1, i + 1, 0);
+                    TH1D* proj1 = fh_dt_Fib->ProjectionY("", i + 1, i + 1);
                     par1->SetOffset1(0.5 * proj1->GetBinCenter(proj1->GetMaximumBin()));
                     par1->SetOffset2(-0.5 * proj1->GetBinCenter(proj1->GetMaximumBin()));
               
@@ -1060,7 +997,7 @@ void R3BBunchedFiberCal2HitEngRun2019::FinishTask()
 
  				                                
             // gain MA     
-                TH1D* proj = fh_ToT_MA_Fib_raw->ProjectionY("", i + 1, i + 1, 0);
+                TH1D* proj = fh_ToT_MA_Fib_raw->ProjectionY("", i + 1, i + 1);
                 for (UInt_t j = proj->GetNbinsX() - 2; j > 2; j--)
                 {
                     if (j == 2)
@@ -1077,7 +1014,7 @@ void R3BBunchedFiberCal2HitEngRun2019::FinishTask()
                     }
                 }
              // gain SA
-             TH1D* proj3 = fh_ToT_SA_Fib_raw->ProjectionY("", i + 1, i + 1, 0);
+             TH1D* proj3 = fh_ToT_SA_Fib_raw->ProjectionY("", i + 1, i + 1);
                 for (UInt_t j = proj3->GetNbinsX() - 2; j > 2; j--)
                 {
                     if (j == 2)
@@ -1099,7 +1036,7 @@ void R3BBunchedFiberCal2HitEngRun2019::FinishTask()
         /* MH
                 for (UInt_t i = 1; i <= max; i++)
                 {
-                    TH1D* proj = fh_ToT_Single_Fib->ProjectionY("", i + 1, i + 1, 0);
+                    TH1D* proj = fh_ToT_Single_Fib->ProjectionY("", i + 1, i + 1);
                     for (UInt_t j = proj->GetNbinsX() - 2; j > 2; j--)
                     {
                         if (j == 2)
@@ -150,6 +150,12 @@ InitStatus R3BBunchedFiberCal2Hit_s494::Init()
     }
 
     //    }
+    // The calibration is done on these
+    if (fIsCalibrator)
+    {
+        fHistograms.SetGroupEnabled("calib", kTRUE);
+    }
+
     // create histograms
     TString chistName;
     TString chistTitle;
@@ -157,53 +163,48 @@ InitStatus R3BBunchedFiberCal2Hit_s494::Init()
     chistName = fName + "_ToT_MA";
     chistTitle = fName + " ToT of fibers";
     //    fh_ToT_MA_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 2100, 0., 2100., 100, 0., 41.666667);
-    fh_ToT_MA_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 250, 0., 100.);
-    fh_ToT_MA_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_MA_Fib->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_MA_Fib = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;ToT / ns", 512, 0, 512, 250, 0., 100.);
 
     // ToF Tofd -> Fiber:
     chistName = fName + "_time";
     chistTitle = fName + " Time";
-    fh_Fib_ToF = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 44000, -1100., 1100.);
-    fh_Fib_ToF->GetYaxis()->SetTitle("Time/ ns");
-    fh_Fib_ToF->GetXaxis()->SetTitle("Fiber ID");
+    fh_Fib_ToF = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber ID;Time/ ns", 512, 0, 512, 44000, -1100., 1100.);
 
     // Test:
     chistName = fName + "_test";
     chistTitle = fName + " Tsync test";
-    fh_Test = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 50, -1024., 1024.);
-    fh_Test->GetYaxis()->SetTitle("Tsync / ns");
-    fh_Test->GetXaxis()->SetTitle("Fiber ID");
+    fh_Test = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;Tsync / ns", 512, 0, 512, 50, -1024., 1024.);
 
     // ToT single PMT:
     chistName = fName + "_ToT_SA";
     chistTitle = fName + " ToT of fibers";
-    fh_ToT_SA_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 250, 0., 100.);
-    fh_ToT_SA_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_SA_Fib->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_SA_Fib = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;ToT / ns", 512, 0, 512, 250, 0., 100.);
 
     chistName = fName + "_time_SA";
     chistTitle = fName + " time of single PMTs ";
-    fh_time_SA_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 4000, -2000., 2000.);
-    fh_time_SA_Fib->GetXaxis()->SetTitle("single number");
-    fh_time_SA_Fib->GetYaxis()->SetTitle("time / ns");
+    fh_time_SA_Fib = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";single number;time / ns", 512, 0, 512, 4000, -2000., 2000.);
 
     // time difference SPMT - MAPMT:
     chistName = fName + "_dt";
     chistTitle = fName + " dt of fibers";
-    fh_dt_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 1000, -5000., 5000.);
-    fh_dt_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_dt_Fib->GetYaxis()->SetTitle("dt / ns");
+    fh_dt_Fib = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;dt / ns", 512, 0, 512, 1000, -5000., 5000.);
 
     // time of MAPMT:
     chistName = fName + "_time_MA";
     chistTitle = fName + " time of fibers";
-    fh_time_MA_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 4000, -2000., 2000.);
-    fh_time_MA_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_time_MA_Fib->GetYaxis()->SetTitle("time / ns");
+    fh_time_MA_Fib = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber number;time / ns", 512, 0, 512, 4000, -2000., 2000.);
 
     cout << "R3BBunchedFiberCal2Hit: Spectra created!" << endl;
 
+    fHistograms.Report(fName);
+
     return kSUCCESS;
 }
 
@@ -615,13 +616,7 @@ void R3BBunchedFiberCal2Hit_s494::FinishEvent()
 
 void R3BBunchedFiberCal2Hit_s494::FinishTask()
 {
-    fh_ToT_MA_Fib->Write();
-    fh_ToT_SA_Fib->Write();
-    fh_dt_Fib->Write();
-    fh_time_SA_Fib->Write();
-    fh_Fib_ToF->Write();
-    fh_Test->Write();
-    fh_time_MA_Fib->Write();
+    fHistograms.Write();
 
     /*
 
@@ -649,7 +644,7 @@ void R3BBunchedFiberCal2Hit_s494::FinishTask()
             //   R3BBunchedFiberHitModulePar* par = fCalPar->GetModuleParAt(i);
 
             // gain MA
-            TH1D* proj = fh_ToT_MA_Fib->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj = fh_ToT_MA_Fib->ProjectionY("", i + 1, i + 1);
             for (UInt_t j = proj->GetNbinsX() - 2; j > 2; j--)
             {
                 if (j == 2)
@@ -667,7 +662,7 @@ void R3BBunchedFiberCal2Hit_s494::FinishTask()
                 }
             }
             // gain SA
-            TH1D* proj1 = fh_ToT_SA_Fib->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj1 = fh_ToT_SA_Fib->ProjectionY("", i + 1, i + 1);
             for (UInt_t j = proj1->GetNbinsX() - 2; j > 2; j--)
             {
                 if (j == 2)
@@ -686,13 +681,13 @@ void R3BBunchedFiberCal2Hit_s494::FinishTask()
             }
             // time offset
             R3BBunchedFiberHitModulePar* par2 = fCalPar->GetModuleParAt(i);
-            TH1D* proj2 = fh_dt_Fib->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj2 = fh_dt_Fib->ProjectionY("", i + 1, i + 1);
             par2->SetOffset1(0.5 * proj2->GetBinCenter(proj2->GetMaximumBin()));
             par2->SetOffset2(-0.5 * proj2->GetBinCenter(proj2->GetMaximumBin()));
 
             // tsync
             R3BBunchedFiberHitModulePar* par3 = fCalPar->GetModuleParAt(i);
-            TH1D* proj3 = fh_Fib_ToF->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj3 = fh_Fib_ToF->ProjectionY("", i + 1, i + 1);
             par3->SetSync(proj3->GetBinCenter(proj3->GetMaximumBin()));
 
             if (i < 512)
@@ -15,14 +15,12 @@
 #define R3BBUNCHEDFIBERCAL2HIT_S494
 
 #include "FairTask.h"
+#include "R3BFiberHistograms.h"
 
 #include <R3BTCalEngine.h>
 
 #include <list>
 
-class TH1F;
-class TH2F;
-
 class R3BBunchedFiberCalData;
 class R3BBunchedFiberHitPar;
 class R3BBunchedFiberHitModulePar;
@@ -127,6 +125,15 @@ class R3BBunchedFiberCal2Hit_s494 : public FairTask
      */
     virtual void FinishTask();
 
+    /**
+     * Switches a group of diagnostic histograms on or off, e.g. "tot",
+     * "time" or "multiplicity". The "calib" group is always on when
+     * calibrating.
+     */
+    inline void SetHistogramGroup(const char* group, Bool_t enabled) { fHistograms.SetGroupEnabled(group, enabled); }
+    /** 2D histograms with more bins are stored sparse, call before Init **/
+    inline void SetHistogramSparseLimit(Long64_t nBins) { fHistograms.SetSparseLimit(nBins); }
+
     R3BBunchedFiberHitModulePar* GetModuleParAt(Int_t fiber);
 
     /**
@@ -180,19 +187,20 @@ class R3BBunchedFiberCal2Hit_s494 : public FairTask
     // [0=MAPMT,1=SPMT][Channel].
     std::vector<Channel> fChannelArray[2];
 
+    R3BFiberHistograms fHistograms; //!
     // histograms for gain matching
-    TH2F* fh_ToT_MA_Fib;
-    TH2F* fh_ToT_SA_Fib;
-    TH2F* fh_time_SA_Fib;
-    TH2F* fh_dt_Fib;
-    TH2F* fh_Fib_ToF;
-    TH2F* fh_Test;
-    TH1F* fh_multi;
-    TH2F* fh_time_MA_Fib;
+    R3BLazyHist* fh_ToT_MA_Fib;
+    R3BLazyHist* fh_ToT_SA_Fib;
+    R3BLazyHist* fh_time_SA_Fib;
+    R3BLazyHist* fh_dt_Fib;
+    R3BLazyHist* fh_Fib_ToF;
+    R3BLazyHist* fh_Test;
+    R3BLazyHist* fh_multi;
+    R3BLazyHist* fh_time_MA_Fib;
     
 
   public:
-    ClassDef(R3BBunchedFiberCal2Hit_s494, 3)
+    ClassDef(R3BBunchedFiberCal2Hit_s494, 4)
 };
 
 #endif
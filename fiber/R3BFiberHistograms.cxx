@@ -0,0 +1,262 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BFiberHistograms.h"
+
+#include "FairLogger.h"
+
+#include "TDirectory.h"
+#include "TH1F.h"
+#include "TH2F.h"
+#include "THnSparse.h"
+#include "TObjArray.h"
+
+namespace
+{
+    // TH2F with more bins go sparse, 20 MB
+    const Long64_t kDefaultSparseLimit = 5000000;
+
+    Double_t ToMB(Long64_t bytes) { return bytes / (1024. * 1024.); }
+} // namespace
+
+std::set<const R3BFiberHistograms*> R3BFiberHistograms::fgRegistries;
+
+R3BLazyHist::R3BLazyHist(const TString& name,
+                         const TString& title,
+                         const Bool_t* enabled,
+                         Bool_t sparse,
+                         Int_t nx,
+                         Double_t xmin,
+                         Double_t xmax,
+                         Int_t ny,
+                         Double_t ymin,
+                         Double_t ymax)
+    : fName(name)
+    , fTitle(title)
+    , fEnabled(enabled)
+    , fSparse(sparse && ny > 0)
+    , fNx(nx)
+    , fXmin(xmin)
+    , fXmax(xmax)
+    , fNy(ny)
+    , fYmin(ymin)
+    , fYmax(ymax)
+{
+}
+
+R3BLazyHist::~R3BLazyHist() {}
+
+void R3BLazyHist::Allocate()
+{
+    // Owned here, not by the current file
+    TDirectory::TContext context(nullptr);
+    if (fSparse)
+    {
+        const Int_t bins[2] = { fNx, fNy };
+        const Double_t xmin[2] = { fXmin, fYmin };
+        const Double_t xmax[2] = { fXmax, fYmax };
+        fSparseHist.reset(new THnSparseF(fName, fTitle, 2, bins, xmin, xmax));
+        // THnSparse takes the axis titles from the axes only
+        TObjArray* titles = fTitle.Tokenize(";");
+        for (Int_t i = 1; i < titles->GetEntriesFast() && i < 3; i++)
+        {
+            fSparseHist->GetAxis(i - 1)->SetTitle(titles->At(i)->GetName());
+        }
+        delete titles;
+    }
+    else if (fNy > 0)
+    {
+        fHist.reset(new TH2F(fName, fTitle, fNx, fXmin, fXmax, fNy, fYmin, fYmax));
+    }
+    else
+    {
+        fHist.reset(new TH1F(fName, fTitle, fNx, fXmin, fXmax));
+    }
+}
+
+void R3BLazyHist::Write()
+{
+    if (fSparseHist)
+    {
+        fSparseHist->Write();
+    }
+    else if (fHist)
+    {
+        fHist->Write();
+    }
+}
+
+TH1D* R3BLazyHist::ProjectionY(const char* name, Int_t firstxbin, Int_t lastxbin)
+{
+    if (!IsAllocated())
+    {
+        Allocate();
+    }
+    if (!fSparse)
+    {
+        return static_cast<TH2*>(fHist.get())->ProjectionY(name, firstxbin, lastxbin);
+    }
+
+    TDirectory::TContext context(nullptr);
+    fSparseHist->GetAxis(0)->SetRange(firstxbin, lastxbin);
+    fProjection.reset(fSparseHist->Projection(1));
+    fSparseHist->GetAxis(0)->SetRange();
+    fProjection->SetName(*name ? TString(name) : fName + "_py");
+    return fProjection.get();
+}
+
+Long64_t R3BLazyHist::GetDenseBytes() const
+{
+    const Long64_t nCells = (fNx + 2) * (Long64_t)(fNy > 0 ? fNy + 2 : 1);
+    return nCells * sizeof(Float_t);
+}
+
+Long64_t R3BLazyHist::GetBytes() const
+{
+    Long64_t bytes = fHist ? GetDenseBytes() : 0;
+    if (fSparseHist)
+    {
+        bytes += fSparseHist->GetSparseFractionMem() * GetDenseBytes();
+    }
+    return bytes;
+}
+
+R3BFiberHistograms::R3BFiberHistograms()
+    : fSparseLimit(kDefaultSparseLimit)
+{
+    fgRegistries.insert(this);
+}
+
+R3BFiberHistograms::~R3BFiberHistograms() { fgRegistries.erase(this); }
+
+R3BLazyHist* R3BFiberHistograms::Book1D(const char* group,
+                                        const TString& name,
+                                        const TString& title,
+                                        Int_t nx,
+                                        Double_t xmin,
+                                        Double_t xmax)
+{
+    // The flag keeps its address in the map, a setting made before booking stays
+    const Bool_t* enabled = &fGroups.emplace(group, kTRUE).first->second;
+    fHists.emplace_back(group,
+                        std::unique_ptr<R3BLazyHist>(new R3BLazyHist(name, title, enabled, kFALSE, nx, xmin, xmax)));
+    return fHists.back().second.get();
+}
+
+R3BLazyHist* R3BFiberHistograms::Book2D(const char* group,
+                                        const TString& name,
+                                        const TString& title,
+                                        Int_t nx,
+                                        Double_t xmin,
+                                        Double_t xmax,
+                                        Int_t ny,
+                                        Double_t ymin,
+                                        Double_t ymax)
+{
+    const Bool_t* enabled = &fGroups.emplace(group, kTRUE).first->second;
+    const Bool_t sparse = (Long64_t)nx * ny > fSparseLimit;
+    fHists.emplace_back(
+        group,
+        std::unique_ptr<R3BLazyHist>(new R3BLazyHist(name, title, enabled, sparse, nx, xmin, xmax, ny, ymin, ymax)));
+    return fHists.back().second.get();
+}
+
+void R3BFiberHistograms::SetGroupEnabled(const char* group, Bool_t enabled) { fGroups[group] = enabled; }
+
+Bool_t R3BFiberHistograms::IsGroupEnabled(const char* group) const
+{
+    auto it = fGroups.find(group);
+    return it == fGroups.end() || it->second;
+}
+
+Long64_t R3BFiberHistograms::GetBookedBytes() const
+{
+    Long64_t bytes = 0;
+    for (auto& h : fHists)
+    {
+        if (IsGroupEnabled(h.first.c_str()))
+        {
+            bytes += h.second->GetDenseBytes();
+        }
+    }
+    return bytes;
+}
+
+Long64_t R3BFiberHistograms::GetDenseBytes() const
+{
+    Long64_t bytes = 0;
+    for (auto& h : fHists)
+    {
+        if (IsGroupEnabled(h.first.c_str()) && !h.second->IsSparse())
+        {
+            bytes += h.second->GetDenseBytes();
+        }
+    }
+    return bytes;
+}
+
+Long64_t R3BFiberHistograms::GetAllocatedBytes() const
+{
+    Long64_t bytes = 0;
+    for (auto& h : fHists)
+    {
+        bytes += h.second->GetBytes();
+    }
+    return bytes;
+}
+
+Long64_t R3BFiberHistograms::GetTotalDenseBytes()
+{
+    Long64_t bytes = 0;
+    for (auto registry : fgRegistries)
+    {
+        bytes += registry->GetDenseBytes();
+    }
+    return bytes;
+}
+
+void R3BFiberHistograms::Report(const TString& owner) const
+{
+    Int_t nEnabled = 0, nSparse = 0;
+    for (auto& h : fHists)
+    {
+        if (IsGroupEnabled(h.first.c_str()))
+        {
+            nEnabled++;
+            nSparse += h.second->IsSparse();
+        }
+    }
+    TString disabled;
+    for (auto& g : fGroups)
+    {
+        if (!g.second)
+        {
+            disabled += disabled.IsNull() ? "" : ", ";
+            disabled += g.first.c_str();
+        }
+    }
+
+    LOG(INFO) << owner << ": " << nEnabled << " of " << fHists.size() << " histograms enabled"
+              << (disabled.IsNull() ? TString("") : " (off: " + disabled + ")") << ", " << nSparse << " of them sparse";
+    LOG(INFO) << owner << ": histograms take up to " << ToMB(GetDenseBytes()) << " MB dense (" << ToMB(GetBookedBytes())
+              << " MB without sparse storage), allocated at first fill. All fiber tasks: up to " << ToMB(GetTotalDenseBytes())
+              << " MB dense";
+}
+
+void R3BFiberHistograms::Write()
+{
+    for (auto& h : fHists)
+    {
+        h.second->Write();
+    }
+}
@@ -0,0 +1,174 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BFIBERHISTOGRAMS_H
+#define R3BFIBERHISTOGRAMS_H
+
+#include "Rtypes.h"
+#include "TH1.h"
+#include "THnSparse.h"
+#include "TString.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * Diagnostic histogram of the fiber Cal2Hit tasks. It is booked in Init but
+ * only allocated at the first Fill(), and not at all while its group is
+ * disabled. 2D histograms with more bins than the sparse limit of the
+ * registry are filled into a THnSparseF instead of a TH2F.
+ */
+class R3BLazyHist
+{
+  public:
+    R3BLazyHist(const TString& name,
+                const TString& title,
+                const Bool_t* enabled,
+                Bool_t sparse,
+                Int_t nx,
+                Double_t xmin,
+                Double_t xmax,
+                Int_t ny = 0,
+                Double_t ymin = 0.,
+                Double_t ymax = 0.);
+    ~R3BLazyHist();
+
+    R3BLazyHist(const R3BLazyHist&) = delete;
+    R3BLazyHist& operator=(const R3BLazyHist&) = delete;
+
+    inline void Fill(Double_t x);
+    inline void Fill(Double_t x, Double_t y);
+
+    /** Writes the histogram to the current directory if it was ever filled **/
+    void Write();
+
+    /** Like TH2::ProjectionY, also for sparse storage. The projection is
+        owned here and overwritten by the next call. **/
+    TH1D* ProjectionY(const char* name, Int_t firstxbin, Int_t lastxbin);
+
+    const TString& GetName() const { return fName; }
+    Int_t GetNbinsX() const { return fNx; }
+    Bool_t IsAllocated() const { return fHist || fSparseHist; }
+    Bool_t IsSparse() const { return fSparse; }
+
+    /** Memory of a dense histogram with this binning **/
+    Long64_t GetDenseBytes() const;
+    /** Memory in use now **/
+    Long64_t GetBytes() const;
+
+  private:
+    void Allocate();
+
+    TString fName;
+    TString fTitle;
+    const Bool_t* fEnabled; // flag of the group, owned by the registry
+    Bool_t fSparse;
+    Int_t fNx;
+    Double_t fXmin, fXmax;
+    Int_t fNy; // 0 for 1D
+    Double_t fYmin, fYmax;
+
+    std::unique_ptr<TH1> fHist;
+    std::unique_ptr<THnSparse> fSparseHist;
+    std::unique_ptr<TH1D> fProjection; // of the sparse one
+};
+
+/**
+ * The histograms of one fiber task, sorted into groups that can be switched
+ * off before or during the run, e.g. "time" or "multiplicity".
+ */
+class R3BFiberHistograms
+{
+  public:
+    R3BFiberHistograms();
+    ~R3BFiberHistograms();
+
+    R3BFiberHistograms(const R3BFiberHistograms&) = delete;
+    R3BFiberHistograms& operator=(const R3BFiberHistograms&) = delete;
+
+    R3BLazyHist* Book1D(const char* group,
+                        const TString& name,
+                        const TString& title,
+                        Int_t nx,
+                        Double_t xmin,
+                        Double_t xmax);
+    R3BLazyHist* Book2D(const char* group,
+                        const TString& name,
+                        const TString& title,
+                        Int_t nx,
+                        Double_t xmin,
+                        Double_t xmax,
+                        Int_t ny,
+                        Double_t ymin,
+                        Double_t ymax);
+
+    /** Histograms of a disabled group are neither allocated nor filled **/
+    void SetGroupEnabled(const char* group, Bool_t enabled);
+    Bool_t IsGroupEnabled(const char* group) const;
+
+    /** 2D histograms booked with more bins than this are stored sparse **/
+    void SetSparseLimit(Long64_t nBins) { fSparseLimit = nBins; }
+
+    /** Memory of all enabled histograms if all were filled, sparse ones counted dense **/
+    Long64_t GetBookedBytes() const;
+    /** Same, but without the sparse ones, an upper limit of the dense memory **/
+    Long64_t GetDenseBytes() const;
+    /** Memory in use now **/
+    Long64_t GetAllocatedBytes() const;
+    /** GetDenseBytes() of all registries that exist now **/
+    static Long64_t GetTotalDenseBytes();
+
+    /** Logs the memory of this registry and of all registries together **/
+    void Report(const TString& owner) const;
+
+    /** Writes all filled histograms to the current directory **/
+    void Write();
+
+  private:
+    std::map<std::string, Bool_t> fGroups;
+    std::vector<std::pair<std::string, std::unique_ptr<R3BLazyHist>>> fHists;
+    Long64_t fSparseLimit;
+
+    static std::set<const R3BFiberHistograms*> fgRegistries; // all that exist, for the report
+};
+
+inline void R3BLazyHist::Fill(Double_t x)
+{
+    if (!*fEnabled)
+        return;
+    if (!fHist)
+        Allocate();
+    fHist->Fill(x);
+}
+
+inline void R3BLazyHist::Fill(Double_t x, Double_t y)
+{
+    if (!*fEnabled)
+        return;
+    if (!IsAllocated())
+        Allocate();
+    if (fSparse)
+    {
+        const Double_t xy[2] = { x, y };
+        fSparseHist->Fill(xy);
+    }
+    else
+    {
+        fHist->Fill(x, y);
+    }
+}
+
+#endif
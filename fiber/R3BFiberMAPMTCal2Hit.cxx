@@ -178,83 +178,80 @@ InitStatus R3BFiberMAPMTCal2Hit::Init()
     }
 
     // create histograms
+    // The calibration is done on these
+    if (fIsCalibrator)
+    {
+        fHistograms.SetGroupEnabled("calib", kTRUE);
+    }
+
     TString chistName;
     TString chistTitle;
     // ToT bottom PMT raw:
     chistName = fName + "_ToT_bottom_raw";
     chistTitle = fName + " ToTbottom raw of fibers";
-    fh_ToT_bottom_Fib_raw = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 1000, 0., 100.);
-    fh_ToT_bottom_Fib_raw->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_bottom_Fib_raw->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_bottom_Fib_raw = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;ToT / ns", 512, 0, 512, 1000, 0., 100.);
 
     // ToT bottom gainmatched:
     chistName = fName + "_ToT_bottom";
     chistTitle = fName + " ToTbottom of fibers";
-    fh_ToT_bottom_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 400, 0., 100.);
-    fh_ToT_bottom_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_bottom_Fib->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_bottom_Fib = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", 512, 0, 512, 400, 0., 100.);
 
     // ToF Tofd -> Fiber:
     chistName = fName + "_time";
     chistTitle = fName + " Time";
-    fh_Fib_ToF = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 2200, -1100., 1100.);
-    fh_Fib_ToF->GetYaxis()->SetTitle("Time/ ns");
-    fh_Fib_ToF->GetXaxis()->SetTitle("Fiber ID");
+    fh_Fib_ToF = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;Time/ ns", 512, 0, 512, 2200, -1100., 1100.);
 
     // ToF Fiber for sync:
     chistName = fName + "_time_raw";
     chistTitle = fName + " Time raw";
-    fh_Fib_ToF_raw = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 2200, -1100., 1100.);
-    fh_Fib_ToF_raw->GetYaxis()->SetTitle("Time/ ns");
-    fh_Fib_ToF_raw->GetXaxis()->SetTitle("Fiber ID");
+    fh_Fib_ToF_raw = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber ID;Time/ ns", 512, 0, 512, 2200, -1100., 1100.);
 
     // Test:
     chistName = fName + "_test";
     chistTitle = fName + " time test";
-    fh_Test = new TH2F(chistName.Data(), chistTitle.Data(), 10000, 0, 1e6, 4000, -2000., -2000.);
-    fh_Test->GetYaxis()->SetTitle("Tsync / ns");
-    fh_Test->GetXaxis()->SetTitle("Fiber ID");
+    fh_Test = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber ID;Tsync / ns", 10000, 0, 1e6, 4000, -2000., -2000.);
 
     // ToT top MAPMT raw:
     chistName = fName + "_ToT_top_raw";
     chistTitle = fName + " ToTtop raw of fibers";
-    fh_ToT_top_Fib_raw = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 1000, 0., 100.);
-    fh_ToT_top_Fib_raw->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_top_Fib_raw->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_top_Fib_raw = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;ToT / ns", 512, 0, 512, 1000, 0., 100.);
 
     // ToT top MAPMT gainmatched:
     chistName = fName + "_ToT_top";
     chistTitle = fName + " ToTtop of fibers";
-    fh_ToT_top_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 400, 0., 100.);
-    fh_ToT_top_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_ToT_top_Fib->GetYaxis()->SetTitle("ToT / ns");
+    fh_ToT_top_Fib = fHistograms.Book2D(
+        "tot", chistName, chistTitle + ";Fiber number;ToT / ns", 512, 0, 512, 400, 0., 100.);
 
     chistName = fName + "_time_top";
     chistTitle = fName + " time of top MAPMTs ";
-    fh_time_top_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 4000, -2000., 2000.);
-    fh_time_top_Fib->GetXaxis()->SetTitle("single number");
-    fh_time_top_Fib->GetYaxis()->SetTitle("time / ns");
+    fh_time_top_Fib = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";single number;time / ns", 512, 0, 512, 4000, -2000., 2000.);
 
     // time difference top-bottom:
     chistName = fName + "_dt";
     chistTitle = fName + " dt of fibers";
-    fh_dt_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 4000, -2000., 2000.);
-    fh_dt_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_dt_Fib->GetYaxis()->SetTitle("dt / ns");
+    fh_dt_Fib = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber number;dt / ns", 512, 0, 512, 4000, -2000., 2000.);
 
     // time difference top-bottom for offsets:
     chistName = fName + "_dt_raw";
     chistTitle = fName + " dt_raw of fibers";
-    fh_dt_Fib_raw = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 4000, -2000., 2000.);
-    fh_dt_Fib_raw->GetXaxis()->SetTitle("Fiber number");
-    fh_dt_Fib_raw->GetYaxis()->SetTitle("dt / ns");
+    fh_dt_Fib_raw = fHistograms.Book2D(
+        "calib", chistName, chistTitle + ";Fiber number;dt / ns", 512, 0, 512, 4000, -2000., 2000.);
 
     // time of MAPMT:
     chistName = fName + "_time_bottom";
     chistTitle = fName + " time of bottom MAPMTs";
-    fh_time_bottom_Fib = new TH2F(chistName.Data(), chistTitle.Data(), 512, 0, 512, 4000, -2000., 2000.);
-    fh_time_bottom_Fib->GetXaxis()->SetTitle("Fiber number");
-    fh_time_bottom_Fib->GetYaxis()->SetTitle("time / ns");
+    fh_time_bottom_Fib = fHistograms.Book2D(
+        "time", chistName, chistTitle + ";Fiber number;time / ns", 512, 0, 512, 4000, -2000., 2000.);
+
+    fHistograms.Report(fName);
 
     return kSUCCESS;
 }
@@ -546,17 +543,7 @@ void R3BFiberMAPMTCal2Hit::FinishTask()
 {
     if (fWrite)
     {
-        fh_ToT_bottom_Fib->Write();
-        fh_ToT_top_Fib->Write();
-        fh_ToT_bottom_Fib_raw->Write();
-        fh_ToT_top_Fib_raw->Write();
-        fh_dt_Fib->Write();
-        fh_time_top_Fib->Write();
-        fh_Fib_ToF->Write();
-        fh_Test->Write();
-        fh_time_bottom_Fib->Write();
-        fh_dt_Fib_raw->Write();
-        fh_Fib_ToF_raw->Write();
+        fHistograms.Write();
     }
 
     if (fIsCalibrator)
@@ -578,7 +565,7 @@ void R3BFiberMAPMTCal2Hit::FinishTask()
         for (UInt_t i = 1; i <= max; i++)
         {
             // gain bottom MAPMTs
-            TH1D* proj = fh_ToT_bottom_Fib_raw->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj = fh_ToT_bottom_Fib_raw->ProjectionY("", i + 1, i + 1);
             for (UInt_t j = proj->GetNbinsX() - 2; j > 2; j--)
             {
                 if (j == 2)
@@ -596,7 +583,7 @@ void R3BFiberMAPMTCal2Hit::FinishTask()
                 }
             }
             // gain top MAPMT
-            TH1D* proj1 = fh_ToT_top_Fib_raw->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj1 = fh_ToT_top_Fib_raw->ProjectionY("", i + 1, i + 1);
             for (UInt_t j = proj1->GetNbinsX() - 2; j > 2; j--)
             {
                 if (j == 2)
@@ -615,13 +602,13 @@ void R3BFiberMAPMTCal2Hit::FinishTask()
             }
             // time offset
             R3BFiberMAPMTHitModulePar* par2 = fCalPar->GetModuleParAt(i);
-            TH1D* proj2 = fh_dt_Fib_raw->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj2 = fh_dt_Fib_raw->ProjectionY("", i + 1, i + 1);
             par2->SetOffsetUp(0.5 * proj2->GetBinCenter(proj2->GetMaximumBin()));
             par2->SetOffsetDown(-0.5 * proj2->GetBinCenter(proj2->GetMaximumBin()));
 
             // tsync
             R3BFiberMAPMTHitModulePar* par3 = fCalPar->GetModuleParAt(i);
-            TH1D* proj3 = fh_Fib_ToF_raw->ProjectionY("", i + 1, i + 1, 0);
+            TH1D* proj3 = fh_Fib_ToF_raw->ProjectionY("", i + 1, i + 1);
             par3->SetSync(proj3->GetBinCenter(proj3->GetMaximumBin()));
 
             cout << fName << " fiberId: " << i << ", offset: " << 0.5 * proj2->GetBinCenter(proj2->GetMaximumBin())
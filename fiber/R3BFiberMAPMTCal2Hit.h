@@ -17,10 +17,9 @@
 #define TOF_MAX  1000
 
 #include "FairTask.h"
+#include "R3BFiberHistograms.h"
 #include <list>
 
-class TH1F;
-class TH2F;
 class R3BFiberMAPMTCalData;
 class R3BFiberMAPMTHitPar;
 class R3BFiberMAPMTHitModulePar;
@@ -79,6 +78,15 @@ class R3BFiberMAPMTCal2Hit : public FairTask
 			ftofmax = tmax;
 		}
 		inline void SetWriteHisto(Bool_t write){fWrite = write;}
+
+		/**
+		 * Switches a group of diagnostic histograms on or off, e.g. "tot",
+		 * "time" or "multiplicity". The "calib" group is always on when
+		 * calibrating.
+		 */
+		inline void SetHistogramGroup(const char* group, Bool_t enabled) { fHistograms.SetGroupEnabled(group, enabled); }
+		/** 2D histograms with more bins are stored sparse, call before Init **/
+		inline void SetHistogramSparseLimit(Long64_t nBins) { fHistograms.SetSparseLimit(nBins); }
  
        R3BFiberMAPMTHitModulePar* GetModuleParAt(Int_t fiber);
     
@@ -112,21 +120,22 @@ class R3BFiberMAPMTCal2Hit : public FairTask
     		// [0=bottom,1=top][Channel].
 		std::vector<Channel> fChannelArray[2];
   
+    R3BFiberHistograms fHistograms; //!
    // histograms for gain matching
-    TH2F* fh_ToT_bottom_Fib_raw;
-    TH2F* fh_ToT_top_Fib_raw;
-    TH2F* fh_ToT_bottom_Fib;
-    TH2F* fh_ToT_top_Fib;
-    TH2F* fh_time_top_Fib;
-    TH2F* fh_dt_Fib;
-    TH2F* fh_Fib_ToF;
-    TH2F* fh_dt_Fib_raw;
-    TH2F* fh_Fib_ToF_raw;
-    TH2F* fh_Test;
-    TH1F* fh_multi;
-    TH2F* fh_time_bottom_Fib;
+    R3BLazyHist* fh_ToT_bottom_Fib_raw;
+    R3BLazyHist* fh_ToT_top_Fib_raw;
+    R3BLazyHist* fh_ToT_bottom_Fib;
+    R3BLazyHist* fh_ToT_top_Fib;
+    R3BLazyHist* fh_time_top_Fib;
+    R3BLazyHist* fh_dt_Fib;
+    R3BLazyHist* fh_Fib_ToF;
+    R3BLazyHist* fh_dt_Fib_raw;
+    R3BLazyHist* fh_Fib_ToF_raw;
+    R3BLazyHist* fh_Test;
+    R3BLazyHist* fh_multi;
+    R3BLazyHist* fh_time_bottom_Fib;
 	public:
-		ClassDef(R3BFiberMAPMTCal2Hit, 3)
+		ClassDef(R3BFiberMAPMTCal2Hit, 4)
 };
 
 #endif
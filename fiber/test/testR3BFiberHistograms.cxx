@@ -0,0 +1,121 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BFiberHistograms.h"
+#include "gtest/gtest.h"
+
+#include "TH1D.h"
+#include "TMemFile.h"
+
+#include <memory>
+
+namespace
+{
+    TEST(testR3BFiberHistograms, allocatesAtFirstFill)
+    {
+        R3BFiberHistograms histograms;
+        auto h1 = histograms.Book1D("time", "h1", "h1", 100, 0., 100.);
+        auto h2 = histograms.Book2D("time", "h2", "h2", 100, 0., 100., 50, 0., 50.);
+
+        EXPECT_FALSE(h1->IsAllocated());
+        EXPECT_FALSE(h2->IsAllocated());
+        EXPECT_EQ(histograms.GetAllocatedBytes(), 0);
+        EXPECT_GT(histograms.GetBookedBytes(), 0);
+
+        h1->Fill(10.);
+        EXPECT_TRUE(h1->IsAllocated());
+        EXPECT_FALSE(h2->IsAllocated());
+        EXPECT_EQ(histograms.GetAllocatedBytes(), h1->GetDenseBytes());
+
+        h2->Fill(10., 20.);
+        EXPECT_TRUE(h2->IsAllocated());
+        EXPECT_EQ(histograms.GetAllocatedBytes(), h1->GetDenseBytes() + h2->GetDenseBytes());
+    }
+
+    TEST(testR3BFiberHistograms, sparseLimit)
+    {
+        R3BFiberHistograms histograms;
+        histograms.SetSparseLimit(1000);
+        auto small = histograms.Book2D("time", "small", "small", 10, 0., 10., 100, 0., 100.);
+        auto large = histograms.Book2D("time", "large", "large", 10, 0., 10., 101, 0., 101.);
+        EXPECT_FALSE(small->IsSparse());
+        EXPECT_TRUE(large->IsSparse());
+        EXPECT_EQ(histograms.GetDenseBytes(), small->GetDenseBytes());
+
+        large->Fill(2.5, 7.5);
+        large->Fill(2.5, 7.5);
+        large->Fill(8.5, 7.5);
+        EXPECT_TRUE(large->IsAllocated());
+        EXPECT_LT(large->GetBytes(), large->GetDenseBytes());
+
+        TH1D* py = large->ProjectionY("py", 3, 3);
+        ASSERT_NE(py, nullptr);
+        EXPECT_EQ(py->GetBinContent(py->FindBin(7.5)), 2.);
+        EXPECT_EQ(py->Integral(), 2.);
+    }
+
+    TEST(testR3BFiberHistograms, disabledGroup)
+    {
+        R3BFiberHistograms histograms;
+        histograms.SetGroupEnabled("multiplicity", kFALSE);
+        auto off = histograms.Book1D("multiplicity", "off", "off", 100, 0., 100.);
+        auto on = histograms.Book2D("time", "on", "on", 10, 0., 10., 10, 0., 10.);
+        EXPECT_FALSE(histograms.IsGroupEnabled("multiplicity"));
+        EXPECT_EQ(histograms.GetBookedBytes(), on->GetDenseBytes());
+
+        off->Fill(1.);
+        EXPECT_FALSE(off->IsAllocated());
+
+        // Switched off during the run, the histogram keeps its content
+        on->Fill(1.5, 1.5);
+        histograms.SetGroupEnabled("time", kFALSE);
+        on->Fill(1.5, 1.5);
+        TH1D* py = on->ProjectionY("on_py", 2, 2);
+        EXPECT_EQ(py->GetBinContent(py->FindBin(1.5)), 1.);
+    }
+
+    TEST(testR3BFiberHistograms, writesFilledOnly)
+    {
+        R3BFiberHistograms histograms;
+        histograms.SetSparseLimit(50);
+        histograms.Book1D("time", "empty", "empty", 10, 0., 10.);
+        histograms.Book2D("time", "emptySparse", "emptySparse", 10, 0., 10., 10, 0., 10.);
+        histograms.Book1D("time", "filled", "filled", 10, 0., 10.)->Fill(1.);
+        histograms.Book2D("time", "filledSparse", "filledSparse", 10, 0., 10., 10, 0., 10.)->Fill(1., 1.);
+
+        TMemFile file("testR3BFiberHistograms.root", "RECREATE");
+        file.cd();
+        histograms.Write();
+        EXPECT_EQ(file.GetListOfKeys()->GetEntries(), 2);
+        EXPECT_NE(file.FindKey("filled"), nullptr);
+        EXPECT_NE(file.FindKey("filledSparse"), nullptr);
+        EXPECT_EQ(file.FindKey("empty"), nullptr);
+        EXPECT_EQ(file.FindKey("emptySparse"), nullptr);
+    }
+
+    TEST(testR3BFiberHistograms, totalOfLiveRegistries)
+    {
+        const Long64_t before = R3BFiberHistograms::GetTotalDenseBytes();
+        R3BFiberHistograms a;
+        a.Book1D("time", "a", "a", 98, 0., 1.);
+        {
+            std::unique_ptr<R3BFiberHistograms> b(new R3BFiberHistograms());
+            b->Book1D("time", "b", "b", 198, 0., 1.);
+            EXPECT_EQ(R3BFiberHistograms::GetTotalDenseBytes(), before + 1200);
+        }
+        // Reporting twice, e.g. after a second Init, does not count twice
+        a.Report("a");
+        a.Report("a");
+        EXPECT_EQ(R3BFiberHistograms::GetTotalDenseBytes(), before + 400);
+    }
+} // namespace
@@ -12,6 +12,7 @@
  ******************************************************************************/
 
 #include "R3BFieldInterp.h"
+#include "R3BTrilinearKernel.h"
 #include <iostream>
 #include <math.h>
 
@@ -147,28 +148,20 @@ double R3BFieldInterp::interp(int ic[3], double dc[3] /*,int &outside*/)
     printf ("[%d %d %d - %d %d %d]",
         ic0[0],ic0[1],ic0[2],ic1[0],ic1[1],ic1[2]);
     */
-    float v000 = get_data_pt(ic0[0], ic0[1], ic0[2]);
-    float v001 = get_data_pt(ic0[0], ic0[1], ic1[2]);
-    float v010 = get_data_pt(ic0[0], ic1[1], ic0[2]);
-    float v011 = get_data_pt(ic0[0], ic1[1], ic1[2]);
-    float v100 = get_data_pt(ic1[0], ic0[1], ic0[2]);
-    float v101 = get_data_pt(ic1[0], ic0[1], ic1[2]);
-    float v110 = get_data_pt(ic1[0], ic1[1], ic0[2]);
-    float v111 = get_data_pt(ic1[0], ic1[1], ic1[2]);
-
     // Either we always operate with the raw data, which makes it rather
     // straight-forward to handle the out-of-bounds cases (by simply
     // giving the same values for the two interpolations to do)
 
-    double vx00 = v000 + dc[0] * (v100 - v000);
-    double vx01 = v001 + dc[0] * (v101 - v001);
-    double vx10 = v010 + dc[0] * (v110 - v010);
-    double vx11 = v011 + dc[0] * (v111 - v011);
-
-    double vxy0 = vx00 + dc[1] * (vx10 - vx00);
-    double vxy1 = vx01 + dc[1] * (vx11 - vx01);
+    R3BTrilinearPoint p;
+    p.fBase = ic0[0] * _m1 + ic0[1] * _m2 + ic0[2];
+    p.fStride[0] = (ic1[0] - ic0[0]) * _m1;
+    p.fStride[1] = (ic1[1] - ic0[1]) * _m2;
+    p.fStride[2] = ic1[2] - ic0[2];
+    for (int i = 0; i < 3; i++)
+        p.fFrac[i] = dc[i];
 
-    double vxyz = vxy0 + dc[2] * (vxy1 - vxy0);
+    double vxyz;
+    R3BTrilinearKernel::InterpolateOne(_data, 1, p, &vxyz);
 
     return vxyz;
 
@@ -31,6 +31,7 @@
 //#include "R3BFieldMapCreator.h"
 #include "R3BFieldMapData.h"
 #include "R3BFieldPar.h"
+#include "R3BTrilinearKernel.h"
 #include "TArrayI.h"
 
 using std::cerr;
@@ -206,7 +207,6 @@ R3BFieldMap::R3BFieldMap(Int_t type, Bool_t verbosity)
 void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
 {
     // Main function to get the field values
-    // not optimized  for the moment
     // <D.Bertini@gsi.de>
 
     Double_t Bfield[3] = { 0.0, 0.0, 0.0 };
@@ -214,9 +214,6 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
     if (typeField == 0 || typeField == 1 || typeField == 3)
     {
 
-        // local
-        TArrayI* linesArray = new TArrayI(8);
-
         // local to global
         TVector3 localPoint(point[0], point[1], point[2]);
 
@@ -234,76 +231,36 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
             localPoint.Y() <= initialY + ((stepsInY - 1) * gridStep) &&
             localPoint.Z() <= initialZ + ((stepsInZ - 1) * gridStep))
         {
-
-            //   cout << "-I-  inside  the magnetic area! " << endl;
-            //   cout << "Transf. Point: " << localPoint.X() << " : " <<
-            //        localPoint.Y() << " : " <<  localPoint.Z()
-            //       << endl;
-
-            Int_t returnValue = GetLinesArrayForPosition(&localPoint, linesArray);
-
-            if (!returnValue)
-            {
-                TVector3 vertexReferenceInGrid;
-                Int_t linpos = linesArray->At(0);
-                if (GetPositionForLine(linpos, &vertexReferenceInGrid))
-                {
-                    cout << "-E-R3BFieldMap Line out of bound " << endl;
-                }
-                else
-                {
-                    Double_t t = (localPoint.X() - vertexReferenceInGrid.X()) / (gridStep);
-                    Double_t u = (localPoint.Y() - vertexReferenceInGrid.Y()) / (gridStep);
-                    Double_t v = (localPoint.Z() - vertexReferenceInGrid.Z()) / (gridStep);
-
-                    Bfield[0] = (1 - t) * (1 - u) * (1 - v) * Bxfield[linesArray->At(0)] +
-                                t * (1 - u) * (1 - v) * Bxfield[linesArray->At(1)] +
-                                t * u * (1 - v) * Bxfield[linesArray->At(2)] + t * u * v * Bxfield[linesArray->At(3)] +
-                                (1 - t) * u * (1 - v) * Bxfield[linesArray->At(4)] +
-                                (1 - t) * u * v * Bxfield[linesArray->At(5)] +
-                                (1 - t) * (1 - u) * v * Bxfield[linesArray->At(6)] +
-                                t * (1 - u) * v * Bxfield[linesArray->At(7)];
-
-                    Bfield[1] = (1 - t) * (1 - u) * (1 - v) * Byfield[linesArray->At(0)] +
-                                t * (1 - u) * (1 - v) * Byfield[linesArray->At(1)] +
-                                t * u * (1 - v) * Byfield[linesArray->At(2)] + t * u * v * Byfield[linesArray->At(3)] +
-                                (1 - t) * u * (1 - v) * Byfield[linesArray->At(4)] +
-                                (1 - t) * u * v * Byfield[linesArray->At(5)] +
-                                (1 - t) * (1 - u) * v * Byfield[linesArray->At(6)] +
-                                t * (1 - u) * v * Byfield[linesArray->At(7)];
-
-                    Bfield[2] = (1 - t) * (1 - u) * (1 - v) * Bzfield[linesArray->At(0)] +
-                                t * (1 - u) * (1 - v) * Bzfield[linesArray->At(1)] +
-                                t * u * (1 - v) * Bzfield[linesArray->At(2)] + t * u * v * Bzfield[linesArray->At(3)] +
-                                (1 - t) * u * (1 - v) * Bzfield[linesArray->At(4)] +
-                                (1 - t) * u * v * Bzfield[linesArray->At(5)] +
-                                (1 - t) * (1 - u) * v * Bzfield[linesArray->At(6)] +
-                                t * (1 - u) * v * Bzfield[linesArray->At(7)];
-                }
-
-            } //! returnValue
-
-            else if (returnValue == 1)
+            Int_t line = GetLineForPosition(&localPoint);
+            TVector3 vertexReferenceInGrid;
+            if (GetPositionForLine(line, &vertexReferenceInGrid))
             {
-                cout << "-I- R3BFieldMap Point "
-                     << " is just in one grid point!" << endl;
-
-                Bfield[0] = Bxfield[linesArray->At(0)];
-                Bfield[1] = Byfield[linesArray->At(0)];
-                Bfield[2] = Bzfield[linesArray->At(0)];
-            } // returnValue ==1
-
+                cout << "-E-R3BFieldMap Line out of bound " << endl;
+            }
             else
             {
-                cout << "-E- R3BFieldMap::GetFieldValue(): Point "
-                     << ", but return value from GetLinesArrayForPosition() not valid!!" << endl;
-
-                Bfield[0] = 0;
-                Bfield[1] = 0;
-                Bfield[2] = 0;
+                R3BTrilinearPoint cell;
+                cell.fBase = line;
+                cell.fStride[0] = stepsInY * stepsInZ;
+                cell.fStride[1] = stepsInZ;
+                cell.fStride[2] = 1;
+                cell.fFrac[0] = (localPoint.X() - vertexReferenceInGrid.X()) / (gridStep);
+                cell.fFrac[1] = (localPoint.Y() - vertexReferenceInGrid.Y()) / (gridStep);
+                cell.fFrac[2] = (localPoint.Z() - vertexReferenceInGrid.Z()) / (gridStep);
+
+                // A point on a grid plane does not need the next plane,
+                // which does not exist on the upper edge of the map
+                for (Int_t i = 0; i < 3; i++)
+                {
+                    if (cell.fFrac[i] == 0.)
+                        cell.fStride[i] = 0;
+                }
 
-            } // whatever other cases
-        }     //! outside of field area
+                R3BTrilinearKernel::InterpolateOne(Bxfield, 1, cell, &Bfield[0]);
+                R3BTrilinearKernel::InterpolateOne(Byfield, 1, cell, &Bfield[1]);
+                R3BTrilinearKernel::InterpolateOne(Bzfield, 1, cell, &Bfield[2]);
+            }
+        } //! outside of field area
 
         else
         {
@@ -314,16 +271,6 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
             Bfield[1] = 0;
             Bfield[2] = 0;
         }
-        // Reset heap memory
-
-        if (linesArray)
-        {
-            delete linesArray;
-            linesArray = NULL;
-        }
-
-        // linesArray
-        // localPoint;
     }
     else if (typeField == 2)
     {
@@ -12,9 +12,14 @@
  ******************************************************************************/
 
 // Includes from C
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Includes from ROOT
 #include "TArrayF.h"
@@ -22,6 +27,7 @@
 #include "TMath.h"
 
 #include "R3BGladFieldMap.h"
+#include "R3BTrilinearKernel.h"
 
 using std::cerr;
 using std::cout;
@@ -34,6 +40,32 @@ using std::setw;
 using std::showpoint;
 using TMath::Nint;
 
+namespace
+{
+    // Header of the binary field map, followed by Bx,By,Bz [kG] of each
+    // grid point as float, in the same order as in memory. The values are
+    // already rotated and not scaled. The file is used in the byte order
+    // of the machine, fByteOrder tells whether it was written in another.
+    struct BinaryMapHeader
+    {
+        char fMagic[8];
+        UInt_t fVersion;
+        UInt_t fByteOrder;
+        UInt_t fHeaderSize;
+        Int_t fType;
+        Int_t fNx, fNy, fNz; // number of grid points
+        Int_t fNComp;
+        Double_t fXmin, fXmax;
+        Double_t fYmin, fYmax;
+        Double_t fZmin, fZmax;
+        Double_t fYAngle;
+    };
+
+    const char kBinaryMagic[8] = "R3BFMAP";
+    const UInt_t kBinaryVersion = 1;
+    const UInt_t kByteOrder = 0x01020304;
+} // namespace
+
 // -------------   Default constructor  ----------------------------------
 R3BGladFieldMap::R3BGladFieldMap()
 {
@@ -43,7 +75,10 @@ R3BGladFieldMap::R3BGladFieldMap()
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    fBx = fBy = fBz = NULL;
+    fB = NULL;
+    fBData = NULL;
+    fMapAddr = NULL;
+    fMapLength = 0;
     fPosX = fPosY = fPosZ = 0.;
     fName = "";
     fFileName = "";
@@ -62,12 +97,17 @@ R3BGladFieldMap::R3BGladFieldMap(const char* mapName, const char* fileType)
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    fBx = fBy = fBz = NULL;
+    fB = NULL;
+    fBData = NULL;
+    fMapAddr = NULL;
+    fMapLength = 0;
     fName = mapName;
     TString dir = getenv("VMCWORKDIR");
     fFileName = dir + "/field/magField/R3B/" + mapName;
     if (fileType[0] == 'R')
         fFileName += ".root";
+    else if (fileType[0] == 'B')
+        fFileName += ".bin";
     else
         fFileName += ".dat";
     fType = 1;
@@ -85,7 +125,10 @@ R3BGladFieldMap::R3BGladFieldMap(R3BFieldPar* fieldPar)
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    fBx = fBy = fBz = NULL;
+    fB = NULL;
+    fBData = NULL;
+    fMapAddr = NULL;
+    fMapLength = 0;
     if (!fieldPar)
     {
         cerr << "-W- R3BGladFieldConst::R3BGladFieldMap: empty parameter container!" << endl;
@@ -111,12 +154,9 @@ R3BGladFieldMap::R3BGladFieldMap(R3BFieldPar* fieldPar)
 // ------------   Destructor   --------------------------------------------
 R3BGladFieldMap::~R3BGladFieldMap()
 {
-    if (fBx)
-        delete fBx;
-    if (fBy)
-        delete fBy;
-    if (fBz)
-        delete fBz;
+    if (fB)
+        delete fB;
+    UnmapBinaryFile();
 }
 // ------------------------------------------------------------------------
 
@@ -128,9 +168,26 @@ void R3BGladFieldMap::Init()
     fPosZ = 163.4;
     fYAngle = -14.;
     gTrans = new TVector3(-fPosX, -fPosY, -fPosZ);
+    // Same rotation as TVector3::RotateY(-fYAngle * TMath::DegToRad())
+    fSinY = TMath::Sin(-fYAngle * TMath::DegToRad());
+    fCosY = TMath::Cos(-fYAngle * TMath::DegToRad());
     //  if      (fFileName.EndsWith(".root")) ReadRootFile(fFileName, fName);
     if (fFileName.EndsWith(".dat"))
+    {
+        // Use the binary version of the map instead if it is up to date
+        TString binName = fFileName;
+        binName.Replace(binName.Length() - 4, 4, ".bin");
+        struct stat binStat, datStat;
+        if (stat(binName, &binStat) == 0 &&
+            (stat(fFileName, &datStat) != 0 || binStat.st_mtime >= datStat.st_mtime) && MapBinaryFile(binName))
+            return;
         ReadAsciiFile(fFileName);
+    }
+    else if (fFileName.EndsWith(".bin"))
+    {
+        if (!MapBinaryFile(fFileName))
+            LOG(fatal) << "Init: Could not map " << fFileName;
+    }
     else
     {
         cerr << "-E- R3BGladFieldMap::Init: No proper file name defined! (" << fFileName << ")" << endl;
@@ -142,124 +199,117 @@ void R3BGladFieldMap::Init()
 // -----------   Get x component of the field   ---------------------------
 Double_t R3BGladFieldMap::GetBx(Double_t x, Double_t y, Double_t z)
 {
-
-    // cout << "-I- get Bx called " << endl;
-    // transform to local coordinates
-    // local to global
-    TVector3 localPoint(x, y, z);
-
-    localPoint = localPoint + (*gTrans);
-    localPoint.RotateY(-fYAngle * TMath::DegToRad());
-
-    Int_t ix = 0;
-    Int_t iy = 0;
-    Int_t iz = 0;
-    Double_t dx = 0.;
-    Double_t dy = 0.;
-    Double_t dz = 0.;
-
-    if (IsInside(localPoint.X(), localPoint.Y(), localPoint.Z(), ix, iy, iz, dx, dy, dz))
-    {
-
-        // Get Bx field values at grid cell corners
-        fHa[0][0][0] = fBx->At(ix * fNy * fNz + iy * fNz + iz);
-        fHa[1][0][0] = fBx->At((ix + 1) * fNy * fNz + iy * fNz + iz);
-        fHa[0][1][0] = fBx->At(ix * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[1][1][0] = fBx->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[0][0][1] = fBx->At(ix * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[1][0][1] = fBx->At((ix + 1) * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[0][1][1] = fBx->At(ix * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-        fHa[1][1][1] = fBx->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-
-        // Return interpolated field value
-        Double_t val = Interpolate(dx, dy, dz);
-        // cout << " (X) interpolated " << val << endl;
-        return (fTrackerCorr * val);
-    }
-
-    return 0.;
+    Double_t point[3] = { x, y, z };
+    Double_t bField[3];
+    GetFieldValue(point, bField);
+    return bField[0];
 }
 // ------------------------------------------------------------------------
 
 // -----------   Get y component of the field   ---------------------------
 Double_t R3BGladFieldMap::GetBy(Double_t x, Double_t y, Double_t z)
 {
+    Double_t point[3] = { x, y, z };
+    Double_t bField[3];
+    GetFieldValue(point, bField);
+    return bField[1];
+}
+// ------------------------------------------------------------------------
 
-    // transform to local coordinates
-    // local to global
-    TVector3 localPoint(x, y, z);
+// -----------   Get z component of the field   ---------------------------
+Double_t R3BGladFieldMap::GetBz(Double_t x, Double_t y, Double_t z)
+{
+    Double_t point[3] = { x, y, z };
+    Double_t bField[3];
+    GetFieldValue(point, bField);
+    return bField[2];
+}
+// ------------------------------------------------------------------------
 
-    localPoint = localPoint + (*gTrans);
-    localPoint.RotateY(-fYAngle * TMath::DegToRad());
+// -----------   Get all components of the field   ------------------------
+void R3BGladFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
+{
+    R3BTrilinearPoint cell;
+    if (!GetCell(point, cell))
+    {
+        bField[0] = bField[1] = bField[2] = 0.;
+        return;
+    }
 
-    Int_t ix = 0;
-    Int_t iy = 0;
-    Int_t iz = 0;
-    Double_t dx = 0.;
-    Double_t dy = 0.;
-    Double_t dz = 0.;
+    R3BTrilinearKernel::InterpolateOne(fBData, 3, cell, bField);
+    const Double_t factor = fScale * fTrackerCorr;
+    for (Int_t i = 0; i < 3; i++)
+    {
+        bField[i] *= factor;
+    }
+}
+// ------------------------------------------------------------------------
 
-    if (IsInside(localPoint.X(), localPoint.Y(), localPoint.Z(), ix, iy, iz, dx, dy, dz))
+// -----------   Get the field at many points   ---------------------------
+void R3BGladFieldMap::GetFieldValues(Int_t n, const Double_t* points, Double_t* bField)
+{
+    // Points inside the map are collected in chunks and handed to the
+    // vectorised kernel together
+    const Int_t kChunk = 64;
+    R3BTrilinearPoint cells[kChunk];
+    Int_t index[kChunk];
+    Double_t values[3 * kChunk];
+    const Double_t factor = fScale * fTrackerCorr;
+
+    for (Int_t first = 0; first < n; first += kChunk)
     {
+        const Int_t last = first + kChunk < n ? first + kChunk : n;
+        Int_t nInside = 0;
+        for (Int_t i = first; i < last; i++)
+        {
+            if (GetCell(points + 3 * i, cells[nInside]))
+            {
+                index[nInside++] = i;
+            }
+            else
+            {
+                bField[3 * i] = bField[3 * i + 1] = bField[3 * i + 2] = 0.;
+            }
+        }
 
-        // Get By field values at grid cell corners
-        fHa[0][0][0] = fBy->At(ix * fNy * fNz + iy * fNz + iz);
-        fHa[1][0][0] = fBy->At((ix + 1) * fNy * fNz + iy * fNz + iz);
-        fHa[0][1][0] = fBy->At(ix * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[1][1][0] = fBy->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[0][0][1] = fBy->At(ix * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[1][0][1] = fBy->At((ix + 1) * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[0][1][1] = fBy->At(ix * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-        fHa[1][1][1] = fBy->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-
-        // Return interpolated field value
-        Double_t val = Interpolate(dx, dy, dz);
-        // cout << " (Y) interpolated " << val << endl;
-        return (fTrackerCorr * val);
+        R3BTrilinearKernel::Interpolate(fBData, 3, nInside, cells, values, 3);
+        for (Int_t j = 0; j < nInside; j++)
+        {
+            for (Int_t k = 0; k < 3; k++)
+            {
+                bField[3 * index[j] + k] = factor * values[3 * j + k];
+            }
+        }
     }
-
-    return 0.;
 }
 // ------------------------------------------------------------------------
 
-// -----------   Get z component of the field   ---------------------------
-Double_t R3BGladFieldMap::GetBz(Double_t x, Double_t y, Double_t z)
+// -----------   Locate the grid cell of a point   ------------------------
+Bool_t R3BGladFieldMap::GetCell(const Double_t point[3], R3BTrilinearPoint& cell)
 {
+    // transform to local coordinates
+    Double_t xl = point[0] + gTrans->X();
+    Double_t yl = point[1] + gTrans->Y();
+    Double_t zl = point[2] + gTrans->Z();
+    Double_t zz = zl;
+    zl = fCosY * zz - fSinY * xl;
+    xl = fSinY * zz + fCosY * xl;
 
     Int_t ix = 0;
     Int_t iy = 0;
     Int_t iz = 0;
-    Double_t dx = 0.;
-    Double_t dy = 0.;
-    Double_t dz = 0.;
 
-    // transform to local coordinates
-    // local to global
-    TVector3 localPoint(x, y, z);
-
-    localPoint = localPoint + (*gTrans);
-    localPoint.RotateY(-fYAngle * TMath::DegToRad());
-
-    if (IsInside(localPoint.X(), localPoint.Y(), localPoint.Z(), ix, iy, iz, dx, dy, dz))
+    if (!IsInside(xl, yl, zl, ix, iy, iz, cell.fFrac[0], cell.fFrac[1], cell.fFrac[2]))
     {
-
-        // Get Bz field values at grid cell corners
-        fHa[0][0][0] = fBz->At(ix * fNy * fNz + iy * fNz + iz);
-        fHa[1][0][0] = fBz->At((ix + 1) * fNy * fNz + iy * fNz + iz);
-        fHa[0][1][0] = fBz->At(ix * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[1][1][0] = fBz->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[0][0][1] = fBz->At(ix * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[1][0][1] = fBz->At((ix + 1) * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[0][1][1] = fBz->At(ix * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-        fHa[1][1][1] = fBz->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-
-        // Return interpolated field value
-        Double_t val = Interpolate(dx, dy, dz);
-        // cout << " (Z) interpolated " << val << endl;
-        return (fTrackerCorr * val);
+        return kFALSE;
     }
 
-    return 0.;
+    // Strides between the grid cell corners, three components per grid point
+    cell.fStride[0] = 3 * fNy * fNz;
+    cell.fStride[1] = 3 * fNz;
+    cell.fStride[2] = 3;
+    cell.fBase = ix * cell.fStride[0] + iy * cell.fStride[1] + iz * cell.fStride[2];
+    return kTRUE;
 }
 // ------------------------------------------------------------------------
 
@@ -331,7 +381,7 @@ void R3BGladFieldMap::WriteAsciiFile(const char* fileName)
     mapFile << fZmin << " " << fZmax << " " << fNz << endl;
 
     // Write field values
-    Double_t factor = 10. * fScale; // Takes out scaling and converts kG->T
+    Double_t factor = 10.; // Converts kG->T
     cout << right;
     Int_t nTot = fNx * fNy * fNz;
     cout << "-I- R3BGladFieldMap: " << fNx * fNy * fNz << " entries to write... " << setw(3) << 0 << " % ";
@@ -351,8 +401,8 @@ void R3BGladFieldMap::WriteAsciiFile(const char* fileName)
                     Double_t perc = TMath::Nint(100. * index / nTot);
                     cout << "\b\b\b\b\b\b" << setw(3) << perc << " % " << flush;
                 }
-                mapFile << fBx->At(index) / factor << " " << fBy->At(index) / factor << " " << fBz->At(index) / factor
-                        << endl;
+                mapFile << fBData[3 * index] / factor << " " << fBData[3 * index + 1] / factor << " "
+                        << fBData[3 * index + 2] / factor << endl;
             } // z-Loop
         }     // y-Loop
     }         // x-Loop
@@ -361,6 +411,52 @@ void R3BGladFieldMap::WriteAsciiFile(const char* fileName)
 }
 // ------------------------------------------------------------------------
 
+// ----------   Write the map to a binary file   --------------------------
+Bool_t R3BGladFieldMap::WriteBinaryFile(const char* fileName)
+{
+    if (!fBData)
+    {
+        cerr << "-E- R3BGladFieldMap::WriteBinaryFile: No field map loaded! " << endl;
+        return kFALSE;
+    }
+
+    cout << "-I- R3BGladFieldMap: Writing field map to binary file " << fileName << endl;
+    BinaryMapHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.fMagic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.fVersion = kBinaryVersion;
+    header.fByteOrder = kByteOrder;
+    header.fHeaderSize = sizeof(BinaryMapHeader);
+    header.fType = fType;
+    header.fNx = fNx;
+    header.fNy = fNy;
+    header.fNz = fNz;
+    header.fNComp = 3;
+    header.fXmin = fXmin;
+    header.fXmax = fXmax;
+    header.fYmin = fYmin;
+    header.fYmax = fYmax;
+    header.fZmin = fZmin;
+    header.fZmax = fZmax;
+    header.fYAngle = fYAngle;
+
+    // Written to a temporary file first, jobs mapping the old file are
+    // not disturbed and never see a partial file
+    TString tmpName = TString(fileName) + ".tmp";
+    ofstream mapFile(tmpName, std::ios::binary);
+    mapFile.write((const char*)&header, sizeof(header));
+    mapFile.write((const char*)fBData, 3 * sizeof(Float_t) * fNx * fNy * fNz);
+    mapFile.close();
+    if (!mapFile || rename(tmpName, fileName) != 0)
+    {
+        cerr << "-E- R3BGladFieldMap::WriteBinaryFile: Could not write file! " << endl;
+        remove(tmpName);
+        return kFALSE;
+    }
+    return kTRUE;
+}
+// ------------------------------------------------------------------------
+
 // -------   Write field map to a ROOT file   -----------------------------
 /*
 void R3BGladFieldMap::WriteRootFile(const char* fileName,
@@ -433,21 +529,13 @@ void R3BGladFieldMap::Reset()
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    if (fBx)
+    if (fB)
     {
-        delete fBx;
-        fBx = NULL;
-    }
-    if (fBy)
-    {
-        delete fBy;
-        fBy = NULL;
-    }
-    if (fBz)
-    {
-        delete fBz;
-        fBz = NULL;
+        delete fB;
+        fB = NULL;
     }
+    UnmapBinaryFile();
+    fBData = NULL;
 }
 // ------------------------------------------------------------------------
 
@@ -495,12 +583,14 @@ void R3BGladFieldMap::ReadAsciiFile(const char* fileName)
     fNx += 1;
     fNy += 1;
     fNz += 1;
-    fBx = new TArrayF(fNx * fNy * fNz);
-    fBy = new TArrayF(fNx * fNy * fNz);
-    fBz = new TArrayF(fNx * fNy * fNz);
+    UnmapBinaryFile();
+    fB = new TArrayF(3 * fNx * fNy * fNz);
+    fBData = fB->GetArray();
 
     // Read the field values
-    Double_t factor = fScale * 10.; // Factor 10 for T -> kG
+    // The global scaling factor is applied in GetFieldValue, so that the
+    // values are the same as in a binary map
+    Double_t factor = 10.; // Factor 10 for T -> kG
     cout << right;
     Int_t nTot = fNx * fNy * fNz;
     cout << "-I- R3BGladFieldMap: " << nTot << " entries to read... " << setw(3) << 0 << " % ";
@@ -536,9 +626,9 @@ void R3BGladFieldMap::ReadAsciiFile(const char* fileName)
                 TVector3 B(bx, by, bz);
                 B.RotateY(fYAngle * TMath::DegToRad());
 
-                fBx->AddAt(factor * B.X(), index1);
-                fBy->AddAt(factor * B.Y(), index1);
-                fBz->AddAt(factor * B.Z(), index1);
+                fB->AddAt(factor * B.X(), 3 * index1);
+                fB->AddAt(factor * B.Y(), 3 * index1 + 1);
+                fB->AddAt(factor * B.Z(), 3 * index1 + 2);
                 // ------------------------------------------------------------------------------------------
 
                 //  cout << "-I- " << bx << " : " << by << " : "  << bz  << " : " << endl;
@@ -561,6 +651,90 @@ void R3BGladFieldMap::ReadAsciiFile(const char* fileName)
 }
 // ------------------------------------------------------------------------
 
+// -------   Map field values from a binary file (private)   -------------
+Bool_t R3BGladFieldMap::MapBinaryFile(const char* fileName)
+{
+    cout << "-I- R3BGladFieldMap: Mapping field map from binary file " << fileName << endl;
+    Int_t fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        cerr << "-E- R3BGladFieldMap::MapBinaryFile: Could not open file! " << endl;
+        return kFALSE;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(BinaryMapHeader))
+    {
+        cerr << "-E- R3BGladFieldMap::MapBinaryFile: File too short! " << endl;
+        close(fd);
+        return kFALSE;
+    }
+    // Shared with all other processes mapping the same file
+    void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+        cerr << "-E- R3BGladFieldMap::MapBinaryFile: mmap failed! " << endl;
+        return kFALSE;
+    }
+
+    const BinaryMapHeader* header = (const BinaryMapHeader*)addr;
+    const size_t nValues = size_t(header->fNComp) * header->fNx * header->fNy * header->fNz;
+    if (memcmp(header->fMagic, kBinaryMagic, sizeof(kBinaryMagic)) != 0 || header->fVersion != kBinaryVersion ||
+        header->fByteOrder != kByteOrder || header->fHeaderSize != sizeof(BinaryMapHeader) || header->fNComp != 3 ||
+        size_t(st.st_size) != header->fHeaderSize + nValues * sizeof(Float_t))
+    {
+        cerr << "-E- R3BGladFieldMap::MapBinaryFile: Not a binary field map of version " << kBinaryVersion << "!"
+             << endl;
+        munmap(addr, st.st_size);
+        return kFALSE;
+    }
+    if (fType != header->fType || fYAngle != header->fYAngle)
+    {
+        cerr << "-E- R3BGladFieldMap::MapBinaryFile: Incompatible map type or rotation!" << endl;
+        munmap(addr, st.st_size);
+        return kFALSE;
+    }
+
+    UnmapBinaryFile();
+    if (fB)
+    {
+        delete fB;
+        fB = NULL;
+    }
+    fMapAddr = addr;
+    fMapLength = st.st_size;
+    fBData = (const Float_t*)((const char*)addr + header->fHeaderSize);
+
+    // Same grid parameters as from the ASCII file
+    fXmin = header->fXmin;
+    fXmax = header->fXmax;
+    fYmin = header->fYmin;
+    fYmax = header->fYmax;
+    fZmin = header->fZmin;
+    fZmax = header->fZmax;
+    fNx = header->fNx;
+    fNy = header->fNy;
+    fNz = header->fNz;
+    fXstep = (fXmax - fXmin) / Double_t(fNx - 1);
+    fYstep = (fYmax - fYmin) / Double_t(fNy - 1);
+    fZstep = (fZmax - fZmin) / Double_t(fNz - 1);
+    return kTRUE;
+}
+// ------------------------------------------------------------------------
+
+// ---------   Release a mapped binary file (private)   -------------------
+void R3BGladFieldMap::UnmapBinaryFile()
+{
+    if (fMapAddr)
+    {
+        munmap(fMapAddr, fMapLength);
+        fBData = NULL;
+        fMapAddr = NULL;
+        fMapLength = 0;
+    }
+}
+// ------------------------------------------------------------------------
+
 // -------------   Read field map from ROOT file (private)  ---------------
 /*
 void R3BGladFieldMap::ReadRootFile(const char* fileName,
@@ -656,23 +830,4 @@ void R3BGladFieldMap::SetField(const R3BGladFieldMapData* data) {
 }
 */
 
-// ------------   Interpolation in a grid cell (private)  -----------------
-Double_t R3BGladFieldMap::Interpolate(Double_t dx, Double_t dy, Double_t dz)
-{
-
-    // Interpolate in x coordinate
-    fHb[0][0] = fHa[0][0][0] + (fHa[1][0][0] - fHa[0][0][0]) * dx;
-    fHb[1][0] = fHa[0][1][0] + (fHa[1][1][0] - fHa[0][1][0]) * dx;
-    fHb[0][1] = fHa[0][0][1] + (fHa[1][0][1] - fHa[0][0][1]) * dx;
-    fHb[1][1] = fHa[0][1][1] + (fHa[1][1][1] - fHa[0][1][1]) * dx;
-
-    // Interpolate in y coordinate
-    fHc[0] = fHb[0][0] + (fHb[1][0] - fHb[0][0]) * dy;
-    fHc[1] = fHb[0][1] + (fHb[1][1] - fHb[0][1]) * dy;
-
-    // Interpolate in z coordinate
-    return fHc[0] + (fHc[1] - fHc[0]) * dz;
-}
-// ------------------------------------------------------------------------
-
 ClassImp(R3BGladFieldMap)
@@ -19,7 +19,10 @@
 #include "TRotation.h"
 #include "TVector3.h"
 
+#include <cstddef>
+
 class TArrayF;
+struct R3BTrilinearPoint;
 
 class R3BGladFieldMap : public FairField
 {
@@ -30,7 +33,8 @@ class R3BGladFieldMap : public FairField
 
     /** Standard constructor
      ** @param name       Name of field map
-     ** @param fileType   R = ROOT file, A = ASCII
+     ** @param fileType   R = ROOT file, A = ASCII (or binary if there is an
+     **                   up to date one), B = binary
      **/
     R3BGladFieldMap(const char* mapName, const char* fileType = "A");
 
@@ -54,6 +58,20 @@ class R3BGladFieldMap : public FairField
     virtual Double_t GetBy(Double_t x, Double_t y, Double_t z);
     virtual Double_t GetBz(Double_t x, Double_t y, Double_t z);
 
+    /** Get all field components at a point, transforming the point and
+     ** locating the grid cell only once
+     ** @param point     Point coordinates (global) [cm]
+     ** @param bField    Field components [kG]
+     **/
+    virtual void GetFieldValue(const Double_t point[3], Double_t* bField);
+
+    /** Get the field at many points at once, e.g. for a propagator
+     ** @param n         Number of points
+     ** @param points    Point coordinates (global) [cm], x,y,z for each point
+     ** @param bField    Field components [kG], Bx,By,Bz for each point
+     **/
+    void GetFieldValues(Int_t n, const Double_t* points, Double_t* bField);
+
     /** Determine whether a point is inside the field map
      ** @param x,y,z              Point coordinates (global) [cm]
      ** @param ix,iy,iz (return)  Grid cell
@@ -73,6 +91,12 @@ class R3BGladFieldMap : public FairField
     /** Write the field map to an ASCII file **/
     void WriteAsciiFile(const char* fileName);
 
+    /** Write the field map to a binary file, which Init() maps instead of
+     ** reading the ASCII file of the same name if it is not older
+     ** @value kTRUE on success
+     **/
+    Bool_t WriteBinaryFile(const char* fileName);
+
     /** Write field map data to a ROOT file **/
     // void WriteRootFile(const char* fileName, const char* mapName);
 
@@ -83,6 +107,7 @@ class R3BGladFieldMap : public FairField
     virtual void SetScale(Double_t factor) { fScale = factor; }
 
     void SetTrackerCorrection(const Double_t& corr) { fTrackerCorr = corr; }
+    Double_t GetTrackerCorrection() const { return fTrackerCorr; }
 
     /** Accessors to field parameters in local coordinate system **/
     Double_t GetXmin() const { return fXmin; }
@@ -109,10 +134,9 @@ class R3BGladFieldMap : public FairField
     /** Accessor to global scaling factor  **/
     Double_t GetScale() const { return fScale; }
 
-    /** Accessors to the field value arrays **/
-    TArrayF* GetBx() const { return fBx; }
-    TArrayF* GetBy() const { return fBy; }
-    TArrayF* GetBz() const { return fBz; }
+    /** Accessor to the field values, Bx,By,Bz for each grid point [kG]
+     ** without the global scaling factor **/
+    const Float_t* GetB() const { return fBData; }
 
     /** Accessor to field map file **/
     const char* GetFileName() { return fFileName.Data(); }
@@ -127,16 +151,26 @@ class R3BGladFieldMap : public FairField
     /** Read the field map from an ASCII file **/
     void ReadAsciiFile(const char* fileName);
 
+    /** Map the field values read-only from a binary file
+     ** @value kTRUE if the file is a valid binary field map
+     **/
+    Bool_t MapBinaryFile(const char* fileName);
+
+    /** Release a mapped binary file **/
+    void UnmapBinaryFile();
+
     /** Read field map from a ROOT file **/
     // void ReadRootFile(const char* fileName, const char* mapName);
 
     /** Set field parameters and data **/
     // void SetField(const R3BGladFieldMapData* data);
 
-    /** Get field values by interpolation of the grid.
-     ** @param dx,dy,dz  Relative distance from grid point [cell units]
+    /** Transform a point to local coordinates and locate its grid cell
+     ** @param point     Point coordinates (global) [cm]
+     ** @param cell      Grid cell for R3BTrilinearKernel
+     ** @value kTRUE if inside map, else kFALSE
      **/
-    Double_t Interpolate(Double_t dx, Double_t dy, Double_t dz);
+    Bool_t GetCell(const Double_t point[3], R3BTrilinearPoint& cell);
 
     /** Map file name **/
     TString fFileName;
@@ -158,21 +192,20 @@ class R3BGladFieldMap : public FairField
     /** Number of grid points  **/
     Int_t fNx, fNy, fNz; //
 
-    /** Arrays with the field values  **/
-    TArrayF* fBx; //!
-    TArrayF* fBy; //!
-    TArrayF* fBz; //!
+    /** Field values, Bx,By,Bz of a grid point next to each other **/
+    TArrayF* fB; //!
 
-    /** Variables for temporary storage
-     ** Used in the very frequently called method GetFieldValue  **/
-    Double_t fHa[2][2][2]; //! Field at corners of a grid cell
-    Double_t fHb[2][2];    //! Interpolated field (2-dim)
-    Double_t fHc[2];       //! Interpolated field (1-dim)
+    /** Field values in use, either fB or mapped from a binary file **/
+    const Float_t* fBData; //!
+    void* fMapAddr;        //!
+    size_t fMapLength;     //!
 
     /** local transformation
      **/
     TRotation* gRot;  //!
     TVector3* gTrans; //!
+    Double_t fSinY;   //! sin and cos of -fYAngle
+    Double_t fCosY;   //!
 
     Double_t fTrackerCorr;
 
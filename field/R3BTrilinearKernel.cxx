@@ -0,0 +1,159 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTrilinearKernel.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define R3BTRILINEAR_AVX2 1
+#include <immintrin.h>
+#endif
+
+#ifdef R3BTRILINEAR_AVX2
+namespace
+{
+    // Four points at a time, one lane per point. Only the loads differ
+    // between float and double data, the arithmetic is done in double
+    // without fused multiply-add, exactly as in InterpolateOne.
+
+    struct Corners
+    {
+        __m128i i000, i100, i010, i110, i001, i101, i011, i111;
+    };
+
+    __attribute__((target("avx2"))) inline Corners GetCorners(const R3BTrilinearPoint* p)
+    {
+        Corners k;
+        __m128i sx = _mm_setr_epi32(p[0].fStride[0], p[1].fStride[0], p[2].fStride[0], p[3].fStride[0]);
+        __m128i sy = _mm_setr_epi32(p[0].fStride[1], p[1].fStride[1], p[2].fStride[1], p[3].fStride[1]);
+        __m128i sz = _mm_setr_epi32(p[0].fStride[2], p[1].fStride[2], p[2].fStride[2], p[3].fStride[2]);
+        k.i000 = _mm_setr_epi32(p[0].fBase, p[1].fBase, p[2].fBase, p[3].fBase);
+        k.i100 = _mm_add_epi32(k.i000, sx);
+        k.i010 = _mm_add_epi32(k.i000, sy);
+        k.i110 = _mm_add_epi32(k.i100, sy);
+        k.i001 = _mm_add_epi32(k.i000, sz);
+        k.i101 = _mm_add_epi32(k.i100, sz);
+        k.i011 = _mm_add_epi32(k.i010, sz);
+        k.i111 = _mm_add_epi32(k.i110, sz);
+        return k;
+    }
+
+    __attribute__((target("avx2"))) inline __m256d Gather(const Float_t* data, __m128i idx)
+    {
+        return _mm256_cvtps_pd(_mm_i32gather_ps(data, idx, 4));
+    }
+
+    __attribute__((target("avx2"))) inline __m256d Gather(const Double_t* data, __m128i idx)
+    {
+        // The masked form avoids a spurious -Wmaybe-uninitialized with gcc
+        const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), data, idx, all, 8);
+    }
+
+    __attribute__((target("avx2"))) inline __m256d Lerp(__m256d a, __m256d b, __m256d d)
+    {
+        return _mm256_add_pd(a, _mm256_mul_pd(_mm256_sub_pd(b, a), d));
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) void InterpolateAvx2(const T* data,
+                                                         Int_t nComp,
+                                                         Int_t n,
+                                                         const R3BTrilinearPoint* points,
+                                                         Double_t* out,
+                                                         Int_t outStride)
+    {
+        Int_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const R3BTrilinearPoint* p = points + i;
+            const Corners k = GetCorners(p);
+            const __m256d dx = _mm256_setr_pd(p[0].fFrac[0], p[1].fFrac[0], p[2].fFrac[0], p[3].fFrac[0]);
+            const __m256d dy = _mm256_setr_pd(p[0].fFrac[1], p[1].fFrac[1], p[2].fFrac[1], p[3].fFrac[1]);
+            const __m256d dz = _mm256_setr_pd(p[0].fFrac[2], p[1].fFrac[2], p[2].fFrac[2], p[3].fFrac[2]);
+
+            for (Int_t c = 0; c < nComp; c++)
+            {
+                const T* b = data + c;
+
+                // Interpolate in x coordinate
+                __m256d b00 = Lerp(Gather(b, k.i000), Gather(b, k.i100), dx);
+                __m256d b10 = Lerp(Gather(b, k.i010), Gather(b, k.i110), dx);
+                __m256d b01 = Lerp(Gather(b, k.i001), Gather(b, k.i101), dx);
+                __m256d b11 = Lerp(Gather(b, k.i011), Gather(b, k.i111), dx);
+
+                // Interpolate in y coordinate
+                __m256d b0 = Lerp(b00, b10, dy);
+                __m256d b1 = Lerp(b01, b11, dy);
+
+                // Interpolate in z coordinate
+                alignas(32) Double_t v[4];
+                _mm256_store_pd(v, Lerp(b0, b1, dz));
+                for (Int_t j = 0; j < 4; j++)
+                {
+                    out[(i + j) * outStride + c] = v[j];
+                }
+            }
+        }
+        R3BTrilinearKernel::InterpolateScalar(data, nComp, n - i, points + i, out + i * outStride, outStride);
+    }
+
+    Bool_t CpuHasAvx2()
+    {
+        static const Bool_t hasAvx2 = __builtin_cpu_supports("avx2");
+        return hasAvx2;
+    }
+} // namespace
+#endif
+
+void R3BTrilinearKernel::Interpolate(const Float_t* data,
+                                     Int_t nComp,
+                                     Int_t n,
+                                     const R3BTrilinearPoint* points,
+                                     Double_t* out,
+                                     Int_t outStride)
+{
+#ifdef R3BTRILINEAR_AVX2
+    if (n >= 4 && CpuHasAvx2())
+    {
+        InterpolateAvx2(data, nComp, n, points, out, outStride);
+        return;
+    }
+#endif
+    InterpolateScalar(data, nComp, n, points, out, outStride);
+}
+
+void R3BTrilinearKernel::Interpolate(const Double_t* data,
+                                     Int_t nComp,
+                                     Int_t n,
+                                     const R3BTrilinearPoint* points,
+                                     Double_t* out,
+                                     Int_t outStride)
+{
+#ifdef R3BTRILINEAR_AVX2
+    if (n >= 4 && CpuHasAvx2())
+    {
+        InterpolateAvx2(data, nComp, n, points, out, outStride);
+        return;
+    }
+#endif
+    InterpolateScalar(data, nComp, n, points, out, outStride);
+}
+
+Bool_t R3BTrilinearKernel::HasSimd()
+{
+#ifdef R3BTRILINEAR_AVX2
+    return CpuHasAvx2();
+#else
+    return kFALSE;
+#endif
+}
@@ -0,0 +1,107 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BTRILINEARKERNEL_H
+#define R3BTRILINEARKERNEL_H
+
+#include "Rtypes.h"
+
+/** One point to interpolate on a regular grid
+ ** fBase   Index of the lower corner of the grid cell
+ ** fStride Index offset to the upper corner along x, y, z. Set to 0 to
+ **         repeat the lower value, e.g. on the boundary of the map.
+ ** fFrac   Relative position inside the cell along x, y, z [cell units]
+ **/
+struct R3BTrilinearPoint
+{
+    Int_t fBase;
+    Int_t fStride[3];
+    Double_t fFrac[3];
+};
+
+/** Stateless trilinear interpolation of field maps, shared by
+ ** R3BGladFieldMap, R3BFieldMap and R3BFieldInterp (ALADIN).
+ **
+ ** nComp values are stored next to each other for each grid point, the
+ ** result of component c of point i is written to out[i * outStride + c].
+ ** The interpolation is done as a + (b - a) * d in double precision, first
+ ** along x, then y, then z. The vectorised (AVX2) version gives the same
+ ** results as the scalar one, it is used when the CPU supports it.
+ **/
+class R3BTrilinearKernel
+{
+  public:
+    /** Interpolate a batch of points **/
+    static void Interpolate(const Float_t* data,
+                            Int_t nComp,
+                            Int_t n,
+                            const R3BTrilinearPoint* points,
+                            Double_t* out,
+                            Int_t outStride);
+    static void Interpolate(const Double_t* data,
+                            Int_t nComp,
+                            Int_t n,
+                            const R3BTrilinearPoint* points,
+                            Double_t* out,
+                            Int_t outStride);
+
+    /** Same as Interpolate, without vector instructions **/
+    template <typename T>
+    static void InterpolateScalar(const T* data,
+                                  Int_t nComp,
+                                  Int_t n,
+                                  const R3BTrilinearPoint* points,
+                                  Double_t* out,
+                                  Int_t outStride)
+    {
+        for (Int_t i = 0; i < n; i++)
+        {
+            InterpolateOne(data, nComp, points[i], out + i * outStride);
+        }
+    }
+
+    /** Interpolate a single point **/
+    template <typename T>
+    static inline void InterpolateOne(const T* data, Int_t nComp, const R3BTrilinearPoint& p, Double_t* out)
+    {
+        const Int_t sx = p.fStride[0];
+        const Int_t sy = p.fStride[1];
+        const Int_t sz = p.fStride[2];
+        const Double_t dx = p.fFrac[0];
+        const Double_t dy = p.fFrac[1];
+        const Double_t dz = p.fFrac[2];
+
+        for (Int_t c = 0; c < nComp; c++)
+        {
+            const T* b = data + p.fBase + c;
+
+            // Interpolate in x coordinate
+            Double_t b00 = b[0] + (Double_t(b[sx]) - b[0]) * dx;
+            Double_t b10 = b[sy] + (Double_t(b[sx + sy]) - b[sy]) * dx;
+            Double_t b01 = b[sz] + (Double_t(b[sx + sz]) - b[sz]) * dx;
+            Double_t b11 = b[sy + sz] + (Double_t(b[sx + sy + sz]) - b[sy + sz]) * dx;
+
+            // Interpolate in y coordinate
+            Double_t b0 = b00 + (b10 - b00) * dy;
+            Double_t b1 = b01 + (b11 - b01) * dy;
+
+            // Interpolate in z coordinate
+            out[c] = b0 + (b1 - b0) * dz;
+        }
+    }
+
+    /** kTRUE if Interpolate uses the AVX2 version on this machine **/
+    static Bool_t HasSimd();
+};
+
+#endif
@@ -0,0 +1,233 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Evaluates the GLAD field map at random points inside the map, point by
+// point through GetFieldValue and in batches through GetFieldValues, and
+// compares speed and results with a copy of the scalar interpolation that
+// R3BGladFieldMap used before R3BTrilinearKernel.
+// Needs $VMCWORKDIR/field/magField/R3B/R3BGladMap.dat
+// Usage: benchR3BGladFieldMap [number of points, default 1e7]
+
+#include "R3BGladFieldMap.h"
+#include "R3BTrilinearKernel.h"
+
+#include "TMath.h"
+#include "TVector3.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Int_t kNofPoints = 1 << 16;
+
+    template <typename F>
+    Double_t Run(const char* name, Long64_t n, F evaluate)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (Long64_t i = 0; i < n; i += kNofPoints)
+        {
+            evaluate();
+        }
+        const Double_t s = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << s << " s, " << 1e9 * s / n << " ns/point" << std::endl;
+        return s;
+    }
+
+    // The interpolation of R3BGladFieldMap before R3BTrilinearKernel: GetBx, GetBy and GetBz each transform
+    // the point, locate the grid cell, and interpolate the corners of one component copied to fHa
+    class OldGladFieldMap
+    {
+      public:
+        explicit OldGladFieldMap(const R3BGladFieldMap& field)
+            : fField(field)
+            , fB(field.GetB())
+            , fNx(field.GetNx())
+            , fNy(field.GetNy())
+            , fNz(field.GetNz())
+        {
+        }
+
+        void GetFieldValue(const Double_t point[3], Double_t* bField)
+        {
+            for (Int_t c = 0; c < 3; c++)
+            {
+                bField[c] = GetB(c, point[0], point[1], point[2]);
+            }
+        }
+
+      private:
+        Double_t GetB(Int_t c, Double_t x, Double_t y, Double_t z)
+        {
+            TVector3 localPoint(x, y, z);
+            localPoint = localPoint + TVector3(-fField.GetPositionX(), -fField.GetPositionY(), -fField.GetPositionZ());
+            localPoint.RotateY(-fField.GetYAngle() * TMath::DegToRad());
+
+            Int_t ix = 0;
+            Int_t iy = 0;
+            Int_t iz = 0;
+            Double_t dx = 0.;
+            Double_t dy = 0.;
+            Double_t dz = 0.;
+
+            if (IsInside(localPoint.X(), localPoint.Y(), localPoint.Z(), ix, iy, iz, dx, dy, dz))
+            {
+                fHa[0][0][0] = At(c, ix, iy, iz);
+                fHa[1][0][0] = At(c, ix + 1, iy, iz);
+                fHa[0][1][0] = At(c, ix, iy + 1, iz);
+                fHa[1][1][0] = At(c, ix + 1, iy + 1, iz);
+                fHa[0][0][1] = At(c, ix, iy, iz + 1);
+                fHa[1][0][1] = At(c, ix + 1, iy, iz + 1);
+                fHa[0][1][1] = At(c, ix, iy + 1, iz + 1);
+                fHa[1][1][1] = At(c, ix + 1, iy + 1, iz + 1);
+
+                // The scaling factor used to be applied when reading the map
+                return fField.GetTrackerCorrection() * (fField.GetScale() * Interpolate(dx, dy, dz));
+            }
+            return 0.;
+        }
+
+        // Like TArrayF::At, 0 outside the array
+        Double_t At(Int_t c, Int_t ix, Int_t iy, Int_t iz) const
+        {
+            if (ix >= fNx || iy >= fNy || iz >= fNz)
+            {
+                return 0.;
+            }
+            return fB[3 * (ix * fNy * fNz + iy * fNz + iz) + c];
+        }
+
+        Bool_t IsInside(Double_t xl,
+                        Double_t yl,
+                        Double_t zl,
+                        Int_t& ix,
+                        Int_t& iy,
+                        Int_t& iz,
+                        Double_t& dx,
+                        Double_t& dy,
+                        Double_t& dz) const
+        {
+            if (!(xl >= fField.GetXmin() && xl < fField.GetXmax() && yl >= fField.GetYmin() &&
+                  yl < fField.GetYmax() && zl >= fField.GetZmin() && zl < fField.GetZmax()))
+            {
+                return kFALSE;
+            }
+            ix = Int_t((xl - fField.GetXmin()) / fField.GetXstep());
+            iy = Int_t((yl - fField.GetYmin()) / fField.GetYstep());
+            iz = Int_t((zl - fField.GetZmin()) / fField.GetZstep());
+            dx = (xl - fField.GetXmin()) / fField.GetXstep() - Double_t(ix);
+            dy = (yl - fField.GetYmin()) / fField.GetYstep() - Double_t(iy);
+            dz = (zl - fField.GetZmin()) / fField.GetZstep() - Double_t(iz);
+            return kTRUE;
+        }
+
+        Double_t Interpolate(Double_t dx, Double_t dy, Double_t dz)
+        {
+            fHb[0][0] = fHa[0][0][0] + (fHa[1][0][0] - fHa[0][0][0]) * dx;
+            fHb[1][0] = fHa[0][1][0] + (fHa[1][1][0] - fHa[0][1][0]) * dx;
+            fHb[0][1] = fHa[0][0][1] + (fHa[1][0][1] - fHa[0][0][1]) * dx;
+            fHb[1][1] = fHa[0][1][1] + (fHa[1][1][1] - fHa[0][1][1]) * dx;
+
+            fHc[0] = fHb[0][0] + (fHb[1][0] - fHb[0][0]) * dy;
+            fHc[1] = fHb[0][1] + (fHb[1][1] - fHb[0][1]) * dy;
+
+            return fHc[0] + (fHc[1] - fHc[0]) * dz;
+        }
+
+        const R3BGladFieldMap& fField;
+        const Float_t* fB;
+        Int_t fNx, fNy, fNz;
+        Double_t fHa[2][2][2];
+        Double_t fHb[2][2];
+        Double_t fHc[2];
+    };
+
+    // Number of values that differ and the largest difference
+    Int_t Compare(const char* name, const std::vector<Double_t>& a, const std::vector<Double_t>& b)
+    {
+        Int_t nDiff = 0;
+        Double_t maxDiff = 0.;
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            nDiff += a[i] != b[i];
+            maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]));
+        }
+        std::cout << name << ": " << nDiff << " differences, largest " << maxDiff << " kG" << std::endl;
+        return nDiff;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Long64_t n = argc > 1 ? atof(argv[1]) : 1e7;
+
+    R3BGladFieldMap field("R3BGladMap", "A");
+    field.Init();
+    field.Print();
+
+    // Random points in the local frame of the map, rotated and shifted back
+    // to the global frame like R3BGladFieldMap::GetFieldValue expects them
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<Double_t> x(field.GetXmin(), field.GetXmax());
+    std::uniform_real_distribution<Double_t> y(field.GetYmin(), field.GetYmax());
+    std::uniform_real_distribution<Double_t> z(field.GetZmin(), field.GetZmax());
+    const Double_t a = field.GetYAngle() * TMath::DegToRad();
+    std::vector<Double_t> points(3 * kNofPoints);
+    for (Int_t i = 0; i < kNofPoints; i++)
+    {
+        const Double_t xl = x(rng);
+        const Double_t zl = z(rng);
+        points[3 * i] = std::cos(a) * xl + std::sin(a) * zl + field.GetPositionX();
+        points[3 * i + 1] = y(rng) + field.GetPositionY();
+        points[3 * i + 2] = -std::sin(a) * xl + std::cos(a) * zl + field.GetPositionZ();
+    }
+
+    OldGladFieldMap oldField(field);
+    std::vector<Double_t> old(3 * kNofPoints);
+    std::vector<Double_t> single(3 * kNofPoints);
+    std::vector<Double_t> batch(3 * kNofPoints);
+    std::cout << "AVX2 kernel: " << (R3BTrilinearKernel::HasSimd() ? "yes" : "no") << std::endl;
+    const Double_t tOld = Run("old scalar    ", n, [&] {
+        for (Int_t i = 0; i < kNofPoints; i++)
+        {
+            oldField.GetFieldValue(&points[3 * i], &old[3 * i]);
+        }
+    });
+    const Double_t tSingle = Run("GetFieldValue ", n, [&] {
+        for (Int_t i = 0; i < kNofPoints; i++)
+        {
+            field.GetFieldValue(&points[3 * i], &single[3 * i]);
+        }
+    });
+    const Double_t tBatch =
+        Run("GetFieldValues", n, [&] { field.GetFieldValues(kNofPoints, points.data(), batch.data()); });
+    std::cout << "speedup over old scalar: GetFieldValue " << tOld / tSingle << ", GetFieldValues " << tOld / tBatch
+              << std::endl;
+    std::cout << "speedup of GetFieldValues over GetFieldValue: " << tSingle / tBatch << std::endl;
+
+    Int_t nZero = 0;
+    for (Int_t i = 0; i < 3 * kNofPoints; i++)
+    {
+        nZero += old[i] == 0.;
+    }
+    std::cout << nZero << " of " << 3 * kNofPoints << " values zero" << std::endl;
+    Int_t nDiff = Compare("GetFieldValue  vs old scalar", old, single);
+    nDiff += Compare("GetFieldValues vs old scalar", old, batch);
+    nDiff += Compare("GetFieldValues vs GetFieldValue", single, batch);
+    return nDiff == 0 ? 0 : 1;
+}
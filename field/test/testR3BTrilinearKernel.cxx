@@ -0,0 +1,115 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTrilinearKernel.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Int_t kNx = 7;
+    const Int_t kNy = 5;
+    const Int_t kNz = 9;
+
+    // Cells anywhere on a kNx * kNy * kNz grid with nComp values per grid
+    // point, clamped on the upper edge like R3BFieldInterp does it
+    std::vector<R3BTrilinearPoint> RandomPoints(Int_t n, Int_t nComp, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<Double_t> frac(0., 1.);
+        std::vector<R3BTrilinearPoint> points(n);
+        for (auto& p : points)
+        {
+            const Int_t ix = rng() % kNx;
+            const Int_t iy = rng() % kNy;
+            const Int_t iz = rng() % kNz;
+            p.fStride[0] = ix + 1 < kNx ? nComp * kNy * kNz : 0;
+            p.fStride[1] = iy + 1 < kNy ? nComp * kNz : 0;
+            p.fStride[2] = iz + 1 < kNz ? nComp : 0;
+            p.fBase = nComp * ((ix * kNy + iy) * kNz + iz);
+            for (Int_t i = 0; i < 3; i++)
+            {
+                p.fFrac[i] = frac(rng);
+            }
+        }
+        return points;
+    }
+
+    template <typename T>
+    void CompareToScalar(Int_t nComp, Int_t n)
+    {
+        std::mt19937 rng(n);
+        std::uniform_real_distribution<Double_t> value(-20., 20.);
+        std::vector<T> data(nComp * kNx * kNy * kNz);
+        for (auto& d : data)
+        {
+            d = value(rng);
+        }
+        const auto points = RandomPoints(n, nComp, rng);
+
+        std::vector<Double_t> batch(nComp * n);
+        std::vector<Double_t> scalar(nComp * n);
+        R3BTrilinearKernel::Interpolate(data.data(), nComp, n, points.data(), batch.data(), nComp);
+        R3BTrilinearKernel::InterpolateScalar(data.data(), nComp, n, points.data(), scalar.data(), nComp);
+        for (Int_t i = 0; i < nComp * n; i++)
+        {
+            EXPECT_EQ(scalar[i], batch[i]) << "value " << i;
+        }
+    }
+
+    TEST(testR3BTrilinearKernel, BatchMatchesScalarFloat)
+    {
+        for (Int_t n : { 0, 1, 3, 4, 5, 64, 1001 })
+        {
+            CompareToScalar<Float_t>(3, n);
+            CompareToScalar<Float_t>(1, n);
+        }
+    }
+
+    TEST(testR3BTrilinearKernel, BatchMatchesScalarDouble)
+    {
+        for (Int_t n : { 0, 1, 3, 4, 5, 64, 1001 })
+        {
+            CompareToScalar<Double_t>(3, n);
+            CompareToScalar<Double_t>(1, n);
+        }
+    }
+
+    TEST(testR3BTrilinearKernel, ReproducesLinearField)
+    {
+        // Trilinear interpolation is exact for a linear function
+        std::vector<Double_t> data(kNx * kNy * kNz);
+        for (Int_t ix = 0; ix < kNx; ix++)
+            for (Int_t iy = 0; iy < kNy; iy++)
+                for (Int_t iz = 0; iz < kNz; iz++)
+                    data[(ix * kNy + iy) * kNz + iz] = 1. + 2. * ix - 3. * iy + 0.5 * iz;
+
+        R3BTrilinearPoint p;
+        p.fBase = (2 * kNy + 3) * kNz + 4;
+        p.fStride[0] = kNy * kNz;
+        p.fStride[1] = kNz;
+        p.fStride[2] = 1;
+        p.fFrac[0] = 0.25;
+        p.fFrac[1] = 0.5;
+        p.fFrac[2] = 0.75;
+
+        std::vector<R3BTrilinearPoint> points(8, p);
+        std::vector<Double_t> out(points.size());
+        R3BTrilinearKernel::Interpolate(data.data(), 1, points.size(), points.data(), out.data(), 1);
+        for (auto v : out)
+        {
+            EXPECT_NEAR(1. + 2. * 2.25 - 3. * 3.5 + 0.5 * 4.75, v, 1e-12);
+        }
+    }
+} // namespace
@@ -27,11 +27,12 @@ R3BNeulandClusterFinder::R3BNeulandClusterFinder(const Double_t dx,
     , fDigis(input)
     , fClusters(output)
 {
-    fClusteringEngine.SetClusteringCondition([=](const R3BNeulandHit& a, const R3BNeulandHit& b) {
-        return std::abs(a.GetPosition().X() - b.GetPosition().X()) < dx &&
-               std::abs(a.GetPosition().Y() - b.GetPosition().Y()) < dy &&
-               std::abs(a.GetPosition().Z() - b.GetPosition().Z()) < dz && std::abs(a.GetT() - b.GetT()) < dt;
+    // Hits belong to the same cluster if they are closer than dx, dy, dz and dt to any hit of the cluster
+    fClusteringEngine.SetCoordinates([](const R3BNeulandHit& h) {
+        const TVector3 pos = h.GetPosition();
+        return Neuland::GridClusteringEngine<R3BNeulandHit>::Coordinates{ pos.X(), pos.Y(), pos.Z(), h.GetT() };
     });
+    fClusteringEngine.SetMaxDistance({ dx, dy, dz, dt });
 }
 
 InitStatus R3BNeulandClusterFinder::Init()
@@ -45,19 +46,19 @@ void R3BNeulandClusterFinder::Exec(Option_t*)
 {
     fClusters.Reset();
 
-    auto digis = fDigis.RetrieveObjects();
-    const auto nDigis = digis.size();
+    const auto digis = fDigis.View();
 
-    // Group them using the clustering condition set above: vector of digis -> vector of vector of digis
-    auto clusteredDigis = fClusteringEngine.Clusterize(digis);
-    const auto nClusters = clusteredDigis.size();
-
-    LOG(DEBUG) << "R3BNeulandClusterFinder - nDigis nCluster:" << nDigis << " " << nClusters;
+    // Group them using the clustering condition set above. The clusters are filled directly from the input array into
+    // clusters recycled from the previous event, so no hits are copied in between
+    fClusteringEngine.Clusterize(digis, [&](const std::vector<size_t>& indices) {
+        auto& cluster = fClusters.Recycle();
+        for (const auto i : indices)
+        {
+            cluster.AddHit(digis[i]);
+        }
+    });
 
-    for (auto& cluster : clusteredDigis)
-    {
-        fClusters.Insert(R3BNeulandCluster{ std::move(cluster) });
-    }
+    LOG(DEBUG) << "R3BNeulandClusterFinder - nDigis nCluster:" << digis.size() << " " << fClusters.Size();
 }
 
 ClassImp(R3BNeulandClusterFinder);
@@ -24,7 +24,7 @@
  *
  */
 
-#include "ClusteringEngine.h"
+#include "GridClusteringEngine.h"
 #include "FairTask.h"
 #include "R3BNeulandCluster.h"
 #include "R3BNeulandHit.h"
@@ -55,7 +55,7 @@ class R3BNeulandClusterFinder : public FairTask
     void Exec(Option_t*) override;
 
   private:
-    Neuland::ClusteringEngine<R3BNeulandHit> fClusteringEngine;
+    Neuland::GridClusteringEngine<R3BNeulandHit> fClusteringEngine;
     TCAInputConnector<R3BNeulandHit> fDigis;
     TCAOutputConnector<R3BNeulandCluster> fClusters;
 
@@ -14,6 +14,7 @@
 #include "DigitizingEngine.h"
 #include <algorithm>
 #include <cmath>
+#include <stdexcept>
 
 namespace Neuland
 {
@@ -39,6 +40,12 @@ namespace Neuland
             fRightChannel->AddHit(time, light, dist);
         }
 
+        void Paddle::Clear()
+        {
+            fLeftChannel->Clear();
+            fRightChannel->Clear();
+        }
+
         bool Paddle::HasFired() const { return (fLeftChannel->HasFired() && fRightChannel->HasFired()); }
 
         bool Paddle::HasHalfFired() const
@@ -65,18 +72,40 @@ namespace Neuland
                                         const Double_t light,
                                         const Double_t dist)
     {
-        if (paddles.find(paddle_id) == paddles.end())
+        StartEvent();
+        if (paddle_id < 0)
+        {
+            throw std::out_of_range("DigitizingEngine::DepositLight: Negative paddle id");
+        }
+        if ((size_t)paddle_id >= paddles.size())
+        {
+            paddles.resize(paddle_id + 1);
+            paddleInUse.resize(paddle_id + 1, false);
+        }
+        auto& paddle = paddles[paddle_id];
+        if (!paddle)
+        {
+            paddle = std::unique_ptr<Digitizing::Paddle>(
+                new Digitizing::Paddle(this->BuildChannel(), this->BuildChannel()));
+        }
+        if (!paddleInUse[paddle_id])
         {
-            paddles[paddle_id] =
-                std::unique_ptr<Digitizing::Paddle>(new Digitizing::Paddle(this->BuildChannel(), this->BuildChannel()));
+            paddleInUse[paddle_id] = true;
+            if (!usedPaddles.empty() && usedPaddles.back().first > paddle_id)
+            {
+                usedPaddlesSorted = false;
+            }
+            usedPaddles.emplace_back(paddle_id, paddle.get());
         }
-        paddles.at(paddle_id)->DepositLight(time, light, dist);
+        paddle->DepositLight(time, light, dist);
     }
 
-    Double_t DigitizingEngine::GetTriggerTime() const
+    Double_t DigitizingEngine::GetTriggerTime()
     {
+        StartEvent();
+        SortUsedPaddles();
         Double_t triggerTime = 1e100;
-        for (const auto& kv : paddles)
+        for (const auto& kv : usedPaddles)
         {
             const auto& paddle = kv.second;
 
@@ -93,9 +122,37 @@ namespace Neuland
         return triggerTime;
     }
 
-    std::map<Int_t, std::unique_ptr<Digitizing::Paddle>> DigitizingEngine::ExtractPaddles()
+    const DigitizingEngine::PaddleList& DigitizingEngine::ExtractPaddles()
     {
-        return std::move(paddles);
+        StartEvent();
+        SortUsedPaddles();
+        eventDone = true;
+        return usedPaddles;
+    }
+
+    void DigitizingEngine::StartEvent()
+    {
+        if (!eventDone)
+        {
+            return;
+        }
+        for (const auto& kv : usedPaddles)
+        {
+            paddles[kv.first]->Clear();
+            paddleInUse[kv.first] = false;
+        }
+        usedPaddles.clear();
+        usedPaddlesSorted = true;
+        eventDone = false;
+    }
+
+    void DigitizingEngine::SortUsedPaddles()
+    {
+        if (!usedPaddlesSorted)
+        {
+            std::sort(usedPaddles.begin(), usedPaddles.end());
+            usedPaddlesSorted = true;
+        }
     }
 
 } // namespace Neuland
@@ -15,8 +15,8 @@
 #define NEULAND_DIGITIZING_ENGINE_H
 
 #include "Rtypes.h"
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace Neuland
@@ -43,9 +43,12 @@ namespace Neuland
             virtual Double_t GetQDC() const = 0;
             virtual Double_t GetTDC() const = 0;
             virtual Double_t GetEnergy() const = 0;
+            // Remove all hits, keeping the allocated memory for the next event
+            virtual void Clear() { fPMTHits.clear(); }
 
           protected:
-            std::vector<PMTHit> fPMTHits;
+            // Hits are appended unsorted, derived classes sort them once when needed
+            mutable std::vector<PMTHit> fPMTHits;
         };
 
         class Paddle
@@ -53,6 +56,7 @@ namespace Neuland
           public:
             Paddle(std::unique_ptr<Channel> l, std::unique_ptr<Channel> r);
             void DepositLight(Double_t time, Double_t light, Double_t dist);
+            void Clear();
 
             bool HasFired() const;
             bool HasHalfFired() const;
@@ -82,12 +86,24 @@ namespace Neuland
         virtual ~DigitizingEngine() = default; // FIXME: Root doesn't like pure virtual destructors (= 0;)
         virtual std::unique_ptr<Digitizing::Channel> BuildChannel() = 0;
 
+        using PaddleList = std::vector<std::pair<Int_t, const Digitizing::Paddle*>>;
+
         void DepositLight(Int_t paddle_id, Double_t time, Double_t light, Double_t dist);
-        Double_t GetTriggerTime() const;
-        std::map<Int_t, std::unique_ptr<Digitizing::Paddle>> ExtractPaddles();
+        Double_t GetTriggerTime();
+        // Paddles with light in this event, sorted by paddle id. They stay valid until the next call of
+        // DepositLight, GetTriggerTime or ExtractPaddles, which then start the next event.
+        const PaddleList& ExtractPaddles();
 
       protected:
-        std::map<Int_t, std::unique_ptr<Digitizing::Paddle>> paddles;
+        void StartEvent();
+        void SortUsedPaddles();
+
+        // Paddles are kept and reused in all events, indexed by paddle id
+        std::vector<std::unique_ptr<Digitizing::Paddle>> paddles;
+        std::vector<bool> paddleInUse;
+        PaddleList usedPaddles;
+        bool usedPaddlesSorted = true;
+        bool eventDone = false;
     };
 } // namespace Neuland
 
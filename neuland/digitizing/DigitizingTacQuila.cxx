@@ -39,17 +39,26 @@ namespace Neuland
 
         void Channel::AddHit(const Double_t mcTime, const Double_t mcLight, const Double_t dist)
         {
+            // NOTE: The hits are only sorted once in HasFired, after all hits of the event have been added
             fPMTHits.emplace_back(mcTime, mcLight, dist);
-            // NOTE: Sorting after every hit may not be efficient, but this way
-            // FindThresholdExeeding hit can be made const
-            std::sort(fPMTHits.begin(), fPMTHits.end());
             cachedFirstHitOverThresh.invalidate();
         }
 
+        void Channel::Clear()
+        {
+            Digitizing::Channel::Clear();
+            cachedFirstHitOverThresh.invalidate();
+            cachedQDC.invalidate();
+            cachedTDC.invalidate();
+            cachedEnergy.invalidate();
+        }
+
         bool Channel::HasFired() const
         {
             if (!cachedFirstHitOverThresh.valid())
             {
+                // Hits with equal times keep the order they were added in, which decides the QDC window
+                std::stable_sort(fPMTHits.begin(), fPMTHits.end());
                 cachedFirstHitOverThresh.set(FindThresholdExceedingHit());
                 cachedQDC.invalidate();
                 cachedTDC.invalidate();
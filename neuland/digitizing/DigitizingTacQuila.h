@@ -45,6 +45,7 @@ namespace Neuland
             Double_t GetQDC() const override;
             Double_t GetTDC() const override;
             Double_t GetEnergy() const override;
+            void Clear() override;
 
           private:
             // NOTE: Some expensive calculations and random distributions are cached
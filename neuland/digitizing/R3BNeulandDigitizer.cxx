@@ -87,14 +87,14 @@ void R3BNeulandDigitizer::Exec(Option_t*)
 
     std::map<UInt_t, Double_t> paddleEnergyDeposit;
     // Look at each Land Point, if it deposited energy in the scintillator, store it with reference to the bar
-    for (const auto& point : fPoints.Retrieve())
+    for (const auto& point : fPoints.View())
     {
-        if (point->GetEnergyLoss() > 0.)
+        if (point.GetEnergyLoss() > 0.)
         {
-            const Int_t paddleID = point->GetPaddle();
+            const Int_t paddleID = point.GetPaddle();
 
             // Convert position of point to paddle-coordinates, including any rotation or translation
-            const TVector3 position = point->GetPosition();
+            const TVector3 position = point.GetPosition();
             const TVector3 converted_position = fNeulandGeoPar->ConvertToLocalCoordinates(position, paddleID);
             LOG(DEBUG) << "NeulandDigitizer: Point in paddle " << paddleID
                        << " with global position XYZ: " << position.X() << " " << position.Y() << " " << position.Z();
@@ -104,24 +104,24 @@ void R3BNeulandDigitizer::Exec(Option_t*)
             // Within the paddle frame, the relevant distance of the light from the pmt is always given by the
             // X-Coordinate
             const Double_t dist = converted_position.X();
-            fDigitizingEngine->DepositLight(paddleID, point->GetTime(), point->GetLightYield() * 1000., dist);
-            paddleEnergyDeposit[paddleID] += point->GetEnergyLoss() * 1000;
+            fDigitizingEngine->DepositLight(paddleID, point.GetTime(), point.GetLightYield() * 1000., dist);
+            paddleEnergyDeposit[paddleID] += point.GetEnergyLoss() * 1000;
         } // eloss
     }     // points
 
     const Double_t triggerTime = fDigitizingEngine->GetTriggerTime();
-    const auto paddles = fDigitizingEngine->ExtractPaddles();
+    const auto& paddles = fDigitizingEngine->ExtractPaddles();
 
     // Fill control histograms
     hMultOne->Fill(std::count_if(paddles.begin(),
                                  paddles.end(),
-                                 [](const std::pair<const Int_t, std::unique_ptr<Neuland::Digitizing::Paddle>>& kv) {
+                                 [](const std::pair<Int_t, const Neuland::Digitizing::Paddle*>& kv) {
                                      return kv.second->HasHalfFired();
                                  }));
 
     hMultTwo->Fill(std::count_if(paddles.begin(),
                                  paddles.end(),
-                                 [](const std::pair<const Int_t, std::unique_ptr<Neuland::Digitizing::Paddle>>& kv) {
+                                 [](const std::pair<Int_t, const Neuland::Digitizing::Paddle*>& kv) {
                                      return kv.second->HasFired();
                                  }));
 
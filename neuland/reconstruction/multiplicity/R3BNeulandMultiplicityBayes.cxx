@@ -56,7 +56,7 @@ void R3BNeulandMultiplicityBayes::SetParContainers()
 
 void R3BNeulandMultiplicityBayes::Exec(Option_t*)
 {
-    const auto clusters = fClusters.Retrieve();
+    const auto clusters = fClusters.View();
     const int nClusters = clusters.size();
 
     if (nClusters == 0)
@@ -67,9 +67,9 @@ void R3BNeulandMultiplicityBayes::Exec(Option_t*)
     }
 
     const int nHits = std::accumulate(
-        clusters.cbegin(), clusters.cend(), 0, [](size_t s, const R3BNeulandCluster* c) { return s + c->GetSize(); });
+        clusters.begin(), clusters.end(), 0, [](size_t s, const R3BNeulandCluster& c) { return s + c.GetSize(); });
     const int Edep = (int)std::accumulate(
-        clusters.cbegin(), clusters.cend(), 0., [](Double_t s, const R3BNeulandCluster* c) { return s + c->GetE(); });
+        clusters.begin(), clusters.end(), 0., [](Double_t s, const R3BNeulandCluster& c) { return s + c.GetE(); });
 
     fMultiplicity->m = fPar->GetProbabilities(nHits, nClusters, Edep);
 }
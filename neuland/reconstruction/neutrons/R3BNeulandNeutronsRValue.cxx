@@ -36,7 +36,13 @@ void R3BNeulandNeutronsRValue::Exec(Option_t*)
 {
     fNeutrons.Reset();
 
-    auto clusters = fClusters.Retrieve();
+    // Only pointers are sorted, the buffer is kept between events
+    auto& clusters = fSelectedClusters;
+    clusters.clear();
+    for (const auto& cluster : fClusters.View())
+    {
+        clusters.push_back(&cluster);
+    }
 
     // Recreate R3BNeutronTracker2D Advanced Method
     // FilterClustersByElasticScattering(clusters); // Check all pairs of clusters. Remove clusters from elastic
@@ -47,18 +53,29 @@ void R3BNeulandNeutronsRValue::Exec(Option_t*)
     const auto mult = fMultiplicity->GetMultiplicity();
     for (size_t n = 0; n < clusters.size() && n < mult; n++)
     {
-        fNeutrons.Insert(R3BNeulandNeutron(*clusters.at(n)));
+        fNeutrons.Emplace(*clusters[n]);
     }
 }
 
-void R3BNeulandNeutronsRValue::SortClustersByRValue(std::vector<R3BNeulandCluster*>& clusters) const
+void R3BNeulandNeutronsRValue::SortClustersByRValue(std::vector<const R3BNeulandCluster*>& clusters)
 {
-    std::sort(clusters.begin(), clusters.end(), [&](const R3BNeulandCluster* a, const R3BNeulandCluster* b) {
-        return a->GetRECluster(fEkinRefMeV) < b->GetRECluster(fEkinRefMeV);
-    });
+    // Compute the R-value of each cluster once instead of in every comparison
+    fRankedClusters.clear();
+    for (const auto cluster : clusters)
+    {
+        fRankedClusters.emplace_back(cluster->GetRECluster(fEkinRefMeV), cluster);
+    }
+    std::sort(fRankedClusters.begin(),
+              fRankedClusters.end(),
+              [](const std::pair<Double_t, const R3BNeulandCluster*>& a,
+                 const std::pair<Double_t, const R3BNeulandCluster*>& b) { return a.first < b.first; });
+    for (size_t i = 0; i < clusters.size(); i++)
+    {
+        clusters[i] = fRankedClusters[i].second;
+    }
 }
 
-void R3BNeulandNeutronsRValue::PrioritizeTimeWiseFirstCluster(std::vector<R3BNeulandCluster*>& clusters) const
+void R3BNeulandNeutronsRValue::PrioritizeTimeWiseFirstCluster(std::vector<const R3BNeulandCluster*>& clusters) const
 {
     auto timewiseFirstCluster =
         std::min_element(clusters.begin(), clusters.end(), [](const R3BNeulandCluster* a, const R3BNeulandCluster* b) {
@@ -68,14 +85,14 @@ void R3BNeulandNeutronsRValue::PrioritizeTimeWiseFirstCluster(std::vector<R3BNeu
     std::rotate(clusters.begin(), timewiseFirstCluster, timewiseFirstCluster + 1);
 }
 
-void R3BNeulandNeutronsRValue::FilterClustersByEnergyDeposit(std::vector<R3BNeulandCluster*>& clusters) const
+void R3BNeulandNeutronsRValue::FilterClustersByEnergyDeposit(std::vector<const R3BNeulandCluster*>& clusters) const
 {
     clusters.erase(
         std::remove_if(clusters.begin(), clusters.end(), [&](const R3BNeulandCluster* a) { return a->GetE() < 2.5; }),
         clusters.end());
 }
 
-void R3BNeulandNeutronsRValue::FilterClustersByKineticEnergy(std::vector<R3BNeulandCluster*>& clusters) const
+void R3BNeulandNeutronsRValue::FilterClustersByKineticEnergy(std::vector<const R3BNeulandCluster*>& clusters) const
 {
     clusters.erase(std::remove_if(clusters.begin(),
                                   clusters.end(),
@@ -85,7 +102,7 @@ void R3BNeulandNeutronsRValue::FilterClustersByKineticEnergy(std::vector<R3BNeul
                    clusters.end());
 }
 
-void R3BNeulandNeutronsRValue::FilterClustersByElasticScattering(std::vector<R3BNeulandCluster*>& clusters) const
+void R3BNeulandNeutronsRValue::FilterClustersByElasticScattering(std::vector<const R3BNeulandCluster*>& clusters) const
 {
     std::map<const R3BNeulandCluster*, bool> marked;
 
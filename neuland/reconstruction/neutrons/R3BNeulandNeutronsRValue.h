@@ -6,6 +6,8 @@
 #include "R3BNeulandMultiplicity.h"
 #include "R3BNeulandNeutron.h"
 #include "TCAConnector.h"
+#include <utility>
+#include <vector>
 
 class R3BNeulandNeutronsRValue : public FairTask
 {
@@ -23,15 +25,17 @@ class R3BNeulandNeutronsRValue : public FairTask
   private:
     const double fEkinRefMeV;
     const TString fInputMultName;
-    const R3BNeulandMultiplicity* fMultiplicity;     //!
-    TCAInputConnector<R3BNeulandCluster> fClusters;  //!
-    TCAOutputConnector<R3BNeulandNeutron> fNeutrons; //!
+    const R3BNeulandMultiplicity* fMultiplicity;                                //!
+    TCAInputConnector<R3BNeulandCluster> fClusters;                             //!
+    TCAOutputConnector<R3BNeulandNeutron> fNeutrons;                            //!
+    std::vector<const R3BNeulandCluster*> fSelectedClusters;                    //!
+    std::vector<std::pair<Double_t, const R3BNeulandCluster*>> fRankedClusters; //!
 
-    void SortClustersByRValue(std::vector<R3BNeulandCluster*>&) const;
-    void PrioritizeTimeWiseFirstCluster(std::vector<R3BNeulandCluster*>&) const;
-    void FilterClustersByEnergyDeposit(std::vector<R3BNeulandCluster*>&) const;
-    void FilterClustersByKineticEnergy(std::vector<R3BNeulandCluster*>&) const;
-    void FilterClustersByElasticScattering(std::vector<R3BNeulandCluster*>&) const;
+    void SortClustersByRValue(std::vector<const R3BNeulandCluster*>&);
+    void PrioritizeTimeWiseFirstCluster(std::vector<const R3BNeulandCluster*>&) const;
+    void FilterClustersByEnergyDeposit(std::vector<const R3BNeulandCluster*>&) const;
+    void FilterClustersByKineticEnergy(std::vector<const R3BNeulandCluster*>&) const;
+    void FilterClustersByElasticScattering(std::vector<const R3BNeulandCluster*>&) const;
 
     ClassDefOverride(R3BNeulandNeutronsRValue, 0)
 };
@@ -0,0 +1,207 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef NEULANDGRIDCLUSTERINGENGINEH
+#define NEULANDGRIDCLUSTERINGENGINEH
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace Neuland
+{
+
+    /* Clusters objects with a box-shaped clustering condition: Two objects belong to the same cluster if each of their
+     * coordinates (e.g. x, y, z, t) differs by less than the maximum distance, or if they are connected through other
+     * objects of the cluster. This gives the same clusters as ClusteringEngine with the corresponding condition, but
+     * instead of comparing every object with all the remaining ones, the objects are sorted into a grid of the last two
+     * coordinates (e.g. plane and time) with the maximum distances as cell size. Only objects in neighboring cells are
+     * compared. Objects with a non-finite value in one of these coordinates are never close to another object and
+     * form a cluster of their own.
+     * The clusters are ordered by their first object in the input, the objects of a cluster are in the order they
+     * were found starting from this first object. */
+    template <typename T>
+    class GridClusteringEngine
+    {
+      public:
+        static constexpr size_t NDim = 4;
+        using Coordinates = std::array<double, NDim>;
+        using CoordinateFunction = std::function<Coordinates(const T&)>;
+
+      private:
+        // Grid cell of the last two coordinates, packed such that the cells along the last coordinate are adjacent
+        struct Entry
+        {
+            uint64_t cell;
+            size_t index;
+            bool operator<(const Entry& rhs) const
+            {
+                return cell < rhs.cell || (cell == rhs.cell && index < rhs.index);
+            }
+        };
+
+        CoordinateFunction c;
+        Coordinates maxDistance;
+
+        // Buffers reused for every call of Clusterize
+        mutable std::vector<Coordinates> coordinates;
+        mutable std::vector<Entry> grid;
+        mutable std::vector<bool> clustered;
+        mutable std::vector<size_t> members;
+
+        bool IsClose(const Coordinates& a, const Coordinates& b) const
+        {
+            for (size_t d = 0; d < NDim; d++)
+            {
+                if (!(std::abs(a[d] - b[d]) < maxDistance[d]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Largest cell index, such that the neighbors of all cells still fit into the 32 bits of Pack
+        static constexpr int64_t MaxCell = (int64_t(1) << 31) - 2;
+
+        static uint64_t Pack(const int64_t outer, const int64_t inner)
+        {
+            return (uint64_t(outer + (int64_t(1) << 31)) << 32) | uint64_t(inner + (int64_t(1) << 31));
+        }
+
+        static bool IsInGrid(const Coordinates& a)
+        {
+            return std::isfinite(a[NDim - 2]) && std::isfinite(a[NDim - 1]);
+        }
+
+        /* Cells beyond MaxCell are merged into the outermost cell. Objects close to each other still end up in the
+         * same or neighboring cells, only the outermost cell is searched pairwise. */
+        int64_t GetCell(const Coordinates& a, const size_t d) const
+        {
+            const double cell = std::floor(a[d] / maxDistance[d]);
+            return (int64_t)std::max(double(-MaxCell), std::min(double(MaxCell), cell));
+        }
+
+        /* Adds all objects close to the object i that are not yet part of a cluster to members. Close objects are at
+         * most one cell away in each direction, the three cells next to each other along the last coordinate form one
+         * range in the sorted grid. */
+        void AddNeighbors(const size_t i) const
+        {
+            const int64_t outer = GetCell(coordinates[i], NDim - 2);
+            const int64_t inner = GetCell(coordinates[i], NDim - 1);
+            for (int64_t o = outer - 1; o <= outer + 1; o++)
+            {
+                const uint64_t last = Pack(o, inner + 1);
+                for (auto it = std::lower_bound(grid.begin(), grid.end(), Entry{ Pack(o, inner - 1), 0 });
+                     it != grid.end() && it->cell <= last;
+                     it++)
+                {
+                    if (!clustered[it->index] && IsClose(coordinates[i], coordinates[it->index]))
+                    {
+                        clustered[it->index] = true;
+                        members.push_back(it->index);
+                    }
+                }
+            }
+        }
+
+      public:
+        /* Default Constructor. Note: If the coordinates are not set, a "bad_function_call" will be thrown upon calling
+         * clusterize. */
+        GridClusteringEngine()
+            : maxDistance{}
+        {
+        }
+        GridClusteringEngine(const CoordinateFunction& _c, const Coordinates& _maxDistance)
+            : c(_c)
+            , maxDistance(_maxDistance)
+        {
+        }
+
+        void SetCoordinates(const CoordinateFunction& _c) { c = _c; }
+        void SetMaxDistance(const Coordinates& _maxDistance) { maxDistance = _maxDistance; }
+
+        bool SatisfiesClusteringCondition(const T& a, const T& b) const { return IsClose(c(a), c(b)); }
+
+        /* Calls f(indices) for each cluster, with the indices of its objects in from. Works on any container with
+         * size() and operator[], e.g. a TCAView, so the objects do not need to be copied first. */
+        template <typename Container, typename Function>
+        void Clusterize(const Container& from, Function f) const
+        {
+            for (size_t d = 0; d < NDim; d++)
+            {
+                if (!(maxDistance[d] > 0.))
+                {
+                    throw std::invalid_argument("GridClusteringEngine: Maximum distances must be positive");
+                }
+            }
+
+            const size_t n = from.size();
+            coordinates.resize(n);
+            grid.clear();
+            for (size_t i = 0; i < n; i++)
+            {
+                coordinates[i] = c(from[i]);
+                if (IsInGrid(coordinates[i]))
+                {
+                    grid.push_back(
+                        Entry{ Pack(GetCell(coordinates[i], NDim - 2), GetCell(coordinates[i], NDim - 1)), i });
+                }
+            }
+            std::sort(grid.begin(), grid.end());
+            clustered.assign(n, false);
+
+            for (size_t seed = 0; seed < n; seed++)
+            {
+                if (clustered[seed])
+                {
+                    continue;
+                }
+                clustered[seed] = true;
+                members.clear();
+                members.push_back(seed);
+                // members grows while new neighbors are found, objects outside the grid have none
+                if (IsInGrid(coordinates[seed]))
+                {
+                    for (size_t m = 0; m < members.size(); m++)
+                    {
+                        AddNeighbors(members[m]);
+                    }
+                }
+                f(static_cast<const std::vector<size_t>&>(members));
+            }
+        }
+
+        std::vector<std::vector<T>> Clusterize(std::vector<T>& from) const
+        {
+            std::vector<std::vector<T>> out;
+            Clusterize(from, [&](const std::vector<size_t>& indices) {
+                std::vector<T> cluster;
+                cluster.reserve(indices.size());
+                for (const auto i : indices)
+                {
+                    cluster.push_back(std::move(from[i]));
+                }
+                out.push_back(std::move(cluster));
+            });
+            return out;
+        }
+    };
+
+}; // namespace Neuland
+
+#endif // NEULANDGRIDCLUSTERINGENGINEH
@@ -17,10 +17,102 @@
 #include "FairRootManager.h"
 #include "TClonesArray.h"
 #include "TString.h"
+#include <cstddef>
 #include <exception>
+#include <iterator>
 #include <utility>
 #include <vector>
 
+/* Non-owning view of the objects in a TClonesArray, without copying them. The pointers to the objects are stored
+ * contiguously in the TClonesArray, the view iterates over them and hands out references to the objects.
+ * A view is only valid until the TClonesArray is modified, i.e. usually until the end of the event. */
+template <typename T>
+class TCAView
+{
+  public:
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator()
+            : fPos(nullptr)
+        {
+        }
+        explicit const_iterator(TObject* const* pos)
+            : fPos(pos)
+        {
+        }
+
+        reference operator*() const { return *static_cast<const T*>(*fPos); }
+        pointer operator->() const { return static_cast<const T*>(*fPos); }
+        reference operator[](difference_type n) const { return *static_cast<const T*>(fPos[n]); }
+
+        const_iterator& operator++()
+        {
+            ++fPos;
+            return *this;
+        }
+        const_iterator operator++(int) { return const_iterator(fPos++); }
+        const_iterator& operator--()
+        {
+            --fPos;
+            return *this;
+        }
+        const_iterator operator--(int) { return const_iterator(fPos--); }
+        const_iterator& operator+=(difference_type n)
+        {
+            fPos += n;
+            return *this;
+        }
+        const_iterator& operator-=(difference_type n)
+        {
+            fPos -= n;
+            return *this;
+        }
+        const_iterator operator+(difference_type n) const { return const_iterator(fPos + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(fPos - n); }
+        difference_type operator-(const const_iterator& rhs) const { return fPos - rhs.fPos; }
+
+        bool operator==(const const_iterator& rhs) const { return fPos == rhs.fPos; }
+        bool operator!=(const const_iterator& rhs) const { return fPos != rhs.fPos; }
+        bool operator<(const const_iterator& rhs) const { return fPos < rhs.fPos; }
+        bool operator>(const const_iterator& rhs) const { return fPos > rhs.fPos; }
+        bool operator<=(const const_iterator& rhs) const { return fPos <= rhs.fPos; }
+        bool operator>=(const const_iterator& rhs) const { return fPos >= rhs.fPos; }
+
+      private:
+        TObject* const* fPos;
+    };
+
+    TCAView()
+        : fBegin(nullptr)
+        , fSize(0)
+    {
+    }
+    explicit TCAView(const TClonesArray* tca)
+        : fBegin(tca == nullptr ? nullptr : tca->GetObjectRef())
+        , fSize(tca == nullptr ? 0 : tca->GetEntriesFast())
+    {
+    }
+
+    size_t size() const { return fSize; }
+    bool empty() const { return fSize == 0; }
+    const T& operator[](size_t i) const { return *static_cast<const T*>(fBegin[i]); }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[fSize - 1]; }
+    const_iterator begin() const { return const_iterator(fBegin); }
+    const_iterator end() const { return const_iterator(fBegin + fSize); }
+
+  private:
+    TObject* const* fBegin;
+    size_t fSize;
+};
+
 template <typename T>
 class TCAInputConnector
 {
@@ -77,6 +169,17 @@ class TCAInputConnector
         return fV;
     }
 
+    // Access the objects without copying them, see TCAView
+    TCAView<T> View() const
+    {
+        if (fTCA == nullptr)
+        {
+            throw std::runtime_error(
+                ("TCAInputConnector: TClonesArray " + fBranchName + " of " + fClassName + "s not available").Data());
+        }
+        return TCAView<T>(fTCA);
+    }
+
     std::vector<T> RetrieveObjects() const
     {
         std::vector<T> fV;
@@ -145,6 +248,9 @@ class TCAOptionalInputConnector
         return fV;
     }
 
+    // Access the objects without copying them, see TCAView. Empty if the branch is not available
+    TCAView<T> View() const { return TCAView<T>(fTCA); }
+
     std::vector<T> RetrieveObjects() const
     {
         std::vector<T> fV;
@@ -196,6 +302,18 @@ class TCAOutputConnector
         }
     }
 
+    // Write into an existing TClonesArray instead of one registered with the FairRootManager
+    void Init(TClonesArray* tca)
+    {
+        if (tca == nullptr || !TString(tca->GetClass()->GetName()).EqualTo(fClassName))
+        {
+            throw std::runtime_error(
+                ("TCAOutputConnector: TClonesArray " + fBranchName + " does not contain elements of type " + fClassName)
+                    .Data());
+        }
+        fTCA = tca;
+    }
+
     void Reset()
     {
         if (fTCA == nullptr)
@@ -216,6 +334,30 @@ class TCAOutputConnector
         return fTCA->GetEntries();
     }
 
+    // Construct a new object directly in the TClonesArray
+    template <typename... Args>
+    T& Emplace(Args&&... args)
+    {
+        if (fTCA == nullptr)
+        {
+            throw std::runtime_error(
+                ("TCAOutputConnector: TClonesArray " + fBranchName + " of " + fClassName + "s not available").Data());
+        }
+        return *new ((*fTCA)[fTCA->GetEntriesFast()]) T(std::forward<Args>(args)...);
+    }
+
+    /* Append an object that is reused from a previous event if possible. It is in the state left by its Clear("C")
+     * method (called by Reset), so memory held by its members can be recycled instead of allocated again. */
+    T& Recycle()
+    {
+        if (fTCA == nullptr)
+        {
+            throw std::runtime_error(
+                ("TCAOutputConnector: TClonesArray " + fBranchName + " of " + fClassName + "s not available").Data());
+        }
+        return *static_cast<T*>(fTCA->ConstructedAt(fTCA->GetEntriesFast()));
+    }
+
     void Insert(T t)
     {
         if (fTCA == nullptr)
@@ -0,0 +1,132 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Clusters random NeuLAND-like events with the condition of R3BNeulandClusterFinder, using ClusteringEngine and
+// GridClusteringEngine, and compares speed and results.
+// Usage: benchClusteringEngine [number of events per multiplicity, default 100]
+
+#include "ClusteringEngine.h"
+#include "GridClusteringEngine.h"
+#include "R3BNeulandHit.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Double_t gDx = 7.5;
+    const Double_t gDy = 7.5;
+    const Double_t gDz = 15.;
+    const Double_t gDt = 1.;
+
+    // Hits in 30 double planes of 50 paddles, grouped in showers around a few tracks
+    std::vector<R3BNeulandHit> MakeEvent(const Int_t nHits, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<Double_t> uniform(0., 1.);
+        std::normal_distribution<Double_t> spread(0., 10.);
+        std::vector<R3BNeulandHit> hits;
+        hits.reserve(nHits);
+        const Int_t nTracks = 1 + nHits / 20;
+        for (Int_t i = 0; i < nHits; i++)
+        {
+            std::mt19937 track(rng() % nTracks);
+            const Double_t x0 = 250. * uniform(track) - 125.;
+            const Double_t y0 = 250. * uniform(track) - 125.;
+            const Double_t t0 = 60. + 20. * uniform(track);
+            const Int_t plane = rng() % 60;
+            const Int_t bar = std::min(49, std::max(0, Int_t((y0 + spread(rng) + 125.) / 5.)));
+            const Double_t z = 1400. + 5. * plane + 2.5;
+            const Double_t t = t0 + z / 30. + 0.3 * spread(rng) / 10.;
+            const Double_t along = x0 + spread(rng);
+            const Double_t across = -122.5 + 5. * bar;
+            const TVector3 pos = (plane % 2) ? TVector3(across, along, z) : TVector3(along, across, z);
+            hits.emplace_back(plane * 50 + bar + 1, t, t, t, 10., 10., 10., pos, pos);
+        }
+        return hits;
+    }
+
+    std::vector<std::vector<Int_t>> Canonical(const std::vector<std::vector<R3BNeulandHit>>& clusters)
+    {
+        std::vector<std::vector<Int_t>> ids;
+        for (const auto& cluster : clusters)
+        {
+            std::vector<Int_t> c;
+            for (const auto& hit : cluster)
+            {
+                c.push_back(hit.GetPaddle() * 1000 + Int_t(hit.GetT()));
+            }
+            std::sort(c.begin(), c.end());
+            ids.push_back(c);
+        }
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Int_t nEvents = argc > 1 ? atoi(argv[1]) : 100;
+
+    Neuland::ClusteringEngine<R3BNeulandHit> reference([](const R3BNeulandHit& a, const R3BNeulandHit& b) {
+        return std::abs(a.GetPosition().X() - b.GetPosition().X()) < gDx &&
+               std::abs(a.GetPosition().Y() - b.GetPosition().Y()) < gDy &&
+               std::abs(a.GetPosition().Z() - b.GetPosition().Z()) < gDz && std::abs(a.GetT() - b.GetT()) < gDt;
+    });
+    Neuland::GridClusteringEngine<R3BNeulandHit> grid(
+        [](const R3BNeulandHit& h) {
+            const TVector3 pos = h.GetPosition();
+            return Neuland::GridClusteringEngine<R3BNeulandHit>::Coordinates{ pos.X(), pos.Y(), pos.Z(), h.GetT() };
+        },
+        { gDx, gDy, gDz, gDt });
+
+    Int_t nDiff = 0;
+    for (const Int_t nHits : { 10, 50, 200, 1000, 3000 })
+    {
+        std::mt19937 rng(nHits);
+        std::vector<std::vector<R3BNeulandHit>> events;
+        for (Int_t i = 0; i < nEvents; i++)
+        {
+            events.push_back(MakeEvent(nHits, rng));
+        }
+
+        Double_t tReference = 0.;
+        Double_t tGrid = 0.;
+        Long64_t nClusters = 0;
+        for (const auto& event : events)
+        {
+            auto a = event;
+            auto start = std::chrono::steady_clock::now();
+            const auto expected = reference.Clusterize(a);
+            auto stop = std::chrono::steady_clock::now();
+            tReference += std::chrono::duration<Double_t>(stop - start).count();
+
+            auto b = event;
+            start = std::chrono::steady_clock::now();
+            const auto clusters = grid.Clusterize(b);
+            stop = std::chrono::steady_clock::now();
+            tGrid += std::chrono::duration<Double_t>(stop - start).count();
+
+            nClusters += clusters.size();
+            nDiff += Canonical(clusters) != Canonical(expected);
+        }
+
+        std::cout << nHits << " hits, " << Double_t(nClusters) / nEvents << " clusters: ClusteringEngine "
+                  << 1e6 * tReference / nEvents << " us/event, GridClusteringEngine " << 1e6 * tGrid / nEvents
+                  << " us/event, speedup " << tReference / tGrid << std::endl;
+    }
+    std::cout << nDiff << " events with different clusters" << std::endl;
+    return nDiff == 0 ? 0 : 1;
+}
@@ -12,7 +12,12 @@
  ******************************************************************************/
 
 #include "ClusteringEngine.h"
+#include "GridClusteringEngine.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
 #include <stdexcept>
 #include <vector>
 
@@ -73,6 +78,144 @@ namespace
         EXPECT_FALSE(clusterer.SatisfiesClusteringCondition(1, 3));
     }
 
+    struct DummyHit
+    {
+        int id;
+        double x, y, z, t;
+        bool operator==(const DummyHit& rhs) const { return id == rhs.id; }
+        bool operator<(const DummyHit& rhs) const { return id < rhs.id; }
+    };
+
+    // Clusters as sets, independent of the order of the clusters and of the hits in them
+    std::vector<std::vector<DummyHit>> Canonical(std::vector<std::vector<DummyHit>> clusters)
+    {
+        for (auto& cluster : clusters)
+        {
+            std::sort(cluster.begin(), cluster.end());
+        }
+        std::sort(clusters.begin(), clusters.end());
+        return clusters;
+    }
+
+    TEST(testGridClusteringEngine, same_clusters_as_ClusteringEngine)
+    {
+        const double dx = 7.5, dy = 7.5, dz = 15., dt = 1.;
+        auto reference = Neuland::ClusteringEngine<DummyHit>([=](const DummyHit& a, const DummyHit& b) {
+            return std::abs(a.x - b.x) < dx && std::abs(a.y - b.y) < dy && std::abs(a.z - b.z) < dz &&
+                   std::abs(a.t - b.t) < dt;
+        });
+        auto clusterer = Neuland::GridClusteringEngine<DummyHit>(
+            [](const DummyHit& h) {
+                return Neuland::GridClusteringEngine<DummyHit>::Coordinates{ h.x, h.y, h.z, h.t };
+            },
+            { dx, dy, dz, dt });
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> pos(-125., 125.);
+        std::uniform_real_distribution<double> time(0., 30.);
+        for (int event = 0; event < 200; event++)
+        {
+            // Hits on the paddle grid, on cell boundaries and at exactly the maximum distance included
+            std::vector<DummyHit> hits;
+            const int n = rng() % 300;
+            for (int i = 0; i < n; i++)
+            {
+                const double z = 1400. + 5. * (rng() % 60);
+                const double paddle = -123.75 + 5. * (rng() % 50);
+                const double t = (rng() % 4 == 0) ? double(rng() % 30) : time(rng);
+                const double along = pos(rng);
+                hits.push_back((rng() % 2) ? DummyHit{ i, along, paddle, z, t } : DummyHit{ i, paddle, along, z, t });
+            }
+
+            auto copy = hits;
+            auto expected = Canonical(reference.Clusterize(copy));
+            auto clusters = Canonical(clusterer.Clusterize(hits));
+            EXPECT_EQ(clusters, expected) << "event " << event;
+        }
+    }
+
+    TEST(testGridClusteringEngine, cluster_order)
+    {
+        auto clusterer = Neuland::GridClusteringEngine<DummyHit>(
+            [](const DummyHit& h) {
+                return Neuland::GridClusteringEngine<DummyHit>::Coordinates{ h.x, h.y, h.z, h.t };
+            },
+            { 1., 1., 1., 1. });
+
+        std::vector<DummyHit> hits{ { 0, 5., 0., 0., 0. },
+                                    { 1, 0., 0., 0., 0. },
+                                    { 2, 5.5, 0., 0., 0. },
+                                    { 3, 0.5, 0., 0., 0. },
+                                    { 4, 6., 0., 0., 2. } };
+        auto clusters = clusterer.Clusterize(hits);
+
+        std::vector<std::vector<DummyHit>> expected{ { { 0, 5., 0., 0., 0. }, { 2, 5.5, 0., 0., 0. } },
+                                                     { { 1, 0., 0., 0., 0. }, { 3, 0.5, 0., 0., 0. } },
+                                                     { { 4, 6., 0., 0., 2. } } };
+        EXPECT_EQ(clusters, expected);
+    }
+
+    TEST(testGridClusteringEngine, non_finite_and_far_out_coordinates)
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double inf = std::numeric_limits<double>::infinity();
+        auto reference = Neuland::ClusteringEngine<DummyHit>([](const DummyHit& a, const DummyHit& b) {
+            return std::abs(a.x - b.x) < 1. && std::abs(a.y - b.y) < 1. && std::abs(a.z - b.z) < 1. &&
+                   std::abs(a.t - b.t) < 1.;
+        });
+        auto clusterer = Neuland::GridClusteringEngine<DummyHit>(
+            [](const DummyHit& h) {
+                return Neuland::GridClusteringEngine<DummyHit>::Coordinates{ h.x, h.y, h.z, h.t };
+            },
+            { 1., 1., 1., 1. });
+
+        // Cells beyond 32 bits, in particular at the edges where the neighbor cells would overflow
+        const double edge = double(int64_t(1) << 31);
+        std::vector<DummyHit> hits{ { 0, 0., 0., 0., nan },
+                                    { 1, 0., 0., 0., 0. },
+                                    { 2, 0., 0., 0., 0.5 },
+                                    { 3, 0., 0., 0., inf },
+                                    { 4, 0., 0., 0., -inf },
+                                    { 5, 0., 0., nan, 0.2 },
+                                    { 6, nan, 0., 0., 0.2 },
+                                    { 7, 0., 0., 1e12, 1e12 },
+                                    { 8, 0., 0., 1e12, 1e12 + 0.5 },
+                                    { 9, 0., 0., 1e12, 3e12 },
+                                    { 10, 0., 0., -1e15, -1e15 },
+                                    { 11, 0., 0., -1e15 + 0.5, -1e15 },
+                                    { 12, 0., 0., edge - 1.5, edge - 1.5 },
+                                    { 13, 0., 0., edge - 1.5, edge - 0.8 },
+                                    { 14, 0., 0., edge + 0.1, edge - 0.2 },
+                                    { 15, 0., 0., -edge - 0.5, -edge + 0.5 },
+                                    { 16, 0., 0., -edge - 0.5, -edge - 0.2 } };
+
+        auto copy = hits;
+        auto clusters = clusterer.Clusterize(hits);
+        EXPECT_EQ(Canonical(clusters), Canonical(reference.Clusterize(copy)));
+
+        // Ordered by their first hit
+        std::vector<std::vector<int>> ids;
+        for (const auto& cluster : clusters)
+        {
+            ids.emplace_back();
+            for (const auto& hit : cluster)
+            {
+                ids.back().push_back(hit.id);
+            }
+        }
+        std::vector<std::vector<int>> expected{ { 0 },    { 1, 2 }, { 3 },      { 4 },      { 5 },  { 6 },
+                                                { 7, 8 }, { 9 },    { 10, 11 }, { 12, 13 }, { 14 }, { 15, 16 } };
+        EXPECT_EQ(ids, expected);
+    }
+
+    TEST(testGridClusteringEngine, coordinates_not_set)
+    {
+        auto clusterer = Neuland::GridClusteringEngine<DummyHit>();
+        clusterer.SetMaxDistance({ 1., 1., 1., 1. });
+        std::vector<DummyHit> hits{ { 0, 0., 0., 0., 0. } };
+        EXPECT_ANY_THROW(clusterer.Clusterize(hits));
+    }
+
 } // namespace
 
 int main(int argc, char** argv)
@@ -0,0 +1,187 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "DigitizingTacQuila.h"
+#include "TRandom3.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    // Values of one paddle, index 0 is the left and 1 the right channel
+    struct Reference
+    {
+        Int_t paddle;
+        bool fired[2];
+        Double_t qdc[2];
+        Double_t tdc[2];
+        Double_t energy[2];
+    };
+
+    // Event 1: Paddle 7 gets 20 hits in pairs of equal times, added out of order. Paddle 3 crosses the
+    // threshold on the second of three hits at the same time, its fourth hit is outside the integration
+    // window. Paddle 12 stays below the threshold, paddle 5 only fires on the left.
+    void DepositFirstEvent(Neuland::DigitizingEngine& engine)
+    {
+        for (int i = 0; i < 20; i++)
+        {
+            engine.DepositLight(7, 10. + 1.5 * ((i * 7 % 20) / 2), 0.3, 20.);
+        }
+        engine.DepositLight(3, 30., 0.6, 0.);
+        engine.DepositLight(3, 30., 0.8, 0.);
+        engine.DepositLight(3, 30., 0.5, 0.);
+        engine.DepositLight(3, 450., 0.7, 0.);
+        engine.DepositLight(12, 20., 0.5, 0.);
+        engine.DepositLight(5, 15., 0.9, 50.);
+    }
+
+    // Event 2: Paddle 7 is reused with new hits, paddle 12 fires now, paddles 3 and 5 are not hit
+    void DepositSecondEvent(Neuland::DigitizingEngine& engine)
+    {
+        engine.DepositLight(7, 80., 0.4, -10.);
+        engine.DepositLight(7, 75., 0.7, -10.);
+        engine.DepositLight(7, 75., 0.5, -10.);
+        engine.DepositLight(12, 5., 2.0, 0.);
+    }
+
+    // Obtained from the implementation that sorted the hits in every AddHit and built new paddles for each event
+    const std::vector<Reference> firstEvent = {
+        { 3,
+          { true, true },
+          { 0.44147418333842087, 0.44147418333842087 },
+          { 39.642857142857139, 39.642857142857139 },
+          { 1.3, 1.3 } },
+        { 5, { true, false }, { 0.4559552931290306, 0. }, { 21.071428571428569, -1. }, { 1.3426422278771433, 0. } },
+        { 7,
+          { true, true },
+          { 2.0324471095310228, 0.26044579614514551 },
+          { 19.714285714285715, 33.071428571428569 },
+          { 5.9849054420582348, 0.76692941006959015 } },
+        { 12, { false, false }, { 0., 0. }, { -1., -1. }, { 0., 0. } },
+    };
+    const Double_t firstTrigger = 19.714285714285715;
+
+    const std::vector<Reference> secondEvent = {
+        { 7,
+          { true, true },
+          { 0.28213756279434477, 0.33109149705429808 },
+          { 85.357142857142861, 83.928571428571431 },
+          { 0.83080471174797232, 0.9749583609074628 } },
+        { 12,
+          { true, true },
+          { 0.67919105128987822, 0.67919105128987822 },
+          { 14.642857142857142, 14.642857142857142 },
+          { 2., 2. } },
+    };
+    const Double_t secondTrigger = 14.642857142857142;
+
+    void ExpectPaddles(Neuland::DigitizingEngine& engine, const std::vector<Reference>& expected)
+    {
+        const auto& paddles = engine.ExtractPaddles();
+        ASSERT_EQ(paddles.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            const auto& ref = expected[i];
+            EXPECT_EQ(paddles[i].first, ref.paddle);
+            const auto paddle = paddles[i].second;
+            EXPECT_EQ(paddle->HasFired(), ref.fired[0] && ref.fired[1]);
+            EXPECT_EQ(paddle->HasHalfFired(), ref.fired[0] != ref.fired[1]);
+
+            const Neuland::Digitizing::Channel* channels[2] = { paddle->GetLeftChannel(), paddle->GetRightChannel() };
+            for (int side = 0; side < 2; side++)
+            {
+                EXPECT_EQ(channels[side]->HasFired(), ref.fired[side]) << "paddle " << ref.paddle << " side " << side;
+                EXPECT_NEAR(channels[side]->GetQDC(), ref.qdc[side], 1e-12);
+                EXPECT_NEAR(channels[side]->GetTDC(), ref.tdc[side], 1e-12);
+                EXPECT_NEAR(channels[side]->GetEnergy(), ref.energy[side], 1e-12);
+            }
+        }
+    }
+
+    TEST(testDigitizingTacQuila, reference_values_without_smearing)
+    {
+        Neuland::DigitizingTacQuila engine;
+        engine.SetTimeRes(0.);
+        engine.SetERes(0.);
+
+        DepositFirstEvent(engine);
+        EXPECT_NEAR(engine.GetTriggerTime(), firstTrigger, 1e-12);
+        ExpectPaddles(engine, firstEvent);
+
+        DepositSecondEvent(engine);
+        EXPECT_NEAR(engine.GetTriggerTime(), secondTrigger, 1e-12);
+        ExpectPaddles(engine, secondEvent);
+    }
+
+    // Replays the random numbers in the order the engine draws them: the TDC of each fired channel in
+    // GetTriggerTime, then the energy of each channel when it is first requested.
+    void ExpectSmearedPaddles(Neuland::DigitizingEngine& engine,
+                              const std::vector<Reference>& unsmeared,
+                              TRandom3& rnd,
+                              const Neuland::TacQuila::Params& par)
+    {
+        std::vector<std::vector<Double_t>> tdc;
+        Double_t trigger = 1e100;
+        for (const auto& ref : unsmeared)
+        {
+            tdc.push_back({ ref.tdc[0], ref.tdc[1] });
+            for (int side = 0; side < 2; side++)
+            {
+                if (ref.fired[side])
+                {
+                    tdc.back()[side] += rnd.Gaus(0., par.fTimeRes);
+                    trigger = std::min(trigger, tdc.back()[side]);
+                }
+            }
+        }
+        EXPECT_DOUBLE_EQ(engine.GetTriggerTime(), trigger);
+
+        const auto& paddles = engine.ExtractPaddles();
+        ASSERT_EQ(paddles.size(), unsmeared.size());
+        for (size_t i = 0; i < unsmeared.size(); i++)
+        {
+            const auto& ref = unsmeared[i];
+            const Neuland::Digitizing::Channel* channels[2] = { paddles[i].second->GetLeftChannel(),
+                                                                paddles[i].second->GetRightChannel() };
+            for (int side = 0; side < 2; side++)
+            {
+                EXPECT_EQ(channels[side]->HasFired(), ref.fired[side]);
+                EXPECT_NEAR(channels[side]->GetQDC(), ref.qdc[side], 1e-12);
+                EXPECT_DOUBLE_EQ(channels[side]->GetTDC(), tdc[i][side]);
+
+                using Neuland::Digitizing::Paddle;
+                Double_t e = ref.qdc[side] * std::exp(Paddle::gHalfLength * Paddle::gAttenuation);
+                e = e / (1. + par.fSaturationCoefficient * e);
+                e = rnd.Gaus(e, par.fEResRel * e);
+                e = e / (1. - par.fSaturationCoefficient * e);
+                EXPECT_NEAR(channels[side]->GetEnergy(), e, 1e-12);
+            }
+        }
+    }
+
+    TEST(testDigitizingTacQuila, fixed_seed_random_numbers)
+    {
+        // Both generators start from the default seed of TRandom3
+        Neuland::DigitizingTacQuila engine;
+        TRandom3 rnd;
+        const Neuland::TacQuila::Params par;
+
+        DepositFirstEvent(engine);
+        ExpectSmearedPaddles(engine, firstEvent, rnd, par);
+
+        DepositSecondEvent(engine);
+        ExpectSmearedPaddles(engine, secondEvent, rnd, par);
+    }
+} // namespace
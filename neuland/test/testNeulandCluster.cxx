@@ -0,0 +1,148 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BNeulandCluster.h"
+#include "R3BNeulandHit.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // Computes the cached quantities from scratch, the way R3BNeulandCluster did before it cached them
+    void ExpectFresh(const R3BNeulandCluster& cluster)
+    {
+        const auto& hits = cluster.GetHits();
+        ASSERT_FALSE(hits.empty());
+        auto byTime = [](const R3BNeulandHit& a, const R3BNeulandHit& b) { return a.GetT() < b.GetT(); };
+        const R3BNeulandHit& first = *std::min_element(hits.cbegin(), hits.cend(), byTime);
+        const R3BNeulandHit& last = *std::max_element(hits.cbegin(), hits.cend(), byTime);
+        const Double_t e = std::accumulate(
+            hits.cbegin(), hits.cend(), 0., [](const Double_t c, const R3BNeulandHit& hit) { return c + hit.GetE(); });
+        const TVector3 centroid = std::accumulate(hits.cbegin(),
+                                                  hits.cend(),
+                                                  TVector3(),
+                                                  [](const TVector3& c, const R3BNeulandHit& hit) {
+                                                      return c + (hit.GetPosition() * hit.GetE());
+                                                  }) *
+                                  (1. / e);
+
+        EXPECT_EQ(&cluster.GetFirstHit(), &first);
+        EXPECT_EQ(&cluster.GetLastHit(), &last);
+        EXPECT_EQ(cluster.GetT(), first.GetT());
+        EXPECT_EQ(cluster.GetPosition(), first.GetPosition());
+        EXPECT_EQ(cluster.GetE(), e);
+        EXPECT_EQ(cluster.GetBeta(), first.GetBeta());
+        EXPECT_EQ(cluster.GetEToF(), first.GetEToF());
+        EXPECT_EQ(cluster.GetEnergyCentroid(), centroid);
+        EXPECT_EQ(cluster.GetRCluster(0.5), std::abs(0.5 - first.GetBeta()) / e);
+        EXPECT_EQ(cluster.GetRECluster(100.), std::abs(100. - first.GetEToF()) / e);
+    }
+
+    class testNeulandCluster : public ::testing::Test
+    {
+      protected:
+        testNeulandCluster()
+            : fRnd(42)
+        {
+        }
+
+        // Times on a 1 ns grid, so that some hits have equal times
+        R3BNeulandHit RandomHit()
+        {
+            std::uniform_int_distribution<Int_t> paddle(0, 3000);
+            std::uniform_int_distribution<Int_t> t(60, 70);
+            std::uniform_real_distribution<Double_t> e(0.5, 50.);
+            std::uniform_real_distribution<Double_t> xy(-125., 125.);
+            std::uniform_real_distribution<Double_t> z(1400., 1700.);
+            const TVector3 pos(xy(fRnd), xy(fRnd), z(fRnd));
+            const Double_t energy = e(fRnd);
+            return R3BNeulandHit(paddle(fRnd), 0., 0., t(fRnd), energy, energy, energy, pos, pos);
+        }
+
+        std::mt19937 fRnd;
+    };
+
+    TEST_F(testNeulandCluster, cache_follows_added_hits)
+    {
+        for (Int_t n = 0; n < 100; n++)
+        {
+            R3BNeulandCluster cluster(RandomHit());
+            ExpectFresh(cluster);
+            for (Int_t i = 0; i < 10; i++)
+            {
+                cluster.AddHit(RandomHit());
+                ExpectFresh(cluster);
+            }
+        }
+    }
+
+    TEST_F(testNeulandCluster, added_hit_replaces_first_and_last)
+    {
+        R3BNeulandCluster cluster(std::vector<R3BNeulandHit>{ RandomHit(), RandomHit(), RandomHit() });
+        ExpectFresh(cluster);
+
+        R3BNeulandHit early(1, 0., 0., 55., 3., 3., 3., TVector3(0., 0., 1500.), TVector3());
+        cluster.AddHit(early);
+        EXPECT_EQ(cluster.GetT(), 55.);
+        ExpectFresh(cluster);
+
+        R3BNeulandHit late(2, 0., 0., 500., 3., 3., 3., TVector3(0., 0., 1600.), TVector3());
+        cluster.AddHit(late);
+        EXPECT_EQ(cluster.GetLastHit().GetT(), 500.);
+        ExpectFresh(cluster);
+    }
+
+    TEST_F(testNeulandCluster, cache_is_reset_by_clear)
+    {
+        R3BNeulandCluster cluster(std::vector<R3BNeulandHit>{ RandomHit(), RandomHit(), RandomHit() });
+        ExpectFresh(cluster);
+
+        cluster.Clear("C");
+        EXPECT_THROW(cluster.GetFirstHit(), std::logic_error);
+        EXPECT_THROW(cluster.GetBeta(), std::logic_error);
+
+        for (Int_t i = 0; i < 5; i++)
+        {
+            cluster.AddHit(RandomHit());
+        }
+        ExpectFresh(cluster);
+    }
+
+    TEST_F(testNeulandCluster, copies_are_independent)
+    {
+        R3BNeulandCluster cluster(std::vector<R3BNeulandHit>{ RandomHit(), RandomHit(), RandomHit() });
+        ExpectFresh(cluster);
+
+        // A copy of a cached cluster refers to its own hits
+        R3BNeulandCluster copy(cluster);
+        ExpectFresh(copy);
+
+        const Double_t e = cluster.GetE();
+        copy.AddHit(RandomHit());
+        ExpectFresh(copy);
+        EXPECT_EQ(cluster.GetE(), e);
+        ExpectFresh(cluster);
+
+        R3BNeulandCluster assigned;
+        assigned = copy;
+        ExpectFresh(assigned);
+        assigned.Clear("C");
+        assigned.AddHit(RandomHit());
+        ExpectFresh(assigned);
+        ExpectFresh(copy);
+    }
+} // namespace
@@ -0,0 +1,134 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BNeulandCluster.h"
+#include "R3BNeulandHit.h"
+#include "TCAConnector.h"
+#include "TClonesArray.h"
+#include "gtest/gtest.h"
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    R3BNeulandHit MakeHit(Int_t paddle, Double_t t, Double_t e)
+    {
+        return R3BNeulandHit(paddle, t, t, t, e, e, e, TVector3(0., 0., 1400. + paddle), TVector3(0., 0., paddle));
+    }
+
+    TEST(testTCAConnector, view_reflects_the_array)
+    {
+        TClonesArray tca("R3BNeulandHit");
+        EXPECT_TRUE(TCAView<R3BNeulandHit>(&tca).empty());
+        EXPECT_TRUE(TCAView<R3BNeulandHit>(nullptr).empty());
+
+        for (Int_t i = 0; i < 5; i++)
+        {
+            new (tca[i]) R3BNeulandHit(MakeHit(i, 10. + i, 2. * i));
+        }
+
+        const TCAView<R3BNeulandHit> view(&tca);
+        ASSERT_EQ(view.size(), 5u);
+        EXPECT_EQ(view.end() - view.begin(), 5);
+        for (size_t i = 0; i < view.size(); i++)
+        {
+            // The view hands out the objects in the array, not copies
+            EXPECT_EQ(&view[i], tca.At(i));
+            EXPECT_EQ(view[i].GetPaddle(), (Int_t)i);
+        }
+        EXPECT_EQ(&view.front(), tca.At(0));
+        EXPECT_EQ(&view.back(), tca.At(4));
+
+        Int_t n = 0;
+        for (const auto& hit : view)
+        {
+            EXPECT_EQ(&hit, tca.At(n++));
+        }
+        EXPECT_EQ(n, 5);
+        EXPECT_EQ(view.begin()[3].GetT(), 13.);
+        EXPECT_EQ((view.begin() + 2)->GetE(), 4.);
+
+        // A new view after the array was modified sees the change
+        tca.Clear("C");
+        new (tca[0]) R3BNeulandHit(MakeHit(7, 1., 1.));
+        const TCAView<R3BNeulandHit> after(&tca);
+        ASSERT_EQ(after.size(), 1u);
+        EXPECT_EQ(after[0].GetPaddle(), 7);
+    }
+
+    TEST(testTCAConnector, emplace_constructs_in_place)
+    {
+        TClonesArray tca("R3BNeulandHit");
+        TCAOutputConnector<R3BNeulandHit> out("NeulandHits");
+        out.Init(&tca);
+
+        std::vector<const R3BNeulandHit*> addresses;
+        for (Int_t i = 0; i < 4; i++)
+        {
+            const R3BNeulandHit& hit =
+                out.Emplace(i, 1., 2., 3., 4., 5., 6. + i, TVector3(1., 2., 3.), TVector3(0., 0., 0.));
+            EXPECT_EQ(&hit, tca.At(i));
+            EXPECT_EQ(hit.GetPaddle(), i);
+            EXPECT_EQ(hit.GetE(), 6. + i);
+            addresses.push_back(&hit);
+        }
+        EXPECT_EQ(out.Size(), 4);
+
+        // After a reset, the objects are built again in the memory of the previous event
+        out.Reset();
+        EXPECT_EQ(out.Size(), 0);
+        for (Int_t i = 0; i < 4; i++)
+        {
+            EXPECT_EQ(&out.Emplace(MakeHit(10 + i, 0., 0.)), addresses[i]);
+        }
+        EXPECT_EQ(TCAView<R3BNeulandHit>(&tca)[2].GetPaddle(), 12);
+    }
+
+    TEST(testTCAConnector, recycle_keeps_capacity)
+    {
+        TClonesArray tca("R3BNeulandCluster");
+        TCAOutputConnector<R3BNeulandCluster> out("NeulandClusters");
+        out.Init(&tca);
+
+        R3BNeulandCluster& cluster = out.Recycle();
+        EXPECT_TRUE(cluster.GetHits().empty());
+        for (Int_t i = 0; i < 50; i++)
+        {
+            cluster.AddHit(MakeHit(i, i, 1.));
+        }
+        const auto capacity = cluster.GetHits().capacity();
+        const auto* data = cluster.GetHits().data();
+
+        // Clear("C") empties the cluster but keeps its hit buffer for the next event
+        out.Reset();
+        EXPECT_EQ(out.Size(), 0);
+        R3BNeulandCluster& recycled = out.Recycle();
+        EXPECT_EQ(&recycled, &cluster);
+        EXPECT_TRUE(recycled.GetHits().empty());
+        EXPECT_EQ(recycled.GetHits().capacity(), capacity);
+
+        recycled.AddHit(MakeHit(3, 2., 5.));
+        EXPECT_EQ(recycled.GetHits().data(), data);
+        EXPECT_EQ(recycled.GetE(), 5.);
+        EXPECT_EQ(out.Size(), 1);
+    }
+
+    TEST(testTCAConnector, init_checks_the_class)
+    {
+        TClonesArray tca("R3BNeulandHit");
+        TCAOutputConnector<R3BNeulandCluster> out("NeulandClusters");
+        EXPECT_THROW(out.Init(&tca), std::runtime_error);
+        EXPECT_THROW(out.Init(nullptr), std::runtime_error);
+        EXPECT_THROW(out.Recycle(), std::runtime_error);
+    }
+} // namespace
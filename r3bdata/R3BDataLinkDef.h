@@ -94,6 +94,7 @@
 #pragma link C++ class R3BNeulandHit+;
 #pragma link C++ class R3BNeulandMultiplicity+;
 #pragma link C++ class R3BNeulandCluster+;
+#pragma read sourceClass="R3BNeulandCluster" targetClass="R3BNeulandCluster" version="[1-]" source="" target="fCached" code="{ fCached = kFALSE; }"
 #pragma link C++ class R3BNeulandNeutron+;
 #pragma link C++ class R3BPspxMappedData+;
 #pragma link C++ class R3BPspxPrecalData+;
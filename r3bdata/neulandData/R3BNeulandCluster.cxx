@@ -28,28 +28,61 @@ R3BNeulandHit R3BNeulandCluster::GetForemostHit() const
     return *min;
 }
 
-R3BNeulandHit R3BNeulandCluster::GetFirstHit() const
+void R3BNeulandCluster::Cache() const
 {
-    auto min = std::min_element(fHits.cbegin(), fHits.cend(), [](const R3BNeulandHit& a, const R3BNeulandHit& b) {
-        return a.GetT() < b.GetT();
-    });
-    if (min == fHits.end())
+    // Same tie breaking as std::min_element and std::max_element, same summation order as std::accumulate
+    fFirstHit = 0;
+    fLastHit = 0;
+    fE = 0.;
+    TVector3 centroid;
+    for (size_t i = 0; i < fHits.size(); i++)
+    {
+        const R3BNeulandHit& hit = fHits[i];
+        if (hit.GetT() < fHits[fFirstHit].GetT())
+        {
+            fFirstHit = i;
+        }
+        if (fHits[fLastHit].GetT() < hit.GetT())
+        {
+            fLastHit = i;
+        }
+        fE += hit.GetE();
+        // analog to Geometrical Centroid \vec{c} = \frac{\sum_i (\vec{r}_{i} \cdot V_i)}{\sum_i V_i}
+        centroid = centroid + (hit.GetPosition() * hit.GetE());
+    }
+    fEnergyCentroid = centroid * (1. / fE);
+    if (!fHits.empty())
+    {
+        fBeta = fHits[fFirstHit].GetBeta();
+        fEToF = fHits[fFirstHit].GetEToF();
+    }
+    fCached = kTRUE;
+}
+
+const R3BNeulandHit& R3BNeulandCluster::GetFirstHit() const
+{
+    if (fHits.empty())
     {
         throw std::logic_error("R3BNeulandCluster::GetFirstHit(): Cluster has no Hits!");
     }
-    return *min;
+    if (!fCached)
+    {
+        Cache();
+    }
+    return fHits[fFirstHit];
 }
 
-R3BNeulandHit R3BNeulandCluster::GetLastHit() const
+const R3BNeulandHit& R3BNeulandCluster::GetLastHit() const
 {
-    auto max = std::max_element(fHits.cbegin(), fHits.cend(), [](const R3BNeulandHit& a, const R3BNeulandHit& b) {
-        return a.GetT() < b.GetT();
-    });
-    if (max == fHits.end())
+    if (fHits.empty())
     {
         throw std::logic_error("R3BNeulandCluster::GetLastHit(): Cluster has no Hits!");
     }
-    return *max;
+    if (!fCached)
+    {
+        Cache();
+    }
+    return fHits[fLastHit];
 }
 
 R3BNeulandHit R3BNeulandCluster::GetMaxEnergyHit() const
@@ -66,27 +99,41 @@ R3BNeulandHit R3BNeulandCluster::GetMaxEnergyHit() const
 
 Double_t R3BNeulandCluster::GetE() const
 {
-    return std::accumulate(
-        fHits.begin(), fHits.end(), 0., [](const Double_t sum, const R3BNeulandHit& hit) { return sum + hit.GetE(); });
+    if (!fCached)
+    {
+        Cache();
+    }
+    return fE;
+}
+
+Double_t R3BNeulandCluster::GetBeta() const
+{
+    GetFirstHit(); // throws for empty clusters and fills the cache
+    return fBeta;
+}
+
+Double_t R3BNeulandCluster::GetEToF() const
+{
+    GetFirstHit(); // throws for empty clusters and fills the cache
+    return fEToF;
 }
 
 Double_t R3BNeulandCluster::GetT() const { return GetFirstHit().GetT(); }
 
 TVector3 R3BNeulandCluster::GetPosition() const { return GetFirstHit().GetPosition(); };
 
-TVector3 R3BNeulandCluster::GetEnergyCentroid() const
+const TVector3& R3BNeulandCluster::GetEnergyCentroid() const
 {
-    // analog to Geometrical Centroid \vec{c} = \frac{\sum_i (\vec{r}_{i} \cdot V_i)}{\sum_i V_i}
-    TVector3 centroid =
-        std::accumulate(fHits.cbegin(), fHits.cend(), TVector3(), [](const TVector3& c, const R3BNeulandHit& hit) {
-            return c + (hit.GetPosition() * hit.GetE());
-        });
-    return centroid * (1. / GetE());
+    if (!fCached)
+    {
+        Cache();
+    }
+    return fEnergyCentroid;
 }
 
 Double_t R3BNeulandCluster::GetEnergyMoment() const
 {
-    const TVector3 centroid = GetEnergyCentroid();
+    const TVector3& centroid = GetEnergyCentroid();
     Double_t mom = std::accumulate(fHits.cbegin(), fHits.cend(), 0., [&](const Double_t c, const R3BNeulandHit& hit) {
         return c + (hit.GetPosition() - centroid).Mag() * hit.GetE();
     });
@@ -23,38 +23,51 @@
 class R3BNeulandCluster : public TObject
 {
   public:
-    R3BNeulandCluster() = default;
+    R3BNeulandCluster()
+        : fCached(kFALSE)
+    {
+    }
     explicit R3BNeulandCluster(const R3BNeulandHit& hit)
         : fHits({ hit })
+        , fCached(kFALSE)
     {
     }
     R3BNeulandCluster(std::vector<R3BNeulandHit>::iterator begin, std::vector<R3BNeulandHit>::iterator end)
         : fHits(begin, end)
+        , fCached(kFALSE)
     {
     }
     explicit R3BNeulandCluster(std::vector<R3BNeulandHit> hits)
         : fHits(std::move(hits))
+        , fCached(kFALSE)
     {
     }
 
+    // Keeps the capacity, so that recycled clusters (see TCAOutputConnector::Recycle) do not allocate again
     void Clear(Option_t*) override
     {
         fHits.clear();
-        fHits.shrink_to_fit();
+        fCached = kFALSE;
+    }
+
+    void AddHit(const R3BNeulandHit& hit)
+    {
+        fHits.push_back(hit);
+        fCached = kFALSE;
     }
 
     const std::vector<R3BNeulandHit>& GetHits() const { return fHits; }
-    R3BNeulandHit GetFirstHit() const;
-    R3BNeulandHit GetLastHit() const;
+    const R3BNeulandHit& GetFirstHit() const;
+    const R3BNeulandHit& GetLastHit() const;
     R3BNeulandHit GetMaxEnergyHit() const;
     R3BNeulandHit GetForemostHit() const;
     TVector3 GetPosition() const;
     Double_t GetT() const;
     Double_t GetE() const;
-    Double_t GetBeta() const { return GetFirstHit().GetBeta(); }
-    Double_t GetEToF() const { return GetFirstHit().GetEToF(); }
+    Double_t GetBeta() const;
+    Double_t GetEToF() const;
     Size_t GetSize() const { return fHits.size(); }
-    TVector3 GetEnergyCentroid() const;
+    const TVector3& GetEnergyCentroid() const;
     Double_t GetEnergyMoment() const;
     Double_t GetRCluster(Double_t beta) const;
     Double_t GetRECluster(Double_t ekin) const;
@@ -66,6 +79,17 @@ class R3BNeulandCluster : public TObject
   private:
     std::vector<R3BNeulandHit> fHits;
 
+    // Quantities derived from the hits, computed once on first use. Reset when the hits change and, through a read
+    // rule in the LinkDef, when the cluster is read from a file
+    void Cache() const;
+    mutable Bool_t fCached;           //!
+    mutable size_t fFirstHit;         //!
+    mutable size_t fLastHit;          //!
+    mutable Double_t fE;              //!
+    mutable Double_t fBeta;           //!
+    mutable Double_t fEToF;           //!
+    mutable TVector3 fEnergyCentroid; //!
+
     ClassDefOverride(R3BNeulandCluster, 1)
 };
 
@@ -0,0 +1,55 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BEVENTHEADERBLOCK_H
+#define R3BEVENTHEADERBLOCK_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+/*
+ * What R3BEventHeader holds for a single event, for all events of a block
+ * read by R3BUcesbSource::ReadBlock(). Event k of the block is index k, as
+ * in R3BTdcBlock. Filled by R3BUnpackReader and R3BTrloiiTpatReader, fields
+ * without a reader stay 0.
+ */
+class R3BEventHeaderBlock
+{
+  public:
+    R3BEventHeaderBlock() {}
+
+    /* Start a block of n events with all fields 0 */
+    void Resize(UInt_t n)
+    {
+        fEventno.assign(n, 0);
+        fTrigger.assign(n, 0);
+        fTpat.assign(n, 0);
+    }
+
+    void SetEventno(UInt_t event, UInt_t eventno) { fEventno[event] = eventno; }
+    void SetTrigger(UInt_t event, UInt_t trigger) { fTrigger[event] = trigger; }
+    void SetTpat(UInt_t event, UShort_t tpat) { fTpat[event] = tpat; }
+
+    UInt_t GetNEvents() const { return fEventno.size(); }
+    UInt_t GetEventno(UInt_t event) const { return fEventno[event]; }
+    UInt_t GetTrigger(UInt_t event) const { return fTrigger[event]; }
+    UShort_t GetTpat(UInt_t event) const { return fTpat[event]; }
+
+  private:
+    std::vector<UInt_t> fEventno;
+    std::vector<UInt_t> fTrigger;
+    std::vector<UShort_t> fTpat;
+};
+
+#endif
@@ -27,6 +27,7 @@ extern "C"
 
 class TClonesArray;
 class R3BEventHeader;
+class R3BEventHeaderBlock;
 
 class R3BReader : public TObject
 {
@@ -40,8 +41,17 @@ class R3BReader : public TObject
     virtual Bool_t ReInit() { return kTRUE; }
     /* Read data from full event structure */
     virtual Bool_t Read() = 0;
+    /* Read n full event structures at once into the reader's block
+     * buffers, see R3BUcesbSource::ReadBlock(). Readers filling
+     * R3BEventHeader in Read() fill the header block instead. Returns
+     * kFALSE if the reader has no block support. */
+    virtual Bool_t ReadBlock(const void* const*, UInt_t, R3BEventHeaderBlock&) { return kFALSE; }
     /* Reset */
     virtual void Reset() = 0;
+    /* Whether Read() only touches this reader's own output and may thus run
+     * concurrently with other readers. Readers writing shared data such as
+     * R3BEventHeader have to return kFALSE. */
+    virtual Bool_t IsParallelSafe() const { return kTRUE; }
     /* Return actual name of the reader */
     const char* GetName() { return fName.Data(); }
 
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BReaderPool.h"
+
+R3BReaderPool::R3BReaderPool(UInt_t nThreads)
+    : fWorkers()
+    , fMutex()
+    , fStart()
+    , fDone()
+    , fJob(nullptr)
+    , fNJobs(0)
+    , fNFinished(0)
+    , fNActive(0)
+    , fRound(0)
+    , fStop(kFALSE)
+    , fNext(0)
+{
+    /* The calling thread takes part in every round */
+    for (UInt_t i = 1; i < nThreads; ++i)
+    {
+        fWorkers.emplace_back(&R3BReaderPool::Work, this);
+    }
+}
+
+R3BReaderPool::~R3BReaderPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = kTRUE;
+    }
+    fStart.notify_all();
+    for (auto& worker : fWorkers)
+    {
+        worker.join();
+    }
+}
+
+void R3BReaderPool::Run(size_t n, const std::function<void(size_t)>& job)
+{
+    if (n == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fJob = &job;
+        fNJobs = n;
+        fNFinished = 0;
+        fNext = 0;
+        ++fRound;
+    }
+    fStart.notify_all();
+
+    const size_t done = Drain(&job, n);
+
+    std::unique_lock<std::mutex> lock(fMutex);
+    fNFinished += done;
+    /* Also wait for late workers, they still hold a pointer to job */
+    fDone.wait(lock, [this] { return fNFinished == fNJobs && fNActive == 0; });
+    fJob = nullptr;
+}
+
+size_t R3BReaderPool::Drain(const std::function<void(size_t)>* job, size_t n)
+{
+    size_t done = 0;
+    for (size_t i = fNext++; i < n; i = fNext++)
+    {
+        (*job)(i);
+        ++done;
+    }
+    return done;
+}
+
+void R3BReaderPool::Work()
+{
+    ULong64_t seen = 0;
+    for (;;)
+    {
+        const std::function<void(size_t)>* job;
+        size_t n;
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fStart.wait(lock, [&] { return fStop || (fRound != seen && fJob != nullptr); });
+            if (fStop)
+            {
+                return;
+            }
+            seen = fRound;
+            job = fJob;
+            n = fNJobs;
+            ++fNActive;
+        }
+
+        const size_t done = Drain(job, n);
+
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fNFinished += done;
+            --fNActive;
+        }
+        fDone.notify_one();
+    }
+}
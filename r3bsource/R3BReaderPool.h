@@ -0,0 +1,70 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BREADERPOOL_H
+#define R3BREADERPOOL_H
+
+#include "Rtypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * A persistent pool of worker threads used by R3BUcesbSource to run
+ * independent readers concurrently on the same event buffer.
+ *
+ * Run() hands out the job indices [0, n) to the workers and to the calling
+ * thread and only returns once every job has finished, i.e. it acts as the
+ * barrier between unpacking and the FairTask chain.
+ */
+class R3BReaderPool
+{
+  public:
+    /* nThreads is the total number of threads including the caller */
+    explicit R3BReaderPool(UInt_t nThreads);
+    ~R3BReaderPool();
+
+    R3BReaderPool(const R3BReaderPool&) = delete;
+    R3BReaderPool& operator=(const R3BReaderPool&) = delete;
+
+    /* Call job(i) for all i < n, block until all calls have returned */
+    void Run(size_t n, const std::function<void(size_t)>& job);
+
+    UInt_t GetNThreads() const { return fWorkers.size() + 1; }
+
+  private:
+    void Work();
+    size_t Drain(const std::function<void(size_t)>* job, size_t n);
+
+    std::vector<std::thread> fWorkers;
+    std::mutex fMutex;
+    std::condition_variable fStart;
+    std::condition_variable fDone;
+
+    /* State of the current round, guarded by fMutex */
+    const std::function<void(size_t)>* fJob;
+    size_t fNJobs;
+    size_t fNFinished;
+    UInt_t fNActive;
+    ULong64_t fRound;
+    Bool_t fStop;
+
+    /* Next job index to hand out */
+    std::atomic<size_t> fNext;
+};
+
+#endif
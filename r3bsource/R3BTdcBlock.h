@@ -0,0 +1,78 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BTDCBLOCK_H
+#define R3BTDCBLOCK_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+/*
+ * Mapped TDC hits of a block of events, filled by R3BReader::ReadBlock.
+ * Every quantity lives in its own contiguous array, the hits of event k are
+ * [GetEventBegin(k), GetEventEnd(k)). The buffers keep their capacity
+ * between blocks.
+ */
+class R3BTdcBlock
+{
+  public:
+    R3BTdcBlock() { Clear(); }
+
+    void Clear()
+    {
+        fEventStart.assign(1, 0);
+        fDetector.clear();
+        fSide.clear();
+        fChannel.clear();
+        fEdge.clear();
+        fTimeCoarse.clear();
+        fTimeFine.clear();
+    }
+
+    /* Close the current event, the following hits belong to the next one */
+    void EndEvent() { fEventStart.push_back(fDetector.size()); }
+
+    void Add(UInt_t detector, UInt_t side, UInt_t channel, UInt_t edge, UInt_t coarse, UInt_t fine)
+    {
+        fDetector.push_back(detector);
+        fSide.push_back(side);
+        fChannel.push_back(channel);
+        fEdge.push_back(edge);
+        fTimeCoarse.push_back(coarse);
+        fTimeFine.push_back(fine);
+    }
+
+    UInt_t GetNEvents() const { return fEventStart.size() - 1; }
+    UInt_t GetNHits() const { return fDetector.size(); }
+    UInt_t GetEventBegin(UInt_t event) const { return fEventStart[event]; }
+    UInt_t GetEventEnd(UInt_t event) const { return fEventStart[event + 1]; }
+
+    const UInt_t* GetDetector() const { return fDetector.data(); }
+    const UInt_t* GetSide() const { return fSide.data(); }
+    const UInt_t* GetChannel() const { return fChannel.data(); }
+    const UInt_t* GetEdge() const { return fEdge.data(); }
+    const UInt_t* GetTimeCoarse() const { return fTimeCoarse.data(); }
+    const UInt_t* GetTimeFine() const { return fTimeFine.data(); }
+
+  private:
+    std::vector<UInt_t> fEventStart;
+    std::vector<UInt_t> fDetector;
+    std::vector<UInt_t> fSide;
+    std::vector<UInt_t> fChannel;
+    std::vector<UInt_t> fEdge;
+    std::vector<UInt_t> fTimeCoarse;
+    std::vector<UInt_t> fTimeFine;
+};
+
+#endif
@@ -27,6 +27,95 @@ extern "C"
 //#define MAX_TOFD_CARDS (sizeof data->TOFD_TRIGCLI / sizeof data->TOFD_TRIGCLI[0])
 #define MAX_TOFD_PLANES (sizeof data->TOFD_P / sizeof data->TOFD_P[0])
 
+namespace
+{
+    /* Calls hit(plane, side, channel, edge, coarse, fine) for every TAMEX hit
+     * of the event and trigger(...) for every trigger time, in the order
+     * of the mapped output */
+    template <typename Hit, typename Trigger>
+    void UnpackTofd(const EXT_STR_h101_TOFD_onion* data, Hit&& hit, Trigger&& trigger)
+    {
+        // puts("Event");
+        for (uint32_t d = 0; d < MAX_TOFD_PLANES; d++)
+        {
+            for (uint32_t t = 0; t < 2; t++)
+            {
+                auto const& side = data->TOFD_P[d].T[t];
+
+                //
+                // TAMEX3.
+                //
+
+                // int32_t first = -1;
+                // bool do_print = false;
+                // Leading.
+                auto numChannels = side.TCLM;
+                uint32_t curChannelStart = 0;
+                for (uint32_t i = 0; i < numChannels; i++)
+                {
+                    uint32_t channel = side.TCLMI[i];
+                    uint32_t nextChannelStart = side.TCLME[i];
+                    for (uint32_t j = curChannelStart; j < nextChannelStart; j++)
+                    {
+                        // printf("Lead %8u %8u %8u %8u\n", d, t, channel, side.TCLv[j] * 5);
+                        hit(d + 1, t + 1, channel, 1, side.TCLv[j], side.TFLv[j]);
+                        // if (-1 == first) { first = side.TCLv[j]; }
+                        // else if (fabs((int32_t)((side.TCLv[j] - first + 2048 + 1024) & 2047) - 1024) > 400) {
+                        //  std::cout << first << '\n';
+                        //  std::cout << side.TCLv[j] - first << '\n';
+                        //  std::cout << ((side.TCLv[j] - first + 2048 + 1024) & 2047) << '\n';
+                        //  std::cout << (int32_t)((side.TCLv[j] - first + 2048 + 1024) & 2047) - 1024 << '\n';
+                        //  std::cout << fabs((int32_t)((side.TCLv[j] - first + 2048 + 1024) & 2047) - 1024) << '\n';
+                        //  do_print = true;
+                        //}
+                    }
+                    curChannelStart = nextChannelStart;
+                }
+                // if (do_print) {
+                // numChannels = side.TCLM;
+                // curChannelStart = 0;
+                // for (uint32_t i = 0; i < numChannels; i++)
+                //{
+                //    uint32_t channel = side.TCLMI[i];
+                //    uint32_t nextChannelStart = side.TCLME[i];
+                //    for (uint32_t j = curChannelStart; j < nextChannelStart; j++)
+                //    {
+                // printf("Lead %8u %8u %8u %8u\n", d, t, channel, side.TCLv[j]);
+                //    }
+                //    curChannelStart = nextChannelStart;
+                //}
+                //}
+
+                // Trailing.
+                numChannels = side.TCTM;
+                curChannelStart = 0;
+                for (uint32_t i = 0; i < numChannels; i++)
+                {
+                    uint32_t channel = side.TCTMI[i];
+                    uint32_t nextChannelStart = side.TCTME[i];
+                    for (uint32_t j = curChannelStart; j < nextChannelStart; j++)
+                    {
+                        // printf("Tail %8u %8u %8u %8u\n", d, t, channel, side.TCTv[j] * 5);
+                        hit(d + 1, t + 1, channel, 2, side.TCTv[j], side.TFTv[j]);
+                    }
+                    curChannelStart = nextChannelStart;
+                }
+
+            } // for side
+        }     // for planes
+
+        // Leading TAMEX trigger times.
+        {
+            auto numChannels = data->TOFD_TRIGFL;
+            for (uint32_t i = 0; i < numChannels; i++)
+            {
+                uint32_t channel = data->TOFD_TRIGFLI[i];
+                trigger(MAX_TOFD_PLANES + 1, 1, channel, 1, data->TOFD_TRIGCLv[i], data->TOFD_TRIGFLv[i]);
+            }
+        }
+    }
+} // namespace
+
 R3BTofdReader::R3BTofdReader(EXT_STR_h101_TOFD* data, UInt_t offset)
     : R3BReader("R3BTofdReader")
     , fData(data)
@@ -34,6 +123,8 @@ R3BTofdReader::R3BTofdReader(EXT_STR_h101_TOFD* data, UInt_t offset)
     , fOnline(kFALSE)
     , fArray(new TClonesArray("R3BTofdMappedData"))
     , fArrayTrigger(new TClonesArray("R3BTofdMappedData"))
+    , fBlock()
+    , fTriggerBlock()
 {
 }
 
@@ -94,86 +185,39 @@ Bool_t R3BTofdReader::Read()
     // Convert plain raw data to multi-dimensional array
     EXT_STR_h101_TOFD_onion* data = (EXT_STR_h101_TOFD_onion*)fData;
 
-    // puts("Event");
-    for (uint32_t d = 0; d < MAX_TOFD_PLANES; d++)
-    {
-        for (uint32_t t = 0; t < 2; t++)
-        {
-            auto const& side = data->TOFD_P[d].T[t];
-
-            //
-            // TAMEX3.
-            //
+    UnpackTofd(
+        data,
+        [this](UInt_t d, UInt_t t, UInt_t channel, UInt_t edge, UInt_t coarse, UInt_t fine) {
+            new ((*fArray)[fArray->GetEntriesFast()]) R3BTofdMappedData(d, t, channel, edge, coarse, fine);
+        },
+        [this](UInt_t d, UInt_t t, UInt_t channel, UInt_t edge, UInt_t coarse, UInt_t fine) {
+            new ((*fArrayTrigger)[fArrayTrigger->GetEntriesFast()])
+                R3BTofdMappedData(d, t, channel, edge, coarse, fine);
+        });
 
-            // int32_t first = -1;
-            // bool do_print = false;
-            // Leading.
-            auto numChannels = side.TCLM;
-            uint32_t curChannelStart = 0;
-            for (uint32_t i = 0; i < numChannels; i++)
-            {
-                uint32_t channel = side.TCLMI[i];
-                uint32_t nextChannelStart = side.TCLME[i];
-                for (uint32_t j = curChannelStart; j < nextChannelStart; j++)
-                {
-                    // printf("Lead %8u %8u %8u %8u\n", d, t, channel, side.TCLv[j] * 5);
-                    new ((*fArray)[fArray->GetEntriesFast()])
-                        R3BTofdMappedData(d + 1, t + 1, channel, 1, side.TCLv[j], side.TFLv[j]);
-                    // if (-1 == first) { first = side.TCLv[j]; }
-                    // else if (fabs((int32_t)((side.TCLv[j] - first + 2048 + 1024) & 2047) - 1024) > 400) {
-                    //  std::cout << first << '\n';
-                    //  std::cout << side.TCLv[j] - first << '\n';
-                    //  std::cout << ((side.TCLv[j] - first + 2048 + 1024) & 2047) << '\n';
-                    //  std::cout << (int32_t)((side.TCLv[j] - first + 2048 + 1024) & 2047) - 1024 << '\n';
-                    //  std::cout << fabs((int32_t)((side.TCLv[j] - first + 2048 + 1024) & 2047) - 1024) << '\n';
-                    //  do_print = true;
-                    //}
-                }
-                curChannelStart = nextChannelStart;
-            }
-            // if (do_print) {
-            // numChannels = side.TCLM;
-            // curChannelStart = 0;
-            // for (uint32_t i = 0; i < numChannels; i++)
-            //{
-            //    uint32_t channel = side.TCLMI[i];
-            //    uint32_t nextChannelStart = side.TCLME[i];
-            //    for (uint32_t j = curChannelStart; j < nextChannelStart; j++)
-            //    {
-            // printf("Lead %8u %8u %8u %8u\n", d, t, channel, side.TCLv[j]);
-            //    }
-            //    curChannelStart = nextChannelStart;
-            //}
-            //}
-
-            // Trailing.
-            numChannels = side.TCTM;
-            curChannelStart = 0;
-            for (uint32_t i = 0; i < numChannels; i++)
-            {
-                uint32_t channel = side.TCTMI[i];
-                uint32_t nextChannelStart = side.TCTME[i];
-                for (uint32_t j = curChannelStart; j < nextChannelStart; j++)
-                {
-                    // printf("Tail %8u %8u %8u %8u\n", d, t, channel, side.TCTv[j] * 5);
-                    new ((*fArray)[fArray->GetEntriesFast()])
-                        R3BTofdMappedData(d + 1, t + 1, channel, 2, side.TCTv[j], side.TFTv[j]);
-                }
-                curChannelStart = nextChannelStart;
-            }
+    return kTRUE;
+}
 
-        } // for side
-    }     // for planes
+Bool_t R3BTofdReader::ReadBlock(const void* const* events, UInt_t n, R3BEventHeaderBlock&)
+{
+    fBlock.Clear();
+    fTriggerBlock.Clear();
 
-    // Leading TAMEX trigger times.
+    for (UInt_t e = 0; e < n; e++)
     {
-        auto numChannels = data->TOFD_TRIGFL;
-        for (uint32_t i = 0; i < numChannels; i++)
-        {
-            uint32_t channel = data->TOFD_TRIGFLI[i];
-            new ((*fArrayTrigger)[fArrayTrigger->GetEntriesFast()])
-                R3BTofdMappedData(MAX_TOFD_PLANES + 1, 1, channel, 1, data->TOFD_TRIGCLv[i], data->TOFD_TRIGFLv[i]);
-        }
+        // Same layout as fData, but in the e-th event of the block
+        auto data = (const EXT_STR_h101_TOFD_onion*)((const char*)events[e] + fOffset);
+
+        UnpackTofd(
+            data,
+            [this](UInt_t d, UInt_t t, UInt_t channel, UInt_t edge, UInt_t coarse, UInt_t fine) {
+                fBlock.Add(d, t, channel, edge, coarse, fine);
+            },
+            [this](UInt_t d, UInt_t t, UInt_t channel, UInt_t edge, UInt_t coarse, UInt_t fine) {
+                fTriggerBlock.Add(d, t, channel, edge, coarse, fine);
+            });
+        fBlock.EndEvent();
+        fTriggerBlock.EndEvent();
     }
 
     return kTRUE;
@@ -15,6 +15,7 @@
 #define R3BTOFDREADER_H
 
 #include "R3BReader.h"
+#include "R3BTdcBlock.h"
 
 struct EXT_STR_h101_TOFD_t;
 typedef struct EXT_STR_h101_TOFD_t EXT_STR_h101_TOFD;
@@ -29,8 +30,17 @@ class R3BTofdReader : public R3BReader
 
     Bool_t Init(ext_data_struct_info*);
     Bool_t Read();
+    Bool_t ReadBlock(const void* const*, UInt_t, R3BEventHeaderBlock&);
     void Reset();
 
+    /* Mapped data of the last event read by Read() */
+    const TClonesArray* GetArray() const { return fArray; }
+    const TClonesArray* GetTriggerArray() const { return fArrayTrigger; }
+
+    /* Mapped data of the last block, in the numbering of R3BTofdMappedData */
+    const R3BTdcBlock& GetBlock() const { return fBlock; }
+    const R3BTdcBlock& GetTriggerBlock() const { return fTriggerBlock; }
+
     /** Accessor to select online mode **/
     void SetOnline(Bool_t option) { fOnline = option; }
 
@@ -44,6 +54,8 @@ class R3BTofdReader : public R3BReader
     /* the structs of type R3BTofdxMappedItem */
     TClonesArray* fArray;        /**< Output array. */
     TClonesArray* fArrayTrigger; /**< Output array for triggers. */
+    R3BTdcBlock fBlock;          //! Output of ReadBlock
+    R3BTdcBlock fTriggerBlock;   //! Output of ReadBlock for triggers
 
   public:
     ClassDef(R3BTofdReader, 0);
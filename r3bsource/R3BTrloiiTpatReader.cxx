@@ -15,6 +15,7 @@
 #include "FairLogger.h"
 #include "FairRootManager.h"
 #include "R3BEventHeader.h"
+#include "R3BEventHeaderBlock.h"
 
 extern "C"
 {
@@ -87,6 +88,16 @@ Bool_t R3BTrloiiTpatReader::Read()
     return kTRUE;
 }
 
+Bool_t R3BTrloiiTpatReader::ReadBlock(const void* const* events, UInt_t n, R3BEventHeaderBlock& header)
+{
+    for (UInt_t e = 0; e < n; e++)
+    {
+        auto data = (const EXT_STR_h101_TPAT*)((const char*)events[e] + fOffset);
+        header.SetTpat(e, data->TPAT > 0 ? data->TPATv[0] : 0);
+    }
+    return kTRUE;
+}
+
 void R3BTrloiiTpatReader::Reset() { fNEvent = 0; }
 
 ClassImp(R3BTrloiiTpatReader)
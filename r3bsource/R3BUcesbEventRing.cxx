@@ -0,0 +1,175 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BUcesbEventRing.h"
+
+#include <cstring>
+
+/* External data client interface (ucesb) */
+#include "ext_data_clnt.hh"
+
+R3BUcesbEventRing::R3BUcesbEventRing(ext_data_clnt* client, size_t eventSize, UInt_t depth)
+    : fClient(client)
+    , fEventSize(eventSize)
+    , fSlots(depth < 1 ? 1 : depth)
+    , fThread()
+    , fMutex()
+    , fNotEmpty()
+    , fNotFull()
+    , fHead(0)
+    , fCount(0)
+    , fStop(kFALSE)
+    , fDone(kFALSE)
+    , fConsumerStalls(0)
+    , fProducerStalls(0)
+    , fRaw()
+    , fLastError()
+{
+    for (auto& slot : fSlots)
+    {
+        slot.fData.assign(fEventSize, 0);
+        slot.fHasRaw = kFALSE;
+        slot.fRet = 0;
+    }
+}
+
+R3BUcesbEventRing::~R3BUcesbEventRing() { Stop(); }
+
+void R3BUcesbEventRing::Start()
+{
+    if (!fThread.joinable())
+    {
+        fThread = std::thread(&R3BUcesbEventRing::Fetch, this);
+    }
+}
+
+void R3BUcesbEventRing::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = kTRUE;
+    }
+    fNotFull.notify_all();
+    /* A fetch_event() in progress is finished first */
+    if (fThread.joinable())
+    {
+        fThread.join();
+    }
+}
+
+void R3BUcesbEventRing::Fetch()
+{
+    for (;;)
+    {
+        size_t tail;
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            if (fCount == fSlots.size() && !fStop)
+            {
+                ++fProducerStalls;
+                fNotFull.wait(lock, [this] { return fStop || fCount < fSlots.size(); });
+            }
+            if (fStop)
+            {
+                return;
+            }
+            tail = (fHead + fCount) % fSlots.size();
+        }
+
+        /* The slot at tail is owned by this thread until it is published */
+        Slot& slot = fSlots[tail];
+        slot.fRet = fClient->fetch_event(slot.fData.data(), fEventSize);
+        slot.fHasRaw = kFALSE;
+        if (slot.fRet > 0)
+        {
+            const void* raw;
+            ssize_t raw_words;
+            if (0 != fClient->get_raw_data(&raw, &raw_words))
+            {
+                slot.fRet = -1;
+                slot.fError = "Failed to get raw data.";
+            }
+            else if (raw)
+            {
+                const uint32_t* u = (const uint32_t*)raw;
+                slot.fRaw.assign(u, u + raw_words);
+                slot.fHasRaw = kTRUE;
+            }
+        }
+        else if (-1 == slot.fRet)
+        {
+            slot.fError = fClient->last_error() ? fClient->last_error() : "";
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            ++fCount;
+            if (slot.fRet <= 0)
+            {
+                fDone = kTRUE;
+            }
+        }
+        fNotEmpty.notify_one();
+
+        if (slot.fRet <= 0)
+        {
+            return;
+        }
+    }
+}
+
+int R3BUcesbEventRing::Pop(void* event, const void** raw, ssize_t* raw_words)
+{
+    {
+        std::unique_lock<std::mutex> lock(fMutex);
+        if (0 == fCount)
+        {
+            if (fDone)
+            {
+                /* Nothing follows the last delivered end of input or error */
+                return 0;
+            }
+            ++fConsumerStalls;
+            fNotEmpty.wait(lock, [this] { return fCount > 0; });
+        }
+    }
+
+    /* The slot at fHead is owned by this thread until it is released */
+    Slot& slot = fSlots[fHead];
+    int ret = slot.fRet;
+    *raw = nullptr;
+    *raw_words = 0;
+    if (ret > 0)
+    {
+        memcpy(event, slot.fData.data(), fEventSize);
+        if (slot.fHasRaw)
+        {
+            fRaw.swap(slot.fRaw);
+            *raw = fRaw.data();
+            *raw_words = fRaw.size();
+        }
+    }
+    else if (-1 == ret)
+    {
+        fLastError = slot.fError;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fHead = (fHead + 1) % fSlots.size();
+        --fCount;
+    }
+    fNotFull.notify_one();
+
+    return ret;
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BUCESBEVENTRING_H
+#define R3BUCESBEVENTRING_H
+
+#include "Rtypes.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+class ext_data_clnt;
+
+/*
+ * A ring of event buffers that a background thread fills from an already
+ * set up ext_data_clnt, so that the pipe read from ucesb overlaps with the
+ * processing of the previous events.
+ *
+ * The readers keep pointers into the event structure handed to
+ * R3BUcesbSource, therefore Pop() copies the next ready buffer into it.
+ * The ext_data_clnt must not be used by anybody else while the ring runs.
+ */
+class R3BUcesbEventRing
+{
+  public:
+    R3BUcesbEventRing(ext_data_clnt* client, size_t eventSize, UInt_t depth);
+    ~R3BUcesbEventRing();
+
+    R3BUcesbEventRing(const R3BUcesbEventRing&) = delete;
+    R3BUcesbEventRing& operator=(const R3BUcesbEventRing&) = delete;
+
+    /* Start the fetching thread */
+    void Start();
+    /* Stop and join the fetching thread */
+    void Stop();
+
+    /* Copy the next event to event and return the value of fetch_event().
+     * raw/raw_words point to the raw data of this event, valid until the
+     * next call. */
+    int Pop(void* event, const void** raw, ssize_t* raw_words);
+
+    /* Error message of the client if Pop() returned -1 */
+    const std::string& GetLastError() const { return fLastError; }
+
+    UInt_t GetDepth() const { return fSlots.size(); }
+    /* Number of times Pop() had to wait for the fetching thread */
+    ULong64_t GetConsumerStalls() const { return fConsumerStalls; }
+    /* Number of times the fetching thread had to wait for a free buffer */
+    ULong64_t GetProducerStalls() const { return fProducerStalls; }
+
+  private:
+    struct Slot
+    {
+        std::vector<char> fData;
+        std::vector<uint32_t> fRaw;
+        Bool_t fHasRaw;
+        int fRet;
+        std::string fError;
+    };
+
+    void Fetch();
+
+    ext_data_clnt* fClient;
+    size_t fEventSize;
+    std::vector<Slot> fSlots;
+    std::thread fThread;
+
+    /* Ring state, guarded by fMutex */
+    std::mutex fMutex;
+    std::condition_variable fNotEmpty;
+    std::condition_variable fNotFull;
+    size_t fHead;  /* next slot to pop */
+    size_t fCount; /* number of filled slots */
+    Bool_t fStop;
+    Bool_t fDone; /* fetching thread saw end of input or an error */
+    ULong64_t fConsumerStalls;
+    ULong64_t fProducerStalls;
+
+    /* Consumer side copies of the popped slot */
+    std::vector<uint32_t> fRaw;
+    std::string fLastError;
+};
+
+#endif
@@ -11,12 +11,18 @@
  * or submit itself to any jurisdiction.                                      *
  ******************************************************************************/
 
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
 
 #include "FairLogger.h"
+#include "R3BReaderPool.h"
+#include "R3BUcesbEventRing.h"
 #include "R3BUcesbSource.h"
+#include "TROOT.h"
 
 #include "ext_data_client.h"
 
@@ -38,14 +44,22 @@ R3BUcesbSource::R3BUcesbSource(const TString& FileName,
     , fLastEventNo(-1)
     , fLogger(FairLogger::GetLogger())
     , fReaders(new TObjArray())
+    , fNumReaderThreads(1)
+    , fReaderPool(nullptr)
+    , fSerialReaders()
+    , fParallelReaders()
+    , fReaderTime()
+    , fPrefetchDepth(0)
+    , fEventRing(nullptr)
+    , fBlockBuffers()
 {
 }
 
 R3BUcesbSource::~R3BUcesbSource()
 {
+    Close();
     fReaders->Delete();
     delete fReaders;
-    Close();
 }
 
 Bool_t R3BUcesbSource::Init()
@@ -98,6 +112,30 @@ Bool_t R3BUcesbSource::InitUnpackers()
         }
     }
 
+    /* Decide which readers may run concurrently */
+    fSerialReaders.clear();
+    fParallelReaders.clear();
+    fReaderTime.assign(fReaders->GetEntriesFast(), 0.);
+    for (int i = 0; i < fReaders->GetEntriesFast(); ++i)
+    {
+        if (fNumReaderThreads > 1 && ((R3BReader*)fReaders->At(i))->IsParallelSafe())
+        {
+            fParallelReaders.push_back(i);
+        }
+        else
+        {
+            fSerialReaders.push_back(i);
+        }
+    }
+    if (fNumReaderThreads > 1 && !fReaderPool)
+    {
+        /* Readers construct objects in their TClonesArrays */
+        ROOT::EnableThreadSafety();
+        fReaderPool = new R3BReaderPool(fNumReaderThreads);
+        LOG(info) << "R3BUcesbSource: running " << fParallelReaders.size() << " of " << fReaders->GetEntriesFast()
+                  << " readers on " << fNumReaderThreads << " threads";
+    }
+
     /* Setup client */
 #ifdef EXT_DATA_ITEM_MAP_MATCH
     /* this is the version for ucesb setup with extended mapping info */
@@ -164,7 +202,8 @@ Int_t R3BUcesbSource::ReadEvent(UInt_t i)
     int ret;
     (void)i; /* Why is i not used? Outer loop seems not to use it. */
 
-    LOG(debug1) << "R3BUcesbSource::ReadEvent " << (fNEvent++);
+    LOG(debug1) << "R3BUcesbSource::ReadEvent " << fNEvent;
+    fNEvent++;
 
     /* Need to initialize first */
     if (nullptr == fFd)
@@ -173,7 +212,7 @@ Int_t R3BUcesbSource::ReadEvent(UInt_t i)
     }
 
     /* Fetch data */
-    ret = fClient.fetch_event(fEvent, fEventSize);
+    ret = FetchEvent(fEvent, &raw, &raw_words);
     if (0 == ret)
     {
         LOG(info) << "R3BUcesbSource::End of input";
@@ -181,28 +220,24 @@ Int_t R3BUcesbSource::ReadEvent(UInt_t i)
     }
     if (-1 == ret)
     {
-        perror("ext_data_clnt::fetch_event()");
-        LOG(error) << "ext_data_clnt::fetch_event() failed";
-        LOG(fatal) << "ucesb: " << fClient.last_error();
         return 0;
     }
 
-    /* Get raw data, if any */
-    ret = fClient.get_raw_data(&raw, &raw_words);
-    if (0 != ret)
+    /* Run detector specific readers, the ones filling shared data first */
+    for (auto r : fSerialReaders)
     {
-        perror("ext_data_clnt::get_raw_data()");
-        LOG(fatal) << "Failed to get raw data.";
-        return 0;
+        RunReader(r);
     }
-
-    /* Run detector specific readers */
-    for (int r = 0; r < fReaders->GetEntriesFast(); ++r)
+    if (fReaderPool)
     {
-        R3BReader* reader = (R3BReader*)fReaders->At(r);
-
-        LOG(debug1) << "  Reading reader " << r << " (" << reader->GetName() << ")";
-        reader->Read();
+        fReaderPool->Run(fParallelReaders.size(), [this](size_t i) { RunReader(fParallelReaders[i]); });
+    }
+    else
+    {
+        for (auto r : fParallelReaders)
+        {
+            RunReader(r);
+        }
     }
 
     /* Display raw data */
@@ -224,10 +259,163 @@ Int_t R3BUcesbSource::ReadEvent(UInt_t i)
     return 0;
 }
 
+Int_t R3BUcesbSource::FetchEvent(void* event, const void** raw, ssize_t* raw_words)
+{
+    int ret;
+
+    if (fPrefetchDepth > 0 && !fEventRing)
+    {
+        /* The client is set up by now, from here on only the ring uses it */
+        fEventRing = new R3BUcesbEventRing(&fClient, fEventSize, fPrefetchDepth);
+        fEventRing->Start();
+    }
+    if (fEventRing)
+    {
+        ret = fEventRing->Pop(event, raw, raw_words);
+    }
+    else
+    {
+        ret = fClient.fetch_event(event, fEventSize);
+    }
+    if (-1 == ret)
+    {
+        perror("ext_data_clnt::fetch_event()");
+        LOG(error) << "ext_data_clnt::fetch_event() failed";
+        LOG(fatal) << "ucesb: " << (fEventRing ? fEventRing->GetLastError().c_str() : fClient.last_error());
+        return -1;
+    }
+
+    /* Get raw data, if any */
+    if (0 != ret && !fEventRing)
+    {
+        if (0 != fClient.get_raw_data(raw, raw_words))
+        {
+            perror("ext_data_clnt::get_raw_data()");
+            LOG(fatal) << "Failed to get raw data.";
+            return -1;
+        }
+    }
+
+    return ret;
+}
+
+Int_t R3BUcesbSource::ReadBlock(UInt_t n)
+{
+    /* Need to initialize first */
+    if (nullptr == fFd)
+    {
+        Init();
+    }
+
+    if (fBlockBuffers.size() < n)
+    {
+        fBlockBuffers.resize(n);
+    }
+
+    std::vector<const void*> events;
+    events.reserve(n);
+    for (UInt_t k = 0; k < n; ++k)
+    {
+        const void* raw;
+        ssize_t raw_words;
+
+        fBlockBuffers[k].resize(fEventSize);
+        Int_t ret = FetchEvent(fBlockBuffers[k].data(), &raw, &raw_words);
+        if (-1 == ret)
+        {
+            return -1;
+        }
+        if (0 == ret)
+        {
+            LOG(info) << "R3BUcesbSource::End of input";
+            break;
+        }
+        events.push_back(fBlockBuffers[k].data());
+    }
+    fNEvent += events.size();
+
+    if (events.empty())
+    {
+        return 0;
+    }
+
+    fHeaderBlock.Resize(events.size());
+    for (int r = 0; r < fReaders->GetEntriesFast(); ++r)
+    {
+        R3BReader* reader = (R3BReader*)fReaders->At(r);
+        if (!reader->ReadBlock(events.data(), events.size(), fHeaderBlock))
+        {
+            LOG(debug1) << "  Reader " << r << " (" << reader->GetName() << ") has no block support";
+        }
+    }
+
+    return events.size();
+}
+
+void R3BUcesbSource::RunReader(Int_t r)
+{
+    R3BReader* reader = (R3BReader*)fReaders->At(r);
+
+    LOG(debug1) << "  Reading reader " << r << " (" << reader->GetName() << ")";
+    auto start = std::chrono::steady_clock::now();
+    reader->Read();
+    /* Each reader index is handled by exactly one thread per event */
+    fReaderTime[r] += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+}
+
+void R3BUcesbSource::PrintReaderTimes() const
+{
+    std::vector<Int_t> order;
+    Double_t total = 0.;
+    for (size_t r = 0; r < fReaderTime.size(); ++r)
+    {
+        order.push_back(r);
+        total += fReaderTime[r];
+    }
+    if (total <= 0.)
+    {
+        return;
+    }
+    std::sort(order.begin(), order.end(), [this](Int_t a, Int_t b) { return fReaderTime[a] > fReaderTime[b]; });
+
+    LOG(info) << "R3BUcesbSource: reader wall time after " << fNEvent << " events ("
+              << (fReaderPool ? fReaderPool->GetNThreads() : 1) << " threads)";
+    for (auto r : order)
+    {
+        std::ostringstream line;
+        line << "  " << std::left << std::setw(32) << ((R3BReader*)fReaders->At(r))->GetName() << std::right
+             << std::fixed << std::setprecision(3) << std::setw(10) << fReaderTime[r] << " s" << std::setw(7)
+             << std::setprecision(1) << 100. * fReaderTime[r] / total << " %";
+        if (fNEvent > 0)
+        {
+            line << std::setw(10) << std::setprecision(2) << 1e6 * fReaderTime[r] / fNEvent << " us/event";
+        }
+        LOG(info) << line.str();
+    }
+}
+
 void R3BUcesbSource::Close()
 {
     int ret;
 
+    if (fEventRing)
+    {
+        fEventRing->Stop();
+        LOG(info) << "R3BUcesbSource: prefetched with " << fEventRing->GetDepth() << " buffers, "
+                  << fEventRing->GetConsumerStalls() << " times waited for ucesb, "
+                  << fEventRing->GetProducerStalls() << " times ucesb waited for processing";
+        delete fEventRing;
+        fEventRing = nullptr;
+    }
+
+    PrintReaderTimes();
+    fReaderTime.assign(fReaderTime.size(), 0.);
+    if (fReaderPool)
+    {
+        delete fReaderPool;
+        fReaderPool = nullptr;
+    }
+
     /* Close client connection */
     ret = fClient.close();
     if (0 != ret)
@@ -22,10 +22,13 @@
 #define __R3BROOT__R3BUCESBSOURCE__
 
 #include "FairSource.h"
+#include "R3BEventHeaderBlock.h"
 #include "R3BReader.h"
 #include "TObjArray.h"
 #include "TString.h"
 
+#include <vector>
+
 /* External data client interface (ucesb) */
 #include "ext_data_clnt.hh"
 #include "ext_data_struct_info.hh"
@@ -39,6 +42,8 @@ typedef struct EXT_STR_h101_t EXT_STR_h101;
 /*#include "ext_h101.h"*/
 
 class FairLogger;
+class R3BReaderPool;
+class R3BUcesbEventRing;
 
 class R3BUcesbSource : public FairSource
 {
@@ -67,8 +72,36 @@ class R3BUcesbSource : public FairSource
     void SetMaxEvents(int a_max) { fLastEventNo = a_max; }
     /* Get readers */
     const TObjArray* GetReaders() const { return fReaders; }
+    /* Run the readers on n threads. Readers that are not parallel safe
+     * (e.g. the ones filling R3BEventHeader) are still run serially before
+     * all others. Default is 1, i.e. everything runs in ReadEvent's thread.
+     * */
+    void SetNumReaderThreads(UInt_t n) { fNumReaderThreads = n; }
+    /* Print the accumulated wall time spent in each reader */
+    void PrintReaderTimes() const;
+    /* Fetch up to n events ahead from ucesb on a separate thread. Each
+     * event is then copied into the full event structure by ReadEvent.
+     * Default is 0, i.e. fetch_event is called from ReadEvent.
+     * */
+    void SetPrefetchDepth(UInt_t n) { fPrefetchDepth = n; }
+    /* Fetch up to n events and pass them to R3BReader::ReadBlock() of all
+     * readers at once, bypassing the per-event TClonesArray output. This
+     * is meant for drivers calling the source directly instead of ReadEvent.
+     * Returns the number of events in the block, 0 at the end of input and
+     * -1 on error.
+     * */
+    Int_t ReadBlock(UInt_t n);
+    /* Event number, trigger and TPAT of the events of the last block */
+    const R3BEventHeaderBlock& GetHeaderBlock() const { return fHeaderBlock; }
 
   private:
+    /* Fetch the next event into event, returns 1 on success, 0 at the end
+     * of input and -1 on error */
+    Int_t FetchEvent(void* event, const void** raw, ssize_t* raw_words);
+    /* Call a single reader and account its wall time */
+    void RunReader(Int_t);
+
+
     /* File descriptor returned from popen() */
     FILE* fFd;
     /* The ucesb interface class */
@@ -92,6 +125,23 @@ class R3BUcesbSource : public FairSource
     FairLogger* fLogger;
     /* The array of readers */
     TObjArray* fReaders;
+    /* Number of threads used to run the readers */
+    UInt_t fNumReaderThreads;
+    /* Worker threads for the parallel readers */
+    R3BReaderPool* fReaderPool; //!
+    /* Reader indices run before and concurrently with each other */
+    std::vector<Int_t> fSerialReaders;
+    std::vector<Int_t> fParallelReaders;
+    /* Accumulated wall time per reader in seconds */
+    std::vector<Double_t> fReaderTime;
+    /* Number of event buffers fetched ahead */
+    UInt_t fPrefetchDepth;
+    /* Background fetching of events */
+    R3BUcesbEventRing* fEventRing; //!
+    /* Event structures of the last block */
+    std::vector<std::vector<char>> fBlockBuffers;
+    /* Event headers of the last block */
+    R3BEventHeaderBlock fHeaderBlock; //!
 
   public:
     /* Create dictionary */
@@ -15,6 +15,7 @@
 #include "FairLogger.h"
 #include "FairRootManager.h"
 #include "R3BEventHeader.h"
+#include "R3BEventHeaderBlock.h"
 
 extern "C"
 {
@@ -88,6 +89,21 @@ Bool_t R3BUnpackReader::Read()
     return kTRUE;
 }
 
+Bool_t R3BUnpackReader::ReadBlock(const void* const* events, UInt_t n, R3BEventHeaderBlock& header)
+{
+    for (UInt_t e = 0; e < n; e++)
+    {
+        auto data = (const EXT_STR_h101_unpack*)((const char*)events[e] + fOffset);
+        header.SetTrigger(e, data->TRIGGER);
+        header.SetEventno(e, data->EVENTNO);
+    }
+    if (n > 0)
+    {
+        fNEvent = header.GetEventno(n - 1);
+    }
+    return kTRUE;
+}
+
 void R3BUnpackReader::Reset() { fNEvent = 0; }
 
 ClassImp(R3BUnpackReader)
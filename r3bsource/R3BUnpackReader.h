@@ -30,7 +30,10 @@ class R3BUnpackReader : public R3BReader
 
     Bool_t Init(ext_data_struct_info*);
     Bool_t Read();
+    Bool_t ReadBlock(const void* const*, UInt_t, R3BEventHeaderBlock&);
     void Reset();
+    /* Fills R3BEventHeader, which other readers use */
+    Bool_t IsParallelSafe() const { return kFALSE; }
 
   private:
     /* An event counter */
@@ -0,0 +1,65 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTdcBlock.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    TEST(testR3BTdcBlock, eventOffsets)
+    {
+        R3BTdcBlock block;
+        EXPECT_EQ(block.GetNEvents(), 0u);
+
+        // 2 hits, no hit, 1 hit
+        block.Add(1, 1, 3, 1, 100, 10);
+        block.Add(1, 2, 3, 2, 101, 11);
+        block.EndEvent();
+        block.EndEvent();
+        block.Add(4, 1, 7, 1, 200, 20);
+        block.EndEvent();
+
+        ASSERT_EQ(block.GetNEvents(), 3u);
+        EXPECT_EQ(block.GetNHits(), 3u);
+        EXPECT_EQ(block.GetEventBegin(0), 0u);
+        EXPECT_EQ(block.GetEventEnd(0), 2u);
+        EXPECT_EQ(block.GetEventBegin(1), 2u);
+        EXPECT_EQ(block.GetEventEnd(1), 2u);
+        EXPECT_EQ(block.GetEventBegin(2), 2u);
+        EXPECT_EQ(block.GetEventEnd(2), 3u);
+
+        EXPECT_EQ(block.GetDetector()[2], 4u);
+        EXPECT_EQ(block.GetSide()[1], 2u);
+        EXPECT_EQ(block.GetChannel()[2], 7u);
+        EXPECT_EQ(block.GetEdge()[1], 2u);
+        EXPECT_EQ(block.GetTimeCoarse()[1], 101u);
+        EXPECT_EQ(block.GetTimeFine()[2], 20u);
+    }
+
+    TEST(testR3BTdcBlock, clearStartsNewBlock)
+    {
+        R3BTdcBlock block;
+        block.Add(1, 1, 1, 1, 1, 1);
+        block.EndEvent();
+        block.Clear();
+        EXPECT_EQ(block.GetNEvents(), 0u);
+        EXPECT_EQ(block.GetNHits(), 0u);
+
+        block.Add(2, 1, 1, 1, 1, 1);
+        block.EndEvent();
+        ASSERT_EQ(block.GetNEvents(), 1u);
+        EXPECT_EQ(block.GetEventBegin(0), 0u);
+        EXPECT_EQ(block.GetEventEnd(0), 1u);
+        EXPECT_EQ(block.GetDetector()[0], 2u);
+    }
+} // namespace
@@ -0,0 +1,152 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BEventHeaderBlock.h"
+#include "R3BTofdMappedData.h"
+#include "R3BTofdReader.h"
+#include "R3BTrloiiTpatReader.h"
+#include "R3BUnpackReader.h"
+#include "TClonesArray.h"
+#include "gtest/gtest.h"
+
+extern "C"
+{
+#include "ext_h101_tofd.h"
+#include "ext_h101_tpat.h"
+#include "ext_h101_unpack.h"
+}
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // The full event structure of an unpacker with these readers
+    struct Event
+    {
+        EXT_STR_h101_unpack unpack;
+        EXT_STR_h101_TPAT tpat;
+        EXT_STR_h101_TOFD tofd;
+    };
+
+    // Multi-hit channels on some of the planes and sides, and some triggers
+    void FillRandom(Event& event, UInt_t eventno, std::mt19937& rng)
+    {
+        event.unpack.EVENTNO = eventno;
+        event.unpack.TRIGGER = 1 + rng() % 3;
+        event.tpat.TPAT = rng() % 2;
+        event.tpat.TPATv[0] = rng() % 65536;
+
+        auto data = (EXT_STR_h101_TOFD_onion*)&event.tofd;
+        for (auto& plane : data->TOFD_P)
+        {
+            for (auto& side : plane.T)
+            {
+                UInt_t nLead = 0, nTrail = 0, nChannelsLead = 0, nChannelsTrail = 0;
+                for (UInt_t channel = 1; channel <= 48; channel++)
+                {
+                    if (rng() % 8 != 0)
+                    {
+                        continue;
+                    }
+                    for (UInt_t n = 1 + rng() % 3; n > 0; n--)
+                    {
+                        side.TCLv[nLead] = rng() % 2048;
+                        side.TFLv[nLead++] = rng() % 1024;
+                    }
+                    side.TCLMI[nChannelsLead] = channel;
+                    side.TCLME[nChannelsLead++] = nLead;
+                    for (UInt_t n = rng() % 3; n > 0; n--)
+                    {
+                        side.TCTv[nTrail] = rng() % 2048;
+                        side.TFTv[nTrail++] = rng() % 1024;
+                    }
+                    side.TCTMI[nChannelsTrail] = channel;
+                    side.TCTME[nChannelsTrail++] = nTrail;
+                }
+                side.TCLM = side.TFLM = nChannelsLead;
+                side.TCL = side.TFL = nLead;
+                side.TCTM = side.TFTM = nChannelsTrail;
+                side.TCT = side.TFT = nTrail;
+            }
+        }
+
+        data->TOFD_TRIGFL = data->TOFD_TRIGCL = rng() % 4;
+        for (UInt_t i = 0; i < data->TOFD_TRIGFL; i++)
+        {
+            data->TOFD_TRIGFLI[i] = data->TOFD_TRIGCLI[i] = 1 + i;
+            data->TOFD_TRIGFLv[i] = rng() % 1024;
+            data->TOFD_TRIGCLv[i] = rng() % 2048;
+        }
+    }
+
+    void ExpectSame(const TClonesArray* array, const R3BTdcBlock& block, UInt_t event)
+    {
+        ASSERT_EQ((UInt_t)array->GetEntriesFast(), block.GetEventEnd(event) - block.GetEventBegin(event));
+        for (Int_t i = 0; i < array->GetEntriesFast(); i++)
+        {
+            auto hit = (const R3BTofdMappedData*)array->At(i);
+            const UInt_t k = block.GetEventBegin(event) + i;
+            EXPECT_EQ(hit->GetDetectorId(), block.GetDetector()[k]);
+            EXPECT_EQ(hit->GetSideId(), block.GetSide()[k]);
+            EXPECT_EQ(hit->GetBarId(), block.GetChannel()[k]);
+            EXPECT_EQ(hit->GetEdgeId(), block.GetEdge()[k]);
+            EXPECT_EQ(hit->GetTimeCoarse(), block.GetTimeCoarse()[k]);
+            EXPECT_EQ(hit->GetTimeFine(), block.GetTimeFine()[k]);
+        }
+    }
+
+    TEST(testR3BTofdReader, readBlockMatchesRead)
+    {
+        const UInt_t n = 6;
+        std::mt19937 rng(7);
+        std::vector<std::unique_ptr<Event>> events;
+        std::vector<const void*> block;
+        for (UInt_t e = 0; e < n; e++)
+        {
+            events.emplace_back(new Event());
+            FillRandom(*events.back(), 1000 + e, rng);
+            block.push_back(events.back().get());
+        }
+
+        // Read() looks at this one, ReadBlock() at the block
+        std::unique_ptr<Event> current(new Event());
+        R3BUnpackReader unpackReader(&current->unpack, offsetof(Event, unpack));
+        R3BTrloiiTpatReader tpatReader(&current->tpat, offsetof(Event, tpat));
+        R3BTofdReader tofdReader(&current->tofd, offsetof(Event, tofd));
+
+        R3BEventHeaderBlock header;
+        header.Resize(n);
+        ASSERT_TRUE(unpackReader.ReadBlock(block.data(), n, header));
+        ASSERT_TRUE(tpatReader.ReadBlock(block.data(), n, header));
+        ASSERT_TRUE(tofdReader.ReadBlock(block.data(), n, header));
+        ASSERT_EQ(tofdReader.GetBlock().GetNEvents(), n);
+        ASSERT_EQ(tofdReader.GetTriggerBlock().GetNEvents(), n);
+        EXPECT_GT(tofdReader.GetBlock().GetNHits(), 0u);
+
+        for (UInt_t e = 0; e < n; e++)
+        {
+            *current = *events[e];
+            tofdReader.Reset();
+            ASSERT_TRUE(tofdReader.Read());
+            ExpectSame(tofdReader.GetArray(), tofdReader.GetBlock(), e);
+            ExpectSame(tofdReader.GetTriggerArray(), tofdReader.GetTriggerBlock(), e);
+
+            EXPECT_EQ(header.GetEventno(e), events[e]->unpack.EVENTNO);
+            EXPECT_EQ(header.GetTrigger(e), events[e]->unpack.TRIGGER);
+            EXPECT_EQ(header.GetTpat(e), events[e]->tpat.TPAT > 0 ? events[e]->tpat.TPATv[0] : 0u);
+        }
+    }
+} // namespace
@@ -20,8 +20,24 @@
 #include "TH1F.h"
 #include "TPad.h"
 
+#include <algorithm>
+
 using namespace std;
 
+namespace
+{
+    // Largest range of TDC values covered by a lookup table
+    const Int_t kMaxLutSize = 1 << 16;
+    // Lookup table entry for TDC values outside of all segments
+    const UShort_t kNoSegment = 0xFFFF;
+
+    // Shared by scan and lookup, so that both give identical results
+    inline Double_t TacquilaTime(Double_t offset, Double_t slope, Int_t tdc, Int_t binLow)
+    {
+        return offset + slope * (Double_t)(tdc - binLow);
+    }
+} // namespace
+
 ClassImp(R3BTCalModulePar);
 
 R3BTCalModulePar::R3BTCalModulePar(const char* name, const char* title, const char* context, Bool_t own)
@@ -30,6 +46,12 @@ R3BTCalModulePar::R3BTCalModulePar(const char* name, const char* title, const ch
     , fPaddle(0)
     , fSide(0)
     , fNofChannels(0)
+    , fExactBuilt(kFALSE)
+    , fExactMin(0)
+    , fExactLut()
+    , fRangeBuilt(kFALSE)
+    , fRangeMin(0)
+    , fRangeLut()
 {
     // Reset all parameters
     clear();
@@ -92,6 +114,7 @@ Bool_t R3BTCalModulePar::getParams(FairParamList* list)
     {
         return kFALSE;
     }
+    ResetLookupTables();
 
     return kTRUE;
 }
@@ -106,6 +129,7 @@ void R3BTCalModulePar::clear()
         fSlope[i] = 0.;
         fOffset[i] = 0.;
     }
+    ResetLookupTables();
 }
 
 void R3BTCalModulePar::printParams()
@@ -124,6 +148,62 @@ void R3BTCalModulePar::printParams()
 }
 
 Double_t R3BTCalModulePar::GetTimeClockTDC(Int_t tdc)
+{
+    if (!fExactBuilt)
+    {
+        BuildExactLookup();
+    }
+    if (fExactLut.empty())
+    {
+        return GetTimeClockTDCScan(tdc);
+    }
+    UInt_t bin = tdc - fExactMin;
+    if (bin >= fExactLut.size() || kNoSegment == fExactLut[bin])
+    {
+        return -10000.;
+    }
+    return fOffset[fExactLut[bin]];
+}
+
+Double_t R3BTCalModulePar::GetTimeTacquila(Int_t tdc)
+{
+    if (!fRangeBuilt)
+    {
+        BuildRangeLookup();
+    }
+    if (fRangeLut.empty())
+    {
+        return GetTimeTacquilaScan(tdc);
+    }
+    tdc = tdc + 1;
+    UInt_t bin = tdc - fRangeMin;
+    if (bin >= fRangeLut.size() || kNoSegment == fRangeLut[bin])
+    {
+        return -10000.;
+    }
+    Int_t i = fRangeLut[bin];
+    return TacquilaTime(fOffset[i], fSlope[i], tdc, fBinLow[i]);
+}
+
+Double_t R3BTCalModulePar::GetTimeVFTX(Int_t tdc)
+{
+    if (!fExactBuilt)
+    {
+        BuildExactLookup();
+    }
+    if (fExactLut.empty())
+    {
+        return GetTimeVFTXScan(tdc);
+    }
+    UInt_t bin = tdc + 1 - fExactMin;
+    if (bin >= fExactLut.size() || kNoSegment == fExactLut[bin])
+    {
+        return -10000.;
+    }
+    return fOffset[fExactLut[bin]];
+}
+
+Double_t R3BTCalModulePar::GetTimeClockTDCScan(Int_t tdc) const
 {
     for (Int_t i = 0; i < fNofChannels; i++)
     {
@@ -136,21 +216,21 @@ Double_t R3BTCalModulePar::GetTimeClockTDC(Int_t tdc)
     return -10000.;
 }
 
-Double_t R3BTCalModulePar::GetTimeTacquila(Int_t tdc)
+Double_t R3BTCalModulePar::GetTimeTacquilaScan(Int_t tdc) const
 {
     tdc = tdc + 1;
     for (Int_t i = 0; i < fNofChannels; i++)
     {
         if (tdc >= fBinLow[i] && tdc <= fBinUp[i])
         {
-            Double_t time = fOffset[i] + fSlope[i] * (Double_t)(tdc - fBinLow[i]);
+            Double_t time = TacquilaTime(fOffset[i], fSlope[i], tdc, fBinLow[i]);
             return time;
         }
     }
     return -10000.;
 }
 
-Double_t R3BTCalModulePar::GetTimeVFTX(Int_t tdc)
+Double_t R3BTCalModulePar::GetTimeVFTXScan(Int_t tdc) const
 {
     for (Int_t i = 0; i < fNofChannels; i++)
     {
@@ -163,6 +243,74 @@ Double_t R3BTCalModulePar::GetTimeVFTX(Int_t tdc)
     return -10000.;
 }
 
+void R3BTCalModulePar::BuildLookupTables()
+{
+    BuildExactLookup();
+    BuildRangeLookup();
+}
+
+void R3BTCalModulePar::BuildExactLookup()
+{
+    fExactBuilt = kTRUE;
+    fExactLut.clear();
+    if (fNofChannels <= 0)
+    {
+        return;
+    }
+
+    Int_t nofChannels = std::min(fNofChannels, NCHMAX);
+    Int_t lo = *std::min_element(fBinLow, fBinLow + nofChannels);
+    Int_t hi = *std::max_element(fBinLow, fBinLow + nofChannels);
+    if ((Long64_t)hi - lo >= kMaxLutSize)
+    {
+        return;
+    }
+
+    fExactMin = lo;
+    fExactLut.assign(hi - lo + 1, kNoSegment);
+    // Backwards, so that the first matching segment wins as in the scan
+    for (Int_t i = nofChannels - 1; i >= 0; i--)
+    {
+        fExactLut[fBinLow[i] - lo] = i;
+    }
+}
+
+void R3BTCalModulePar::BuildRangeLookup()
+{
+    fRangeBuilt = kTRUE;
+    fRangeLut.clear();
+    if (fNofChannels <= 0)
+    {
+        return;
+    }
+
+    Int_t nofChannels = std::min(fNofChannels, NCHMAX);
+    Int_t lo = *std::min_element(fBinLow, fBinLow + nofChannels);
+    Int_t hi = *std::max_element(fBinUp, fBinUp + nofChannels);
+    if (hi < lo)
+    {
+        // No segment can match, an empty table would mean the scan
+        fRangeMin = lo;
+        fRangeLut.assign(1, kNoSegment);
+        return;
+    }
+    if ((Long64_t)hi - lo >= kMaxLutSize)
+    {
+        return;
+    }
+
+    fRangeMin = lo;
+    fRangeLut.assign(hi - lo + 1, kNoSegment);
+    // Backwards, so that the first matching segment wins as in the scan
+    for (Int_t i = nofChannels - 1; i >= 0; i--)
+    {
+        for (Int_t tdc = fBinLow[i]; tdc <= fBinUp[i]; tdc++)
+        {
+            fRangeLut[tdc - lo] = i;
+        }
+    }
+}
+
 void R3BTCalModulePar::DrawParams()
 {
     Int_t type = 2; // VFTX
@@ -16,6 +16,8 @@
 
 #include "FairParGenericSet.h"
 
+#include <vector>
+
 #define NCHMAX 5000
 
 class FairParamList;
@@ -82,6 +84,7 @@ class R3BTCalModulePar : public FairParGenericSet
     /**
      * Member function for converting TDC value into time [ns]
      * using calibration parameters for clock TDC electronics.
+     * The value is taken from a lookup table which is built on first use.
      * @param tdc a TDC value.
      * @return time value in nanoseconds.
      */
@@ -90,6 +93,7 @@ class R3BTCalModulePar : public FairParGenericSet
     /**
      * Member function for converting TDC value into time [ns]
      * using calibration parameters for TACQUILA electronics.
+     * The value is taken from a lookup table which is built on first use.
      * @param tdc a TDC value.
      * @return time value in nanoseconds.
      */
@@ -98,11 +102,25 @@ class R3BTCalModulePar : public FairParGenericSet
     /**
      * Member function for converting TDC value into time [ns]
      * using calibration parameters for VFTX electronics.
+     * The value is taken from a lookup table which is built on first use.
      * @param tdc a TDC value.
      * @return time value in nanoseconds.
      */
     Double_t GetTimeVFTX(Int_t tdc);
 
+    /**
+     * Reference implementations of the conversions above, which search
+     * all linear segments for every call.
+     */
+    Double_t GetTimeClockTDCScan(Int_t tdc) const;
+    Double_t GetTimeTacquilaScan(Int_t tdc) const;
+    Double_t GetTimeVFTXScan(Int_t tdc) const;
+
+    /**
+     * Build the lookup tables now instead of on first use, e.g. in ReInit().
+     */
+    void BuildLookupTables();
+
     /** Accessor functions **/
     Int_t GetPlane() const { return fPlane; }
     Int_t GetPaddle() const { return fPaddle; }
@@ -115,13 +133,37 @@ class R3BTCalModulePar : public FairParGenericSet
     void SetPlane(Int_t i) { fPlane = i; }
     void SetPaddle(Int_t i) { fPaddle = i; }
     void SetSide(Int_t i) { fSide = i; }
-    void IncrementNofChannels() { fNofChannels += 1; }
-    void SetBinLowAt(Int_t ch, Int_t i) { fBinLow[i] = ch; }
-    void SetBinUpAt(Int_t ch, Int_t i) { fBinUp[i] = ch; }
-    void SetSlopeAt(Double_t slope, Int_t i) { fSlope[i] = slope; }
-    void SetOffsetAt(Double_t offset, Int_t i) { fOffset[i] = offset; }
+    void IncrementNofChannels()
+    {
+        fNofChannels += 1;
+        ResetLookupTables();
+    }
+    void SetBinLowAt(Int_t ch, Int_t i)
+    {
+        fBinLow[i] = ch;
+        ResetLookupTables();
+    }
+    void SetBinUpAt(Int_t ch, Int_t i)
+    {
+        fBinUp[i] = ch;
+        ResetLookupTables();
+    }
+    void SetSlopeAt(Double_t slope, Int_t i)
+    {
+        fSlope[i] = slope;
+        ResetLookupTables();
+    }
+    void SetOffsetAt(Double_t offset, Int_t i)
+    {
+        fOffset[i] = offset;
+        ResetLookupTables();
+    }
 
   private:
+    void ResetLookupTables() { fExactBuilt = fRangeBuilt = kFALSE; }
+    void BuildExactLookup();
+    void BuildRangeLookup();
+
     Int_t fPlane;             /**< Index of a plane. */
     Int_t fPaddle;            /**< Index of a paddle. */
     Int_t fSide;              /**< Side of a module: for NeuLAND - L/R PMT. */
@@ -131,6 +173,15 @@ class R3BTCalModulePar : public FairParGenericSet
     Double_t fSlope[NCHMAX];  /**< Slope of liear interpolation. */
     Double_t fOffset[NCHMAX]; /**< Offset of linear interpolation [ns]. */
 
+    /* Segment index for every TDC value, 0xFFFF if none matches. Empty if
+     * the range of TDC values is too wide, then the scan is used. */
+    Bool_t fExactBuilt;              //! Table by fBinLow, for VFTX and clock TDC
+    Int_t fExactMin;                 //!
+    std::vector<UShort_t> fExactLut; //!
+    Bool_t fRangeBuilt;              //! Table by [fBinLow, fBinUp], for TACQUILA
+    Int_t fRangeMin;                 //!
+    std::vector<UShort_t> fRangeLut; //!
+
     ClassDef(R3BTCalModulePar, 1);
 };
 
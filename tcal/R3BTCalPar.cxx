@@ -17,12 +17,18 @@
 #include "FairParamList.h" // for FairParamList
 #include "FairRtdbRun.h"
 
+#include <algorithm>
+
 ClassImp(R3BTCalPar);
 
 R3BTCalPar::R3BTCalPar(const char* name, const char* title, const char* context, Bool_t own)
     : FairParGenericSet(name, title, context, own)
     , fTCalParams(new TObjArray(NMODULEMAX))
     , fMapInit(kFALSE)
+    , fNofPlanes(0)
+    , fNofPaddles(0)
+    , fNofSides(0)
+    , fIndex()
 {
 }
 
@@ -55,10 +61,18 @@ Bool_t R3BTCalPar::getParams(FairParamList* list)
     {
         return kFALSE;
     }
+    ResetIndex();
     return kTRUE;
 }
 
-void R3BTCalPar::clear() {}
+void R3BTCalPar::clear() { ResetIndex(); }
+
+void R3BTCalPar::ResetIndex()
+{
+    fMapInit = kFALSE;
+    fNofPlanes = fNofPaddles = fNofSides = 0;
+    fIndex.clear();
+}
 
 void R3BTCalPar::printParams()
 {
@@ -77,66 +91,96 @@ void R3BTCalPar::printParams()
     }
 }
 
-R3BTCalModulePar* R3BTCalPar::GetModuleParAt(Int_t plane, Int_t paddle, Int_t side)
+void R3BTCalPar::BuildIndex()
 {
-    if (!fMapInit)
+    R3BTCalModulePar* par;
+    Int_t tplane;
+    Int_t tpaddle;
+    Int_t tside;
+
+    // Size the table by the modules that are actually there
+    fNofPlanes = fNofPaddles = fNofSides = 0;
+    for (Int_t i = 0; i < fTCalParams->GetEntries(); i++)
     {
-        fIndexMap.clear();
-        R3BTCalModulePar* par;
-        Int_t tplane;
-        Int_t tpaddle;
-        Int_t tside;
-        Int_t index;
-        for (Int_t i = 0; i < fTCalParams->GetEntries(); i++)
+        par = (R3BTCalModulePar*)fTCalParams->At(i);
+        if (NULL == par)
         {
-            par = (R3BTCalModulePar*)fTCalParams->At(i);
-            if (NULL == par)
-            {
-                continue;
-            }
-            tplane = par->GetPlane();
-            tpaddle = par->GetPaddle();
-            tside = par->GetSide();
-            if (tplane < 1 || tplane > N_PLANE_MAX || tpaddle < 1 || tpaddle > N_PADDLE_MAX || tside < 1 ||
-                tside > N_SIDE_MAX)
-            {
-                LOG(ERROR) << "R3BTCalPar::GetModuleParAt : error in plane/paddle/side indexing. " << tplane << " / "
-                           << tpaddle << " / " << tside;
-                continue;
-            }
-            index = (tplane - 1) * N_PADDLE_MAX * N_SIDE_MAX + (tpaddle - 1) * N_SIDE_MAX + tside - 1;
-            if (fIndexMap.find(index) != fIndexMap.end())
-            {
-                LOG(ERROR) << "R3BTCalPar::GetModuleParAt : parameter found more than once. " << tplane << " / "
-                           << tpaddle << " / " << tside;
-                continue;
-            }
-            fIndexMap[index] = i;
+            continue;
+        }
+        tplane = par->GetPlane();
+        tpaddle = par->GetPaddle();
+        tside = par->GetSide();
+        if (tplane < 1 || tplane > N_PLANE_MAX || tpaddle < 1 || tpaddle > N_PADDLE_MAX || tside < 1 ||
+            tside > N_SIDE_MAX)
+        {
+            continue;
         }
-        fMapInit = kTRUE;
+        fNofPlanes = std::max(fNofPlanes, (UInt_t)tplane);
+        fNofPaddles = std::max(fNofPaddles, (UInt_t)tpaddle);
+        fNofSides = std::max(fNofSides, (UInt_t)tside);
     }
 
+    fIndex.assign(fNofPlanes * fNofPaddles * fNofSides, NULL);
+    for (Int_t i = 0; i < fTCalParams->GetEntries(); i++)
+    {
+        par = (R3BTCalModulePar*)fTCalParams->At(i);
+        if (NULL == par)
+        {
+            continue;
+        }
+        tplane = par->GetPlane();
+        tpaddle = par->GetPaddle();
+        tside = par->GetSide();
+        if (tplane < 1 || tplane > N_PLANE_MAX || tpaddle < 1 || tpaddle > N_PADDLE_MAX || tside < 1 ||
+            tside > N_SIDE_MAX)
+        {
+            LOG(ERROR) << "R3BTCalPar::GetModuleParAt : error in plane/paddle/side indexing. " << tplane << " / "
+                       << tpaddle << " / " << tside;
+            continue;
+        }
+        R3BTCalModulePar*& entry = fIndex[((tplane - 1) * fNofPaddles + tpaddle - 1) * fNofSides + tside - 1];
+        if (NULL != entry)
+        {
+            LOG(ERROR) << "R3BTCalPar::GetModuleParAt : parameter found more than once. " << tplane << " / "
+                       << tpaddle << " / " << tside;
+            continue;
+        }
+        entry = par;
+    }
+    fMapInit = kTRUE;
+}
+
+R3BTCalModulePar* R3BTCalPar::ModuleParNotFound(Int_t plane, Int_t paddle, Int_t side)
+{
     if (plane < 1 || plane > N_PLANE_MAX || paddle < 1 || paddle > N_PADDLE_MAX || side < 1 || side > N_SIDE_MAX)
     {
         LOG(ERROR) << "R3BTCalPar::GetModuleParAt : error in plane/paddle/side indexing. " << plane << " / " << paddle
                    << " / " << side;
         return NULL;
     }
-    Int_t index = (plane - 1) * N_PADDLE_MAX * N_SIDE_MAX + (paddle - 1) * N_SIDE_MAX + side - 1;
+    LOG(WARNING) << "R3BTCalPar::GetModuleParAt : parameter not found for: " << plane << " / " << paddle << " / "
+                 << side;
+    return NULL;
+}
 
-    if (fIndexMap.find(index) == fIndexMap.end())
+Int_t R3BTCalPar::GetModuleParAt(Int_t n,
+                                 const Int_t* plane,
+                                 const Int_t* paddle,
+                                 const Int_t* side,
+                                 R3BTCalModulePar** par)
+{
+    Int_t nFound = 0;
+    for (Int_t i = 0; i < n; i++)
     {
-        LOG(WARNING) << "R3BTCalPar::GetModuleParAt : parameter not found for: " << plane << " / " << paddle << " / "
-                     << side;
-        return NULL;
+        par[i] = GetModuleParAt(plane[i], paddle[i], side[i]);
+        nFound += (NULL != par[i]);
     }
-    Int_t arind = fIndexMap[index];
-    return (R3BTCalModulePar*)fTCalParams->At(arind);
+    return nFound;
 }
 
 void R3BTCalPar::AddModulePar(R3BTCalModulePar* tch)
 {
-    fMapInit = kFALSE;
+    ResetIndex();
     fTCalParams->Add(tch);
 }
 
@@ -24,6 +24,7 @@
 #include "R3BTCalModulePar.h"
 #include "TObjArray.h"
 #include <map>
+#include <vector>
 
 using namespace std;
 
@@ -140,21 +141,64 @@ class R3BTCalPar : public FairParGenericSet
 
     /**
      * Method to get single parameter container for a specific module.
-     * @param idx an index of a module.
+     * The containers are looked up in a dense plane x paddle x side table,
+     * which is built on the first call.
+     * @param plane an index of detector plane
+     * @param paddle a paddle index within the plane
+     * @param side a side of a paddle
      * @return parameter container of this module.
      */
-    R3BTCalModulePar* GetModuleParAt(Int_t plane, Int_t paddle, Int_t side);
+    R3BTCalModulePar* GetModuleParAt(Int_t plane, Int_t paddle, Int_t side)
+    {
+        if (!fMapInit)
+        {
+            BuildIndex();
+        }
+        UInt_t iPlane = plane - 1;
+        UInt_t iPaddle = paddle - 1;
+        UInt_t iSide = side - 1;
+        if (iPlane < fNofPlanes && iPaddle < fNofPaddles && iSide < fNofSides)
+        {
+            R3BTCalModulePar* par = fIndex[(iPlane * fNofPaddles + iPaddle) * fNofSides + iSide];
+            if (par)
+            {
+                return par;
+            }
+        }
+        return ModuleParNotFound(plane, paddle, side);
+    }
+
+    /**
+     * Method to get the parameter containers of many modules at once,
+     * e.g. for all channels of a mapped event.
+     * @param n number of modules
+     * @param plane plane indices of the modules
+     * @param paddle paddle indices of the modules
+     * @param side side indices of the modules
+     * @param par output, parameter containers or NULL if not found
+     * @return number of modules for which a container was found
+     */
+    Int_t GetModuleParAt(Int_t n, const Int_t* plane, const Int_t* paddle, const Int_t* side, R3BTCalModulePar** par);
 
   private:
     const R3BTCalPar& operator=(const R3BTCalPar&); /**< an assignment operator */
     R3BTCalPar(const R3BTCalPar&);                  /**< a copy constructor */
 
+    void BuildIndex();
+    /** The index points into fTCalParams, it has to be rebuilt whenever the array is refilled,
+        also when it is streamed in, see the read rule in TCalLinkDef.h **/
+    void ResetIndex();
+    R3BTCalModulePar* ModuleParNotFound(Int_t plane, Int_t paddle, Int_t side);
+
     TObjArray* fTCalParams; /**< an array with parameter containers of all modules */
 
-    Bool_t fMapInit;             /**< a boolean flag for indication whether the indexing map is initialized */
-    map<Int_t, Int_t> fIndexMap; /**< a map between index of a container in array and plane,paddle,side */
+    Bool_t fMapInit;                       //! a boolean flag for indication whether fIndex is initialized
+    UInt_t fNofPlanes;                     //! dimensions of fIndex
+    UInt_t fNofPaddles;                    //!
+    UInt_t fNofSides;                      //!
+    std::vector<R3BTCalModulePar*> fIndex; //! parameter containers by plane,paddle,side
 
-    ClassDef(R3BTCalPar, 1);
+    ClassDef(R3BTCalPar, 2);
 };
 
 #endif /* !R3BTCALPAR_H*/
@@ -21,6 +21,7 @@
 
 #pragma link C++ class R3BTCalModulePar+;
 #pragma link C++ class R3BTCalPar+;
+#pragma read sourceClass="R3BTCalPar" targetClass="R3BTCalPar" version="[1-]" source="" target="fMapInit" code="{ fMapInit = kFALSE; }"
 #pragma link C++ class R3BTCalContFact+;
 #pragma link C++ class R3BTCalEngine+;
 
@@ -0,0 +1,106 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Converts TDC values through the scan and the lookup table of
+// R3BTCalModulePar and compares speed and results.
+// Usage: benchR3BTCalModulePar [number of conversions, default 1e8]
+
+#include "R3BTCalModulePar.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Int_t kNofBins = 1000;
+    const Int_t kNofValues = 1 << 16;
+
+    template <typename F>
+    Double_t Run(const char* name, Long64_t n, const std::vector<Int_t>& tdcs, F convert, std::vector<Double_t>& out)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Double_t sum = 0.;
+        for (Long64_t i = 0; i < n; i++)
+        {
+            const Double_t t = convert(tdcs[i % kNofValues]);
+            if (i < kNofValues)
+            {
+                out[i] = t;
+            }
+            sum += t;
+        }
+        const Double_t s = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+        std::cout << name << ": " << s << " s, " << 1e9 * s / n << " ns/conversion (sum " << sum << ")" << std::endl;
+        return s;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Long64_t n = argc > 1 ? atof(argv[1]) : 1e8;
+
+    // VFTX-like: one bin per fine time value, TACQUILA-like: linear segments
+    R3BTCalModulePar vftx;
+    R3BTCalModulePar tacquila;
+    Double_t offset = 0.;
+    for (Int_t i = 0; i < kNofBins; i++)
+    {
+        offset += 5. / kNofBins;
+        vftx.SetBinLowAt(i + 1, i);
+        vftx.SetBinUpAt(i + 1, i);
+        vftx.SetOffsetAt(offset, i);
+        vftx.IncrementNofChannels();
+        tacquila.SetBinLowAt(4 * i, i);
+        tacquila.SetBinUpAt(4 * i + 3, i);
+        tacquila.SetOffsetAt(4. * offset, i);
+        tacquila.SetSlopeAt(0.005, i);
+        tacquila.IncrementNofChannels();
+    }
+    vftx.BuildLookupTables();
+    tacquila.BuildLookupTables();
+
+    std::mt19937 rng(1);
+    std::vector<Int_t> tdcs(kNofValues);
+    for (auto& tdc : tdcs)
+    {
+        tdc = rng() % (4 * kNofBins);
+    }
+
+    std::vector<Double_t> scan(kNofValues);
+    std::vector<Double_t> lut(kNofValues);
+    Int_t failed = 0;
+
+    std::cout << "Converting " << n << " TDC values through " << kNofBins << " bins" << std::endl;
+
+    Double_t tScan = Run("VFTX scan", n, tdcs, [&](Int_t tdc) { return vftx.GetTimeVFTXScan(tdc); }, scan);
+    Double_t tLut = Run("VFTX lookup", n, tdcs, [&](Int_t tdc) { return vftx.GetTimeVFTX(tdc); }, lut);
+    std::cout << "VFTX speedup: " << tScan / tLut << std::endl;
+    failed += memcmp(scan.data(), lut.data(), kNofValues * sizeof(Double_t)) != 0;
+
+    tScan = Run("TACQUILA scan", n, tdcs, [&](Int_t tdc) { return tacquila.GetTimeTacquilaScan(tdc); }, scan);
+    tLut = Run("TACQUILA lookup", n, tdcs, [&](Int_t tdc) { return tacquila.GetTimeTacquila(tdc); }, lut);
+    std::cout << "TACQUILA speedup: " << tScan / tLut << std::endl;
+    failed += memcmp(scan.data(), lut.data(), kNofValues * sizeof(Double_t)) != 0;
+
+    if (failed)
+    {
+        std::cout << "Results of scan and lookup differ!" << std::endl;
+        return 1;
+    }
+    std::cout << "Results of scan and lookup are identical." << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTCalModulePar.h"
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <random>
+
+namespace
+{
+    // Segments of random width, with some overlaps and empty segments
+    void FillRandom(R3BTCalModulePar& par, std::mt19937& rng)
+    {
+        const Int_t n = rng() % 1200;
+        Int_t pos = rng() % 50;
+        for (Int_t i = 0; i < n; i++)
+        {
+            const Int_t width = rng() % 6;
+            par.SetBinLowAt(pos, i);
+            par.SetBinUpAt(pos + width - 1, i);
+            par.SetSlopeAt((rng() % 1000) / 997., i);
+            par.SetOffsetAt((rng() % 100000) / 7., i);
+            par.IncrementNofChannels();
+            pos += (rng() % 10 == 0) ? -2 : width;
+        }
+    }
+
+    ::testing::AssertionResult BitEqual(Double_t a, Double_t b)
+    {
+        if (0 == memcmp(&a, &b, sizeof(Double_t)))
+        {
+            return ::testing::AssertionSuccess();
+        }
+        return ::testing::AssertionFailure() << a << " != " << b;
+    }
+
+    TEST(testR3BTCalModulePar, lookupMatchesScan)
+    {
+        std::mt19937 rng(42);
+        for (Int_t trial = 0; trial < 50; trial++)
+        {
+            R3BTCalModulePar par;
+            FillRandom(par, rng);
+            for (Int_t tdc = -10; tdc < 5000; tdc++)
+            {
+                ASSERT_TRUE(BitEqual(par.GetTimeVFTX(tdc), par.GetTimeVFTXScan(tdc)));
+                ASSERT_TRUE(BitEqual(par.GetTimeClockTDC(tdc), par.GetTimeClockTDCScan(tdc)));
+                ASSERT_TRUE(BitEqual(par.GetTimeTacquila(tdc), par.GetTimeTacquilaScan(tdc)));
+            }
+        }
+    }
+
+    TEST(testR3BTCalModulePar, lookupFollowsChanges)
+    {
+        R3BTCalModulePar par;
+        par.SetBinLowAt(10, 0);
+        par.SetBinUpAt(20, 0);
+        par.SetOffsetAt(5., 0);
+        par.SetSlopeAt(0.5, 0);
+        par.IncrementNofChannels();
+        EXPECT_EQ(par.GetTimeTacquila(9), 5.);
+        EXPECT_EQ(par.GetTimeVFTX(9), 5.);
+
+        par.SetOffsetAt(7., 0);
+        EXPECT_EQ(par.GetTimeTacquila(9), 7.);
+        EXPECT_EQ(par.GetTimeVFTX(9), 7.);
+
+        par.clear();
+        EXPECT_EQ(par.GetTimeTacquila(9), -10000.);
+        EXPECT_EQ(par.GetTimeVFTX(9), -10000.);
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
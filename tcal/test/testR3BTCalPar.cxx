@@ -0,0 +1,89 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTCalModulePar.h"
+#include "R3BTCalPar.h"
+#include "gtest/gtest.h"
+
+#include "TBufferFile.h"
+
+namespace
+{
+    R3BTCalModulePar* MakeModulePar(Int_t plane, Int_t paddle, Int_t side, Double_t offset)
+    {
+        R3BTCalModulePar* par = new R3BTCalModulePar();
+        par->SetPlane(plane);
+        par->SetPaddle(paddle);
+        par->SetSide(side);
+        par->SetBinLowAt(0, 0);
+        par->SetBinUpAt(4095, 0);
+        par->SetOffsetAt(offset, 0);
+        par->IncrementNofChannels();
+        return par;
+    }
+
+    TEST(testR3BTCalPar, lookupFindsModules)
+    {
+        R3BTCalPar par("LosTCalPar");
+        par.AddModulePar(MakeModulePar(1, 1, 1, 1.));
+        par.AddModulePar(MakeModulePar(1, 3, 2, 2.));
+        par.AddModulePar(MakeModulePar(2, 2, 1, 3.));
+
+        ASSERT_NE(par.GetModuleParAt(1, 3, 2), nullptr);
+        EXPECT_EQ(par.GetModuleParAt(1, 3, 2)->GetOffsetAt(0), 2.);
+        EXPECT_EQ(par.GetModuleParAt(2, 2, 1)->GetOffsetAt(0), 3.);
+        EXPECT_EQ(par.GetModuleParAt(2, 1, 1), nullptr);
+        EXPECT_EQ(par.GetModuleParAt(3, 1, 1), nullptr);
+        EXPECT_EQ(par.GetModuleParAt(0, 1, 1), nullptr);
+    }
+
+    // What a parameter version change does: clear(), then the array is refilled behind AddModulePar()
+    TEST(testR3BTCalPar, lookupFollowsRefill)
+    {
+        R3BTCalPar par("LosTCalPar");
+        par.AddModulePar(MakeModulePar(1, 1, 1, 1.));
+        ASSERT_NE(par.GetModuleParAt(1, 1, 1), nullptr);
+
+        par.clear();
+        par.GetListOfModulePar()->Delete();
+        par.GetListOfModulePar()->Add(MakeModulePar(1, 1, 1, 5.));
+        par.GetListOfModulePar()->Add(MakeModulePar(4, 7, 2, 6.));
+
+        ASSERT_NE(par.GetModuleParAt(1, 1, 1), nullptr);
+        EXPECT_EQ(par.GetModuleParAt(1, 1, 1)->GetOffsetAt(0), 5.);
+        ASSERT_NE(par.GetModuleParAt(4, 7, 2), nullptr);
+        EXPECT_EQ(par.GetModuleParAt(4, 7, 2)->GetOffsetAt(0), 6.);
+    }
+
+    // Streaming into a container that was used before, as reading a new version from a ROOT file does
+    TEST(testR3BTCalPar, lookupFollowsStreamer)
+    {
+        R3BTCalPar written("LosTCalPar");
+        written.AddModulePar(MakeModulePar(1, 2, 1, 7.));
+        written.AddModulePar(MakeModulePar(3, 1, 2, 8.));
+        TBufferFile out(TBuffer::kWrite);
+        written.Streamer(out);
+
+        R3BTCalPar par("LosTCalPar");
+        par.AddModulePar(MakeModulePar(1, 2, 1, 1.));
+        ASSERT_NE(par.GetModuleParAt(1, 2, 1), nullptr);
+
+        TBufferFile in(TBuffer::kRead, out.Length(), out.Buffer(), kFALSE);
+        par.Streamer(in);
+
+        ASSERT_NE(par.GetModuleParAt(1, 2, 1), nullptr);
+        EXPECT_EQ(par.GetModuleParAt(1, 2, 1)->GetOffsetAt(0), 7.);
+        ASSERT_NE(par.GetModuleParAt(3, 1, 2), nullptr);
+        EXPECT_EQ(par.GetModuleParAt(3, 1, 2)->GetOffsetAt(0), 8.);
+    }
+} // namespace
@@ -0,0 +1,208 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <stdio.h>
+
+#include <TFile.h>
+#include <TSystem.h>
+
+#include "StreamingStitcher.h"
+#include "TreeIterator.h"
+
+using namespace std;
+
+namespace R3BCalifaTimestitcher
+{
+    namespace
+    {
+        const int kCheckpointVersion = 1;
+        // Less read-ahead than a basket does not save any reads
+        const Long64_t kMinReadAhead = 64 * 1024;
+        const Int_t kMinBasketSize = 4 * 1024;
+    } // namespace
+
+    StreamingStitcher::StreamingStitcher(vector<TreeWrapper*>& _trees, TTree* _merged, const string& outName)
+        : trees(_trees)
+        , merged(_merged)
+        , outBase(outName)
+        , window(500)
+        , memoryBudget(256 * 1024 * 1024)
+        , chunkEntries(1000000)
+        , chunk(0)
+        , steps(0)
+        , filled(0)
+        , chunkFile(NULL)
+        , chunkTree(NULL)
+        , finished(false)
+    {
+        const size_t ext = outBase.rfind(".root");
+        if (ext != string::npos && ext + 5 == outBase.size())
+            outBase.erase(ext);
+        checkpointName = outBase + ".checkpoint";
+    }
+
+    StreamingStitcher::~StreamingStitcher()
+    {
+        // Only open if run() was interrupted, the chunk is left as .part
+        delete chunkFile;
+    }
+
+    string StreamingStitcher::chunkName(uint32_t n) const
+    {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), "_%04u.root", n);
+        return outBase + suffix;
+    }
+
+    void StreamingStitcher::openChunk()
+    {
+        // Written under a temporary name, a crash never leaves a truncated chunk behind
+        const string name = chunkName(chunk) + ".part";
+        chunkFile = TFile::Open(name.c_str(), "RECREATE");
+        if (!chunkFile || chunkFile->IsZombie())
+            throw runtime_error("StreamingStitcher: Could not open " + name + " for writing!");
+
+        chunkFile->cd();
+        chunkTree = merged->CloneTree(0);
+        chunkTree->SetDirectory(chunkFile);
+
+        // Half of the budget for the output baskets
+        const Long64_t outputBudget = memoryBudget / 2;
+        const Int_t nBaskets = max(1, chunkTree->GetListOfLeaves()->GetEntries());
+        chunkTree->SetBasketSize("*", (Int_t)max<Long64_t>(kMinBasketSize, outputBudget / nBaskets));
+        chunkTree->SetAutoFlush(-outputBudget);
+    }
+
+    void StreamingStitcher::closeChunk()
+    {
+        const string name = chunkName(chunk);
+        chunkFile->cd();
+        chunkTree->Write();
+        chunkFile->Close();
+        delete chunkFile;
+        chunkFile = NULL;
+        chunkTree = NULL;
+
+        if (gSystem->Rename((name + ".part").c_str(), name.c_str()) != 0)
+            throw runtime_error("StreamingStitcher: Could not rename " + name + ".part!");
+        cout << "Wrote " << name << ", " << filled << " of " << steps << " entries merged so far" << endl;
+        chunk++;
+    }
+
+    bool StreamingStitcher::readCheckpoint()
+    {
+        ifstream in(checkpointName.c_str());
+        if (!in)
+            return false;
+
+        string line, word;
+        int version = 0;
+        getline(in, line);
+        if (sscanf(line.c_str(), "# R3BCalifaTimestitcher checkpoint version %d", &version) != 1 ||
+            version != kCheckpointVersion)
+            throw runtime_error("StreamingStitcher: " + checkpointName + " is no checkpoint of this version!");
+
+        uint64_t cpWindow;
+        Long64_t cpChunkEntries;
+        size_t nInputs;
+        int done;
+        in >> word >> cpWindow >> word >> cpChunkEntries >> word >> nInputs;
+        in >> word >> chunk >> word >> steps >> word >> filled >> word >> done;
+        if (!in || cpWindow != window || cpChunkEntries != chunkEntries || nInputs != trees.size())
+            throw runtime_error("StreamingStitcher: " + checkpointName + " was written with other settings!");
+
+        for (size_t i = 0; i < nInputs; i++)
+        {
+            uint32_t id;
+            uint64_t position;
+            in >> id >> position;
+            if (!in || id != trees[i]->getId())
+                throw runtime_error("StreamingStitcher: " + checkpointName + " does not match the inputs!");
+            if (!done && !trees[i]->seek(position))
+                throw runtime_error("StreamingStitcher: Could not go back to the checkpoint in the inputs!");
+        }
+
+        cout << "Continuing from " << checkpointName << " at chunk " << chunk << ", " << filled << " of " << steps
+             << " entries merged" << endl;
+        finished = done;
+        return true;
+    }
+
+    void StreamingStitcher::writeCheckpoint(bool done)
+    {
+        const string tmpName = checkpointName + ".tmp";
+        {
+            ofstream out(tmpName.c_str());
+            out << "# R3BCalifaTimestitcher checkpoint version " << kCheckpointVersion << "\n";
+            out << "window " << window << " chunkEntries " << chunkEntries << " inputs " << trees.size() << "\n";
+            out << "chunk " << chunk << " steps " << steps << " filled " << filled << " done " << done << "\n";
+            for (auto t : trees)
+                out << t->getId() << " " << t->getPosition() << "\n";
+            if (!out.flush())
+                throw runtime_error("StreamingStitcher: Could not write " + tmpName + "!");
+        }
+        if (gSystem->Rename(tmpName.c_str(), checkpointName.c_str()) != 0)
+            throw runtime_error("StreamingStitcher: Could not rename " + tmpName + "!");
+    }
+
+    uint64_t StreamingStitcher::run()
+    {
+        // The other half of the budget for reading ahead in the inputs
+        const Long64_t inputBudget = memoryBudget / 2 / max<Long64_t>(1, trees.size());
+        for (auto t : trees)
+            t->setReadAhead(max(kMinReadAhead, inputBudget));
+
+        TreeIterator it(trees);
+        TreeWrapper* e;
+        if (readCheckpoint())
+        {
+            if (finished)
+                return filled;
+            it.resume();
+            e = it.next();
+        }
+        else
+        {
+            e = it.first();
+        }
+
+        Long64_t inChunk = 0;
+        for (; e != NULL; e = it.next())
+        {
+            steps++;
+            if (!it.isCoincident(window))
+                continue;
+
+            if (!chunkTree)
+                openChunk();
+            chunkTree->Fill();
+            filled++;
+
+            if (++inChunk == chunkEntries)
+            {
+                closeChunk();
+                writeCheckpoint(false);
+                inChunk = 0;
+            }
+        }
+
+        if (chunkTree)
+            closeChunk();
+        writeCheckpoint(true);
+        return filled;
+    }
+} // namespace R3BCalifaTimestitcher
@@ -0,0 +1,89 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef STREAMINGSTITCHER_H_
+#define STREAMINGSTITCHER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <TTree.h>
+
+#include "TreeWrapper.h"
+
+class TFile;
+
+namespace R3BCalifaTimestitcher
+{
+    class TreeIterator;
+
+    // Writes the merged events in chunks of separate files instead of one
+    // tree, <output>_0000.root, <output>_0001.root, ...
+    //
+    // merged is the tree set up by addTreeBranches(), it is only used as the
+    // template of the chunk trees and never filled. The output baskets and
+    // the read-ahead of the inputs share the memory budget.
+    //
+    // After every chunk the position of all inputs is written to a
+    // checkpoint file. If it exists, run() continues from there, so a job
+    // that crashed only repeats the chunk it was working on.
+    class StreamingStitcher
+    {
+      protected:
+        std::vector<TreeWrapper*>& trees;
+        TTree* merged;
+        std::string outBase;
+        std::string checkpointName;
+
+        uint64_t window;
+        Long64_t memoryBudget;
+        Long64_t chunkEntries;
+
+        uint32_t chunk;
+        uint64_t steps;
+        uint64_t filled;
+
+        TFile* chunkFile;
+        TTree* chunkTree;
+        bool finished;
+
+        std::string chunkName(uint32_t n) const;
+        void openChunk();
+        void closeChunk();
+
+        bool readCheckpoint();
+        void writeCheckpoint(bool done);
+
+      public:
+        StreamingStitcher(std::vector<TreeWrapper*>& trees, TTree* merged, const std::string& outName);
+        ~StreamingStitcher();
+
+        // Largest timestamp difference of the entries of a merged event
+        void setWindow(uint64_t w) { window = w; }
+        // Bytes for the output baskets and the input read-ahead together
+        void setMemoryBudget(Long64_t bytes) { memoryBudget = bytes; }
+        // Number of merged events per output file
+        void setChunkEntries(Long64_t n) { chunkEntries = n; }
+        // Default is <output>.checkpoint
+        void setCheckpoint(const std::string& name) { checkpointName = name; }
+
+        // Merge until one of the inputs is exhausted, returns the number of
+        // events written including those of an earlier, interrupted run
+        uint64_t run();
+
+        uint32_t getNumChunks() const { return chunk; }
+    };
+} // namespace R3BCalifaTimestitcher
+
+#endif
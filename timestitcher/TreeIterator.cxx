@@ -11,6 +11,8 @@
  * or submit itself to any jurisdiction.                                      *
  ******************************************************************************/
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 
 #include "TreeIterator.h"
@@ -21,48 +23,74 @@ namespace R3BCalifaTimestitcher
 {
     TreeIterator::TreeIterator(vector<TreeWrapper*>& _trees)
         : trees(_trees)
+        , maxTS(0)
+        , current(NULL)
     {
     }
 
+    void TreeIterator::push(uint32_t i)
+    {
+        const uint64_t ts = trees[i]->currentTS();
+        // Only the smallest timestamp is replaced, so the largest one can
+        // only go down if a single tree is left
+        maxTS = heap.empty() ? ts : max(maxTS, ts);
+        heap.push_back(make_pair(ts, i));
+        push_heap(heap.begin(), heap.end(), greater<pair<uint64_t, uint32_t>>());
+    }
+
     TreeWrapper* TreeIterator::first()
     {
-        TreeWrapper* t_min = NULL;
-        uint64_t ts_min = 0, cts;
+        heap.clear();
+        heap.reserve(trees.size());
+        current = NULL;
 
         for (unsigned int i = 0; i < trees.size(); i++)
         {
             if (!trees[i]->next())
                 return NULL;
-
-            cts = trees[i]->getTS();
-            if (ts_min == 0 || cts < ts_min)
-            {
-                ts_min = cts;
-                t_min = trees[i];
-            }
+            push(i);
         }
 
-        return t_min;
+        if (!heap.empty())
+            current = trees[heap.front().second];
+        return current;
     }
 
-    TreeWrapper* TreeIterator::next()
+    void TreeIterator::resume()
     {
-        TreeWrapper* t_min = NULL;
-        uint64_t ts_min = 0, cts;
+        heap.clear();
+        heap.reserve(trees.size());
+        current = NULL;
 
         for (unsigned int i = 0; i < trees.size(); i++)
+            push(i);
+    }
+
+    TreeWrapper* TreeIterator::next()
+    {
+        if (heap.empty())
+            return NULL;
+
+        pop_heap(heap.begin(), heap.end(), greater<pair<uint64_t, uint32_t>>());
+        const uint32_t i = heap.back().second;
+        heap.pop_back();
+
+        if (!trees[i]->next())
         {
-            cts = trees[i]->getTS();
-            if (ts_min == 0 || cts < ts_min)
-            {
-                ts_min = cts;
-                t_min = trees[i];
-            }
+            current = NULL;
+            return NULL;
         }
+        push(i);
 
-        if (!t_min || !t_min->next())
-            return NULL;
+        current = trees[i];
+        return current;
+    }
 
-        return t_min;
+    bool TreeIterator::isCoincident(uint64_t window) const
+    {
+        if (!current)
+            return false;
+        const uint64_t ts = current->currentTS();
+        return maxTS - ts < window && ts - getMinTS() < window;
     }
 } // namespace R3BCalifaTimestitcher
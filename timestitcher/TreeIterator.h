@@ -14,6 +14,8 @@
 #ifndef TREEITERATOR_H_
 #define TREEITERATOR_H_
 
+#include <stdint.h>
+#include <utility>
 #include <vector>
 
 #include "TreeWrapper.h"
@@ -21,15 +23,37 @@
 namespace R3BCalifaTimestitcher
 {
 
+    // Merges the trees by timestamp. The current entries are kept in a
+    // min-heap, so each step costs O(log n) instead of a scan over all trees.
     class TreeIterator
     {
       protected:
         std::vector<TreeWrapper*>& trees;
 
+        // (timestamp, index in trees) with the smallest on top, equal
+        // timestamps are taken in the order of trees
+        std::vector<std::pair<uint64_t, uint32_t>> heap;
+        uint64_t maxTS;
+        TreeWrapper* current;
+
+        void push(uint32_t i);
+
       public:
         TreeIterator(std::vector<TreeWrapper*>& trees);
         TreeWrapper* first();
         TreeWrapper* next();
+
+        // Continue with next() from trees that were positioned with
+        // TreeWrapper::seek() instead of starting with first()
+        void resume();
+
+        // Smallest and largest timestamp of the current entries of all trees
+        uint64_t getMinTS() const { return heap.front().first; }
+        uint64_t getMaxTS() const { return maxTS; }
+
+        // True if the current entries of all trees lie closer than window to
+        // the entry returned last, i.e. the merged event should be filled
+        bool isCoincident(uint64_t window) const;
     };
 
 } // namespace R3BCalifaTimestitcher
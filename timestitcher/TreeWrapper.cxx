@@ -23,6 +23,8 @@ namespace R3BCalifaTimestitcher
     TreeWrapper::TreeWrapper(TTree* _tree, uint32_t _id)
         : tree(_tree)
         , idx(0)
+        , ptrTS(NULL)
+        , curTS(0)
         , id(_id)
     {
         this->nEntries = tree->GetEntries();
@@ -41,11 +43,34 @@ namespace R3BCalifaTimestitcher
             //         cerr << " treeIdx = " << treeIdx << endl;
             tree->GetEntry(idx++);
             if (isGood())
+            {
+                curTS = getTS();
                 return true;
+            }
         }
         return false;
     }
 
+    void TreeWrapper::setReadAhead(Long64_t cacheSize)
+    {
+        // The branches are known up front, skip the learning phase of the cache
+        tree->SetCacheSize(cacheSize);
+        tree->AddBranchToCache("*", kTRUE);
+        tree->StopCacheLearningPhase();
+    }
+
+    bool TreeWrapper::seek(uint64_t position)
+    {
+        if (position == 0 || position > nEntries)
+            return false;
+        tree->GetEntry(position - 1);
+        idx = position;
+        if (!isGood())
+            return false;
+        curTS = getTS();
+        return true;
+    }
+
     uint32_t TreeWrapper::getId() { return id; }
 
 } // namespace R3BCalifaTimestitcher
@@ -30,6 +30,7 @@ namespace R3BCalifaTimestitcher
         uint64_t idx;
         uint64_t nEntries;
         uint64_t* ptrTS;
+        uint64_t curTS;
 
         uint32_t id;
 
@@ -41,6 +42,17 @@ namespace R3BCalifaTimestitcher
         virtual uint64_t getTS();
         virtual bool next();
 
+        // Timestamp of the entry loaded by the last successful next()
+        uint64_t currentTS() const { return curTS; }
+
+        // Prefetch the baskets of all active branches, cacheSize bytes at a time
+        void setReadAhead(Long64_t cacheSize);
+
+        // Number of entries read so far, the current entry is the one before
+        uint64_t getPosition() const { return idx; }
+        // Load the current entry again from a position returned by getPosition()
+        bool seek(uint64_t position);
+
         virtual uint32_t getId();
 
         virtual ~TreeWrapper(){};
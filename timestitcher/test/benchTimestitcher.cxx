@@ -0,0 +1,244 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Merges synthetic Land02-like trees with TreeIterator and with the linear
+// scan over all trees it replaced, and compares throughput and results.
+// Usage: benchTimestitcher [entries per tree, default 1e5] [numbers of trees, default 2 8 32 64]
+
+#include "Land02TreeWrapper.h"
+#include "TreeIterator.h"
+#include "libtimestitcher.h"
+
+#include <TFile.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace R3BCalifaTimestitcher;
+
+namespace
+{
+    const char* kFileName = "benchTimestitcher.root";
+    const uint64_t kWindow = 500;
+    const Long64_t kReadAhead = 32 * 1024 * 1024;
+
+    // Every tree sees most of a common sequence of events with some jitter,
+    // a few entries fail the Pspx selection
+    void WriteTrees(Int_t nTrees, Long64_t nEntries)
+    {
+        TFile file(kFileName, "RECREATE");
+        std::mt19937_64 rng(nTrees);
+        for (Int_t i = 0; i < nTrees; i++)
+        {
+            TTree tree(Form("h509_%i", i), "synthetic");
+            UInt_t tsLow, tsHigh, pspx04n, pspx05n;
+            Float_t payload[16];
+            tree.Branch("Wr_time_l", &tsLow, "Wr_time_l/i");
+            tree.Branch("Wr_time_h", &tsHigh, "Wr_time_h/i");
+            tree.Branch("Pspx04n", &pspx04n, "Pspx04n/i");
+            tree.Branch("Pspx05n", &pspx05n, "Pspx05n/i");
+            tree.Branch("Payload", payload, "Payload[16]/F");
+
+            uint64_t t = 1ull << 40;
+            for (Long64_t n = 0; n < nEntries; n++)
+            {
+                do
+                {
+                    t += 1000;
+                } while (rng() % 5 == 0);
+                const uint64_t ts = t + rng() % 100;
+                tsLow = ts & 0xffffffff;
+                tsHigh = ts >> 32;
+                pspx04n = rng() % 20 != 0;
+                pspx05n = 1;
+                for (auto& p : payload)
+                {
+                    p = rng() % 4096;
+                }
+                tree.Fill();
+            }
+            tree.Write();
+        }
+    }
+
+    struct Inputs
+    {
+        std::unique_ptr<TFile> file;
+        std::unique_ptr<TTree> merged;
+        std::vector<TreeWrapper*> trees;
+        std::vector<void*> buffers;
+
+        Inputs(Int_t nTrees)
+            : file(TFile::Open(kFileName))
+            , merged(new TTree("merged", "Timestitched"))
+        {
+            merged->SetDirectory(nullptr);
+            for (Int_t i = 0; i < nTrees; i++)
+            {
+                auto tree = static_cast<TTree*>(file->Get(Form("h509_%i", i)));
+                branchptrmap_t branchmap;
+                addTreeBranches(merged.get(), tree, Form("t%i_", i), branchmap);
+                for (auto& b : branchmap)
+                {
+                    buffers.push_back(b.second);
+                }
+                trees.push_back(new Land02TreeWrapper(tree, branchmap, i));
+                trees.back()->setReadAhead(kReadAhead);
+            }
+        }
+
+        ~Inputs()
+        {
+            for (auto t : trees)
+            {
+                delete t;
+            }
+            merged.reset();
+            file.reset();
+            for (auto b : buffers)
+            {
+                free(b);
+            }
+        }
+    };
+
+    struct Result
+    {
+        uint64_t steps = 0;
+        uint64_t coincident = 0;
+        uint64_t hash = 0;
+        Double_t seconds = 0.;
+
+        void Add(TreeWrapper* e, bool coincident_)
+        {
+            steps++;
+            coincident += coincident_;
+            hash = hash * 1000003 + e->getId() * 2 + coincident_;
+        }
+    };
+
+    // The merge as it was done before TreeIterator used a heap
+    TreeWrapper* ScanFirst(std::vector<TreeWrapper*>& trees)
+    {
+        TreeWrapper* t_min = NULL;
+        uint64_t ts_min = 0, cts;
+        for (auto t : trees)
+        {
+            if (!t->next())
+                return NULL;
+            cts = t->getTS();
+            if (ts_min == 0 || cts < ts_min)
+            {
+                ts_min = cts;
+                t_min = t;
+            }
+        }
+        return t_min;
+    }
+
+    TreeWrapper* ScanNext(std::vector<TreeWrapper*>& trees)
+    {
+        TreeWrapper* t_min = NULL;
+        uint64_t ts_min = 0, cts;
+        for (auto t : trees)
+        {
+            cts = t->getTS();
+            if (ts_min == 0 || cts < ts_min)
+            {
+                ts_min = cts;
+                t_min = t;
+            }
+        }
+        if (!t_min || !t_min->next())
+            return NULL;
+        return t_min;
+    }
+
+    Result Scan(Int_t nTrees)
+    {
+        Inputs in(nTrees);
+        Result r;
+        auto start = std::chrono::steady_clock::now();
+        for (TreeWrapper* e = ScanFirst(in.trees); e != NULL; e = ScanNext(in.trees))
+        {
+            const uint64_t ts = e->getTS();
+            int64_t tsDiffMax = 0;
+            for (auto t : in.trees)
+            {
+                tsDiffMax = std::max<int64_t>(tsDiffMax, llabs((int64_t)(ts - t->getTS())));
+            }
+            r.Add(e, tsDiffMax < (int64_t)kWindow);
+        }
+        r.seconds = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+        return r;
+    }
+
+    Result Heap(Int_t nTrees)
+    {
+        Inputs in(nTrees);
+        Result r;
+        auto start = std::chrono::steady_clock::now();
+        TreeIterator it(in.trees);
+        for (TreeWrapper* e = it.first(); e != NULL; e = it.next())
+        {
+            r.Add(e, it.isCoincident(kWindow));
+        }
+        r.seconds = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+        return r;
+    }
+
+    void Print(const char* name, const Result& r)
+    {
+        std::cout << "  " << name << ": " << r.seconds << " s, " << 1e-6 * r.steps / r.seconds << " M entries/s, "
+                  << r.coincident << " of " << r.steps << " coincident" << std::endl;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Long64_t nEntries = argc > 1 ? atof(argv[1]) : 1e5;
+    std::vector<Int_t> nTrees;
+    for (Int_t i = 2; i < argc; i++)
+    {
+        nTrees.push_back(atoi(argv[i]));
+    }
+    if (nTrees.empty())
+    {
+        nTrees = { 2, 8, 32, 64 };
+    }
+
+    Int_t nDiff = 0;
+    for (auto n : nTrees)
+    {
+        WriteTrees(n, nEntries);
+        std::cout << n << " trees with " << nEntries << " entries" << std::endl;
+        const Result scan = Scan(n);
+        Print("scan", scan);
+        const Result heap = Heap(n);
+        Print("heap", heap);
+        if (scan.steps != heap.steps || scan.coincident != heap.coincident || scan.hash != heap.hash)
+        {
+            std::cout << "  results differ!" << std::endl;
+            nDiff++;
+        }
+    }
+    gSystem->Unlink(kFileName);
+    return nDiff == 0 ? 0 : 1;
+}
@@ -0,0 +1,286 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "Land02TreeWrapper.h"
+#include "StreamingStitcher.h"
+#include "libtimestitcher.h"
+#include "gtest/gtest.h"
+
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TSystem.h>
+#include <TTree.h>
+
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace R3BCalifaTimestitcher;
+
+namespace
+{
+    const char* kInputName = "testStreamingStitcher.root";
+    const Int_t kNTrees = 3;
+    const Long64_t kNEntries = 200;
+    const Long64_t kChunkEntries = 10;
+
+    // Stops the run like a crash once the tree has read limit entries
+    class InterruptedTreeWrapper : public Land02TreeWrapper
+    {
+      public:
+        InterruptedTreeWrapper(TTree* t, branchptrmap_t& branchmap, uint32_t id, uint64_t _limit)
+            : Land02TreeWrapper(t, branchmap, id)
+            , limit(_limit)
+        {
+        }
+
+        virtual bool next()
+        {
+            if (idx >= limit)
+                throw std::runtime_error("interrupted");
+            return Land02TreeWrapper::next();
+        }
+
+      private:
+        uint64_t limit;
+    };
+
+    // Small Land02-like trees with some entries missing in each and some failing the Pspx selection
+    void WriteTrees()
+    {
+        TFile file(kInputName, "RECREATE");
+        std::mt19937_64 rng(17);
+        for (Int_t i = 0; i < kNTrees; i++)
+        {
+            TTree tree(Form("h509_%i", i), "synthetic");
+            UInt_t tsLow, tsHigh, pspx04n, pspx05n, payload;
+            tree.Branch("Wr_time_l", &tsLow, "Wr_time_l/i");
+            tree.Branch("Wr_time_h", &tsHigh, "Wr_time_h/i");
+            tree.Branch("Pspx04n", &pspx04n, "Pspx04n/i");
+            tree.Branch("Pspx05n", &pspx05n, "Pspx05n/i");
+            tree.Branch("Payload", &payload, "Payload/i");
+
+            uint64_t t = 1ull << 40;
+            for (Long64_t n = 0; n < kNEntries; n++)
+            {
+                do
+                {
+                    t += 1000;
+                } while (rng() % 5 == 0);
+                const uint64_t ts = t + rng() % 100;
+                tsLow = ts & 0xffffffff;
+                tsHigh = ts >> 32;
+                pspx04n = rng() % 20 != 0;
+                pspx05n = 1;
+                payload = rng();
+                tree.Fill();
+            }
+            tree.Write();
+        }
+    }
+
+    // The inputs of one run of the stitcher, interrupted in tree 0 if limit > 0
+    struct Inputs
+    {
+        std::unique_ptr<TFile> file;
+        std::unique_ptr<TTree> merged;
+        std::vector<TreeWrapper*> trees;
+        std::vector<void*> buffers;
+
+        Inputs(uint64_t limit = 0)
+            : file(TFile::Open(kInputName))
+            , merged(new TTree("merged", "Timestitched"))
+        {
+            merged->SetDirectory(nullptr);
+            for (Int_t i = 0; i < kNTrees; i++)
+            {
+                auto tree = static_cast<TTree*>(file->Get(Form("h509_%i", i)));
+                branchptrmap_t branchmap;
+                addTreeBranches(merged.get(), tree, Form("t%i_", i), branchmap);
+                for (auto& b : branchmap)
+                {
+                    buffers.push_back(b.second);
+                }
+                if (i == 0 && limit > 0)
+                {
+                    trees.push_back(new InterruptedTreeWrapper(tree, branchmap, i, limit));
+                }
+                else
+                {
+                    trees.push_back(new Land02TreeWrapper(tree, branchmap, i));
+                }
+            }
+        }
+
+        ~Inputs()
+        {
+            for (auto t : trees)
+            {
+                delete t;
+            }
+            merged.reset();
+            file.reset();
+            for (auto b : buffers)
+            {
+                free(b);
+            }
+        }
+    };
+
+    std::string ChunkName(const std::string& base, Int_t n) { return base + Form("_%04i.root", n); }
+
+    // All values of all entries of the chunk, in the order of the leaves
+    std::vector<Double_t> ReadChunk(const std::string& name)
+    {
+        std::vector<Double_t> values;
+        std::unique_ptr<TFile> file(TFile::Open(name.c_str()));
+        if (!file || file->IsZombie())
+        {
+            ADD_FAILURE() << "Could not open " << name;
+            return values;
+        }
+        auto tree = static_cast<TTree*>(file->Get("merged"));
+        if (!tree)
+        {
+            ADD_FAILURE() << "No tree in " << name;
+            return values;
+        }
+        for (Long64_t n = 0; n < tree->GetEntries(); n++)
+        {
+            tree->GetEntry(n);
+            for (auto obj : *tree->GetListOfLeaves())
+            {
+                auto leaf = static_cast<TLeaf*>(obj);
+                for (Int_t j = 0; j < leaf->GetLen(); j++)
+                {
+                    values.push_back(leaf->GetValue(j));
+                }
+            }
+        }
+        return values;
+    }
+
+    void Remove(const std::string& base, uint32_t nChunks)
+    {
+        for (uint32_t n = 0; n <= nChunks; n++)
+        {
+            gSystem->Unlink(ChunkName(base, n).c_str());
+            gSystem->Unlink((ChunkName(base, n) + ".part").c_str());
+        }
+        gSystem->Unlink((base + ".checkpoint").c_str());
+    }
+
+    uint64_t Stitch(Inputs& in, const std::string& base, Long64_t chunkEntries = kChunkEntries, uint64_t window = 500)
+    {
+        StreamingStitcher stitcher(in.trees, in.merged.get(), base + ".root");
+        stitcher.setChunkEntries(chunkEntries);
+        stitcher.setWindow(window);
+        stitcher.setMemoryBudget(4 * 1024 * 1024);
+        return stitcher.run();
+    }
+
+    // Message of the exception thrown by the run, empty if none
+    std::string StitchError(Inputs& in, const std::string& base, Long64_t chunkEntries, uint64_t window)
+    {
+        try
+        {
+            Stitch(in, base, chunkEntries, window);
+        }
+        catch (const std::runtime_error& e)
+        {
+            return e.what();
+        }
+        return "";
+    }
+
+    class testStreamingStitcher : public ::testing::Test
+    {
+      protected:
+        static void SetUpTestCase() { WriteTrees(); }
+        static void TearDownTestCase() { gSystem->Unlink(kInputName); }
+    };
+
+    TEST_F(testStreamingStitcher, resumeGivesTheSameChunks)
+    {
+        const std::string full = "testStreamingStitcherFull";
+        const std::string resumed = "testStreamingStitcherResumed";
+
+        uint64_t nFull;
+        {
+            Inputs in;
+            nFull = Stitch(in, full);
+        }
+        const Int_t nChunks = (nFull + kChunkEntries - 1) / kChunkEntries;
+        ASSERT_GT(nChunks, 3);
+
+        // Like a crash, possibly in the middle of a chunk which is then left as .part
+        {
+            Inputs in(kNEntries / 2);
+            EXPECT_THROW(Stitch(in, resumed), std::runtime_error);
+        }
+        FileStat_t stat;
+        Int_t nWritten = 0;
+        while (gSystem->GetPathInfo(ChunkName(resumed, nWritten).c_str(), stat) == 0)
+        {
+            nWritten++;
+        }
+        ASSERT_GT(nWritten, 0);
+        ASSERT_LT(nWritten, nChunks - 1);
+
+        {
+            Inputs in;
+            EXPECT_EQ(Stitch(in, resumed), nFull);
+        }
+        for (Int_t n = 0; n < nChunks; n++)
+        {
+            EXPECT_EQ(ReadChunk(ChunkName(resumed, n)), ReadChunk(ChunkName(full, n))) << "chunk " << n;
+            EXPECT_NE(gSystem->GetPathInfo((ChunkName(resumed, n) + ".part").c_str(), stat), 0);
+        }
+        EXPECT_NE(gSystem->GetPathInfo(ChunkName(resumed, nChunks).c_str(), stat), 0);
+
+        // Once done, running again only returns the count
+        {
+            Inputs in;
+            EXPECT_EQ(Stitch(in, resumed), nFull);
+        }
+
+        Remove(full, nChunks);
+        Remove(resumed, nChunks);
+    }
+
+    TEST_F(testStreamingStitcher, refusesOtherSettings)
+    {
+        const std::string base = "testStreamingStitcherSettings";
+        {
+            Inputs in(kNEntries / 2);
+            EXPECT_THROW(Stitch(in, base), std::runtime_error);
+        }
+        {
+            Inputs in;
+            EXPECT_NE(StitchError(in, base, 2 * kChunkEntries, 500).find("other settings"), std::string::npos);
+        }
+        {
+            Inputs in;
+            EXPECT_NE(StitchError(in, base, kChunkEntries, 1000).find("other settings"), std::string::npos);
+        }
+        // The checkpoint is still usable with the settings it was written with
+        {
+            Inputs in;
+            EXPECT_EQ(StitchError(in, base, kChunkEntries, 500), "");
+        }
+        Remove(base, kNEntries);
+    }
+} // namespace
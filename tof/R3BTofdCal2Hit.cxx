@@ -25,6 +25,7 @@
 #include "R3BTofdHitData.h"
 #include "R3BTofdHitModulePar.h"
 #include "R3BTofdHitPar.h"
+#include "R3BTofdHitRecord.h"
 
 #include "FairLogger.h"
 #include "FairRuntimeDb.h"
@@ -834,27 +835,6 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
     if (nHitsEvent == 0)
         events_wo_tofd_hits++;
 
-    // init arrays to store hits
-    Double_t tArrQ[2 * nHitsEvent + 1];
-    Double_t tArrT[2 * nHitsEvent + 1];
-    Double_t tArrX[2 * nHitsEvent + 1];
-    Double_t tArrY[2 * nHitsEvent + 1];
-    Double_t tArrYT[2 * nHitsEvent + 1];
-    Double_t tArrP[2 * nHitsEvent + 1];
-    Double_t tArrB[2 * nHitsEvent + 1];
-    Bool_t tArrU[2 * nHitsEvent + 1];
-    for (int i = 0; i < (2 * nHitsEvent + 1); i++)
-    {
-        tArrQ[i] = -1.;
-        tArrT[i] = -1.;
-        tArrX[i] = -1.;
-        tArrY[i] = -1.;
-        tArrYT[i] = -1.;
-        tArrP[i] = -1.;
-        tArrB[i] = -1.;
-        tArrU[i] = kFALSE;
-    }
-
     for (Int_t i = 1; i <= fNofPlanes; i++)
     {
         for (Int_t j = 0; j < fPaddlesPerPlane * 2 + 1; j++)
@@ -868,102 +848,45 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
     }
 
     // order events for time
+    std::vector<R3BTofdHitRecord> hits;
+    hits.reserve(2 * nHitsEvent + 1);
     for (Int_t i = 1; i <= fNofPlanes; i++)
     { // loop over planes i
         for (Int_t j = 0; j < fPaddlesPerPlane * 2 + 1; j++)
         { // loop over virtual paddles j
-            if (tof[i][j].empty() == false)
-            { // check paddle for entries
-                for (Int_t m = 0; m < tof[i][j].size(); m++)
-                { // loop over multihits m
-                    Int_t p = 0;
-                    if (tArrT[0] == -1.)
-                    { // first entry
-                        LOG(DEBUG) << "First entry plane/bar " << i << "/" << j;
-                        tArrQ[0] = q[i][j].at(m);
-                        tArrT[0] = tof[i][j].at(m);
-                        tArrX[0] = x[i][j].at(m);
-                        tArrY[0] = y[i][j].at(m);
-                        tArrYT[0] = yToT[i][j].at(m);
-                        tArrP[0] = i;
-                        tArrB[0] = j;
-                    }
-                    else
-                    {
-                        if (tof[i][j].at(m) < tArrT[0])
-                        { // new first entry with smaller time
-                            LOG(DEBUG) << "Insert new first " << i << " " << j;
-                            insertX(2 * nHitsEvent, tArrQ, q[i][j].at(m), 1);
-                            insertX(2 * nHitsEvent, tArrT, tof[i][j].at(m), 1);
-                            insertX(2 * nHitsEvent, tArrX, x[i][j].at(m), 1);
-                            insertX(2 * nHitsEvent, tArrY, y[i][j].at(m), 1);
-                            insertX(2 * nHitsEvent, tArrYT, yToT[i][j].at(m), 1);
-                            insertX(2 * nHitsEvent, tArrP, i, 1);
-                            insertX(2 * nHitsEvent, tArrB, j, 1);
-                        }
-                        else
-                        {
-                            while (tof[i][j].at(m) > tArrT[p] && tArrT[p] != -1.)
-                            {
-                                p++; // find insert position
-                                if (p > 2 * nHitsEvent + 1)
-                                    LOG(FATAL) << "Insert position oor"; // should not happen
-                            }
-
-                            LOG(DEBUG) << "Will insert at " << p;
-                            if (p > 0 && tof[i][j].at(m) > tArrT[p - 1] && tof[i][j].at(m) != tArrT[p])
-                            { // insert at right position
-                                LOG(DEBUG) << "Insert at " << p << " " << i << " " << j;
-                                insertX(2 * nHitsEvent, tArrQ, q[i][j].at(m), p + 1);
-                                insertX(2 * nHitsEvent, tArrT, tof[i][j].at(m), p + 1);
-                                insertX(2 * nHitsEvent, tArrX, x[i][j].at(m), p + 1);
-                                insertX(2 * nHitsEvent, tArrY, y[i][j].at(m), p + 1);
-                                insertX(2 * nHitsEvent, tArrYT, yToT[i][j].at(m), p + 1);
-                                insertX(2 * nHitsEvent, tArrP, i, p + 1);
-                                insertX(2 * nHitsEvent, tArrB, j, p + 1);
-                            }
-                            else
-                            {
-                                if (tof[i][j].at(m) == tArrT[p])
-                                { // handle virtual bars
-                                    LOG(DEBUG) << "Insert virtual bar " << i << " " << j;
-                                    insertX(2 * nHitsEvent, tArrQ, q[i][j].at(m), p + 2);
-                                    insertX(2 * nHitsEvent, tArrT, tof[i][j].at(m), p + 2);
-                                    insertX(2 * nHitsEvent, tArrX, x[i][j].at(m), p + 2);
-                                    insertX(2 * nHitsEvent, tArrY, y[i][j].at(m), p + 2);
-                                    insertX(2 * nHitsEvent, tArrYT, yToT[i][j].at(m), p + 2);
-                                    insertX(2 * nHitsEvent, tArrP, i, p + 2);
-                                    insertX(2 * nHitsEvent, tArrB, j, p + 2);
-                                }
-                            }
-                        }
-                    }
-                }
+            for (Int_t m = 0; m < tof[i][j].size(); m++)
+            { // loop over multihits m
+                hits.push_back(
+                    { tof[i][j].at(m), q[i][j].at(m), x[i][j].at(m), y[i][j].at(m), yToT[i][j].at(m), i, j, kFALSE });
             }
         }
     }
+    R3BTofdSortHits(hits);
+    // Bars without hit parameters were counted but left no hits, their slots
+    // stay empty. One more slot behind the last hit for its virtual partner.
+    hits.resize(2 * nHitsEvent + 1, { -1., -1., -1., -1., -1., -1, -1, kFALSE });
 
     // print time sorted events
     /*
-    if(tArrT[0]!=-1.){
+    if(hits[0].t!=-1.){
 
             for (Int_t a = 0; a < 2*nHitsEvent; a++)
-                std::cout << tArrQ[a] << " ";
+                std::cout << hits[a].q << " ";
             std::cout << "\n";
             for (Int_t a = 0; a < 2*nHitsEvent; a++)
-                std::cout << tArrT[a] << " ";
+                std::cout << hits[a].t << " ";
             std::cout << "\n";
             for (Int_t a = 0; a < 2*nHitsEvent; a++)
-                std::cout << tArrX[a] << " ";
+                std::cout << hits[a].x << " ";
             std::cout << "\n";
             for (Int_t a = 0; a < 2*nHitsEvent; a++)
-                std::cout << tArrY[a] << " ";
+                std::cout << hits[a].y << " ";
             std::cout << "\n";
             for (Int_t a = 0; a < 2*nHitsEvent; a++)
-                std::cout << tArrP[a] << " ";
+                std::cout << hits[a].plane << " ";
             std::cout << "\n";
             for (Int_t a = 0; a < 2*nHitsEvent; a++)
-                std::cout << tArrB[a] << " ";
+                std::cout << hits[a].bar << " ";
             std::cout << "\n";
     }
     */
@@ -975,15 +898,15 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
         for (Int_t a = 0; a < 2 * nHitsEvent; a++)
         { // loop over all hits
             eventstore++;
-            fhQ[((Int_t)tArrP[a]) - 1]->Fill(tArrB[a], tArrQ[a]);        // charge per plane
-            fhQvsEvent[((Int_t)tArrP[a]) - 1]->Fill(fnEvents, tArrQ[a]); // charge vs event #
+            fhQ[hits[a].plane - 1]->Fill(hits[a].bar, hits[a].q);     // charge per plane
+            fhQvsEvent[hits[a].plane - 1]->Fill(fnEvents, hits[a].q); // charge vs event #
             if (fTofdTotPos)
             {
-                fhxy[((Int_t)tArrP[a]) - 1]->Fill(tArrB[a], tArrYT[a]); // xy of plane
+                fhxy[hits[a].plane - 1]->Fill(hits[a].bar, hits[a].yToT); // xy of plane
             }
             else
             {
-                fhxy[((Int_t)tArrP[a]) - 1]->Fill(tArrB[a], tArrY[a]); // xy of plane
+                fhxy[hits[a].plane - 1]->Fill(hits[a].bar, hits[a].y); // xy of plane
             }
         }
     }
@@ -992,11 +915,11 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
     Double_t time0;
     for (Int_t ihit = 0; ihit < 2 * nHitsEvent;)
     { // loop over all hits in this event
-        LOG(WARNING) << "\nSet new coincidence window: " << tArrP[ihit] << " " << tArrB[ihit] << " " << tArrT[ihit]
-                     << " " << tArrQ[ihit];
-        time0 = tArrT[ihit];            // time of first hit in coincidence window
-        Double_t charge0 = tArrQ[ihit]; // charge of first hit in coincidence window
-        Double_t plane0 = tArrP[ihit];  // plane of first hit in coincidence window
+        LOG(WARNING) << "\nSet new coincidence window: " << hits[ihit].plane << " " << hits[ihit].bar << " "
+                     << hits[ihit].t << " " << hits[ihit].q;
+        time0 = hits[ihit].t;               // time of first hit in coincidence window
+        Double_t charge0 = hits[ihit].q;    // charge of first hit in coincidence window
+        Double_t plane0 = hits[ihit].plane; // plane of first hit in coincidence window
         Int_t hitscoinc = 0;
         Int_t nAverage = 0;
         Int_t nAverage12 = 0;
@@ -1006,19 +929,19 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
         Double_t sumQ34 = 0;
         Double_t sumQ14[100] = { 0. };
 
-        while (tArrT[ihit] < time0 + hit_coinc)
+        while (hits[ihit].t < time0 + hit_coinc)
         { // check if in coincidence window
             incoincidence++;
             /*
             std::cout<<"Used up hits in this coincidence window:\n";
             for(Int_t a=0; a<2*nHitsEvent; a++)
-                std::cout << tArrP[a] << " ";
+                std::cout << hits[a].plane << " ";
             std::cout << "\n";
             for(Int_t a=0; a<2*nHitsEvent; a++)
-                std::cout << tArrB[a] << " ";
+                std::cout << hits[a].bar << " ";
             std::cout << "\n";
             for(Int_t a=0; a<2*nHitsEvent; a++)
-                std::cout << tArrU[a] << " ";
+                std::cout << hits[a].used << " ";
             std::cout << "\n";
             */
 
@@ -1026,106 +949,110 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
 
             if (fTofdHisto)
             {
-                if (tArrP[ihit] == plane0 && charge0 != tArrQ[ihit])
+                if (hits[ihit].plane == plane0 && charge0 != hits[ihit].q)
                 {
-                    fhQM[(Int_t)tArrP[ihit] - 1]->Fill(charge0, tArrQ[ihit]);
+                    fhQM[hits[ihit].plane - 1]->Fill(charge0, hits[ihit].q);
                 }
             }
 
-            LOG(DEBUG) << "Hit in coincidence window: " << tArrP[ihit] << " " << tArrB[ihit] << " " << tArrT[ihit]
-                       << " " << tArrQ[ihit];
+            LOG(DEBUG) << "Hit in coincidence window: " << hits[ihit].plane << " " << hits[ihit].bar << " "
+                       << hits[ihit].t << " " << hits[ihit].q;
 
             // try to average plane 1&2
             for (Int_t i = 1; i < hitscoinc; i++)
             { // loop over hits in coincidence
-                if (tArrP[ihit] <= 2 && tArrP[ihit - i] <= 2)
+                if (hits[ihit].plane <= 2 && hits[ihit - i].plane <= 2)
                 {
-                    // cout << i << "  " << tArrP[ihit] << "  " << tArrB[ihit] << " "
-                    // << tArrP[ihit-i] << "  " << tArrB[ihit-i] << endl;
-                    if (hitscoinc > 0 && (Int_t)(tArrP[ihit] - tArrP[ihit - i]) != 0)
+                    // cout << i << "  " << hits[ihit].plane << "  " << hits[ihit].bar << " "
+                    // << hits[ihit-i].plane << "  " << hits[ihit-i].bar << endl;
+                    if (hitscoinc > 0 && (Int_t)(hits[ihit].plane - hits[ihit - i].plane) != 0)
                     { // check if planes differ
                         /// find overlapping virtualbars && similar charge in both planes? && bar wasn't used for other
                         /// average?
-                        if (tArrB[ihit - i] == tArrB[ihit] && abs(tArrQ[ihit - i] - tArrQ[ihit]) < maxChargeDiff &&
-                            tArrU[ihit] == false && tArrU[ihit - i] == false)
+                        if (hits[ihit - i].bar == hits[ihit].bar &&
+                            abs(hits[ihit - i].q - hits[ihit].q) < maxChargeDiff && hits[ihit].used == false &&
+                            hits[ihit - i].used == false)
                         {
                             inaverage12++;
-                            // cout << "Try to average " << tArrQ[ihit] << " plane: " << tArrP[ihit] << " Bar: " <<
-                            // tArrB[ihit]
-                            //             << " and " << tArrQ[ihit - i] << " plane: " << tArrP[ihit - i] << " Bar: "
-                            //             << tArrB[ihit - i] << endl;
+                            // cout << "Try to average " << hits[ihit].q << " plane: " << hits[ihit].plane << " Bar: " <<
+                            // hits[ihit].bar
+                            //             << " and " << hits[ihit - i].q << " plane: " << hits[ihit - i].plane << " Bar: "
+                            //             << hits[ihit - i].bar << endl;
 
                             nAverage12++; // number of averaged hits in this coincidence window
-                            sumQ12 += (tArrQ[ihit] + tArrQ[ihit - i]) / 2.; // average charges and add to sum
+                            sumQ12 += (hits[ihit].q + hits[ihit - i].q) / 2.; // average charges and add to sum
 
-                            tArrU[ihit] = tArrU[ihit - i] = true; // set involved bars as used
+                            hits[ihit].used = hits[ihit - i].used = true; // set involved bars as used
 
                             if ((ihit - i) % 2 != 0)
-                                tArrU[ihit - (i + 1)] =
+                                hits[ihit - (i + 1)].used =
                                     true; // set the associated virtual bars of the used bars as used
                             else
-                                tArrU[ihit - (i - 1)] = true;
+                                hits[ihit - (i - 1)].used = true;
                             if ((ihit - i) % 2 != 0)
-                                tArrU[ihit + 1] = true;
+                                hits[ihit + 1].used = true;
                             else
-                                tArrU[ihit - 1] = true;
+                                hits[ihit - 1].used = true;
 
                             if (fTofdHisto)
                             {
-                                fhCharge->Fill((tArrQ[ihit] + tArrQ[ihit - i]) / 2.); // Fill charge histogram
+                                fhCharge->Fill((hits[ihit].q + hits[ihit - i].q) / 2.); // Fill charge histogram
 
-                                if (((Int_t)tArrP[ihit]) == 2)
+                                if (hits[ihit].plane == 2)
                                 {
-                                    fhQvsQ[((Int_t)tArrP[ihit]) - 1][((Int_t)tArrB[ihit]) - 1]->Fill(
-                                        tArrQ[ihit - i], tArrQ[ihit]); // Fill charge vs charge histogram
-                                    fhTdiffvsQ[((Int_t)tArrP[ihit]) - 2][((Int_t)tArrB[ihit]) - 1]->Fill(
-                                        tArrT[ihit] - tArrT[ihit - i],
-                                        (tArrQ[ihit] + tArrQ[ihit - i]) / 2.); // Fill tdiff planes histogram
+                                    fhQvsQ[hits[ihit].plane - 1][hits[ihit].bar - 1]->Fill(
+                                        hits[ihit - i].q, hits[ihit].q); // Fill charge vs charge histogram
+                                    fhTdiffvsQ[hits[ihit].plane - 2][hits[ihit].bar - 1]->Fill(
+                                        hits[ihit].t - hits[ihit - i].t,
+                                        (hits[ihit].q + hits[ihit - i].q) / 2.); // Fill tdiff planes histogram
                                 }
                                 else
                                 {
-                                    fhQvsQ[((Int_t)tArrP[ihit]) - 1][((Int_t)tArrB[ihit]) - 1]->Fill(tArrQ[ihit],
-                                                                                                     tArrQ[ihit - i]);
-                                    if ((Int_t)tArrP[ihit] == 1)
-                                        fhTdiffvsQ[((Int_t)tArrP[ihit]) - 1][((Int_t)tArrB[ihit]) - 1]->Fill(
-                                            -(tArrT[ihit] - tArrT[ihit - i]),
-                                            (tArrQ[ihit] + tArrQ[ihit - i]) / 2.); // Fill tdiff planes histogram
+                                    fhQvsQ[hits[ihit].plane - 1][hits[ihit].bar - 1]->Fill(hits[ihit].q,
+                                                                                           hits[ihit - i].q);
+                                    if (hits[ihit].plane == 1)
+                                        fhTdiffvsQ[hits[ihit].plane - 1][hits[ihit].bar - 1]->Fill(
+                                            -(hits[ihit].t - hits[ihit - i].t),
+                                            (hits[ihit].q + hits[ihit - i].q) / 2.); // Fill tdiff planes histogram
                                 }
 
-                                if ((tArrQ[ihit] || tArrQ[ihit - i] > 7.5) && (tArrQ[ihit] || tArrQ[ihit - i] < 8.5))
-                                    fhxy12->Fill((tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                                 (tArrY[ihit] + tArrY[ihit - i]) / 2.); // Fill average xy histogram
-                                fhxy12tot->Fill((tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                                (tArrYT[ihit] + tArrYT[ihit - i]) / 2.); // Fill average xy histogram
+                                if ((hits[ihit].q || hits[ihit - i].q > 7.5) &&
+                                    (hits[ihit].q || hits[ihit - i].q < 8.5))
+                                    fhxy12->Fill((hits[ihit].x + hits[ihit - i].x) / 2.,
+                                                 (hits[ihit].y + hits[ihit - i].y) / 2.); // Fill average xy histogram
+                                fhxy12tot->Fill((hits[ihit].x + hits[ihit - i].x) / 2.,
+                                                (hits[ihit].yToT + hits[ihit - i].yToT) /
+                                                    2.); // Fill average xy histogram
                             }
 
                             // store average
                             if (fTofdTotPos)
                             {
                                 new ((*fHitItems)[fNofHitItems++])
-                                    R3BTofdHitData((tArrT[ihit] + tArrT[ihit - i]) / 2.,
-                                                   (tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                                   (tArrYT[ihit] + tArrYT[ihit - i]) / 2.,
-                                                   (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
-                                                   abs(tArrT[ihit] - tArrT[ihit - i]),
-                                                   (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
+                                    R3BTofdHitData((hits[ihit].t + hits[ihit - i].t) / 2.,
+                                                   (hits[ihit].x + hits[ihit - i].x) / 2.,
+                                                   (hits[ihit].yToT + hits[ihit - i].yToT) / 2.,
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
+                                                   abs(hits[ihit].t - hits[ihit - i].t),
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
                                                    12);
                             }
                             else
                             {
-                                new ((*fHitItems)[fNofHitItems++]) R3BTofdHitData((tArrT[ihit] + tArrT[ihit - i]) / 2.,
-                                                                                  (tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                                                                  (tArrY[ihit] + tArrY[ihit - i]) / 2.,
-                                                                                  (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
-                                                                                  abs(tArrT[ihit] - tArrT[ihit - i]),
-                                                                                  (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
-                                                                                  12);
+                                new ((*fHitItems)[fNofHitItems++])
+                                    R3BTofdHitData((hits[ihit].t + hits[ihit - i].t) / 2.,
+                                                   (hits[ihit].x + hits[ihit - i].x) / 2.,
+                                                   (hits[ihit].y + hits[ihit - i].y) / 2.,
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
+                                                   abs(hits[ihit].t - hits[ihit - i].t),
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
+                                                   12);
                             }
                         }
 
                         // std::cout<<"Used up averaged hits in this coincidence window:\n";
                         // for(Int_t a=0; a<2*nHitsEvent; a++)
-                        //    std::cout << tArrU[a] << " ";
+                        //    std::cout << hits[a].used << " ";
                         // std::cout << "\n";
                     }
                 }
@@ -1134,91 +1061,94 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
             // try to average plane 3&4
             for (Int_t i = 1; i < hitscoinc; i++)
             { // loop over hits in coincidence
-                if (tArrP[ihit] >= 3 && tArrP[ihit - i] >= 3)
+                if (hits[ihit].plane >= 3 && hits[ihit - i].plane >= 3)
                 {
-                    // std::cout<<i<<" "<<tArrP[ihit]<<" "<<tArrB[ihit]<<" "<<tArrP[ihit-i]<<" "<<tArrB[ihit-i]<<"\n";
-                    if (hitscoinc > 0 && (Int_t)(tArrP[ihit] - tArrP[ihit - i]) != 0)
+                    // std::cout<<i<<" "<<hits[ihit].plane<<" "<<hits[ihit].bar<<" "<<hits[ihit-i].plane<<" "<<hits[ihit-i].bar<<"\n";
+                    if (hitscoinc > 0 && (Int_t)(hits[ihit].plane - hits[ihit - i].plane) != 0)
                     { // check if planes differ
                         /// find overlapping virtualbars         similar charge in both planes?               bar wasn't
                         /// used for other average?
-                        if (tArrB[ihit - i] == tArrB[ihit] && abs(tArrQ[ihit - i] - tArrQ[ihit]) < maxChargeDiff &&
-                            tArrU[ihit] == false && tArrU[ihit - i] == false)
+                        if (hits[ihit - i].bar == hits[ihit].bar &&
+                            abs(hits[ihit - i].q - hits[ihit].q) < maxChargeDiff && hits[ihit].used == false &&
+                            hits[ihit - i].used == false)
                         {
                             inaverage34++;
-                            LOG(WARNING) << "Try to average " << tArrQ[ihit] << " " << tArrP[ihit] << " " << tArrB[ihit]
-                                         << " and " << tArrQ[ihit - i] << " " << tArrP[ihit - i] << " "
-                                         << tArrB[ihit - i];
+                            LOG(WARNING) << "Try to average " << hits[ihit].q << " " << hits[ihit].plane << " "
+                                         << hits[ihit].bar << " and " << hits[ihit - i].q << " "
+                                         << hits[ihit - i].plane << " " << hits[ihit - i].bar;
 
                             nAverage34++; // number of averaged hits in this coincidence window
-                            sumQ34 += (tArrQ[ihit] + tArrQ[ihit - i]) / 2.; // average charges and add to sum
+                            sumQ34 += (hits[ihit].q + hits[ihit - i].q) / 2.; // average charges and add to sum
 
-                            tArrU[ihit] = tArrU[ihit - i] = true; // set involved bars as used
+                            hits[ihit].used = hits[ihit - i].used = true; // set involved bars as used
 
                             if ((ihit - i) % 2 != 0)
-                                tArrU[ihit - (i + 1)] =
+                                hits[ihit - (i + 1)].used =
                                     true; // set the associated virtual bars of the used bars as used
                             else
-                                tArrU[ihit - (i - 1)] = true;
+                                hits[ihit - (i - 1)].used = true;
                             if ((ihit - i) % 2 != 0)
-                                tArrU[ihit + 1] = true;
+                                hits[ihit + 1].used = true;
                             else
-                                tArrU[ihit - 1] = true;
+                                hits[ihit - 1].used = true;
 
                             if (fTofdHisto)
                             {
-                                fhCharge->Fill((tArrQ[ihit] + tArrQ[ihit - i]) / 2.); // Fill charge histogram
+                                fhCharge->Fill((hits[ihit].q + hits[ihit - i].q) / 2.); // Fill charge histogram
 
-                                if (((Int_t)tArrP[ihit]) == fNofPlanes)
+                                if (hits[ihit].plane == fNofPlanes)
                                 { /// TODO: maybe get first plane here?
-                                    fhQvsQ[((Int_t)tArrP[ihit]) - 1][((Int_t)tArrB[ihit]) - 1]->Fill(
-                                        tArrQ[ihit - i], tArrQ[ihit]); // Fill charge vs charge histogram
-                                    fhTdiffvsQ[((Int_t)tArrP[ihit]) - 2][((Int_t)tArrB[ihit]) - 1]->Fill(
-                                        tArrT[ihit] - tArrT[ihit - i],
-                                        (tArrQ[ihit] + tArrQ[ihit - i]) / 2.); // Fill tdiff planes histogram
+                                    fhQvsQ[hits[ihit].plane - 1][hits[ihit].bar - 1]->Fill(
+                                        hits[ihit - i].q, hits[ihit].q); // Fill charge vs charge histogram
+                                    fhTdiffvsQ[hits[ihit].plane - 2][hits[ihit].bar - 1]->Fill(
+                                        hits[ihit].t - hits[ihit - i].t,
+                                        (hits[ihit].q + hits[ihit - i].q) / 2.); // Fill tdiff planes histogram
                                 }
                                 else
                                 {
-                                    fhQvsQ[((Int_t)tArrP[ihit]) - 1][((Int_t)tArrB[ihit]) - 1]->Fill(tArrQ[ihit],
-                                                                                                     tArrQ[ihit - i]);
-                                    if ((Int_t)tArrP[ihit] == 3)
-                                        fhTdiffvsQ[((Int_t)tArrP[ihit]) - 1][((Int_t)tArrB[ihit]) - 1]->Fill(
-                                            -(tArrT[ihit] - tArrT[ihit - i]),
-                                            (tArrQ[ihit] + tArrQ[ihit - i]) / 2.); // Fill tdiff planes histogram
+                                    fhQvsQ[hits[ihit].plane - 1][hits[ihit].bar - 1]->Fill(hits[ihit].q,
+                                                                                           hits[ihit - i].q);
+                                    if (hits[ihit].plane == 3)
+                                        fhTdiffvsQ[hits[ihit].plane - 1][hits[ihit].bar - 1]->Fill(
+                                            -(hits[ihit].t - hits[ihit - i].t),
+                                            (hits[ihit].q + hits[ihit - i].q) / 2.); // Fill tdiff planes histogram
                                 }
 
-                                fhxy34->Fill((tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                             (tArrY[ihit] + tArrY[ihit - i]) / 2.); // Fill average xy histogram
-                                fhxy34tot->Fill((tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                                (tArrYT[ihit] + tArrYT[ihit - i]) / 2.); // Fill average xy histogram
+                                fhxy34->Fill((hits[ihit].x + hits[ihit - i].x) / 2.,
+                                             (hits[ihit].y + hits[ihit - i].y) / 2.); // Fill average xy histogram
+                                fhxy34tot->Fill((hits[ihit].x + hits[ihit - i].x) / 2.,
+                                                (hits[ihit].yToT + hits[ihit - i].yToT) /
+                                                    2.); // Fill average xy histogram
                             }
 
                             // store average
                             if (fTofdTotPos)
                             {
                                 new ((*fHitItems)[fNofHitItems++])
-                                    R3BTofdHitData((tArrT[ihit] + tArrT[ihit - i]) / 2.,
-                                                   (tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                                   (tArrYT[ihit] + tArrYT[ihit - i]) / 2.,
-                                                   (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
-                                                   abs(tArrT[ihit] - tArrT[ihit - i]),
-                                                   (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
+                                    R3BTofdHitData((hits[ihit].t + hits[ihit - i].t) / 2.,
+                                                   (hits[ihit].x + hits[ihit - i].x) / 2.,
+                                                   (hits[ihit].yToT + hits[ihit - i].yToT) / 2.,
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
+                                                   abs(hits[ihit].t - hits[ihit - i].t),
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
                                                    34);
                             }
                             else
                             {
-                                new ((*fHitItems)[fNofHitItems++]) R3BTofdHitData((tArrT[ihit] + tArrT[ihit - i]) / 2.,
-                                                                                  (tArrX[ihit] + tArrX[ihit - i]) / 2.,
-                                                                                  (tArrY[ihit] + tArrY[ihit - i]) / 2.,
-                                                                                  (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
-                                                                                  abs(tArrT[ihit] - tArrT[ihit - i]),
-                                                                                  (tArrQ[ihit] + tArrQ[ihit - i]) / 2.,
-                                                                                  34);
+                                new ((*fHitItems)[fNofHitItems++])
+                                    R3BTofdHitData((hits[ihit].t + hits[ihit - i].t) / 2.,
+                                                   (hits[ihit].x + hits[ihit - i].x) / 2.,
+                                                   (hits[ihit].y + hits[ihit - i].y) / 2.,
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
+                                                   abs(hits[ihit].t - hits[ihit - i].t),
+                                                   (hits[ihit].q + hits[ihit - i].q) / 2.,
+                                                   34);
                             }
                         }
 
                         // std::cout<<"Used up averaged hits in this coincidence window:\n";
                         // for(Int_t a=0; a<2*nHitsEvent; a++)
-                        //    std::cout << tArrU[a] << " ";
+                        //    std::cout << hits[a].used << " ";
                         // std::cout << "\n";
                     }
                 }
@@ -1228,25 +1158,25 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
             if (hitscoinc > 0)
             { // loop over hits in coincidence
 
-                Int_t bar = tArrB[ihit];
+                Int_t bar = hits[ihit].bar;
                 if (bar > 0 && bar < 89)
                 {
-                    // cout << "ihit: " << ihit << " plane: " << tArrP[ihit] << " bar: " << tArrB[ihit]
-                    //	<< "  Q: " << tArrQ[ihit] << endl;
+                    // cout << "ihit: " << ihit << " plane: " << hits[ihit].plane << " bar: " << hits[ihit].bar
+                    //	<< "  Q: " << hits[ihit].q << endl;
 
                     // cout << "so far: " << nAverage14[bar] << " Q: " << sumQ14[bar] / nAverage14[bar] << endl;
-                    if (tArrP[ihit] > 0)
+                    if (hits[ihit].plane > 0)
                     {
-                        if (abs(tArrQ[ihit] - sumQ14[bar] / nAverage14[bar]) < maxChargeDiff || nAverage14[bar] == 0)
+                        if (abs(hits[ihit].q - sumQ14[bar] / nAverage14[bar]) < maxChargeDiff || nAverage14[bar] == 0)
                         {
 
                             // cout << "Average " << nAverage14[bar] << " Try to average "  << sumQ14[bar] /
                             // nAverage14[bar]
-                            // << " with " << tArrQ[ihit] << " plane: " << tArrP[ihit] << " Bar: " << tArrB[ihit] <<
+                            // << " with " << hits[ihit].q << " plane: " << hits[ihit].plane << " Bar: " << hits[ihit].bar <<
                             // endl;
 
                             nAverage14[bar]++;          // number of averaged hits in this coincidence window
-                            sumQ14[bar] += tArrQ[ihit]; // average charges and add to sum
+                            sumQ14[bar] += hits[ihit].q; // average charges and add to sum
                         }
                     }
                 }
@@ -1277,31 +1207,31 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
     }
     for (Int_t hit = 0; hit < 2 * nHitsEvent; hit++)
     { // loop over not averaged hits
-        if (tArrU[hit] == false)
+        if (hits[hit].used == false)
         {
-            LOG(DEBUG) << "Single Hit for Plane " << tArrP[hit] << " " << tArrB[hit];
-            tArrU[hit] = tArrU[hit + 1] = true;
+            LOG(DEBUG) << "Single Hit for Plane " << hits[hit].plane << " " << hits[hit].bar;
+            hits[hit].used = hits[hit + 1].used = true;
             // store single hits only seen in planes
             singlehit++;
             if (fTofdTotPos)
             {
-                new ((*fHitItems)[fNofHitItems++]) R3BTofdHitData(tArrT[hit],
-                                                                  (tArrX[hit] + tArrX[hit + 1]) / 2.,
-                                                                  tArrYT[hit],
-                                                                  tArrQ[hit],
+                new ((*fHitItems)[fNofHitItems++]) R3BTofdHitData(hits[hit].t,
+                                                                  (hits[hit].x + hits[hit + 1].x) / 2.,
+                                                                  hits[hit].yToT,
+                                                                  hits[hit].q,
                                                                   -1.,
-                                                                  tArrQ[hit],
-                                                                  tArrP[hit]);
+                                                                  hits[hit].q,
+                                                                  hits[hit].plane);
             }
             else
             {
-                new ((*fHitItems)[fNofHitItems++]) R3BTofdHitData(tArrT[hit],
-                                                                  (tArrX[hit] + tArrX[hit + 1]) / 2.,
-                                                                  tArrY[hit],
-                                                                  tArrQ[hit],
+                new ((*fHitItems)[fNofHitItems++]) R3BTofdHitData(hits[hit].t,
+                                                                  (hits[hit].x + hits[hit + 1].x) / 2.,
+                                                                  hits[hit].y,
+                                                                  hits[hit].q,
                                                                   -1.,
-                                                                  tArrQ[hit],
-                                                                  tArrP[hit]);
+                                                                  hits[hit].q,
+                                                                  hits[hit].plane);
             }
             hit++;
         }
@@ -1310,8 +1240,8 @@ void R3BTofdCal2Hit::Exec(Option_t* option)
     // std::cout<<"Used up hits in this event:\n";
     for (Int_t a = 0; a < 2 * nHitsEvent; a++)
     {
-        // std::cout << tArrU[a] << " ";
-        if (tArrU[a] != true)
+        // std::cout << hits[a].used << " ";
+        if (hits[a].used != true)
             LOG(FATAL)<<"Not all hits were analyzed!";
     }
     // std::cout << "\n";
@@ -1869,21 +1799,4 @@ Double_t R3BTofdCal2Hit::saturation(Double_t x)
     return kor;
 }
 
-Double_t* R3BTofdCal2Hit::insertX(Int_t n, Double_t arr[], Double_t x, Int_t pos)
-{
-    Int_t i;
-
-    // increase the size by 1
-    n++;
-
-    // shift elements forward
-    for (i = n; i >= pos; i--)
-        arr[i] = arr[i - 1];
-
-    // insert x at pos
-    arr[pos - 1] = x;
-
-    return arr;
-}
-
 ClassImp(R3BTofdCal2Hit)
@@ -0,0 +1,44 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTofdHitRecord.h"
+
+#include <algorithm>
+#include <cmath>
+
+void R3BTofdSortHits(std::vector<R3BTofdHitRecord>& hits)
+{
+    // The insertion sort found no place for a hit without a time
+    hits.erase(std::remove_if(hits.begin(), hits.end(), [](const R3BTofdHitRecord& hit) { return std::isnan(hit.t); }),
+               hits.end());
+
+    std::stable_sort(hits.begin(), hits.end(), [](const R3BTofdHitRecord& a, const R3BTofdHitRecord& b) {
+        return a.t < b.t;
+    });
+
+    // The insertion sort put a hit with the same time as others right
+    // behind the first of them
+    for (auto first = hits.begin(); first != hits.end();)
+    {
+        auto last = first + 1;
+        while (last != hits.end() && last->t == first->t)
+        {
+            ++last;
+        }
+        if (last - first > 2)
+        {
+            std::reverse(first + 1, last);
+        }
+        first = last;
+    }
+}
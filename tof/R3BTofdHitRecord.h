@@ -0,0 +1,46 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BTOFDHITRECORD_H
+#define R3BTOFDHITRECORD_H
+
+#include "Rtypes.h"
+
+#include <vector>
+
+/**
+ * One ToFD hit in a virtual bar as it goes into the coincidence and
+ * averaging step of R3BTofdCal2Hit. Every bar hit appears twice, once in
+ * each of the two virtual (half-width) bars it covers.
+ */
+struct R3BTofdHitRecord
+{
+    Double_t t;    // time-of-flight / ns
+    Double_t q;    // charge
+    Double_t x;    // cm
+    Double_t y;    // from the time difference / cm
+    Double_t yToT; // from the ToT ratio / cm
+    Int_t plane;   // 1..n, -1 for an empty slot
+    Int_t bar;     // virtual bar
+    Bool_t used;   // averaged or stored as single hit
+};
+
+/**
+ * Sorts the hits in time. Of hits with equal times the first one given
+ * stays in front, the others follow in reverse order, as the insertion
+ * sort R3BTofdCal2Hit used before did it. Hits with a NaN time are
+ * dropped, the insertion sort lost them, too.
+ */
+void R3BTofdSortHits(std::vector<R3BTofdHitRecord>& hits);
+
+#endif
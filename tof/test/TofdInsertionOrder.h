@@ -0,0 +1,82 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef TOFDINSERTIONORDER_H
+#define TOFDINSERTIONORDER_H
+
+#include "R3BTofdHitRecord.h"
+
+#include <vector>
+
+// The time ordering of R3BTofdCal2Hit before R3BTofdSortHits, insertion with
+// insertX into arrays of nSlots = 2 * nHitsEvent + 1 entries preset to -1,
+// as reference for the tests
+inline std::vector<R3BTofdHitRecord> TofdInsertionOrder(const std::vector<R3BTofdHitRecord>& in, Int_t nSlots)
+{
+    const R3BTofdHitRecord empty = { -1., -1., -1., -1., -1., -1, -1, kFALSE };
+    // insertX wrote one entry past the end
+    std::vector<R3BTofdHitRecord> arr(nSlots + 1, empty);
+    const Int_t n = nSlots - 1;
+    auto insertX = [&](const R3BTofdHitRecord& x, Int_t pos) {
+        for (Int_t i = n + 1; i >= pos; i--)
+            arr[i] = arr[i - 1];
+        arr[pos - 1] = x;
+    };
+
+    for (auto& hit : in)
+    {
+        if (arr[0].t == -1.)
+        {
+            arr[0] = hit;
+        }
+        else if (hit.t < arr[0].t)
+        {
+            insertX(hit, 1);
+        }
+        else
+        {
+            Int_t p = 0;
+            while (hit.t > arr[p].t && arr[p].t != -1.)
+                p++;
+            if (p > 0 && hit.t > arr[p - 1].t && hit.t != arr[p].t)
+                insertX(hit, p + 1);
+            else if (hit.t == arr[p].t)
+                insertX(hit, p + 2);
+        }
+    }
+    arr.resize(nSlots);
+    return arr;
+}
+
+// The same with R3BTofdSortHits, as R3BTofdCal2Hit does it now
+inline std::vector<R3BTofdHitRecord> TofdSortedOrder(std::vector<R3BTofdHitRecord> hits, Int_t nSlots)
+{
+    R3BTofdSortHits(hits);
+    hits.resize(nSlots, { -1., -1., -1., -1., -1., -1, -1, kFALSE });
+    return hits;
+}
+
+inline Bool_t TofdSameOrder(const std::vector<R3BTofdHitRecord>& a, const std::vector<R3BTofdHitRecord>& b)
+{
+    if (a.size() != b.size())
+        return kFALSE;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].t != b[i].t || a[i].q != b[i].q || a[i].x != b[i].x || a[i].y != b[i].y || a[i].yToT != b[i].yToT ||
+            a[i].plane != b[i].plane || a[i].bar != b[i].bar)
+            return kFALSE;
+    }
+    return kTRUE;
+}
+
+#endif
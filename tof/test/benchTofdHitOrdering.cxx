@@ -0,0 +1,153 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Orders the ToFD hits of recorded TofdCal events with the insertion sort
+// R3BTofdCal2Hit used before and with R3BTofdSortHits, and compares the
+// results and timings. Several events can be merged into one to try high
+// multiplicities.
+// Usage: benchTofdHitOrdering <file with TofdCal> [events merged into one, default 1 10 100]
+
+#include "R3BTofdCalData.h"
+#include "R3BTofdHitRecord.h"
+#include "TofdInsertionOrder.h"
+
+#include <TClonesArray.h>
+#include <TFile.h>
+#include <TTree.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    // Top and bottom PMT of a bar in the order of the cal data, as
+    // R3BTofdCal2Hit pairs them before the walk correction
+    std::vector<R3BTofdHitRecord> ReadEvent(TClonesArray* cal)
+    {
+        std::map<std::pair<Int_t, Int_t>, std::pair<std::vector<R3BTofdCalData*>, std::vector<R3BTofdCalData*>>> bars;
+        for (Int_t i = 0; i < cal->GetEntriesFast(); i++)
+        {
+            auto hit = static_cast<R3BTofdCalData*>(cal->At(i));
+            auto& bar = bars[std::make_pair((Int_t)hit->GetDetectorId(), (Int_t)hit->GetBarId())];
+            (hit->GetSideId() == 1 ? bar.second : bar.first).push_back(hit);
+        }
+
+        std::vector<R3BTofdHitRecord> hits;
+        for (auto& b : bars)
+        {
+            const Int_t plane = b.first.first;
+            const Int_t bar = b.first.second;
+            auto& top = b.second.first;
+            auto& bot = b.second.second;
+            for (size_t i = 0; i < top.size() && i < bot.size(); i++)
+            {
+                const Double_t t = (top[i]->GetTimeLeading_ns() + bot[i]->GetTimeLeading_ns()) / 2.;
+                const Double_t q = std::sqrt(std::fabs((top[i]->GetTimeTrailing_ns() - top[i]->GetTimeLeading_ns()) *
+                                                       (bot[i]->GetTimeTrailing_ns() - bot[i]->GetTimeLeading_ns())));
+                const Double_t y = bot[i]->GetTimeLeading_ns() - top[i]->GetTimeLeading_ns();
+                const Int_t shift = (plane == 2 || plane == 4) ? 2 : 0;
+                hits.push_back({ t, q, (Double_t)bar, y, y, plane, bar * 2 - 2 + shift, kFALSE });
+                hits.push_back({ t, q, (Double_t)bar, y, y, plane, bar * 2 - 1, kFALSE });
+            }
+        }
+        return hits;
+    }
+
+    template <typename Order>
+    Double_t Time(const std::vector<std::vector<R3BTofdHitRecord>>& events,
+                  Order order,
+                  std::vector<std::vector<R3BTofdHitRecord>>& out)
+    {
+        out.clear();
+        auto start = std::chrono::steady_clock::now();
+        for (auto& e : events)
+        {
+            out.push_back(order(e, e.size() + 1));
+        }
+        return std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <file with TofdCal> [events merged into one...]" << std::endl;
+        return 2;
+    }
+    std::vector<Int_t> merges;
+    for (Int_t i = 2; i < argc; i++)
+    {
+        merges.push_back(atoi(argv[i]));
+    }
+    if (merges.empty())
+    {
+        merges = { 1, 10, 100 };
+    }
+
+    std::unique_ptr<TFile> file(TFile::Open(argv[1]));
+    auto tree = file ? static_cast<TTree*>(file->Get("evt")) : nullptr;
+    if (!tree)
+    {
+        std::cerr << "No tree evt in " << argv[1] << std::endl;
+        return 2;
+    }
+    TClonesArray* cal = nullptr;
+    if (tree->SetBranchAddress("TofdCal", &cal) < 0)
+    {
+        std::cerr << "No branch TofdCal in " << argv[1] << std::endl;
+        return 2;
+    }
+
+    std::vector<std::vector<R3BTofdHitRecord>> recorded;
+    size_t nHits = 0;
+    for (Long64_t n = 0; n < tree->GetEntries(); n++)
+    {
+        tree->GetEntry(n);
+        recorded.push_back(ReadEvent(cal));
+        nHits += recorded.back().size();
+    }
+    std::cout << recorded.size() << " events with " << nHits << " virtual bar hits" << std::endl;
+
+    Int_t nDiff = 0;
+    for (auto m : merges)
+    {
+        std::vector<std::vector<R3BTofdHitRecord>> events;
+        for (size_t n = 0; n < recorded.size(); n++)
+        {
+            if (n % m == 0)
+            {
+                events.emplace_back();
+            }
+            events.back().insert(events.back().end(), recorded[n].begin(), recorded[n].end());
+        }
+
+        std::vector<std::vector<R3BTofdHitRecord>> inserted, sorted;
+        const Double_t tInsert = Time(events, TofdInsertionOrder, inserted);
+        const Double_t tSort = Time(events, TofdSortedOrder, sorted);
+        Int_t nEventDiff = 0;
+        for (size_t n = 0; n < events.size(); n++)
+        {
+            nEventDiff += !TofdSameOrder(inserted[n], sorted[n]);
+        }
+        std::cout << m << " events merged: insertion " << tInsert << " s, sort " << tSort << " s, " << nEventDiff
+                  << " of " << events.size() << " events ordered differently" << std::endl;
+        nDiff += nEventDiff;
+    }
+    return nDiff == 0 ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTofdHitRecord.h"
+#include "TofdInsertionOrder.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace
+{
+    // Every bar hit goes into two virtual bars with the same time, as in
+    // R3BTofdCal2Hit. Times on a coarse grid make hits of different bars
+    // coincide, too. The grid leaves out -1, the mark of an empty slot in
+    // the arrays of the insertion sort.
+    std::vector<R3BTofdHitRecord> RandomEvent(std::mt19937& rng, Int_t nBarHits, Double_t step)
+    {
+        std::vector<R3BTofdHitRecord> hits;
+        for (Int_t i = 0; i < nBarHits; i++)
+        {
+            const Double_t t = step * (Int_t)(rng() % 200) - 40.25;
+            const Int_t plane = 1 + rng() % 4;
+            const Int_t bar = 1 + rng() % 44;
+            const Double_t q = (rng() % 1000) / 7.;
+            const Int_t shift = (plane == 2 || plane == 4) ? 2 : 0;
+            hits.push_back({ t, q, (Double_t)bar, i * 0.5, i * 0.25, plane, bar * 2 - 2 + shift, kFALSE });
+            hits.push_back({ t, q, (Double_t)bar, i * 0.5, i * 0.25, plane, bar * 2 - 1, kFALSE });
+        }
+        std::shuffle(hits.begin(), hits.end(), rng);
+        return hits;
+    }
+
+    TEST(testR3BTofdHitRecord, sortMatchesInsertion)
+    {
+        std::mt19937 rng(19);
+        for (Int_t trial = 0; trial < 2000; trial++)
+        {
+            const Int_t nBarHits = rng() % 60;
+            const auto hits = RandomEvent(rng, nBarHits, trial % 2 ? 1.5 : 0.001);
+            const Int_t nSlots = 2 * nBarHits + 1;
+            ASSERT_TRUE(TofdSameOrder(TofdInsertionOrder(hits, nSlots), TofdSortedOrder(hits, nSlots)))
+                << "trial " << trial;
+        }
+    }
+
+    // The hits in the order R3BTofdCal2Hit::Exec hands them over: the bar
+    // hits go into the lists of their virtual bars, which are then read by
+    // plane, virtual bar and multi hit
+    TEST(testR3BTofdHitRecord, execLoopOrder)
+    {
+        const Int_t nPlanes = 4;
+        const Int_t nPaddles = 44;
+        std::mt19937 rng(5);
+        for (Int_t trial = 0; trial < 1000; trial++)
+        {
+            std::vector<std::vector<std::vector<R3BTofdHitRecord>>> bars(
+                nPlanes + 1, std::vector<std::vector<R3BTofdHitRecord>>(2 * nPaddles + 1));
+            const Int_t nBarHits = rng() % 80;
+            for (Int_t n = 0; n < nBarHits; n++)
+            {
+                const Int_t plane = 1 + rng() % nPlanes;
+                // Few bars, so that some get several hits
+                const Int_t bar = 1 + rng() % (trial % 2 ? nPaddles : 5);
+                const Double_t t = 0.5 * (Int_t)(rng() % 100) - 20.25;
+                const Double_t q = (rng() % 1000) / 7.;
+                const Int_t shift = (plane == 2 || plane == 4) ? 2 : 0;
+                const R3BTofdHitRecord hit = { t, q, (Double_t)bar, n * 0.5, n * 0.25, plane, 0, kFALSE };
+                bars[plane][bar * 2 - 2 + shift].push_back(hit);
+                bars[plane][bar * 2 - 1].push_back(hit);
+            }
+
+            std::vector<R3BTofdHitRecord> hits;
+            for (Int_t i = 1; i <= nPlanes; i++)
+            {
+                for (Int_t j = 0; j < 2 * nPaddles + 1; j++)
+                {
+                    for (auto hit : bars[i][j])
+                    {
+                        hit.bar = j;
+                        hits.push_back(hit);
+                    }
+                }
+            }
+            const Int_t nSlots = 2 * nBarHits + 1;
+            ASSERT_TRUE(TofdSameOrder(TofdInsertionOrder(hits, nSlots), TofdSortedOrder(hits, nSlots)))
+                << "trial " << trial;
+        }
+    }
+
+    TEST(testR3BTofdHitRecord, emptySlotsForBarsWithoutParameters)
+    {
+        std::mt19937 rng(7);
+        const auto hits = RandomEvent(rng, 10, 1.);
+        // Five more bar hits were counted, but had no parameters
+        const auto sorted = TofdSortedOrder(hits, 2 * 15 + 1);
+        EXPECT_TRUE(TofdSameOrder(TofdInsertionOrder(hits, 2 * 15 + 1), sorted));
+        for (size_t i = hits.size(); i < sorted.size(); i++)
+        {
+            EXPECT_EQ(-1, sorted[i].plane);
+            EXPECT_EQ(-1., sorted[i].t);
+        }
+    }
+
+    TEST(testR3BTofdHitRecord, nanTimesAreDropped)
+    {
+        std::mt19937 rng(23);
+        for (Int_t trial = 0; trial < 500; trial++)
+        {
+            auto hits = RandomEvent(rng, 1 + rng() % 40, 1.5);
+            // Never in front, after a first hit without a time the insertion sort lost all others
+            const Int_t nNan = 1 + rng() % 4;
+            for (Int_t i = 0; i < nNan; i++)
+            {
+                R3BTofdHitRecord hit = hits[rng() % hits.size()];
+                hit.t = NAN;
+                hits.insert(hits.begin() + 1 + rng() % hits.size(), hit);
+            }
+            const Int_t nSlots = hits.size() + 1;
+            const auto sorted = TofdSortedOrder(hits, nSlots);
+            ASSERT_TRUE(TofdSameOrder(TofdInsertionOrder(hits, nSlots), sorted)) << "trial " << trial;
+            EXPECT_EQ(nNan + 1, std::count_if(sorted.begin(), sorted.end(), [](const R3BTofdHitRecord& hit) {
+                          return hit.plane == -1;
+                      }));
+            for (auto& hit : sorted)
+            {
+                EXPECT_FALSE(std::isnan(hit.t));
+            }
+        }
+    }
+
+    TEST(testR3BTofdHitRecord, equalTimes)
+    {
+        std::vector<R3BTofdHitRecord> hits;
+        for (Int_t i = 0; i < 5; i++)
+        {
+            hits.push_back({ 3., 1., 0., 0., 0., 1, i, kFALSE });
+        }
+        hits.push_back({ 1., 1., 0., 0., 0., 2, 9, kFALSE });
+        R3BTofdSortHits(hits);
+        const Int_t bars[] = { 9, 0, 4, 3, 2, 1 };
+        for (Int_t i = 0; i < 6; i++)
+        {
+            EXPECT_EQ(bars[i], hits[i].bar);
+        }
+    }
+} // namespace
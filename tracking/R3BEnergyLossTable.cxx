@@ -0,0 +1,54 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BEnergyLossTable.h"
+
+#include "TMath.h"
+
+R3BEnergyLossTable::R3BEnergyLossTable() {}
+
+void R3BEnergyLossTable::Fill(const Function& eloss)
+{
+    fValues.resize(kNPoints);
+    for (Int_t i = 0; i < kNPoints; i++)
+    {
+        const Double_t betaGamma = kBetaGammaMin + i * kStep;
+        const Double_t gamma = TMath::Sqrt(1. + betaGamma * betaGamma);
+        const Double_t beta = betaGamma / gamma;
+        fValues[i] = beta * beta * eloss(beta, gamma);
+    }
+}
+
+Double_t R3BEnergyLossTable::GetDeviation(const Function& eloss, Double_t& betaGamma) const
+{
+    Double_t deviation = 0.;
+    betaGamma = 0.;
+    for (Int_t i = 0; i < (Int_t)fValues.size() - 1; i++)
+    {
+        const Double_t bg = kBetaGammaMin + (i + 0.5) * kStep;
+        const Double_t gamma = TMath::Sqrt(1. + bg * bg);
+        const Double_t beta = bg / gamma;
+        const Double_t exact = eloss(beta, gamma);
+        if (exact <= 0.)
+        {
+            continue;
+        }
+        const Double_t d = TMath::Abs(Eval(beta, gamma) - exact) / exact;
+        if (d > deviation)
+        {
+            deviation = d;
+            betaGamma = bg;
+        }
+    }
+    return deviation;
+}
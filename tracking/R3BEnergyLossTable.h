@@ -0,0 +1,74 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BENERGYLOSSTABLE_H
+#define R3BENERGYLOSSTABLE_H
+
+#include "Rtypes.h"
+
+#include <functional>
+#include <vector>
+
+/**
+ * Energy loss of one ion in one detector as a function of beta * gamma, on a
+ * uniform grid with linear interpolation. R3BTrackingDetector::GetEnergyLoss()
+ * uses it instead of the Bethe-Bloch formula. The table holds beta^2 times
+ * the energy loss, for Bethe-Bloch that is the logarithmic term only, which
+ * is smooth down to the lowest beta * gamma.
+ */
+class R3BEnergyLossTable
+{
+  public:
+    static constexpr Double_t kBetaGammaMin = 0.1;
+    static constexpr Double_t kBetaGammaMax = 10.;
+    static constexpr Int_t kNPoints = 2000;
+
+    /** Energy loss [MeV] as a function of beta and gamma **/
+    using Function = std::function<Double_t(Double_t, Double_t)>;
+
+    R3BEnergyLossTable();
+
+    void Fill(const Function& eloss);
+
+    Bool_t IsInside(Double_t betaGamma) const
+    {
+        return !fValues.empty() && betaGamma >= kBetaGammaMin && betaGamma <= kBetaGammaMax;
+    }
+
+    /** Energy loss [MeV], only meaningful if IsInside(beta * gamma) **/
+    inline Double_t Eval(Double_t beta, Double_t gamma) const;
+
+    /** Largest relative deviation from eloss half way between the grid points,
+        where the interpolation is worst, found at betaGamma **/
+    Double_t GetDeviation(const Function& eloss, Double_t& betaGamma) const;
+
+  private:
+    static constexpr Double_t kStep = (kBetaGammaMax - kBetaGammaMin) / (kNPoints - 1);
+    static constexpr Double_t kInvStep = 1. / kStep;
+
+    std::vector<Double_t> fValues; // beta^2 * energy loss at the grid points
+};
+
+inline Double_t R3BEnergyLossTable::Eval(Double_t beta, Double_t gamma) const
+{
+    const Double_t u = (beta * gamma - kBetaGammaMin) * kInvStep;
+    Int_t i = (Int_t)u;
+    if (i > kNPoints - 2)
+    {
+        i = kNPoints - 2;
+    }
+    const Double_t f = u - i;
+    return (fValues[i] + f * (fValues[i + 1] - fValues[i])) / (beta * beta);
+}
+
+#endif
@@ -19,18 +19,129 @@
 
 #include "R3BFragmentFitterChi2S494.h"
 
+#include <functional>
+#include <memory>
+#include <mutex>
+
 using namespace std;
 
 #define SPEED_OF_LIGHT 29.9792458 // cm/ns
 #define Amu 0.938272
 
-R3BTrackingParticle* gCandidate;
-R3BTrackingSetup* gSetup;
-R3BTPropagator* gProp;
+// Everything the chi2 functions need to know about the fit in progress. Each
+// minimizer has its own, so fits of different candidates do not share state.
+struct R3BFragmentFitContext
+{
+    R3BTrackingParticle* candidate;
+    R3BTrackingSetup* setup;
+    R3BTPropagator* prop;
+    Bool_t energyLoss;
+};
+
+// Minimizers of one kind, set up once with their objective function and
+// handed out to one fit at a time. The pool grows to the number of fits that
+// run at the same time.
+class R3BFragmentFitterPool
+{
+  public:
+    struct Slot
+    {
+        R3BFragmentFitContext context;
+        ROOT::Math::Minimizer* minimizer;
+    };
+
+    // Returns the slot to the pool when the fit is done, also on early returns
+    class Lease
+    {
+      public:
+        Lease(R3BFragmentFitterPool* pool)
+            : fPool(pool)
+            , fSlot(pool->Acquire())
+        {
+        }
+        ~Lease() { fPool->Release(fSlot); }
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        R3BFragmentFitContext& Context() { return fSlot->context; }
+        ROOT::Math::Minimizer* Minimizer() { return fSlot->minimizer; }
+
+      private:
+        R3BFragmentFitterPool* fPool;
+        Slot* fSlot;
+    };
+
+    using Objective = double (*)(const R3BFragmentFitContext&, const double*);
+
+    R3BFragmentFitterPool(const char* algorithm,
+                          Objective objective,
+                          UInt_t nParameters,
+                          std::function<void(ROOT::Math::Minimizer*)> configure,
+                          const R3BFragmentFitContext& defaults)
+        : fAlgorithm(algorithm)
+        , fObjective(objective)
+        , fNParameters(nParameters)
+        , fConfigure(configure)
+        , fDefaults(defaults)
+    {
+    }
+
+    ~R3BFragmentFitterPool()
+    {
+        for (auto& slot : fSlots)
+        {
+            delete slot->minimizer;
+        }
+    }
 
-Bool_t gEnergyLoss;
+    Slot* Acquire()
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        Slot* slot;
+        if (fFree.empty())
+        {
+            // The plugin manager behind the factory is not re-entrant, so this stays under the lock
+            fSlots.emplace_back(new Slot);
+            slot = fSlots.back().get();
+            slot->minimizer = ROOT::Math::Factory::CreateMinimizer("Minuit2", fAlgorithm);
+            fConfigure(slot->minimizer);
+            // The minimizer keeps a copy of the functor, which refers to the context of its own slot
+            Objective objective = fObjective;
+            R3BFragmentFitContext* context = &slot->context;
+            ROOT::Math::Functor f([objective, context](const double* xx) { return objective(*context, xx); },
+                                  fNParameters);
+            slot->minimizer->SetFunction(f);
+        }
+        else
+        {
+            slot = fFree.back();
+            fFree.pop_back();
+        }
+        slot->context = fDefaults;
+        return slot;
+    }
+
+    void Release(Slot* slot)
+    {
+        slot->minimizer->Clear();
+        std::lock_guard<std::mutex> lock(fMutex);
+        fFree.push_back(slot);
+    }
 
-double Chi2(const double* xx)
+  private:
+    const char* fAlgorithm;
+    Objective fObjective;
+    UInt_t fNParameters;
+    std::function<void(ROOT::Math::Minimizer*)> fConfigure;
+    R3BFragmentFitContext fDefaults;
+
+    std::mutex fMutex;
+    std::vector<std::unique_ptr<Slot>> fSlots;
+    std::vector<Slot*> fFree;
+};
+
+double Chi2(const R3BFragmentFitContext& ctx, const double* xx)
 {
     // Bool_t result = kFALSE;
     Double_t sdev = 0.;
@@ -41,23 +152,23 @@ double Chi2(const double* xx)
     Double_t chi2 = 0.;
     Int_t nchi2 = 0;
 
-    gCandidate->SetMass(xx[0]);
-    gCandidate->UpdateMomentum();
+    ctx.candidate->SetMass(xx[0]);
+    ctx.candidate->UpdateMomentum();
 
-    gCandidate->Reset();
+    ctx.candidate->Reset();
 
     // Propagate through the setup, defined by array of detectors
-    for (auto const& det : gSetup->GetArray())
+    for (auto const& det : ctx.setup->GetArray())
     {
         if (kTarget != det->section)
         {
-            /*result = */ gProp->PropagateToDetector(gCandidate, det);
+            /*result = */ ctx.prop->PropagateToDetector(ctx.candidate, det);
 
-            time += (gCandidate->GetLength() - prev_l) / (gCandidate->GetBeta() * SPEED_OF_LIGHT);
-            prev_l = gCandidate->GetLength();
+            time += (ctx.candidate->GetLength() - prev_l) / (ctx.candidate->GetBeta() * SPEED_OF_LIGHT);
+            prev_l = ctx.candidate->GetLength();
         }
 
-        if (gEnergyLoss)
+        if (ctx.energyLoss)
         {
             if (kTof != det->section)
             {
@@ -66,15 +177,15 @@ double Chi2(const double* xx)
                 {
                     weight = 0.5;
                 }
-                gCandidate->PassThroughDetector(det, weight);
+                ctx.candidate->PassThroughDetector(det, weight);
             }
         }
 
         // Convert global track coordinates into local on the det plane
-        det->GlobalToLocal(gCandidate->GetPosition(), x_l, y_l);
+        det->GlobalToLocal(ctx.candidate->GetPosition(), x_l, y_l);
 
-        R3BHit* hit =
-            gSetup->GetHit(det->GetDetectorName().Data(), gCandidate->GetHitIndexByName(det->GetDetectorName().Data()));
+        R3BHit* hit = ctx.setup->GetHit(det->GetDetectorName().Data(),
+                                        ctx.candidate->GetHitIndexByName(det->GetDetectorName().Data()));
 
         // X deviation at the last detector
         if (kAfterGlad == det->section)
@@ -100,18 +211,18 @@ double Chi2(const double* xx)
     // sdev = TMath::Sqrt(sdev);
 
     // chi2 /= nchi2;
-    gCandidate->SetChi2(chi2);
+    ctx.candidate->SetChi2(chi2);
 
     return chi2;
 }
 
-double Chi2MomentumForward(const double* xx)
+double Chi2MomentumForward(const R3BFragmentFitContext& ctx, const double* xx)
 {
     LOG(DEBUG3) << "In chi2" << endl;
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z() << endl;
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z() << endl;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z() << endl;
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z() << endl;
     Double_t x_l = 0.;
     Double_t y_l = 0.;
     Double_t chi2 = 0.;
@@ -134,51 +245,51 @@ double Chi2MomentumForward(const double* xx)
     TVector3 startPosition(x0, y0, z0);
     TVector3 startMomentum(px0, py0, pz0);
 
-    gCandidate->SetStartPosition(startPosition);
-    gCandidate->SetStartMomentum(startMomentum);
-    // gCandidate->UpdateMomentum();
-    gCandidate->Reset();
+    ctx.candidate->SetStartPosition(startPosition);
+    ctx.candidate->SetStartMomentum(startMomentum);
+    // ctx.candidate->UpdateMomentum();
+    ctx.candidate->Reset();
 
     LOG(DEBUG3) << "Nach setzen der Startwerte" << endl;
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z() << endl;
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z() << endl;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z() << endl;
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z() << endl;
     // Propagate forward through the setup, defined by array of detectors
-    for (Int_t i = 0; i < (gSetup->GetArray().size() - 0); i++)
+    for (Int_t i = 0; i < (ctx.setup->GetArray().size() - 0); i++)
     {
-        auto det = gSetup->GetArray().at(i);
+        auto det = ctx.setup->GetArray().at(i);
 
         LOG(DEBUG3) << "At detector " << det->GetDetectorName() << endl;
         if (i > 0)
         {
-            gProp->PropagateToDetector(gCandidate, det);
+            ctx.prop->PropagateToDetector(ctx.candidate, det);
 
-            // time += (gCandidate->GetLength() - prev_l) / (gCandidate->GetBeta() * SPEED_OF_LIGHT);
-            // prev_l = gCandidate->GetLength();
+            // time += (ctx.candidate->GetLength() - prev_l) / (ctx.candidate->GetBeta() * SPEED_OF_LIGHT);
+            // prev_l = ctx.candidate->GetLength();
 
-            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << gCandidate->GetMomentum().X() << ", "
-                        << gCandidate->GetMomentum().Y() << ", " << gCandidate->GetMomentum().Z();
+            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << ctx.candidate->GetMomentum().X() << ", "
+                        << ctx.candidate->GetMomentum().Y() << ", " << ctx.candidate->GetMomentum().Z();
         }
-        if (gEnergyLoss)
+        if (ctx.energyLoss)
         {
             Double_t weight = 1.;
             if (kTarget == det->section)
             {
                 weight = 0.5;
             }
-            gCandidate->PassThroughDetector(det, weight);
+            ctx.candidate->PassThroughDetector(det, weight);
         }
 
         // Convert global track coordinates into local on the det plane
-        det->GlobalToLocal(gCandidate->GetPosition(), x_l, y_l);
+        det->GlobalToLocal(ctx.candidate->GetPosition(), x_l, y_l);
         R3BHit* hit = nullptr;
-        Int_t hitIndex = gCandidate->GetHitIndexByName(det->GetDetectorName().Data());
+        Int_t hitIndex = ctx.candidate->GetHitIndexByName(det->GetDetectorName().Data());
 
         // cout << "Hit index " << hitIndex << endl;
         if (-1 != hitIndex)
         {
-            hit = gSetup->GetHit(det->GetDetectorName().Data(), hitIndex);
+            hit = ctx.setup->GetHit(det->GetDetectorName().Data(), hitIndex);
         }
         // Take into chi2 only if there is a hit and user specified SigmaX > 0.
         if (hit && det->res_x > 1e-6)
@@ -200,23 +311,23 @@ double Chi2MomentumForward(const double* xx)
         }
     }
 
-    gCandidate->SetChi2(chi2);
+    ctx.candidate->SetChi2(chi2);
     LOG(DEBUG3) << "Ende chi2" << endl;
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z() << endl;
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z() << endl;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z() << endl;
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z() << endl;
 
     return chi2;
 }
 
-double Chi2MomentumBackward(const double* xx)
+double Chi2MomentumBackward(const R3BFragmentFitContext& ctx, const double* xx)
 {
     LOG(DEBUG3) << "In chi2" << endl;
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z() << endl;
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z() << endl;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z() << endl;
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z() << endl;
 
     Double_t x_l = 0.;
     Double_t y_l = 0.;
@@ -224,18 +335,18 @@ double Chi2MomentumBackward(const double* xx)
     Int_t nchi2 = 0;
     TVector3 pos2;
     TVector3 pos3;
-    // LOG(DEBUG3) << "Test: " << gCandidate->GetHitIndexByName("fi12") << "  " << gCandidate->GetHitIndexByName("fi10")
-    // << endl;
+    // LOG(DEBUG3) << "Test: " << ctx.candidate->GetHitIndexByName("fi12") << "  "
+    // << ctx.candidate->GetHitIndexByName("fi10") << endl;
 
-    if (gCandidate->GetHitIndexByName("fi30") > -1)
+    if (ctx.candidate->GetHitIndexByName("fi30") > -1)
     {
-        auto fi30 = gSetup->GetByName("fi30");
-        fi30->LocalToGlobal(pos3, gSetup->GetHit("fi30", gCandidate->GetHitIndexByName("fi30"))->GetX(), 0.);
+        auto fi30 = ctx.setup->GetByName("fi30");
+        fi30->LocalToGlobal(pos3, ctx.setup->GetHit("fi30", ctx.candidate->GetHitIndexByName("fi30"))->GetX(), 0.);
     }
-    else if (gCandidate->GetHitIndexByName("fi31") > -1 && gCandidate->GetHitIndexByName("fi33") > -1)
+    else if (ctx.candidate->GetHitIndexByName("fi31") > -1 && ctx.candidate->GetHitIndexByName("fi33") > -1)
     {
-        auto fi33 = gSetup->GetByName("fi33");
-        fi33->LocalToGlobal(pos3, gSetup->GetHit("fi33", gCandidate->GetHitIndexByName("fi33"))->GetX(), 0.);
+        auto fi33 = ctx.setup->GetByName("fi33");
+        fi33->LocalToGlobal(pos3, ctx.setup->GetHit("fi33", ctx.candidate->GetHitIndexByName("fi33"))->GetX(), 0.);
     }
     else
     {
@@ -259,69 +370,69 @@ double Chi2MomentumBackward(const double* xx)
     // TVector3 pos0 = pos3;
     TVector3 startMomentum(px0, py0, pz0);
 
-    gCandidate->SetPosition(pos3);
-    gCandidate->SetMomentum(startMomentum);
-    // gCandidate->UpdateMomentum();
-    // gCandidate->Reset();
+    ctx.candidate->SetPosition(pos3);
+    ctx.candidate->SetMomentum(startMomentum);
+    // ctx.candidate->UpdateMomentum();
+    // ctx.candidate->Reset();
 
     LOG(DEBUG3) << "Nach setzen von Werten" << endl;
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z() << endl;
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z() << endl;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z() << endl;
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z() << endl;
 
     /*
-        LOG(DEBUG3) << "Test momentum: " << gCandidate->GetMomentum().X() << ", "
-            << gCandidate->GetMomentum().Y() << ", " << gCandidate->GetMomentum().Z() << endl;
-        LOG(DEBUG3) << "Test position: " << gCandidate->GetPosition().X() << ", "
-            << gCandidate->GetPosition().Y() << ", " << gCandidate->GetPosition().Z() << endl;
-        LOG(DEBUG3) << "Test charge: " << gCandidate->GetCharge() << endl;
+        LOG(DEBUG3) << "Test momentum: " << ctx.candidate->GetMomentum().X() << ", "
+            << ctx.candidate->GetMomentum().Y() << ", " << ctx.candidate->GetMomentum().Z() << endl;
+        LOG(DEBUG3) << "Test position: " << ctx.candidate->GetPosition().X() << ", "
+            << ctx.candidate->GetPosition().Y() << ", " << ctx.candidate->GetPosition().Z() << endl;
+        LOG(DEBUG3) << "Test charge: " << ctx.candidate->GetCharge() << endl;
     */
 
     // Propagate backward through the setup, defined by array of detectors
-    for (Int_t i = (gSetup->GetArray().size() - 2); i >= 0; i--)
+    for (Int_t i = (ctx.setup->GetArray().size() - 2); i >= 0; i--)
     {
-        auto det = gSetup->GetArray().at(i);
+        auto det = ctx.setup->GetArray().at(i);
 
-        if (i < (gSetup->GetArray().size() - 2))
+        if (i < (ctx.setup->GetArray().size() - 2))
         {
-            gProp->PropagateToDetectorBackward(gCandidate, det);
+            ctx.prop->PropagateToDetectorBackward(ctx.candidate, det);
 
-            // time += (gCandidate->GetLength() - prev_l) / (gCandidate->GetBeta() * SPEED_OF_LIGHT);
-            // prev_l = gCandidate->GetLength();
+            // time += (ctx.candidate->GetLength() - prev_l) / (ctx.candidate->GetBeta() * SPEED_OF_LIGHT);
+            // prev_l = ctx.candidate->GetLength();
 
-            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << gCandidate->GetMomentum().X() << ", "
-                        << gCandidate->GetMomentum().Y() << ", " << gCandidate->GetMomentum().Z();
+            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << ctx.candidate->GetMomentum().X() << ", "
+                        << ctx.candidate->GetMomentum().Y() << ", " << ctx.candidate->GetMomentum().Z();
 
             LOG(DEBUG3) << "Vor Energieverlust" << endl;
-            LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  "
-                        << gCandidate->GetMomentum().Y() << "  " << gCandidate->GetMomentum().Z() << endl;
-            LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  "
-                        << gCandidate->GetPosition().Y() << "  " << gCandidate->GetPosition().Z() << endl;
+            LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  "
+                        << ctx.candidate->GetMomentum().Y() << "  " << ctx.candidate->GetMomentum().Z() << endl;
+            LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  "
+                        << ctx.candidate->GetPosition().Y() << "  " << ctx.candidate->GetPosition().Z() << endl;
 
-            if (gEnergyLoss)
+            if (ctx.energyLoss)
             {
                 Double_t weight = 1.;
                 if (kTarget == det->section)
                 {
                     weight = 0.5;
                 }
-                gCandidate->PassThroughDetectorBackward(det, weight);
+                ctx.candidate->PassThroughDetectorBackward(det, weight);
             }
             LOG(DEBUG3) << "Nach Energieverlust" << endl;
-            LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  "
-                        << gCandidate->GetMomentum().Y() << "  " << gCandidate->GetMomentum().Z() << endl;
-            LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  "
-                        << gCandidate->GetPosition().Y() << "  " << gCandidate->GetPosition().Z() << endl;
+            LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  "
+                        << ctx.candidate->GetMomentum().Y() << "  " << ctx.candidate->GetMomentum().Z() << endl;
+            LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  "
+                        << ctx.candidate->GetPosition().Y() << "  " << ctx.candidate->GetPosition().Z() << endl;
         }
 
         // Convert global track coordinates into local on the det plane
-        det->GlobalToLocal(gCandidate->GetPosition(), x_l, y_l);
+        det->GlobalToLocal(ctx.candidate->GetPosition(), x_l, y_l);
 
         R3BHit* hit = nullptr;
-        Int_t hitIndex = gCandidate->GetHitIndexByName(det->GetDetectorName().Data());
+        Int_t hitIndex = ctx.candidate->GetHitIndexByName(det->GetDetectorName().Data());
         if (-1 != hitIndex)
-            hit = gSetup->GetHit(det->GetDetectorName().Data(), hitIndex);
+            hit = ctx.setup->GetHit(det->GetDetectorName().Data(), hitIndex);
 
         // Take into chi2 only if there is a hit and user specified SigmaX > 0.
         if (hit && det->res_x > 1e-6)
@@ -342,17 +453,17 @@ double Chi2MomentumBackward(const double* xx)
         }
     }
     LOG(DEBUG3) << "Ende chi2" << endl;
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z() << endl;
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z() << endl;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z() << endl;
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z() << endl;
 
-    gCandidate->SetChi2(chi2);
+    ctx.candidate->SetChi2(chi2);
 
     return chi2;
 }
 
-double Chi2Beta(const double* xx)
+double Chi2Beta(const R3BFragmentFitContext& ctx, const double* xx)
 {
     // Bool_t result = kFALSE;
     // Double_t sdev = 0.;
@@ -363,42 +474,42 @@ double Chi2Beta(const double* xx)
     Double_t chi2 = 0.;
     Int_t nchi2 = 0;
 
-    gCandidate->SetStartBeta(xx[0]);
-    gCandidate->UpdateMomentum();
+    ctx.candidate->SetStartBeta(xx[0]);
+    ctx.candidate->UpdateMomentum();
 
-    gCandidate->Reset();
+    ctx.candidate->Reset();
 
     // Propagate through the setup, defined by array of detectors
-    for (auto const& det : gSetup->GetArray())
+    for (auto const& det : ctx.setup->GetArray())
     {
         if (kTarget != det->section)
         {
-            /*result = */ gProp->PropagateToDetector(gCandidate, det);
+            /*result = */ ctx.prop->PropagateToDetector(ctx.candidate, det);
 
-            // time += (gCandidate->GetLength() - prev_l) / (gCandidate->GetBeta() * SPEED_OF_LIGHT);
-            // prev_l = gCandidate->GetLength();
+            // time += (ctx.candidate->GetLength() - prev_l) / (ctx.candidate->GetBeta() * SPEED_OF_LIGHT);
+            // prev_l = ctx.candidate->GetLength();
 
-            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << gCandidate->GetMomentum().X() << ","
-                        << gCandidate->GetMomentum().Y() << gCandidate->GetMomentum().Z();
+            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << ctx.candidate->GetMomentum().X() << ","
+                        << ctx.candidate->GetMomentum().Y() << ctx.candidate->GetMomentum().Z();
         }
 
-        if (gEnergyLoss)
+        if (ctx.energyLoss)
         {
             Double_t weight = 1.;
             if (kTarget == det->section)
             {
                 weight = 0.5;
             }
-            gCandidate->PassThroughDetector(det, weight);
+            ctx.candidate->PassThroughDetector(det, weight);
         }
 
         // Convert global track coordinates into local on the det plane
-        det->GlobalToLocal(gCandidate->GetPosition(), x_l, y_l);
+        det->GlobalToLocal(ctx.candidate->GetPosition(), x_l, y_l);
 
         R3BHit* hit = nullptr;
-        Int_t hitIndex = gCandidate->GetHitIndexByName(det->GetDetectorName().Data());
+        Int_t hitIndex = ctx.candidate->GetHitIndexByName(det->GetDetectorName().Data());
         if (hitIndex >= 0)
-            hit = gSetup->GetHit(det->GetDetectorName().Data(), hitIndex);
+            hit = ctx.setup->GetHit(det->GetDetectorName().Data(), hitIndex);
 
         // if(kTarget != det->section)
         // if(kAfterGlad == det->section)
@@ -419,12 +530,12 @@ double Chi2Beta(const double* xx)
     // sdev = TMath::Sqrt(sdev);
 
     // chi2 /= nchi2;
-    gCandidate->SetChi2(chi2);
+    ctx.candidate->SetChi2(chi2);
 
     return chi2;
 }
 
-double Chi2Backward(const double* xx)
+double Chi2Backward(const R3BFragmentFitContext& ctx, const double* xx)
 {
     // Bool_t result = kFALSE;
     // Double_t sdev = 0.;
@@ -435,42 +546,42 @@ double Chi2Backward(const double* xx)
     Double_t chi2 = 0.;
     Int_t nchi2 = 0;
 
-    gCandidate->SetMass(xx[0]);
-    gCandidate->UpdateMomentum();
+    ctx.candidate->SetMass(xx[0]);
+    ctx.candidate->UpdateMomentum();
 
-    gCandidate->Reset();
+    ctx.candidate->Reset();
 
     // Propagate through the setup, defined by array of detectors
-    for (Int_t i = (gSetup->GetArray().size() - 2); i >= 0; i--)
+    for (Int_t i = (ctx.setup->GetArray().size() - 2); i >= 0; i--)
     {
-        auto det = gSetup->GetArray().at(i);
+        auto det = ctx.setup->GetArray().at(i);
 
-        if (i < (gSetup->GetArray().size() - 2))
+        if (i < (ctx.setup->GetArray().size() - 2))
         {
-            /*result = */ gProp->PropagateToDetectorBackward(gCandidate, det);
+            /*result = */ ctx.prop->PropagateToDetectorBackward(ctx.candidate, det);
 
-            // time += (gCandidate->GetLength() - prev_l) / (gCandidate->GetBeta() * SPEED_OF_LIGHT);
-            // prev_l = gCandidate->GetLength();
+            // time += (ctx.candidate->GetLength() - prev_l) / (ctx.candidate->GetBeta() * SPEED_OF_LIGHT);
+            // prev_l = ctx.candidate->GetLength();
 
-            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << gCandidate->GetMomentum().X() << ", "
-                        << gCandidate->GetMomentum().Y() << ", " << gCandidate->GetMomentum().Z();
+            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << ctx.candidate->GetMomentum().X() << ", "
+                        << ctx.candidate->GetMomentum().Y() << ", " << ctx.candidate->GetMomentum().Z();
         }
 
-        if (gEnergyLoss)
+        if (ctx.energyLoss)
         {
             Double_t weight = 1.;
             if (kTarget == det->section)
             {
                 weight = 0.5;
             }
-            gCandidate->PassThroughDetectorBackward(det, weight);
+            ctx.candidate->PassThroughDetectorBackward(det, weight);
         }
 
         // Convert global track coordinates into local on the det plane
-        det->GlobalToLocal(gCandidate->GetPosition(), x_l, y_l);
+        det->GlobalToLocal(ctx.candidate->GetPosition(), x_l, y_l);
 
-        R3BHit* hit =
-            gSetup->GetHit(det->GetDetectorName().Data(), gCandidate->GetHitIndexByName(det->GetDetectorName().Data()));
+        R3BHit* hit = ctx.setup->GetHit(det->GetDetectorName().Data(),
+                                        ctx.candidate->GetHitIndexByName(det->GetDetectorName().Data()));
 
         // if(kTarget != det->section)
         // if(kAfterGlad == det->section)
@@ -490,12 +601,12 @@ double Chi2Backward(const double* xx)
     // sdev = TMath::Sqrt(sdev);
 
     // chi2 /= nchi2;
-    gCandidate->SetChi2(chi2);
+    ctx.candidate->SetChi2(chi2);
 
     return chi2;
 }
 
-double Chi2Backward2D(const double* xx)
+double Chi2Backward2D(const R3BFragmentFitContext& ctx, const double* xx)
 {
     // Require fi30 and fi32  or fi31 and fi33 to have hit
     // for the initial position and direction
@@ -503,27 +614,27 @@ double Chi2Backward2D(const double* xx)
     TVector3 pos2;
     TVector3 pos3;
 
-    if (gCandidate->GetHitIndexByName("fi30") > -1 && gCandidate->GetHitIndexByName("fi32") > -1)
+    if (ctx.candidate->GetHitIndexByName("fi30") > -1 && ctx.candidate->GetHitIndexByName("fi32") > -1)
     {
-        auto fi30 = gSetup->GetByName("fi30");
-        auto fi32 = gSetup->GetByName("fi32");
+        auto fi30 = ctx.setup->GetByName("fi30");
+        auto fi32 = ctx.setup->GetByName("fi32");
         fi30->LocalToGlobal(pos2,
-                            gSetup->GetHit("fi30", gCandidate->GetHitIndexByName("fi30"))->GetX(),
-                            gSetup->GetHit("fi30", gCandidate->GetHitIndexByName("fi30"))->GetY());
+                            ctx.setup->GetHit("fi30", ctx.candidate->GetHitIndexByName("fi30"))->GetX(),
+                            ctx.setup->GetHit("fi30", ctx.candidate->GetHitIndexByName("fi30"))->GetY());
         fi32->LocalToGlobal(pos3,
-                            gSetup->GetHit("fi32", gCandidate->GetHitIndexByName("fi32"))->GetX(),
-                            gSetup->GetHit("fi32", gCandidate->GetHitIndexByName("fi32"))->GetY());
+                            ctx.setup->GetHit("fi32", ctx.candidate->GetHitIndexByName("fi32"))->GetX(),
+                            ctx.setup->GetHit("fi32", ctx.candidate->GetHitIndexByName("fi32"))->GetY());
     }
-    else if (gCandidate->GetHitIndexByName("fi31") > -1 && gCandidate->GetHitIndexByName("fi33") > -1)
+    else if (ctx.candidate->GetHitIndexByName("fi31") > -1 && ctx.candidate->GetHitIndexByName("fi33") > -1)
     {
-        auto fi31 = gSetup->GetByName("fi31");
-        auto fi33 = gSetup->GetByName("fi33");
+        auto fi31 = ctx.setup->GetByName("fi31");
+        auto fi33 = ctx.setup->GetByName("fi33");
         fi31->LocalToGlobal(pos2,
-                            gSetup->GetHit("fi31", gCandidate->GetHitIndexByName("fi31"))->GetX(),
-                            gSetup->GetHit("fi31", gCandidate->GetHitIndexByName("fi31"))->GetY());
+                            ctx.setup->GetHit("fi31", ctx.candidate->GetHitIndexByName("fi31"))->GetX(),
+                            ctx.setup->GetHit("fi31", ctx.candidate->GetHitIndexByName("fi31"))->GetY());
         fi33->LocalToGlobal(pos3,
-                            gSetup->GetHit("fi33", gCandidate->GetHitIndexByName("fi33"))->GetX(),
-                            gSetup->GetHit("fi33", gCandidate->GetHitIndexByName("fi33"))->GetY());
+                            ctx.setup->GetHit("fi33", ctx.candidate->GetHitIndexByName("fi33"))->GetX(),
+                            ctx.setup->GetHit("fi33", ctx.candidate->GetHitIndexByName("fi33"))->GetY());
     }
     else
     {
@@ -538,51 +649,51 @@ double Chi2Backward2D(const double* xx)
     double mass = xx[0];
 
     // cout << "Set mass: " << mass << endl;
-    gCandidate->SetMass(mass);
-    gCandidate->UpdateMomentum();
+    ctx.candidate->SetMass(mass);
+    ctx.candidate->UpdateMomentum();
 
     TVector3 direction0 = (pos2 - pos3).Unit();
     TVector3 pos0 = pos3;
-    Double_t mom = gCandidate->GetMass() * gCandidate->GetStartBeta() * gCandidate->GetStartGamma();
+    Double_t mom = ctx.candidate->GetMass() * ctx.candidate->GetStartBeta() * ctx.candidate->GetStartGamma();
     TVector3 startMomentum(mom * direction0.X(), mom * direction0.Y(), mom * direction0.Z());
-    gCandidate->SetStartPosition(pos0);
-    gCandidate->SetStartMomentum(startMomentum);
-    gCandidate->Reset();
+    ctx.candidate->SetStartPosition(pos0);
+    ctx.candidate->SetStartMomentum(startMomentum);
+    ctx.candidate->Reset();
 
     // Propagate through the setup, defined by array of detectors
-    for (Int_t i = (gSetup->GetArray().size() - 2); i >= 0; i--)
+    for (Int_t i = (ctx.setup->GetArray().size() - 2); i >= 0; i--)
     {
-        auto det = gSetup->GetArray().at(i);
+        auto det = ctx.setup->GetArray().at(i);
 
-        if (i < (gSetup->GetArray().size() - 2))
+        if (i < (ctx.setup->GetArray().size() - 2))
         {
 
-            /*result = */ gProp->PropagateToDetectorBackward(gCandidate, det);
+            /*result = */ ctx.prop->PropagateToDetectorBackward(ctx.candidate, det);
 
-            // time += (gCandidate->GetLength() - prev_l) / (gCandidate->GetBeta() * SPEED_OF_LIGHT);
-            // prev_l = gCandidate->GetLength();
+            // time += (ctx.candidate->GetLength() - prev_l) / (ctx.candidate->GetBeta() * SPEED_OF_LIGHT);
+            // prev_l = ctx.candidate->GetLength();
 
-            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << gCandidate->GetMomentum().X() << ", "
-                        << gCandidate->GetMomentum().Y() << ", " << gCandidate->GetMomentum().Z();
+            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << ctx.candidate->GetMomentum().X() << ", "
+                        << ctx.candidate->GetMomentum().Y() << ", " << ctx.candidate->GetMomentum().Z();
         }
 
-        if (gEnergyLoss)
+        if (ctx.energyLoss)
         {
             Double_t weight = 1.;
             if (kTarget == det->section)
             {
                 weight = 0.5;
             }
-            gCandidate->PassThroughDetectorBackward(det, weight);
+            ctx.candidate->PassThroughDetectorBackward(det, weight);
         }
 
         // Convert global track coordinates into local on the det plane
-        det->GlobalToLocal(gCandidate->GetPosition(), x_l, y_l);
+        det->GlobalToLocal(ctx.candidate->GetPosition(), x_l, y_l);
 
         R3BHit* hit = nullptr;
-        Int_t hitIndex = gCandidate->GetHitIndexByName(det->GetDetectorName().Data());
+        Int_t hitIndex = ctx.candidate->GetHitIndexByName(det->GetDetectorName().Data());
         if (-1 != hitIndex)
-            hit = gSetup->GetHit(det->GetDetectorName().Data(), hitIndex);
+            hit = ctx.setup->GetHit(det->GetDetectorName().Data(), hitIndex);
 
         // Take into chi2 only if there is a hit and user specified SigmaX > 0.
         if (hit && det->res_x > 1e-6)
@@ -602,79 +713,129 @@ double Chi2Backward2D(const double* xx)
             nchi2 += 1;
         }
     }
-    gCandidate->SetChi2(chi2);
+    ctx.candidate->SetChi2(chi2);
     return chi2;
 }
 
-R3BFragmentFitterChi2S494::R3BFragmentFitterChi2S494() {}
+R3BFragmentFitterChi2S494::R3BFragmentFitterChi2S494()
+    : fMassPool(nullptr)
+    , fBetaPool(nullptr)
+    , fBackwardPool(nullptr)
+    , fMomentumForwardPool(nullptr)
+    , fMomentumBackwardPool(nullptr)
+    , fPropagator(nullptr)
+{
+}
 
-R3BFragmentFitterChi2S494::~R3BFragmentFitterChi2S494() {}
+R3BFragmentFitterChi2S494::~R3BFragmentFitterChi2S494() { DeletePools(); }
+
+void R3BFragmentFitterChi2S494::DeletePools()
+{
+    delete fMassPool;
+    delete fBetaPool;
+    delete fBackwardPool;
+    delete fMomentumForwardPool;
+    delete fMomentumBackwardPool;
+    fMassPool = nullptr;
+    fBetaPool = nullptr;
+    fBackwardPool = nullptr;
+    fMomentumForwardPool = nullptr;
+    fMomentumBackwardPool = nullptr;
+}
 
 void R3BFragmentFitterChi2S494::Init(R3BTPropagator* prop, Bool_t energyLoss)
 {
     cout << "Call of init of R3BFragmentFitterChi2S494 !!!!!!!!!!!!!!" << endl;
     fPropagator = prop;
-    gProp = prop;
-    gEnergyLoss = energyLoss;
-
-    fMinimum = ROOT::Math::Factory::CreateMinimizer("Minuit2", "Migrad");
-
-    // set tolerance , etc...
-    fMinimum->SetMaxFunctionCalls(100000); // for Minuit/Minuit2
-    fMinimum->SetMaxIterations(10000);     // for GSL
-    fMinimum->SetTolerance(10.);
-    fMinimum->SetPrintLevel(0);
-    fMinimum->SetStrategy(0);
-
-    // create funciton wrapper for minmizer
-    // a IMultiGenFunction type
-    ROOT::Math::Functor* f = new ROOT::Math::Functor(&Chi2Backward2D, 1);
-
-    fMinimum->SetFunction(*f);
-    minimum_m = ROOT::Math::Factory::CreateMinimizer("Minuit2", "Simplex");
-
-    // set tolerance , etc...
-    minimum_m->SetMaxFunctionCalls(10000); // for Minuit/Minuit2
-    minimum_m->SetMaxIterations(1000);     // for GSL
-    minimum_m->SetTolerance(10.0);
-    minimum_m->SetPrintLevel(0);
-
-    // create funciton wrapper for minmizer
-    // a IMultiGenFunction type
-    ROOT::Math::Functor* fm = new ROOT::Math::Functor(&Chi2MomentumForward, 6);
 
-    minimum_m->SetFunction(*fm);
+    // The minimizers are created when a fit needs one
+    DeletePools();
+    const R3BFragmentFitContext defaults = { nullptr, nullptr, prop, energyLoss };
+
+    fMassPool = new R3BFragmentFitterPool(
+        "Migrad",
+        &Chi2,
+        1,
+        [](ROOT::Math::Minimizer* minimum) {
+            // set tolerance , etc...
+            minimum->SetMaxFunctionCalls(1000000); // for Minuit/Minuit2
+            minimum->SetMaxIterations(10000);      // for GSL
+            minimum->SetTolerance(0.0001);
+            minimum->SetPrintLevel(0);
+        },
+        defaults);
+
+    fBetaPool = new R3BFragmentFitterPool(
+        "",
+        &Chi2Beta,
+        1,
+        [](ROOT::Math::Minimizer* minimum) {
+            minimum->SetMaxFunctionCalls(1000000); // for Minuit/Minuit2
+            minimum->SetMaxIterations(10000);      // for GSL
+            minimum->SetTolerance(0.001);
+            minimum->SetPrintLevel(0);
+        },
+        defaults);
+
+    fBackwardPool = new R3BFragmentFitterPool(
+        "Migrad",
+        &Chi2Backward2D,
+        1,
+        [](ROOT::Math::Minimizer* minimum) {
+            minimum->SetMaxFunctionCalls(100000); // for Minuit/Minuit2
+            minimum->SetMaxIterations(10000);     // for GSL
+            minimum->SetTolerance(10.);
+            minimum->SetPrintLevel(0);
+            minimum->SetStrategy(0);
+        },
+        defaults);
+
+    fMomentumForwardPool = new R3BFragmentFitterPool(
+        "Simplex",
+        &Chi2MomentumForward,
+        6,
+        [](ROOT::Math::Minimizer* minimum) {
+            minimum->SetMaxFunctionCalls(10000); // for Minuit/Minuit2
+            minimum->SetMaxIterations(1000);     // for GSL
+            minimum->SetTolerance(10.0);
+            minimum->SetPrintLevel(0);
+        },
+        defaults);
+
+    fMomentumBackwardPool = new R3BFragmentFitterPool(
+        "Migrad",
+        &Chi2MomentumBackward,
+        3,
+        [](ROOT::Math::Minimizer* minimum) {
+            minimum->SetMaxFunctionCalls(10000); // for Minuit/Minuit2
+            minimum->SetMaxIterations(1000);     // for GSL
+            minimum->SetTolerance(10.0);
+            minimum->SetPrintLevel(0);
+        },
+        defaults);
 }
 
 Int_t R3BFragmentFitterChi2S494::FitTrack(R3BTrackingParticle* particle, R3BTrackingSetup* setup)
 {
-    gCandidate = particle;
+    R3BFragmentFitterPool::Lease lease(fMassPool);
+    R3BFragmentFitContext& ctx = lease.Context();
+    ctx.candidate = particle;
+    ctx.setup = setup;
 
-    ROOT::Math::Minimizer* minimum = ROOT::Math::Factory::CreateMinimizer("Minuit2", "Migrad");
+    ROOT::Math::Minimizer* minimum = lease.Minimizer();
 
-    // set tolerance , etc...
-    minimum->SetMaxFunctionCalls(1000000); // for Minuit/Minuit2
-    minimum->SetMaxIterations(10000);      // for GSL
-    minimum->SetTolerance(0.0001);
-    minimum->SetPrintLevel(0);
-
-    // create funciton wrapper for minmizer
-    // a IMultiGenFunction type
-    ROOT::Math::Functor f(&Chi2, 1);
     double variable[1] = { particle->GetMass() };
     double step[1] = {
         0.001,
     };
 
-    minimum->SetFunction(f);
-
     // Set the free variables to be minimized!
     minimum->SetLimitedVariable(0, "m", variable[0], step[0], variable[0] - 0.5, variable[0] + 0.5);
 
     Int_t status = 0;
 
     // do the minimization
-    gEnergyLoss = kTRUE;
+    ctx.energyLoss = kTRUE;
 
     minimum->Minimize();
 
@@ -689,8 +850,6 @@ Int_t R3BFragmentFitterChi2S494::FitTrack(R3BTrackingParticle* particle, R3BTrac
 
     particle->Reset();
 
-    delete minimum;
-
     return status;
 }
 
@@ -698,30 +857,34 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumForward(R3BTrackingParticle* pa
 {
     // fPropagator->SetVis(kTRUE);
     // LOG(DEBUG3) << "In track momentum" << endl;
-    gCandidate = particle;
-    gSetup = setup;
+    R3BFragmentFitterPool::Lease lease(fMomentumForwardPool);
+    R3BFragmentFitContext& ctx = lease.Context();
+    ctx.candidate = particle;
+    ctx.setup = setup;
+
+    ROOT::Math::Minimizer* minimum_m = lease.Minimizer();
 
-    Double_t px0 = gCandidate->GetStartMomentum().X();
-    Double_t py0 = gCandidate->GetStartMomentum().Y();
-    Double_t pz0 = gCandidate->GetStartMomentum().Z();
-    Double_t x0 = gCandidate->GetStartPosition().X();
-    Double_t y0 = gCandidate->GetStartPosition().Y();
-    Double_t z0 = gCandidate->GetStartPosition().Z();
+    Double_t px0 = ctx.candidate->GetStartMomentum().X();
+    Double_t py0 = ctx.candidate->GetStartMomentum().Y();
+    Double_t pz0 = ctx.candidate->GetStartMomentum().Z();
+    Double_t x0 = ctx.candidate->GetStartPosition().X();
+    Double_t y0 = ctx.candidate->GetStartPosition().Y();
+    Double_t z0 = ctx.candidate->GetStartPosition().Z();
 
     TVector3 pos3;
-    if (gCandidate->GetHitIndexByName("fi23a") > -1)
+    if (ctx.candidate->GetHitIndexByName("fi23a") > -1)
     {
-        auto fi23a = gSetup->GetByName("fi23a");
-        fi23a->LocalToGlobal(pos3, gSetup->GetHit("fi23a", gCandidate->GetHitIndexByName("fi23a"))->GetX(), 0.);
+        auto fi23a = ctx.setup->GetByName("fi23a");
+        fi23a->LocalToGlobal(pos3, ctx.setup->GetHit("fi23a", ctx.candidate->GetHitIndexByName("fi23a"))->GetX(), 0.);
         TVector3 direction0 = pos3.Unit();
         px0 = pz0 * direction0.X();
         py0 = pz0 * direction0.Y();
         pz0 = pz0 * direction0.Z();
     }
-    else if (gCandidate->GetHitIndexByName("fi23b") > -1 && gCandidate->GetHitIndexByName("fi23b") > -1)
+    else if (ctx.candidate->GetHitIndexByName("fi23b") > -1 && ctx.candidate->GetHitIndexByName("fi23b") > -1)
     {
-        auto fi23b = gSetup->GetByName("fi23b");
-        fi23b->LocalToGlobal(pos3, gSetup->GetHit("fi23b", gCandidate->GetHitIndexByName("fi23b"))->GetX(), 0.);
+        auto fi23b = ctx.setup->GetByName("fi23b");
+        fi23b->LocalToGlobal(pos3, ctx.setup->GetHit("fi23b", ctx.candidate->GetHitIndexByName("fi23b"))->GetX(), 0.);
         TVector3 direction0 = pos3.Unit();
         px0 = pz0 * direction0.X();
         py0 = pz0 * direction0.Y();
@@ -747,8 +910,8 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumForward(R3BTrackingParticle* pa
     LOG(DEBUG3) << "Start values momentum: " << px0 << "  " << py0 << "  " << pz0 << endl;
     LOG(DEBUG3) << "Start values position: " << x0 << "  " << y0 << "  " << z0 << endl;
 
-    //    double variable[3] = { gCandidate->GetMomentum().X(), gCandidate->GetMomentum().Y(),
-    //    gCandidate->GetMomentum().Z()}; double step[3] = { 0.01, 0.01, 0.01 };
+    //    double variable[3] = { ctx.candidate->GetMomentum().X(), ctx.candidate->GetMomentum().Y(),
+    //    ctx.candidate->GetMomentum().Z()}; double step[3] = { 0.01, 0.01, 0.01 };
     double variable[6] = { px0, py0, pz0, x0, y0, z0 };
     double step[6] = { 0.1, 0.1, 0.1, 0.01, 0.01, 0.01 };
     //    double variable[5] = { px0, py0, pz0, x0, y0};
@@ -764,20 +927,22 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumForward(R3BTrackingParticle* pa
                                   "pz",
                                   variable[2],
                                   step[2],
-                                  gCandidate->GetStartMomentum().Z() - 2.,
-                                  gCandidate->GetStartMomentum().Z() + 2.);
+                                  ctx.candidate->GetStartMomentum().Z() - 2.,
+                                  ctx.candidate->GetStartMomentum().Z() + 2.);
 
     minimum_m->SetLimitedVariable(3, "x0", variable[3], step[3], -1., 1.);
     minimum_m->SetLimitedVariable(4, "y0", variable[4], step[4], -1., 1.);
     minimum_m->SetLimitedVariable(5, "z0", variable[5], step[5], -1., 1.);
 
-    TVector3 startMomentum(
-        gCandidate->GetStartMomentum().X(), gCandidate->GetStartMomentum().Y(), gCandidate->GetStartMomentum().Z());
-    TVector3 startPosition(
-        gCandidate->GetStartPosition().X(), gCandidate->GetStartPosition().Y(), gCandidate->GetStartPosition().Z());
-    gCandidate->SetStartPosition(startPosition);
-    gCandidate->SetStartMomentum(startMomentum);
-    gCandidate->Reset();
+    TVector3 startMomentum(ctx.candidate->GetStartMomentum().X(),
+                           ctx.candidate->GetStartMomentum().Y(),
+                           ctx.candidate->GetStartMomentum().Z());
+    TVector3 startPosition(ctx.candidate->GetStartPosition().X(),
+                           ctx.candidate->GetStartPosition().Y(),
+                           ctx.candidate->GetStartPosition().Z());
+    ctx.candidate->SetStartPosition(startPosition);
+    ctx.candidate->SetStartMomentum(startMomentum);
+    ctx.candidate->Reset();
 
     Int_t status = 0;
 
@@ -796,18 +961,14 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumForward(R3BTrackingParticle* pa
     TVector3 startPositionOptimized(minimum_m->X()[3], minimum_m->X()[4], minimum_m->X()[5]);
     //    TVector3 startPositionOptimized(minimum_m->X()[3], minimum_m->X()[4], 0.);
     //    TVector3 startPositionOptimized(0., 0., 0.);
-    gCandidate->SetStartPosition(startPositionOptimized);
-    gCandidate->SetStartMomentum(startMomentumOptimized);
-    gCandidate->Reset();
+    ctx.candidate->SetStartPosition(startPositionOptimized);
+    ctx.candidate->SetStartMomentum(startMomentumOptimized);
+    ctx.candidate->Reset();
 
-    minimum_m->Clear();
-
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z();
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z();
-
-    // delete minimum_m;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z();
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z();
 
     return status;
 }
@@ -817,48 +978,40 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumBackward(R3BTrackingParticle* p
     // fPropagator->SetVis(kTRUE);
     // LOG(DEBUG3) << "In track momentum" << endl;
 
-    gCandidate = particle;
-    gSetup = setup;
-
-    ROOT::Math::Minimizer* minimum_a = ROOT::Math::Factory::CreateMinimizer("Minuit2", "Migrad");
-
-    // set tolerance , etc...
-    minimum_a->SetMaxFunctionCalls(10000); // for Minuit/Minuit2
-    minimum_a->SetMaxIterations(1000);     // for GSL
-    minimum_a->SetTolerance(10.0);
-    minimum_a->SetPrintLevel(0);
+    R3BFragmentFitterPool::Lease lease(fMomentumBackwardPool);
+    R3BFragmentFitContext& ctx = lease.Context();
+    ctx.candidate = particle;
+    ctx.setup = setup;
 
-    // create funciton wrapper for minmizer
-    // a IMultiGenFunction type
-    ROOT::Math::Functor fa(&Chi2MomentumBackward, 3);
+    ROOT::Math::Minimizer* minimum_a = lease.Minimizer();
 
     TVector3 pos2;
     TVector3 pos3;
-    // LOG(DEBUG3) << "Test: " << gCandidate->GetHitIndexByName("fi12") << "  " << gCandidate->GetHitIndexByName("fi10")
-    // << endl;
+    // LOG(DEBUG3) << "Test: " << ctx.candidate->GetHitIndexByName("fi12") << "  "
+    // << ctx.candidate->GetHitIndexByName("fi10") << endl;
 
-    if (gCandidate->GetHitIndexByName("fi32") > -1 && gCandidate->GetHitIndexByName("fi30") > -1)
+    if (ctx.candidate->GetHitIndexByName("fi32") > -1 && ctx.candidate->GetHitIndexByName("fi30") > -1)
     {
-        auto fi32 = gSetup->GetByName("fi32");
-        auto fi30 = gSetup->GetByName("fi30");
-        //		fi12->LocalToGlobal(pos2, gSetup->GetHit("fi12", gCandidate->GetHitIndexByName("fi12"))->GetX(),
-        //			gSetup->GetHit("fi12", gCandidate->GetHitIndexByName("fi12"))->GetY());
-        //		fi10->LocalToGlobal(pos3, gSetup->GetHit("fi10", gCandidate->GetHitIndexByName("fi10"))->GetX(),
-        //			gSetup->GetHit("fi10", gCandidate->GetHitIndexByName("fi10"))->GetY());
-        fi32->LocalToGlobal(pos2, gSetup->GetHit("fi32", gCandidate->GetHitIndexByName("fi32"))->GetX(), 0.);
-        fi30->LocalToGlobal(pos3, gSetup->GetHit("fi30", gCandidate->GetHitIndexByName("fi30"))->GetX(), 0.);
+        auto fi32 = ctx.setup->GetByName("fi32");
+        auto fi30 = ctx.setup->GetByName("fi30");
+        //		fi12->LocalToGlobal(pos2, ctx.setup->GetHit("fi12", ctx.candidate->GetHitIndexByName("fi12"))->GetX(),
+        //			ctx.setup->GetHit("fi12", ctx.candidate->GetHitIndexByName("fi12"))->GetY());
+        //		fi10->LocalToGlobal(pos3, ctx.setup->GetHit("fi10", ctx.candidate->GetHitIndexByName("fi10"))->GetX(),
+        //			ctx.setup->GetHit("fi10", ctx.candidate->GetHitIndexByName("fi10"))->GetY());
+        fi32->LocalToGlobal(pos2, ctx.setup->GetHit("fi32", ctx.candidate->GetHitIndexByName("fi32"))->GetX(), 0.);
+        fi30->LocalToGlobal(pos3, ctx.setup->GetHit("fi30", ctx.candidate->GetHitIndexByName("fi30"))->GetX(), 0.);
         LOG(DEBUG2) << "Fi 30 hit index " << particle->GetHitIndexByName("fi30") << " out of " << fi30->hits.size();
     }
-    else if (gCandidate->GetHitIndexByName("fi31") > -1 && gCandidate->GetHitIndexByName("fi33") > -1)
+    else if (ctx.candidate->GetHitIndexByName("fi31") > -1 && ctx.candidate->GetHitIndexByName("fi33") > -1)
     {
-        auto fi31 = gSetup->GetByName("fi31");
-        auto fi33 = gSetup->GetByName("fi33");
-        //		fi11->LocalToGlobal(pos2, gSetup->GetHit("fi11", gCandidate->GetHitIndexByName("fi11"))->GetX(),
-        //			gSetup->GetHit("fi11", gCandidate->GetHitIndexByName("fi11"))->GetY());
-        //		fi13->LocalToGlobal(pos3, gSetup->GetHit("fi13", gCandidate->GetHitIndexByName("fi13"))->GetX(),
-        //			gSetup->GetHit("fi13", gCandidate->GetHitIndexByName("fi13"))->GetY());
-        fi31->LocalToGlobal(pos2, gSetup->GetHit("fi31", gCandidate->GetHitIndexByName("fi31"))->GetX(), 0.);
-        fi33->LocalToGlobal(pos3, gSetup->GetHit("fi33", gCandidate->GetHitIndexByName("fi33"))->GetX(), 0.);
+        auto fi31 = ctx.setup->GetByName("fi31");
+        auto fi33 = ctx.setup->GetByName("fi33");
+        //		fi11->LocalToGlobal(pos2, ctx.setup->GetHit("fi11", ctx.candidate->GetHitIndexByName("fi11"))->GetX(),
+        //			ctx.setup->GetHit("fi11", ctx.candidate->GetHitIndexByName("fi11"))->GetY());
+        //		fi13->LocalToGlobal(pos3, ctx.setup->GetHit("fi13", ctx.candidate->GetHitIndexByName("fi13"))->GetX(),
+        //			ctx.setup->GetHit("fi13", ctx.candidate->GetHitIndexByName("fi13"))->GetY());
+        fi31->LocalToGlobal(pos2, ctx.setup->GetHit("fi31", ctx.candidate->GetHitIndexByName("fi31"))->GetX(), 0.);
+        fi33->LocalToGlobal(pos3, ctx.setup->GetHit("fi33", ctx.candidate->GetHitIndexByName("fi33"))->GetX(), 0.);
     }
     else
     {
@@ -867,35 +1020,33 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumBackward(R3BTrackingParticle* p
 
     TVector3 direction0 = (pos2 - pos3).Unit();
     TVector3 pos0 = pos3;
-    Double_t mom = gCandidate->GetMass() * gCandidate->GetStartBeta() * gCandidate->GetStartGamma();
+    Double_t mom = ctx.candidate->GetMass() * ctx.candidate->GetStartBeta() * ctx.candidate->GetStartGamma();
     TVector3 startMomentum(mom * direction0.X(), mom * direction0.Y(), mom * direction0.Z());
 
-    gCandidate->Reset();
-    gCandidate->SetPosition(pos0);
-    gCandidate->SetMomentum(startMomentum);
+    ctx.candidate->Reset();
+    ctx.candidate->SetPosition(pos0);
+    ctx.candidate->SetMomentum(startMomentum);
 
-    Double_t variable[3] = { gCandidate->GetMomentum().X(),
-                             gCandidate->GetMomentum().Y(),
-                             gCandidate->GetMomentum().Z() };
+    Double_t variable[3] = { ctx.candidate->GetMomentum().X(),
+                             ctx.candidate->GetMomentum().Y(),
+                             ctx.candidate->GetMomentum().Z() };
     Double_t step[3] = { 0.1, 0.1, 0.1 };
 
-    minimum_a->SetFunction(fa);
-
     // Set the free variables to be minimized!
     minimum_a->SetLimitedVariable(0, "px", variable[0], step[0], -10., 10.);
     minimum_a->SetLimitedVariable(1, "py", variable[1], step[1], -10., 10.);
     minimum_a->SetLimitedVariable(
-        2, "pz", variable[2], step[2], gCandidate->GetMomentum().Z() - 5., gCandidate->GetMomentum().Z() + 5.);
+        2, "pz", variable[2], step[2], ctx.candidate->GetMomentum().Z() - 5., ctx.candidate->GetMomentum().Z() + 5.);
 
-    gCandidate->SetStartBeta(gCandidate->GetBeta());
-    gCandidate->SetCharge(-1. * gCandidate->GetCharge());
-    gCandidate->UpdateMomentum();
+    ctx.candidate->SetStartBeta(ctx.candidate->GetBeta());
+    ctx.candidate->SetCharge(-1. * ctx.candidate->GetCharge());
+    ctx.candidate->UpdateMomentum();
 
     /*
-        LOG(DEBUG3) << "Start values momentum: " <<  gCandidate->GetMomentum().X() << "  "
-            << gCandidate->GetMomentum().Y() << "  " <<  gCandidate->GetMomentum().Z() << endl;
-        LOG(DEBUG3) << "Start values position: " <<  gCandidate->GetPosition().X() << "  "
-            << gCandidate->GetPosition().Y() << "  " <<  gCandidate->GetPosition().Z() << endl;
+        LOG(DEBUG3) << "Start values momentum: " <<  ctx.candidate->GetMomentum().X() << "  "
+            << ctx.candidate->GetMomentum().Y() << "  " <<  ctx.candidate->GetMomentum().Z() << endl;
+        LOG(DEBUG3) << "Start values position: " <<  ctx.candidate->GetPosition().X() << "  "
+            << ctx.candidate->GetPosition().Y() << "  " <<  ctx.candidate->GetPosition().Z() << endl;
     */
     Int_t status = 0;
 
@@ -909,22 +1060,22 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumBackward(R3BTrackingParticle* p
                 << minimum_a->X()[2];
 
     TVector3 startMomentumOptimized(minimum_a->X()[0], minimum_a->X()[1], minimum_a->X()[2]);
-    gCandidate->Reset();
-    gCandidate->SetPosition(pos0);
-    gCandidate->SetMomentum(startMomentumOptimized);
+    ctx.candidate->Reset();
+    ctx.candidate->SetPosition(pos0);
+    ctx.candidate->SetMomentum(startMomentumOptimized);
 
     // Propagate through the setup, defined by array of detectors
-    for (Int_t i = (gSetup->GetArray().size() - 2); i >= 0; i--)
+    for (Int_t i = (ctx.setup->GetArray().size() - 2); i >= 0; i--)
     {
-        auto det = gSetup->GetArray().at(i);
-        if (i < (gSetup->GetArray().size() - 2))
+        auto det = ctx.setup->GetArray().at(i);
+        if (i < (ctx.setup->GetArray().size() - 2))
         {
-            gProp->PropagateToDetectorBackward(gCandidate, det);
+            ctx.prop->PropagateToDetectorBackward(ctx.candidate, det);
 
-            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << gCandidate->GetMomentum().X() << ", "
-                        << gCandidate->GetMomentum().Y() << ", " << gCandidate->GetMomentum().Z();
+            LOG(DEBUG2) << " at " << det->GetDetectorName() << ", momentum:" << ctx.candidate->GetMomentum().X() << ", "
+                        << ctx.candidate->GetMomentum().Y() << ", " << ctx.candidate->GetMomentum().Z();
 
-            if (gEnergyLoss)
+            if (ctx.energyLoss)
             {
                 Double_t weight = 1.;
                 if (kTarget == det->section)
@@ -932,25 +1083,23 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumBackward(R3BTrackingParticle* p
                     weight = 0.5;
                 }
 
-                gCandidate->PassThroughDetectorBackward(det, weight);
+                ctx.candidate->PassThroughDetectorBackward(det, weight);
             }
         }
     }
 
     // particle->UpdateMomentum();
     LOG(DEBUG3) << "nach Energieverlust";
-    LOG(DEBUG3) << "current momentum: " << gCandidate->GetMomentum().X() << "  " << gCandidate->GetMomentum().Y()
-                << "  " << gCandidate->GetMomentum().Z();
-    LOG(DEBUG3) << "current position: " << gCandidate->GetPosition().X() << "  " << gCandidate->GetPosition().Y()
-                << "  " << gCandidate->GetPosition().Z();
-
-    gCandidate->SetStartMomentum(-1. * gCandidate->GetMomentum());
-    gCandidate->SetStartPosition(gCandidate->GetPosition());
-    gCandidate->SetCharge(-1. * gCandidate->GetCharge());
-    gCandidate->Reset();
-
-    minimum_a->Clear();
-    // delete minimum_a;
+    LOG(DEBUG3) << "current momentum: " << ctx.candidate->GetMomentum().X() << "  " << ctx.candidate->GetMomentum().Y()
+                << "  " << ctx.candidate->GetMomentum().Z();
+    LOG(DEBUG3) << "current position: " << ctx.candidate->GetPosition().X() << "  " << ctx.candidate->GetPosition().Y()
+                << "  " << ctx.candidate->GetPosition().Z();
+
+    ctx.candidate->SetStartMomentum(-1. * ctx.candidate->GetMomentum());
+    ctx.candidate->SetStartPosition(ctx.candidate->GetPosition());
+    ctx.candidate->SetCharge(-1. * ctx.candidate->GetCharge());
+    ctx.candidate->Reset();
+
     // candidate->Reset();
 
     return status;
@@ -958,31 +1107,23 @@ Int_t R3BFragmentFitterChi2S494::FitTrackMomentumBackward(R3BTrackingParticle* p
 
 Int_t R3BFragmentFitterChi2S494::FitTrackBeta(R3BTrackingParticle* particle, R3BTrackingSetup* setup)
 {
-    gCandidate = particle;
-
-    ROOT::Math::Minimizer* minimum = ROOT::Math::Factory::CreateMinimizer("Minuit2", "");
+    R3BFragmentFitterPool::Lease lease(fBetaPool);
+    R3BFragmentFitContext& ctx = lease.Context();
+    ctx.candidate = particle;
+    ctx.setup = setup;
 
-    // set tolerance , etc...
-    minimum->SetMaxFunctionCalls(1000000); // for Minuit/Minuit2
-    minimum->SetMaxIterations(10000);      // for GSL
-    minimum->SetTolerance(0.001);
-    minimum->SetPrintLevel(0);
+    ROOT::Math::Minimizer* minimum = lease.Minimizer();
 
-    // create funciton wrapper for minmizer
-    // a IMultiGenFunction type
-    ROOT::Math::Functor f(&Chi2Beta, 1);
     double variable[1] = { particle->GetStartBeta() };
     double step[1] = { 0.0001 };
 
-    minimum->SetFunction(f);
-
     // Set the free variables to be minimized!
     minimum->SetLimitedVariable(0, "beta", variable[0], step[0], 0.5, 0.999);
 
     Int_t status = 0;
 
     // do the minimization
-    gEnergyLoss = kTRUE;
+    ctx.energyLoss = kTRUE;
 
     minimum->Minimize();
 
@@ -997,8 +1138,6 @@ Int_t R3BFragmentFitterChi2S494::FitTrackBeta(R3BTrackingParticle* particle, R3B
 
     particle->Reset();
 
-    delete minimum;
-
     return status;
 }
 
@@ -1006,26 +1145,30 @@ Int_t R3BFragmentFitterChi2S494::FitTrackBackward(R3BTrackingParticle* particle,
 {
     // fPropagator->SetVis(kTRUE);
 
-    gCandidate = particle;
-    gSetup = setup;
+    R3BFragmentFitterPool::Lease lease(fBackwardPool);
+    R3BFragmentFitContext& ctx = lease.Context();
+    ctx.candidate = particle;
+    ctx.setup = setup;
 
-    auto fi23b = gSetup->GetByName("fi23b");
-    auto fi30 = gSetup->GetByName("fi30");
-    auto fi32 = gSetup->GetByName("fi32");
-    // auto tof = gSetup->GetFirstByType(kTof);
+    ROOT::Math::Minimizer* minimum = lease.Minimizer();
+
+    auto fi23b = ctx.setup->GetByName("fi23b");
+    auto fi30 = ctx.setup->GetByName("fi30");
+    auto fi32 = ctx.setup->GetByName("fi32");
+    // auto tof = ctx.setup->GetFirstByType(kTof);
 
     double variable[1] = { 132. * amu };
     double step[1] = { 0.01 };
 
     // Set the free variables to be minimized!
-    fMinimum->SetLimitedVariable(0, "m", variable[0], step[0], 125. * amu, 133. * amu);
+    minimum->SetLimitedVariable(0, "m", variable[0], step[0], 125. * amu, 133. * amu);
 
     TVector3 pos1;
     TVector3 pos2;
     TVector3 pos3;
-    fi23b->LocalToGlobal(pos1, gSetup->GetHit("fi23b", particle->GetHitIndexByName("fi23b"))->GetX(), 0.);
-    fi30->LocalToGlobal(pos2, gSetup->GetHit("fi30", particle->GetHitIndexByName("fi30"))->GetX(), 0.);
-    fi32->LocalToGlobal(pos3, gSetup->GetHit("fi32", particle->GetHitIndexByName("fi32"))->GetX(), 0.);
+    fi23b->LocalToGlobal(pos1, ctx.setup->GetHit("fi23b", particle->GetHitIndexByName("fi23b"))->GetX(), 0.);
+    fi30->LocalToGlobal(pos2, ctx.setup->GetHit("fi30", particle->GetHitIndexByName("fi30"))->GetX(), 0.);
+    fi32->LocalToGlobal(pos3, ctx.setup->GetHit("fi32", particle->GetHitIndexByName("fi32"))->GetX(), 0.);
     /*Int_t np = 3;
     Double_t x[] = {pos1.X(), pos2.X(), pos3.X()};
     Double_t xe[] = {fi23b->res_x, fi30->res_x, fi32->res_x};
@@ -1040,36 +1183,36 @@ Int_t R3BFragmentFitterChi2S494::FitTrackBackward(R3BTrackingParticle* particle,
     f1->Eval(fi32->hit_x)) ).Unit(); TVector3 pos0(f2->Eval(fi32->pos0.Z()), 0., fi32->pos0.Z());*/
     TVector3 direction0 = (pos2 - pos3).Unit();
     TVector3 pos0 = pos3;
-    Double_t mom = gCandidate->GetMass() * gCandidate->GetStartBeta() * gCandidate->GetStartGamma();
+    Double_t mom = ctx.candidate->GetMass() * ctx.candidate->GetStartBeta() * ctx.candidate->GetStartGamma();
     TVector3 startMomentum(mom * direction0.X(), mom * direction0.Y(), mom * direction0.Z());
-    gCandidate->SetStartPosition(pos0);
-    gCandidate->SetStartMomentum(startMomentum);
-    gCandidate->Reset();
+    ctx.candidate->SetStartPosition(pos0);
+    ctx.candidate->SetStartMomentum(startMomentum);
+    ctx.candidate->Reset();
 
     // pos1.Print();
     // startMomentum.Print();
 
-    for (Int_t i = 0; i <= (gSetup->GetArray().size() - 2); i++)
+    for (Int_t i = 0; i <= (ctx.setup->GetArray().size() - 2); i++)
     {
-        auto det = gSetup->GetArray().at(i);
+        auto det = ctx.setup->GetArray().at(i);
 
-        if (gEnergyLoss)
+        if (ctx.energyLoss)
         {
             Double_t weight = 1.;
             if (kTarget == det->section)
             {
                 weight = 0.5;
             }
-            gCandidate->PassThroughDetector(det, weight);
+            ctx.candidate->PassThroughDetector(det, weight);
         }
     }
 
-    // LOG(INFO) << "1 Start beta:" << gCandidate->GetStartBeta()
-    //<< ",  Beta:" << gCandidate->GetBeta();
+    // LOG(INFO) << "1 Start beta:" << ctx.candidate->GetStartBeta()
+    //<< ",  Beta:" << ctx.candidate->GetBeta();
 
-    gCandidate->SetStartBeta(gCandidate->GetBeta());
-    gCandidate->SetCharge(-1. * gCandidate->GetCharge());
-    gCandidate->UpdateMomentum();
+    ctx.candidate->SetStartBeta(ctx.candidate->GetBeta());
+    ctx.candidate->SetCharge(-1. * ctx.candidate->GetCharge());
+    ctx.candidate->UpdateMomentum();
 
     // Double_t chi2 = Chi2Backward(variable);
 
@@ -1080,21 +1223,19 @@ Int_t R3BFragmentFitterChi2S494::FitTrackBackward(R3BTrackingParticle* particle,
     Int_t status = 0;
 
     // do the minimization
-    fMinimum->Minimize();
+    minimum->Minimize();
 
-    gCandidate->SetCharge(-1. * gCandidate->GetCharge());
+    ctx.candidate->SetCharge(-1. * ctx.candidate->GetCharge());
 
-    status = fMinimum->Status();
+    status = minimum->Status();
     if (0 != status)
     {
         return status;
     }
 
-    particle->SetMass(fMinimum->X()[0]);
+    particle->SetMass(minimum->X()[0]);
     particle->UpdateMomentum();
 
-    fMinimum->Clear();
-
     // candidate->Reset();
 
     return status;
@@ -1106,74 +1247,78 @@ Int_t R3BFragmentFitterChi2S494::FitTrackBackward2D(R3BTrackingParticle* particl
 
     // Require fi30 and fi32  or fi31 and fi33 to have hit
     // for the initial position and direction
-    gCandidate = particle;
-    gSetup = setup;
+    R3BFragmentFitterPool::Lease lease(fBackwardPool);
+    R3BFragmentFitContext& ctx = lease.Context();
+    ctx.candidate = particle;
+    ctx.setup = setup;
+
+    ROOT::Math::Minimizer* minimum = lease.Minimizer();
 
     TVector3 pos2;
     TVector3 pos3;
-    if (gCandidate->GetHitIndexByName("fi30") > -1 && gCandidate->GetHitIndexByName("fi32") > -1)
+    if (ctx.candidate->GetHitIndexByName("fi30") > -1 && ctx.candidate->GetHitIndexByName("fi32") > -1)
     {
-        auto fi30 = gSetup->GetByName("fi30");
-        auto fi32 = gSetup->GetByName("fi32");
+        auto fi30 = ctx.setup->GetByName("fi30");
+        auto fi32 = ctx.setup->GetByName("fi32");
         fi30->LocalToGlobal(pos2,
-                            gSetup->GetHit("fi30", gCandidate->GetHitIndexByName("fi30"))->GetX(),
-                            gSetup->GetHit("fi30", gCandidate->GetHitIndexByName("fi30"))->GetY());
+                            ctx.setup->GetHit("fi30", ctx.candidate->GetHitIndexByName("fi30"))->GetX(),
+                            ctx.setup->GetHit("fi30", ctx.candidate->GetHitIndexByName("fi30"))->GetY());
         fi32->LocalToGlobal(pos3,
-                            gSetup->GetHit("fi32", gCandidate->GetHitIndexByName("fi32"))->GetX(),
-                            gSetup->GetHit("fi32", gCandidate->GetHitIndexByName("fi32"))->GetY());
+                            ctx.setup->GetHit("fi32", ctx.candidate->GetHitIndexByName("fi32"))->GetX(),
+                            ctx.setup->GetHit("fi32", ctx.candidate->GetHitIndexByName("fi32"))->GetY());
         LOG(DEBUG2) << "Fi 32 hit index " << particle->GetHitIndexByName("fi32") << " out of " << fi32->hits.size();
     }
-    else if (gCandidate->GetHitIndexByName("fi31") > -1 && gCandidate->GetHitIndexByName("fi33") > -1)
+    else if (ctx.candidate->GetHitIndexByName("fi31") > -1 && ctx.candidate->GetHitIndexByName("fi33") > -1)
     {
-        auto fi31 = gSetup->GetByName("fi31");
-        auto fi33 = gSetup->GetByName("fi33");
+        auto fi31 = ctx.setup->GetByName("fi31");
+        auto fi33 = ctx.setup->GetByName("fi33");
         fi31->LocalToGlobal(pos2,
-                            gSetup->GetHit("fi31", gCandidate->GetHitIndexByName("fi31"))->GetX(),
-                            gSetup->GetHit("fi31", gCandidate->GetHitIndexByName("fi31"))->GetY());
+                            ctx.setup->GetHit("fi31", ctx.candidate->GetHitIndexByName("fi31"))->GetX(),
+                            ctx.setup->GetHit("fi31", ctx.candidate->GetHitIndexByName("fi31"))->GetY());
         fi33->LocalToGlobal(pos3,
-                            gSetup->GetHit("fi33", gCandidate->GetHitIndexByName("fi33"))->GetX(),
-                            gSetup->GetHit("fi33", gCandidate->GetHitIndexByName("fi33"))->GetY());
+                            ctx.setup->GetHit("fi33", ctx.candidate->GetHitIndexByName("fi33"))->GetX(),
+                            ctx.setup->GetHit("fi33", ctx.candidate->GetHitIndexByName("fi33"))->GetY());
     }
     else
     {
         return 10;
     }
-    double variable[1] = { gCandidate->GetMass() };
+    double variable[1] = { ctx.candidate->GetMass() };
     double step[1] = { 0.01 };
 
     // Set the free variables to be minimized!
-    fMinimum->SetLimitedVariable(0, "m", variable[0], step[0], 2., 20.);
-    // fMinimum->SetLimitedVariable(1, "xfi32", variable[1], step[1], -200., 200.);
+    minimum->SetLimitedVariable(0, "m", variable[0], step[0], 2., 20.);
+    // minimum->SetLimitedVariable(1, "xfi32", variable[1], step[1], -200., 200.);
 
     TVector3 direction0 = (pos2 - pos3).Unit();
     TVector3 pos0 = pos3;
-    Double_t mom = gCandidate->GetMass() * gCandidate->GetStartBeta() * gCandidate->GetStartGamma();
+    Double_t mom = ctx.candidate->GetMass() * ctx.candidate->GetStartBeta() * ctx.candidate->GetStartGamma();
     TVector3 startMomentum(mom * direction0.X(), mom * direction0.Y(), mom * direction0.Z());
-    gCandidate->SetStartPosition(pos0);
-    gCandidate->SetStartMomentum(startMomentum);
-    gCandidate->Reset();
+    ctx.candidate->SetStartPosition(pos0);
+    ctx.candidate->SetStartMomentum(startMomentum);
+    ctx.candidate->Reset();
 
-    for (Int_t i = 0; i <= (gSetup->GetArray().size() - 2); i++)
+    for (Int_t i = 0; i <= (ctx.setup->GetArray().size() - 2); i++)
     {
-        auto det = gSetup->GetArray().at(i);
+        auto det = ctx.setup->GetArray().at(i);
 
-        if (gEnergyLoss)
+        if (ctx.energyLoss)
         {
             Double_t weight = 1.;
             if (kTarget == det->section)
             {
                 weight = 0.5;
             }
-            gCandidate->PassThroughDetector(det, weight);
+            ctx.candidate->PassThroughDetector(det, weight);
         }
     }
 
-    // LOG(INFO) << "1 Start beta:" << gCandidate->GetStartBeta()
-    //<< ",  Beta:" << gCandidate->GetBeta();
+    // LOG(INFO) << "1 Start beta:" << ctx.candidate->GetStartBeta()
+    //<< ",  Beta:" << ctx.candidate->GetBeta();
 
-    gCandidate->SetStartBeta(gCandidate->GetBeta());
-    gCandidate->SetCharge(-1. * gCandidate->GetCharge());
-    gCandidate->UpdateMomentum();
+    ctx.candidate->SetStartBeta(ctx.candidate->GetBeta());
+    ctx.candidate->SetCharge(-1. * ctx.candidate->GetCharge());
+    ctx.candidate->UpdateMomentum();
 
     // Double_t chi2 = Chi2Backward(variable);
 
@@ -1184,22 +1329,20 @@ Int_t R3BFragmentFitterChi2S494::FitTrackBackward2D(R3BTrackingParticle* particl
     Int_t status = 0;
 
     // do the minimization
-    fMinimum->Minimize();
+    minimum->Minimize();
 
-    gCandidate->SetCharge(-1. * gCandidate->GetCharge());
+    ctx.candidate->SetCharge(-1. * ctx.candidate->GetCharge());
 
-    status = fMinimum->Status();
+    status = minimum->Status();
     // cout << "Status: " << status << endl;
     if (0 != status)
     {
         return status;
     }
 
-    particle->SetMass(fMinimum->X()[0]);
+    particle->SetMass(minimum->X()[0]);
     particle->UpdateMomentum();
 
-    fMinimum->Clear();
-
     // candidate->Reset();
 
     return status;
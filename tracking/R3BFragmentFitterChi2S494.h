@@ -21,6 +21,14 @@
 #include "Math/Minimizer.h"
 #include "Minuit2/Minuit2Minimizer.h"
 
+class R3BFragmentFitterPool;
+
+/*
+ * The FitTrack* methods are re-entrant: the state of a fit lives in a context
+ * of its own, and the minimizer is taken from a pool that was set up in Init().
+ * Candidates can thus be fitted on several threads with one fitter. The other
+ * methods still share the propagator settings and are not.
+ */
 class R3BFragmentFitterChi2S494 : public R3BFragmentFitterGeneric
 {
   public:
@@ -41,6 +49,8 @@ class R3BFragmentFitterChi2S494 : public R3BFragmentFitterGeneric
     
     Int_t FitTrackBackward2D(R3BTrackingParticle*, R3BTrackingSetup*);
 
+    Bool_t IsParallelSafe() const { return kTRUE; }
+
     Double_t TrackFragment(R3BTrackingParticle* particle,
                            Bool_t energyLoss,
                            Double_t& devTof,
@@ -55,13 +65,19 @@ class R3BFragmentFitterChi2S494 : public R3BFragmentFitterGeneric
     Double_t Velocity(R3BTrackingParticle* candidate);
 
   private:
-    ROOT::Math::Minimizer* fMinimum;
-    ROOT::Math::Minimizer* minimum_m;
+    void DeletePools();
+
+    // One pool per minimizer setup, they grow to the number of parallel fits
+    R3BFragmentFitterPool* fMassPool;             //!
+    R3BFragmentFitterPool* fBetaPool;             //!
+    R3BFragmentFitterPool* fBackwardPool;         //! also for FitTrackBackward2D
+    R3BFragmentFitterPool* fMomentumForwardPool;  //!
+    R3BFragmentFitterPool* fMomentumBackwardPool; //!
     R3BTPropagator* fPropagator;
    	//Double_t amu = 0.938272;
    	Double_t amu = 0.931494028;   // Gev/c**2
 
-    ClassDef(R3BFragmentFitterChi2S494, 1)
+    ClassDef(R3BFragmentFitterChi2S494, 2)
 };
 
 #endif
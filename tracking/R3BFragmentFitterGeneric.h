@@ -40,6 +40,10 @@ class R3BFragmentFitterGeneric
     
     virtual Int_t FitTrackBackward2D(R3BTrackingParticle*, R3BTrackingSetup*) = 0;
 
+    /* Whether the FitTrack* methods may be called for different candidates
+     * at the same time, e.g. by the trackers fitting on several threads */
+    virtual Bool_t IsParallelSafe() const { return kFALSE; }
+
     ClassDef(R3BFragmentFitterGeneric, 1)
 };
 
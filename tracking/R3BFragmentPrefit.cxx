@@ -0,0 +1,118 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BFragmentPrefit.h"
+
+#include "TMath.h"
+
+namespace
+{
+    // Momentum [GeV/c] per charge, field [kG] and length [cm] times change of the direction
+    const Double_t kKickConstant = 2.99792458e-4;
+
+    // Adds (deviation / cut)^2 to the score, kFALSE if the cut is applied and not passed
+    Bool_t Score(Double_t deviation, Double_t cut, Double_t& score)
+    {
+        if (cut <= 0.)
+        {
+            return kTRUE;
+        }
+        score += (deviation / cut) * (deviation / cut);
+        return TMath::Abs(deviation) <= cut;
+    }
+} // namespace
+
+R3BFragmentPrefit::R3BFragmentPrefit()
+    : fCos(1.)
+    , fSin(0.)
+    , fIntegral(0.)
+    , fMaxKick(5.)
+    , fMaxTofX(10.)
+    , fMaxTofY(15.)
+    , fMaxMomentumDeviation(0.)
+{
+}
+
+void R3BFragmentPrefit::SetField(const TVector3& center, Double_t angle, Double_t integral)
+{
+    fCenter = center;
+    fCos = TMath::Cos(angle);
+    fSin = TMath::Sin(angle);
+    fIntegral = integral;
+}
+
+void R3BFragmentPrefit::ToField(const TVector3& pos, Double_t& u, Double_t& w) const
+{
+    // Inverse of TVector3::RotateY(angle)
+    const Double_t dx = pos.X() - fCenter.X();
+    const Double_t dz = pos.Z() - fCenter.Z();
+    u = fCos * dx - fSin * dz;
+    w = fSin * dx + fCos * dz;
+}
+
+Bool_t R3BFragmentPrefit::Check(const TVector3& target,
+                                const TVector3& beforeX,
+                                const TVector3& beforeY,
+                                const TVector3& after1,
+                                const TVector3& after2,
+                                const TVector3& tof,
+                                Double_t charge,
+                                Double_t p,
+                                Result& result) const
+{
+    result = Result();
+
+    Double_t uTarget, wTarget, uBefore, wBefore, u1, w1, u2, w2, uTof, wTof, uBeforeY, wBeforeY;
+    ToField(target, uTarget, wTarget);
+    ToField(beforeX, uBefore, wBefore);
+    ToField(beforeY, uBeforeY, wBeforeY);
+    ToField(after1, u1, w1);
+    ToField(after2, u2, w2);
+    ToField(tof, uTof, wTof);
+    if (wBefore == wTarget || w2 == w1 || wBeforeY == wTarget)
+    {
+        return kFALSE;
+    }
+
+    // Both segments in the mid plane w = 0
+    const Double_t slopeIn = (uBefore - uTarget) / (wBefore - wTarget);
+    const Double_t slopeOut = (u2 - u1) / (w2 - w1);
+    const Double_t uIn = uTarget - slopeIn * wTarget;
+    const Double_t uOut = u1 - slopeOut * w1;
+    result.kick = uOut - uIn;
+    result.tofX = uTof - (u1 + slopeOut * (wTof - w1));
+
+    // No bending in y, the path in the bending plane is the lever arm
+    const Double_t pathBeforeY =
+        TMath::Sqrt((uBeforeY - uTarget) * (uBeforeY - uTarget) + (wBeforeY - wTarget) * (wBeforeY - wTarget));
+    const Double_t pathTof = TMath::Sqrt((uIn - uTarget) * (uIn - uTarget) + wTarget * wTarget) +
+                             TMath::Sqrt((uTof - uOut) * (uTof - uOut) + wTof * wTof);
+    result.tofY = tof.Y() - (target.Y() + (beforeY.Y() - target.Y()) / pathBeforeY * pathTof);
+
+    Bool_t passed = Score(result.kick, fMaxKick, result.score);
+    passed = Score(result.tofX, fMaxTofX, result.score) && passed;
+    passed = Score(result.tofY, fMaxTofY, result.score) && passed;
+
+    // Change of the sine of the angle to the axis, as in a field of that integral
+    const Double_t kick = TMath::Abs(slopeOut / TMath::Sqrt(1. + slopeOut * slopeOut) -
+                                     slopeIn / TMath::Sqrt(1. + slopeIn * slopeIn));
+    if (fIntegral > 0. && kick > 0.)
+    {
+        result.momentum = kKickConstant * TMath::Abs(charge) * fIntegral / kick;
+        if (p > 0.)
+        {
+            passed = Score(result.momentum / p - 1., fMaxMomentumDeviation, result.score) && passed;
+        }
+    }
+    return passed;
+}
@@ -0,0 +1,87 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BFRAGMENTPREFIT_H
+#define R3BFRAGMENTPREFIT_H
+
+#include "Rtypes.h"
+#include "TVector3.h"
+
+/**
+ * Cheap check of a hit combination before R3BFragmentTrackerS494 fits it.
+ * GLAD is taken as a thin lens in its mid plane, with straight segments in
+ * front of it and behind it in the bending plane (x-z):
+ *  - the segment from the target through the x fiber in front of GLAD and
+ *    the segment through the two x fibers behind it meet in the mid plane,
+ *  - the ToFD hit lies on the segment behind GLAD,
+ *  - the ToFD hit lies on the straight line in y from the target through
+ *    the y fiber in front of GLAD,
+ *  - the kick, the change of direction in the mid plane, gives a momentum
+ *    close to the expected one.
+ * A cut of 0 or less is not applied. All positions are global [cm].
+ */
+class R3BFragmentPrefit
+{
+  public:
+    struct Result
+    {
+        Double_t kick;     // distance of the two segments in the mid plane [cm]
+        Double_t tofX;     // ToFD hit from the segment behind GLAD [cm]
+        Double_t tofY;     // ToFD hit from the line in y [cm]
+        Double_t momentum; // from the kick [GeV/c], 0 without field integral
+        Double_t score;    // sum of the squares of the deviations in units of their cuts
+    };
+
+    R3BFragmentPrefit();
+
+    /** Centre of GLAD, its angle around y [rad] and the integral of |By| along
+        its axis [kG cm]. Without the integral there is no momentum cut. **/
+    void SetField(const TVector3& center, Double_t angle, Double_t integral);
+
+    void SetMaxKick(Double_t kick) { fMaxKick = kick; }
+    void SetMaxTofX(Double_t dx) { fMaxTofX = dx; }
+    void SetMaxTofY(Double_t dy) { fMaxTofY = dy; }
+    /** Largest relative deviation of the momentum from the expected one **/
+    void SetMaxMomentumDeviation(Double_t deviation) { fMaxMomentumDeviation = deviation; }
+
+    /** kTRUE if the hits pass all cuts, their deviations in result
+     ** @param beforeX, beforeY  Fibers in front of GLAD measuring x and y
+     ** @param after1, after2    Fibers behind GLAD measuring x
+     ** @param p                 Expected momentum [GeV/c] of a fragment with this charge
+     **/
+    Bool_t Check(const TVector3& target,
+                 const TVector3& beforeX,
+                 const TVector3& beforeY,
+                 const TVector3& after1,
+                 const TVector3& after2,
+                 const TVector3& tof,
+                 Double_t charge,
+                 Double_t p,
+                 Result& result) const;
+
+  private:
+    /** Position in the frame of GLAD, u across and w along its axis, 0 in the mid plane **/
+    void ToField(const TVector3& pos, Double_t& u, Double_t& w) const;
+
+    TVector3 fCenter;
+    Double_t fCos;
+    Double_t fSin;
+    Double_t fIntegral;
+
+    Double_t fMaxKick;
+    Double_t fMaxTofX;
+    Double_t fMaxTofY;
+    Double_t fMaxMomentumDeviation;
+};
+
+#endif
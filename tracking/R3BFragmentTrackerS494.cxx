@@ -24,6 +24,7 @@
 #include "R3BFi4HitItem.h"
 #include "R3BFragmentFitterGeneric.h"
 #include "R3BGladFieldMap.h"
+#include "R3BGladTransferMap.h"
 #include "R3BHit.h"
 #include "R3BMCTrack.h"
 #include "R3BPspPoint.h"
@@ -47,6 +48,12 @@
 #include "TH1F.h"
 #include "TH2F.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
 
 using namespace std;
 
@@ -69,8 +76,19 @@ R3BFragmentTrackerS494::R3BFragmentTrackerS494(const char* name, Bool_t vis, Int
     , fVis(vis)
     , fFitter(nullptr)
     , fEnergyLoss(kTRUE)
+    , fEnergyLossTables(kFALSE)
+    , fEnergyLossFromAtima(kFALSE)
     , fSimu(kTRUE)
     , fOptimizeGeometry(kFALSE)
+    , fNumThreads(1)
+    , fTransferMapTolerance(0.05)
+    , fPrefitOn(kFALSE)
+    , fPrefitCheck(kFALSE)
+    , fPrefitMaxCandidates(0)
+    , fNPrefitKept(0)
+    , fNPrefitPruned(0)
+    , fNPrefitSelected(0)
+    , fNPrefitLost(0)
     , fTrackItems(new TClonesArray("R3BTrack"))
     , fNofTrackItems()
 {
@@ -144,6 +162,18 @@ InitStatus R3BFragmentTrackerS494::Init()
         return kERROR;
     }
 
+    if (fEnergyLossTables)
+    {
+        // The fragments identified by their charge in Exec
+        for (auto setup : { fDetectorsLeft, fDetectorsRight })
+        {
+            setup->AddEnergyLossTable(8, 16);
+            setup->AddEnergyLossTable(6, 12);
+            setup->AddEnergyLossTable(2, 4);
+            setup->SetEnergyLossFromAtima(fEnergyLossFromAtima);
+        }
+    }
+
     fDetectorsLeft->Init();
     fDetectorsRight->Init();
     fDetectors->Init();
@@ -198,6 +228,21 @@ InitStatus R3BFragmentTrackerS494::Init()
 
     fFitter->Init(fPropagator, fEnergyLoss);
 
+    if (fNumThreads <= 0)
+    {
+        fNumThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (fNumThreads > 1 && !fFitter->IsParallelSafe())
+    {
+        LOG(WARNING) << "R3BFragmentTrackerS494::Init() the fragment fitter is not re-entrant, fitting on one thread";
+        fNumThreads = 1;
+    }
+    if (fNumThreads > 1)
+    {
+        ROOT::EnableThreadSafety();
+        LOG(INFO) << "R3BFragmentTrackerS494::Init() fitting the candidates on " << fNumThreads << " threads";
+    }
+
     Double_t scale = ((R3BGladFieldMap*)FairRunAna::Instance()->GetField())->GetScale();
     Double_t field = ((R3BGladFieldMap*)FairRunAna::Instance()->GetField())->GetBy(0., 0., 240.);
     cout << "Field:" << field << " scale: " << scale << endl;
@@ -461,6 +506,12 @@ void R3BFragmentTrackerS494::Exec(const Option_t*)
         Double_t Charge = 0;
         Double_t m0 = 0.;
         Double_t p0 = 0.;
+        Double_t beta0 = 0.65; // velocity could eventually be calculated from ToF
+        Bool_t forward = kTRUE;
+
+        // All hit combinations of this charge, fitted together after the loop
+        std::vector<std::pair<R3BTrackingParticle*, R3BTrackingSetup*>> candidates;
+
         if (l == 0)
         {
             charge_requested = 8;
@@ -493,7 +544,6 @@ void R3BFragmentTrackerS494::Exec(const Option_t*)
             if (charge != charge_requested)
                 continue;
 
-            Double_t beta0 = 0.65; // velocity could eventually be calculated from ToF
             tof->res_t = 0.03;
             // Double_t m0 = charge * 2. * 0.931494028; // First guess of mass
 
@@ -608,67 +658,7 @@ void R3BFragmentTrackerS494::Exec(const Option_t*)
                                 candidate->AddHit("fi30", ifi30);
 
                                 fDetectors = fDetectorsLeft;
-                                Bool_t forward = kTRUE;
-                                Int_t status = 10;
-                                if (forward)
-                                {
-                                    status = fFitter->FitTrackMomentumForward(candidate, fDetectors);
-                                }
-                                else
-                                {
-                                    status = fFitter->FitTrackBackward2D(candidate, fDetectors);
-                                }
-                                cout << "Chi2: " << candidate->GetChi2() << "  " << candidate->GetStartMomentum().Mag()
-                                     << "  "
-                                     << 1000. * (candidate->GetStartMomentum().Mag() - p0) *
-                                            (candidate->GetStartMomentum().Mag() - p0)
-                                     << endl;
-                                cout << "--------------------------------" << endl;
-                                nCand += 1;
-
-                                // cout << "Momentum: " << candidate->GetMomentum().Z() << endl;
-                                if (TMath::IsNaN(candidate->GetMomentum().Z()))
-                                {
-                                    delete candidate;
-                                    continue;
-                                }
-
-                                if (10 > status)
-                                {
-                                    if (forward)
-                                    {
-                                        candidate->Reset();
-                                    }
-                                    else
-                                    {
-                                        candidate->SetStartPosition(candidate->GetPosition());
-                                        candidate->SetStartMomentum(-1. * candidate->GetMomentum());
-                                        // candidate->SetStartBeta(0.8328);
-                                        candidate->SetStartBeta(beta0);
-                                        candidate->UpdateMomentum();
-                                        candidate->Reset();
-
-                                        // candidate->GetStartPosition().Print();
-                                        // candidate->GetStartMomentum().Print();
-                                        // cout << "chi2: " << candidate->GetChi2() << endl;
-                                        // status = FitFragment(candidate);
-                                    }
-                                    if (10 > status)
-                                    {
-                                        // if(candidate->GetChi2() < 3.)
-                                        {
-                                            fFragments.push_back(candidate);
-                                        }
-                                    }
-                                    else
-                                    {
-                                        delete candidate;
-                                    }
-                                }
-                                else
-                                {
-                                    delete candidate;
-                                }
+                                candidates.emplace_back(candidate, fDetectors);
 
                                 // return;
                                 ifi23a += 1;
@@ -780,67 +770,7 @@ void R3BFragmentTrackerS494::Exec(const Option_t*)
                                 candidate->AddHit("fi33", ifi33);
 
                                 fDetectors = fDetectorsRight;
-                                Bool_t forward = kTRUE;
-                                Int_t status = 10;
-                                if (forward)
-                                {
-                                    status = fFitter->FitTrackMomentumForward(candidate, fDetectors);
-                                }
-                                else
-                                {
-                                    status = fFitter->FitTrackBackward2D(candidate, fDetectors);
-                                }
-                                cout << "Chi2: " << candidate->GetChi2() << "  " << candidate->GetStartMomentum().Mag()
-                                     << "  "
-                                     << 1000. * (candidate->GetStartMomentum().Mag() - p0) *
-                                            (candidate->GetStartMomentum().Mag() - p0)
-                                     << endl;
-                                cout << "--------------------------------" << endl;
-                                nCand += 1;
-
-                                // cout << "Momentum: " << candidate->GetMomentum().Z() << endl;
-                                if (TMath::IsNaN(candidate->GetMomentum().Z()))
-                                {
-                                    delete candidate;
-                                    continue;
-                                }
-
-                                if (10 > status)
-                                {
-                                    if (forward)
-                                    {
-                                        candidate->Reset();
-                                    }
-                                    else
-                                    {
-                                        candidate->SetStartPosition(candidate->GetPosition());
-                                        candidate->SetStartMomentum(-1. * candidate->GetMomentum());
-                                        // candidate->SetStartBeta(0.8328);
-                                        candidate->SetStartBeta(beta0);
-                                        candidate->UpdateMomentum();
-                                        candidate->Reset();
-
-                                        // candidate->GetStartPosition().Print();
-                                        // candidate->GetStartMomentum().Print();
-                                        // cout << "chi2: " << candidate->GetChi2() << endl;
-                                        // status = FitFragment(candidate);
-                                    }
-                                    if (10 > status)
-                                    {
-                                        // if(candidate->GetChi2() < 3.)
-                                        {
-                                            fFragments.push_back(candidate);
-                                        }
-                                    }
-                                    else
-                                    {
-                                        delete candidate;
-                                    }
-                                }
-                                else
-                                {
-                                    delete candidate;
-                                }
+                                candidates.emplace_back(candidate, fDetectors);
 
                                 // return;
                                 ifi23a += 1;
@@ -870,6 +800,70 @@ void R3BFragmentTrackerS494::Exec(const Option_t*)
 
         } // end for TofD
 
+        std::set<const R3BTrackingParticle*> prefitFailed;
+        if (fPrefitOn)
+        {
+            PrefitCandidates(candidates, p0, prefitFailed);
+        }
+
+        // The candidates stay in the order they were made in, so the minimum chi2 below does not
+        // depend on the number of threads
+        const std::vector<Int_t> fitStatus = FitCandidates(candidates, forward);
+        for (size_t k = 0; k < candidates.size(); k++)
+        {
+            R3BTrackingParticle* candidate = candidates[k].first;
+            Int_t status = fitStatus[k];
+            cout << "Chi2: " << candidate->GetChi2() << "  " << candidate->GetStartMomentum().Mag() << "  "
+                 << 1000. * (candidate->GetStartMomentum().Mag() - p0) * (candidate->GetStartMomentum().Mag() - p0)
+                 << endl;
+            cout << "--------------------------------" << endl;
+            nCand += 1;
+
+            // cout << "Momentum: " << candidate->GetMomentum().Z() << endl;
+            if (TMath::IsNaN(candidate->GetMomentum().Z()))
+            {
+                delete candidate;
+                continue;
+            }
+
+            if (10 > status)
+            {
+                if (forward)
+                {
+                    candidate->Reset();
+                }
+                else
+                {
+                    candidate->SetStartPosition(candidate->GetPosition());
+                    candidate->SetStartMomentum(-1. * candidate->GetMomentum());
+                    // candidate->SetStartBeta(0.8328);
+                    candidate->SetStartBeta(beta0);
+                    candidate->UpdateMomentum();
+                    candidate->Reset();
+
+                    // candidate->GetStartPosition().Print();
+                    // candidate->GetStartMomentum().Print();
+                    // cout << "chi2: " << candidate->GetChi2() << endl;
+                    // status = FitFragment(candidate);
+                }
+                if (10 > status)
+                {
+                    // if(candidate->GetChi2() < 3.)
+                    {
+                        fFragments.push_back(candidate);
+                    }
+                }
+                else
+                {
+                    delete candidate;
+                }
+            }
+            else
+            {
+                delete candidate;
+            }
+        }
+
         fh_ncand->Fill(nCand);
 
         R3BTrackingParticle* candidate;
@@ -903,6 +897,12 @@ void R3BFragmentTrackerS494::Exec(const Option_t*)
             if (minChi2 > 1.e5)
                 continue;
 
+            if (fPrefitOn && fPrefitCheck)
+            {
+                fNPrefitSelected++;
+                fNPrefitLost += prefitFailed.count(candidate);
+            }
+
             if (candidate->GetStartMomentum().X() < 0)
             {
                 fi23a->free_hit[candidate->GetHitIndexByName("fi23a")] = false;
@@ -1174,6 +1174,138 @@ void R3BFragmentTrackerS494::Exec(const Option_t*)
     // delete particle;
 }
 
+std::vector<Int_t> R3BFragmentTrackerS494::FitCandidates(
+    const std::vector<std::pair<R3BTrackingParticle*, R3BTrackingSetup*>>& candidates,
+    Bool_t forward)
+{
+    const size_t n = candidates.size();
+    std::vector<Int_t> status(n, 10);
+
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+        for (size_t i = next++; i < n; i = next++)
+        {
+            if (forward)
+            {
+                status[i] = fFitter->FitTrackMomentumForward(candidates[i].first, candidates[i].second);
+            }
+            else
+            {
+                status[i] = fFitter->FitTrackBackward2D(candidates[i].first, candidates[i].second);
+            }
+        }
+    };
+
+    const UInt_t nThreads = std::min<size_t>(fNumThreads, n);
+    if (nThreads <= 1)
+    {
+        work();
+        return status;
+    }
+
+    std::vector<std::thread> workers;
+    for (UInt_t t = 1; t < nThreads; t++)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    return status;
+}
+
+void R3BFragmentTrackerS494::PrefitCandidates(
+    std::vector<std::pair<R3BTrackingParticle*, R3BTrackingSetup*>>& candidates,
+    Double_t p0,
+    std::set<const R3BTrackingParticle*>& failed)
+{
+    const size_t n = candidates.size();
+    std::vector<Double_t> scores(n);
+    std::vector<Bool_t> passed(n);
+    for (size_t k = 0; k < n; k++)
+    {
+        passed[k] = Prefit(candidates[k].first, candidates[k].second, p0, scores[k]);
+    }
+
+    // Of those that pass, only the best per ToFD hit, in the order they were made in for equal scores
+    if (fPrefitMaxCandidates > 0)
+    {
+        std::map<Int_t, std::vector<size_t>> perTof;
+        for (size_t k = 0; k < n; k++)
+        {
+            if (passed[k])
+            {
+                perTof[candidates[k].first->GetHitIndexByName("tofd")].push_back(k);
+            }
+        }
+        for (auto& tof : perTof)
+        {
+            std::vector<size_t>& ranked = tof.second;
+            if (ranked.size() <= (size_t)fPrefitMaxCandidates)
+            {
+                continue;
+            }
+            std::stable_sort(
+                ranked.begin(), ranked.end(), [&scores](size_t i, size_t j) { return scores[i] < scores[j]; });
+            for (size_t r = fPrefitMaxCandidates; r < ranked.size(); r++)
+            {
+                passed[ranked[r]] = kFALSE;
+            }
+        }
+    }
+
+    size_t nKept = 0;
+    for (size_t k = 0; k < n; k++)
+    {
+        if (passed[k])
+        {
+            fNPrefitKept++;
+        }
+        else
+        {
+            fNPrefitPruned++;
+            if (!fPrefitCheck)
+            {
+                delete candidates[k].first;
+                continue;
+            }
+            failed.insert(candidates[k].first);
+        }
+        candidates[nKept++] = candidates[k];
+    }
+    candidates.resize(nKept);
+}
+
+Bool_t R3BFragmentTrackerS494::Prefit(R3BTrackingParticle* candidate,
+                                      R3BTrackingSetup* setup,
+                                      Double_t p0,
+                                      Double_t& score)
+{
+    auto global = [candidate, setup](const char* name) {
+        R3BHit* hit = setup->GetHit(name, candidate->GetHitIndexByName(name));
+        TVector3 pos;
+        setup->GetByName(name)->LocalToGlobal(pos, hit->GetX(), hit->GetY());
+        return pos;
+    };
+
+    // Left or right of the beam behind GLAD, as in the fitter
+    const Bool_t left = candidate->GetHitIndexByName("fi30") > -1 && candidate->GetHitIndexByName("fi32") > -1;
+    R3BFragmentPrefit::Result result;
+    const Bool_t passed = fPrefit.Check(global("target"),
+                                        global("fi23a"),
+                                        global("fi23b"),
+                                        global(left ? "fi30" : "fi31"),
+                                        global(left ? "fi32" : "fi33"),
+                                        global("tofd"),
+                                        candidate->GetCharge(),
+                                        p0,
+                                        result);
+    score = result.score;
+    return passed;
+}
+
 void R3BFragmentTrackerS494::FinishEvent()
 {
     fTrackItems->Clear();
@@ -1187,6 +1319,17 @@ void R3BFragmentTrackerS494::Finish()
 
     cout << "found pairs: " << counter1 << endl;
 
+    if (fPrefitOn)
+    {
+        LOG(INFO) << "R3BFragmentTrackerS494: the pre-fit kept " << fNPrefitKept << " of "
+                  << fNPrefitKept + fNPrefitPruned << " hit combinations";
+        if (fPrefitCheck)
+        {
+            LOG(INFO) << "R3BFragmentTrackerS494: " << fNPrefitLost << " of " << fNPrefitSelected
+                      << " fragments found come from combinations the pre-fit would have removed";
+        }
+    }
+
     fh_mult_fi23a->Write();
     fh_mult_fi23b->Write();
     fh_mult_fi30->Write();
@@ -1331,6 +1474,62 @@ Bool_t R3BFragmentTrackerS494::InitPropagator()
         LOG(ERROR) << "Unsupported type of field.";
         return kFALSE;
     }
+
+    // Field correction as in Exec
+    gladField->SetTrackerCorrection(-1245. / 3584. / gladField->GetScale());
+
+    if (fPrefitOn)
+    {
+        // Integral of |By| along the axis of GLAD for the momentum from the kick
+        const Double_t angle = gladField->GetYAngle() * TMath::DegToRad();
+        const TVector3 center(gladField->GetPositionX(), gladField->GetPositionY(), gladField->GetPositionZ());
+        const Int_t nSteps = 800;
+        const Double_t step = 1.;
+        std::vector<Double_t> points(3 * nSteps);
+        std::vector<Double_t> field(3 * nSteps);
+        for (Int_t i = 0; i < nSteps; i++)
+        {
+            TVector3 point(0., 0., (i + 0.5 - 0.5 * nSteps) * step);
+            point.RotateY(angle);
+            point += center;
+            point.GetXYZ(&points[3 * i]);
+        }
+        gladField->GetFieldValues(nSteps, points.data(), field.data());
+        Double_t integral = 0.;
+        for (Int_t i = 0; i < nSteps; i++)
+        {
+            integral += TMath::Abs(field[3 * i + 1]) * step;
+        }
+        fPrefit.SetField(center, angle, integral);
+        LOG(INFO) << "R3BFragmentTrackerS494::InitPropagator() field integral of GLAD for the pre-fit: " << integral
+                  << " kG cm";
+    }
+
+    if (fTransferMapFile.Length() > 0)
+    {
+        // The range around the fragments with the rigidity of the beam going
+        // straight, 12C with 9.666 GeV/c
+        R3BTrackingParticle beam(6., 0., 0., 0., 0., 0., 9.666, 0., 0.);
+        Double_t center[R3BGladTransferMap::kNIn];
+        if (fPropagator->GetFieldEntryState(&beam, center))
+        {
+            const Double_t halfWidth[R3BGladTransferMap::kNIn] = {
+                10., 10., 0.06, 0.06, 0.25 * TMath::Abs(center[R3BGladTransferMap::kKappa])
+            };
+            Double_t min[R3BGladTransferMap::kNIn];
+            Double_t max[R3BGladTransferMap::kNIn];
+            for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+            {
+                min[i] = center[i] - halfWidth[i];
+                max[i] = center[i] + halfWidth[i];
+            }
+            fPropagator->UseTransferMaps(fTransferMapFile, min, max, 5, fTransferMapTolerance);
+        }
+        else
+        {
+            LOG(ERROR) << "R3BFragmentTrackerS494::InitPropagator() the beam does not reach GLAD, using Runge-Kutta";
+        }
+    }
     return kTRUE;
 }
 
@@ -15,8 +15,12 @@
 #define R3B_FRAGMENTTRACKERS494_H
 
 #include "FairTask.h"
+#include "R3BFragmentPrefit.h"
+#include "TString.h"
 
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 class TClonesArray;
@@ -49,12 +53,51 @@ class R3BFragmentTrackerS494 : public FairTask
 
     void SetFragmentFitter(R3BFragmentFitterGeneric* fitter) { fFitter = fitter; }
     void SetEnergyLoss(Bool_t energyLoss) { fEnergyLoss = energyLoss; }
+    /** Tabulate the energy loss of the fragments in the detectors at Init, filled from R3BAtima
+        with atima. Other ions and masses fitted far off use the formula. Off by default, as the
+        tables deviate slightly from the formula **/
+    void SetEnergyLossTables(Bool_t tables, Bool_t atima = kFALSE)
+    {
+        fEnergyLossTables = tables;
+        fEnergyLossFromAtima = atima;
+    }
     void SetSimu(Int_t simu) {fSimu = simu;}
     void SetOptimizeGeometry(Int_t optimizeGeometry) {fOptimizeGeometry = optimizeGeometry;}
+    /** Number of threads fitting the hit combinations of an event, 0 means one per core. The
+        default 1 fits them on the calling thread. Needs a fitter with IsParallelSafe() **/
+    void SetNumThreads(Int_t nThreads) { fNumThreads = nThreads; }
+    /** Propagate through GLAD with transfer maps cached in fileName, see R3BTPropagator::UseTransferMaps().
+        Without them, or if they deviate more than tolerance [cm], Runge-Kutta is used **/
+    void SetTransferMaps(const char* fileName, Double_t tolerance = 0.05)
+    {
+        fTransferMapFile = fileName;
+        fTransferMapTolerance = tolerance;
+    }
+    /** Check the hit combinations with R3BFragmentPrefit and fit only those that pass. With
+        check, the others are fitted as well, and it is counted how often one of them would
+        have been the fragment found. The cuts are set on GetPrefit(). **/
+    void SetPrefit(Bool_t prefit, Bool_t check = kFALSE)
+    {
+        fPrefitOn = prefit;
+        fPrefitCheck = check;
+    }
+    /** Fit only the n combinations with the best pre-fit score per ToFD hit, 0 for all **/
+    void SetPrefitMaxCandidates(Int_t n) { fPrefitMaxCandidates = n; }
+    R3BFragmentPrefit& GetPrefit() { return fPrefit; }
 
   private:
     Bool_t InitPropagator();
 
+    /** Fits the candidates on fNumThreads threads, the status of candidate i is at i **/
+    std::vector<Int_t> FitCandidates(const std::vector<std::pair<R3BTrackingParticle*, R3BTrackingSetup*>>& candidates,
+                                     Bool_t forward);
+
+    /** Removes the candidates that do not pass the pre-fit, in check mode they stay and are put into failed **/
+    void PrefitCandidates(std::vector<std::pair<R3BTrackingParticle*, R3BTrackingSetup*>>& candidates,
+                          Double_t p0,
+                          std::set<const R3BTrackingParticle*>& failed);
+    Bool_t Prefit(R3BTrackingParticle* candidate, R3BTrackingSetup* setup, Double_t p0, Double_t& score);
+
     R3BFieldPar* fFieldPar;
     R3BTPropagator* fPropagator;
     TClonesArray* fArrayMCTracks; // simulation output??? To compare?
@@ -79,8 +122,21 @@ class R3BFragmentTrackerS494 : public FairTask
 
     R3BFragmentFitterGeneric* fFitter;
     Bool_t fEnergyLoss;
+    Bool_t fEnergyLossTables;
+    Bool_t fEnergyLossFromAtima;
     Bool_t fSimu;
     Bool_t fOptimizeGeometry;
+    Int_t fNumThreads;
+    TString fTransferMapFile;
+    Double_t fTransferMapTolerance;
+    R3BFragmentPrefit fPrefit; //!
+    Bool_t fPrefitOn;
+    Bool_t fPrefitCheck;
+    Int_t fPrefitMaxCandidates;
+    Long64_t fNPrefitKept;
+    Long64_t fNPrefitPruned;
+    Long64_t fNPrefitSelected;
+    Long64_t fNPrefitLost;
     Double_t fAfterGladResolution;
     Int_t eventCounter = 0;
 
@@ -129,7 +185,7 @@ class R3BFragmentTrackerS494 : public FairTask
     
    TH2F* fh_A_overZ;
 
-    ClassDef(R3BFragmentTrackerS494, 1)
+    ClassDef(R3BFragmentTrackerS494, 2)
 };
 
 #endif
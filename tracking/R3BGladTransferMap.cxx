@@ -0,0 +1,189 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BGladTransferMap.h"
+
+#include "TDecompSVD.h"
+#include "TMath.h"
+#include "TMatrixD.h"
+#include "TVectorD.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Positions of a different field must be further off than this [cm, deg]
+    const Double_t kFieldPrecision = 1e-3;
+} // namespace
+
+R3BGladTransferMap::R3BGladTransferMap()
+    : fDegree(0)
+    , fDeviation(-1.)
+    , fFieldAngle(0.)
+{
+    std::fill(fMin, fMin + kNIn, 0.);
+    std::fill(fMax, fMax + kNIn, 0.);
+    std::fill(fFieldPosition, fFieldPosition + 3, 0.);
+}
+
+R3BGladTransferMap::R3BGladTransferMap(Int_t degree, const Double_t* min, const Double_t* max)
+    : R3BGladTransferMap()
+{
+    fDegree = degree < 1 ? 1 : (degree > kMaxDegree ? kMaxDegree : degree);
+    std::copy(min, min + kNIn, fMin);
+    std::copy(max, max + kNIn, fMax);
+
+    // All products of the inputs up to the total degree, the constant first
+    Int_t e[kNIn] = { 0 };
+    for (;;)
+    {
+        Int_t sum = 0;
+        for (Int_t i = 0; i < kNIn; i++)
+        {
+            sum += e[i];
+        }
+        if (sum <= fDegree)
+        {
+            fExponents.insert(fExponents.end(), e, e + kNIn);
+        }
+        Int_t i = 0;
+        while (i < kNIn && ++e[i] > fDegree)
+        {
+            e[i++] = 0;
+        }
+        if (i == kNIn)
+        {
+            break;
+        }
+    }
+    fCoefficients.assign(GetNTerms() * kNOut, 0.);
+}
+
+R3BGladTransferMap::~R3BGladTransferMap() {}
+
+Bool_t R3BGladTransferMap::IsInside(const Double_t* in) const
+{
+    for (Int_t i = 0; i < kNIn; i++)
+    {
+        if (!(in[i] >= fMin[i] && in[i] <= fMax[i]))
+        {
+            return kFALSE;
+        }
+    }
+    return kTRUE;
+}
+
+void R3BGladTransferMap::GetPowers(const Double_t* in, Double_t (*powers)[kMaxDegree + 1]) const
+{
+    for (Int_t i = 0; i < kNIn; i++)
+    {
+        const Double_t u = (2. * in[i] - fMax[i] - fMin[i]) / (fMax[i] - fMin[i]);
+        powers[i][0] = 1.;
+        for (Int_t d = 1; d <= fDegree; d++)
+        {
+            powers[i][d] = powers[i][d - 1] * u;
+        }
+    }
+}
+
+void R3BGladTransferMap::Eval(const Double_t* in, Double_t* out) const
+{
+    Double_t powers[kNIn][kMaxDegree + 1];
+    GetPowers(in, powers);
+
+    std::fill(out, out + kNOut, 0.);
+    const Int_t nTerms = GetNTerms();
+    const UChar_t* e = fExponents.data();
+    const Double_t* c = fCoefficients.data();
+    for (Int_t t = 0; t < nTerms; t++, e += kNIn, c += kNOut)
+    {
+        const Double_t term = powers[0][e[0]] * powers[1][e[1]] * powers[2][e[2]] * powers[3][e[3]] * powers[4][e[4]];
+        for (Int_t k = 0; k < kNOut; k++)
+        {
+            out[k] += c[k] * term;
+        }
+    }
+}
+
+Double_t R3BGladTransferMap::Fit(const std::vector<Double_t>& in, const std::vector<Double_t>& out)
+{
+    const Int_t nSamples = in.size() / kNIn;
+    const Int_t nTerms = GetNTerms();
+    if (nSamples < nTerms || out.size() != (size_t)nSamples * kNOut)
+    {
+        return -1.;
+    }
+
+    // One row per sample, one column per term
+    TMatrixD a(nSamples, nTerms);
+    Double_t powers[kNIn][kMaxDegree + 1];
+    for (Int_t s = 0; s < nSamples; s++)
+    {
+        GetPowers(&in[s * kNIn], powers);
+        const UChar_t* e = fExponents.data();
+        for (Int_t t = 0; t < nTerms; t++, e += kNIn)
+        {
+            a(s, t) = powers[0][e[0]] * powers[1][e[1]] * powers[2][e[2]] * powers[3][e[3]] * powers[4][e[4]];
+        }
+    }
+
+    TDecompSVD svd(a);
+    if (!svd.Decompose())
+    {
+        return -1.;
+    }
+    TVectorD b(nSamples);
+    for (Int_t k = 0; k < kNOut; k++)
+    {
+        for (Int_t s = 0; s < nSamples; s++)
+        {
+            b(s) = out[s * kNOut + k];
+        }
+        TVectorD x(b);
+        svd.Solve(x);
+        for (Int_t t = 0; t < nTerms; t++)
+        {
+            fCoefficients[t * kNOut + k] = x(t);
+        }
+    }
+
+    Double_t deviation = 0.;
+    Double_t values[kNOut];
+    for (Int_t s = 0; s < nSamples; s++)
+    {
+        Eval(&in[s * kNIn], values);
+        for (Int_t k = 0; k < kNOut; k++)
+        {
+            deviation = std::max(deviation, TMath::Abs(values[k] - out[s * kNOut + k]));
+        }
+    }
+    return deviation;
+}
+
+void R3BGladTransferMap::SetField(const char* fileName, Double_t x, Double_t y, Double_t z, Double_t angle)
+{
+    fFieldFileName = fileName;
+    fFieldPosition[0] = x;
+    fFieldPosition[1] = y;
+    fFieldPosition[2] = z;
+    fFieldAngle = angle;
+}
+
+Bool_t R3BGladTransferMap::IsSameField(const char* fileName, Double_t x, Double_t y, Double_t z, Double_t angle) const
+{
+    return fFieldFileName == fileName && TMath::Abs(fFieldPosition[0] - x) < kFieldPrecision &&
+           TMath::Abs(fFieldPosition[1] - y) < kFieldPrecision &&
+           TMath::Abs(fFieldPosition[2] - z) < kFieldPrecision && TMath::Abs(fFieldAngle - angle) < kFieldPrecision;
+}
+
+ClassImp(R3BGladTransferMap)
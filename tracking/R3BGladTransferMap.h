@@ -0,0 +1,98 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BGLADTRANSFERMAP_H
+#define R3BGLADTRANSFERMAP_H
+
+#include "TObject.h"
+#include "TString.h"
+
+#include <vector>
+
+/**
+ * Transfer map through the GLAD field: the track on the field exit plane as
+ * a polynomial of the track on the entry plane. R3BTPropagator uses it
+ * instead of the Runge-Kutta steps through the field, see
+ * R3BTPropagator::UseTransferMaps().
+ *
+ * A track on a plane is given by x, y in the plane [cm], the slopes
+ * tx = px / pn, ty = py / pn with respect to the plane normal n, and
+ * kappa = charge / p * field factor [e / (GeV/c)]. The field factor is the
+ * scale times the tracker correction of R3BGladFieldMap, so the map does not
+ * depend on them. The map gives x, y, tx, ty on the exit plane and the path
+ * length [cm] in between.
+ */
+class R3BGladTransferMap : public TObject
+{
+  public:
+    // Index of the inputs and outputs, the length takes the place of kappa
+    static constexpr Int_t kX = 0;
+    static constexpr Int_t kY = 1;
+    static constexpr Int_t kTx = 2;
+    static constexpr Int_t kTy = 3;
+    static constexpr Int_t kKappa = 4;
+    static constexpr Int_t kLength = 4;
+    static constexpr Int_t kNIn = 5;
+    static constexpr Int_t kNOut = 5;
+    static constexpr Int_t kMaxDegree = 15;
+
+    R3BGladTransferMap();
+
+    /** Polynomial of the given total degree, valid for min[i] <= in[i] <= max[i] **/
+    R3BGladTransferMap(Int_t degree, const Double_t* min, const Double_t* max);
+
+    virtual ~R3BGladTransferMap();
+
+    /** Least squares fit to samples given as rows of kNIn inputs and of kNOut
+        outputs, returns the largest deviation of a sample from the fit **/
+    Double_t Fit(const std::vector<Double_t>& in, const std::vector<Double_t>& out);
+
+    Bool_t IsInside(const Double_t* in) const;
+
+    /** out[kNOut] of in[kNIn], only meaningful if IsInside(in) **/
+    void Eval(const Double_t* in, Double_t* out) const;
+
+    Int_t GetDegree() const { return fDegree; }
+    Int_t GetNTerms() const { return fExponents.size() / kNIn; }
+    Double_t GetMin(Int_t i) const { return fMin[i]; }
+    Double_t GetMax(Int_t i) const { return fMax[i]; }
+
+    /** Largest deviation from Runge-Kutta found by R3BTPropagator [cm] **/
+    void SetDeviation(Double_t deviation) { fDeviation = deviation; }
+    Double_t GetDeviation() const { return fDeviation; }
+
+    /** The field the map was made for, a map is only used with the same one **/
+    void SetField(const char* fileName, Double_t x, Double_t y, Double_t z, Double_t angle);
+    Bool_t IsSameField(const char* fileName, Double_t x, Double_t y, Double_t z, Double_t angle) const;
+
+  private:
+    /** Powers 0 to fDegree of the inputs scaled to [-1, 1] **/
+    void GetPowers(const Double_t* in, Double_t (*powers)[kMaxDegree + 1]) const;
+
+    Int_t fDegree;
+    Double_t fMin[kNIn];
+    Double_t fMax[kNIn];
+
+    std::vector<UChar_t> fExponents;     // kNIn per term
+    std::vector<Double_t> fCoefficients; // kNOut per term
+
+    Double_t fDeviation;
+
+    TString fFieldFileName;
+    Double_t fFieldPosition[3];
+    Double_t fFieldAngle;
+
+    ClassDef(R3BGladTransferMap, 1)
+};
+
+#endif
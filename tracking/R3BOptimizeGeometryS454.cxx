@@ -46,18 +46,27 @@
 #include "TH1F.h"
 #include "TH2F.h"
 #include "TMath.h"
+#include "TROOT.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
 
 using namespace std;
 
 #define SPEED_OF_LIGHT 29.9792458 // cm/ns
 //#define Amu 0.938272
 //#define Fair_Amu 0.931494028
-namespace GlobalChi2 {
-R3BTrackingSetup* gSetup;
-R3BOptimizeGeometryS454* gThisTask;
-}
+namespace
+{
+    const Int_t kNParameters = 9;
 
-using namespace GlobalChi2;
+    // Detector placed by each parameter of Chi2AllEvents(), none for the field
+    const char* const kLeftDetectors[kNParameters] = { "fi10", "fi10", "fi12", "fi12", "fi10",
+                                                       "fi12", nullptr, "fi3b", "fi3b" };
+    const char* const kRightDetectors[kNParameters] = { "fi11", "fi11", "fi13", "fi13", "fi11",
+                                                        "fi13", nullptr, "fi3a", "fi3a" };
+} // namespace
 
 R3BOptimizeGeometryS454::R3BOptimizeGeometryS454(const char* name, Bool_t vis, Int_t verbose)
     : FairTask(name, verbose)
@@ -67,6 +76,7 @@ R3BOptimizeGeometryS454::R3BOptimizeGeometryS454(const char* name, Bool_t vis, I
     , fDetectors(new R3BTrackingSetup())
     , fDetectorsLeft(new R3BTrackingSetup())
     , fDetectorsRight(new R3BTrackingSetup())
+    , fSetup(NULL)
     , fArrayFragments(new TClonesArray("R3BTrackingParticle"))
     , fNEvents(0)
     , fVis(vis)
@@ -74,6 +84,8 @@ R3BOptimizeGeometryS454::R3BOptimizeGeometryS454(const char* name, Bool_t vis, I
     , fEnergyLoss(kTRUE)
     , fSimu(kTRUE)
     , fLeft(kTRUE)
+    , fNumThreads(1)
+    , fCacheChi2(kTRUE)
 {
     // this is the list of detectors (active areas) we use for tracking
     fDetectorsLeft->AddDetector("target", kTarget, "TargetGeoPar");
@@ -89,7 +101,13 @@ R3BOptimizeGeometryS454::R3BOptimizeGeometryS454(const char* name, Bool_t vis, I
     fDetectorsRight->AddDetector("tofd", kTof, "tofdGeoPar", "TofdHit");
 }
 
-R3BOptimizeGeometryS454::~R3BOptimizeGeometryS454() {}
+R3BOptimizeGeometryS454::~R3BOptimizeGeometryS454()
+{
+    for (auto const& x : fWorkerSetups)
+    {
+        delete x;
+    }
+}
 
 /* For the tracking we use a user-defined list of TrackingDetectors,
  * stored in a TClonesArrays. The TrackingDetectors will provide
@@ -149,10 +167,7 @@ InitStatus R3BOptimizeGeometryS454::Init()
 	fDetectors->Init();
 
 // For the moment we have to change manually between the setup
-	gSetup = fDetectorsLeft;
-	//gSetup = fDetectorsRight;
-	
-	gThisTask = this;
+	fSetup = fLeft ? fDetectorsLeft : fDetectorsRight;
 	
     fh_mult_fi3a = new TH1F("h_mult_fi3a", "Multiplicity fi3a", 20, -0.5, 19.5);
     fh_mult_fi3b = new TH1F("h_mult_fi3b", "Multiplicity fi3b", 20, -0.5, 19.5);
@@ -195,6 +210,21 @@ InitStatus R3BOptimizeGeometryS454::Init()
         fh_x_pull[i] = new TH1F(Form("h_x_pull%d", i), Form("x pull %d", i), 40, -10., 10.);
     }
     fFitter->Init(fPropagator, fEnergyLoss);
+
+    if (fNumThreads <= 0)
+    {
+        fNumThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (fNumThreads > 1 && !fFitter->IsParallelSafe())
+    {
+        LOG(WARNING) << "R3BOptimizeGeometryS454::Init() the fragment fitter is not re-entrant, fitting on one thread";
+        fNumThreads = 1;
+    }
+    if (fNumThreads > 1)
+    {
+        ROOT::EnableThreadSafety();
+        LOG(INFO) << "R3BOptimizeGeometryS454::Init() fitting the events on " << fNumThreads << " threads";
+    }
     return kSUCCESS;
 }
 
@@ -240,7 +270,7 @@ void R3BOptimizeGeometryS454::Exec(const Option_t*)
 		<< fi10->events[fNEvents].size() << "  " << tof->events[fNEvents].size() << endl;
 
         fNEvents += 1;
-		cout << "Saved events: " << gThisTask->GetNEvents() << endl;
+		cout << "Saved events: " << fNEvents << endl;
 	}
 
 /*
@@ -262,14 +292,13 @@ void R3BOptimizeGeometryS454::Exec(const Option_t*)
 		<< fi13->events[fNEvents].size() << "  " << tof->events[fNEvents].size() << endl;
 
         fNEvents += 1;
-		cout << "Saved events: " << gThisTask->GetNEvents() << endl;
+		cout << "Saved events: " << fNEvents << endl;
 	}
 */
 }
 
-double Chi2AllEvents(const double* xx)
+Double_t R3BOptimizeGeometryS454::Chi2AllEvents(const Double_t* xx)
 {
-	Bool_t fLeft = kTRUE;
     Double_t chi2_all = 0;
 	Int_t nof = 0;
 	cout << "new correction: " << xx[0] << "  " << xx[1] << "  " << xx[2] 
@@ -278,7 +307,7 @@ double Chi2AllEvents(const double* xx)
 
 	if(fLeft)
 	{
-		R3BTrackingDetector* fi12 = gSetup->GetByName("fi12");
+		R3BTrackingDetector* fi12 = fSetup->GetByName("fi12");
 		
 		fi12->pos0 = TVector3(0., 0., 0.);
 		fi12->pos1 = TVector3(25., 25., 0.);
@@ -296,7 +325,7 @@ double Chi2AllEvents(const double* xx)
 		fi12->norm = ((fi12->pos1 - fi12->pos0).Cross(fi12->pos2 - fi12->pos0)).Unit();
 
 		
-		R3BTrackingDetector* fi10 = gSetup->GetByName("fi10");
+		R3BTrackingDetector* fi10 = fSetup->GetByName("fi10");
 		fi10->pos0 = TVector3(0., 0., 0.);
 		fi10->pos1 = TVector3(25., 25., 0.);
 		fi10->pos2 = TVector3(-25., 25., 0.);
@@ -312,7 +341,7 @@ double Chi2AllEvents(const double* xx)
 		fi10->pos2 += trans10;
 		fi10->norm = ((fi10->pos1 - fi10->pos0).Cross(fi10->pos2 - fi10->pos0)).Unit();
 
-		R3BTrackingDetector* fi3b = gSetup->GetByName("fi3b");
+		R3BTrackingDetector* fi3b = fSetup->GetByName("fi3b");
 		
 		fi3b->pos0 = TVector3(0., 0., 0.);
 		fi3b->pos1 = TVector3(5., 5., 0.);
@@ -333,7 +362,7 @@ double Chi2AllEvents(const double* xx)
 	else
 	{
 	
-		R3BTrackingDetector* fi11 = gSetup->GetByName("fi11");
+		R3BTrackingDetector* fi11 = fSetup->GetByName("fi11");
 		
 		fi11->pos0 = TVector3(0., 0., 0.);
 		fi11->pos1 = TVector3(25., 25., 0.);
@@ -351,7 +380,7 @@ double Chi2AllEvents(const double* xx)
 		fi11->norm = ((fi11->pos1 - fi11->pos0).Cross(fi11->pos2 - fi11->pos0)).Unit();
 
 		
-		R3BTrackingDetector* fi13 = gSetup->GetByName("fi13");
+		R3BTrackingDetector* fi13 = fSetup->GetByName("fi13");
 		fi13->pos0 = TVector3(0., 0., 0.);
 		fi13->pos1 = TVector3(25., 25., 0.);
 		fi13->pos2 = TVector3(-25., 25., 0.);
@@ -368,7 +397,7 @@ double Chi2AllEvents(const double* xx)
 		fi13->pos2 += trans13;
 		fi13->norm = ((fi13->pos1 - fi13->pos0).Cross(fi13->pos2 - fi13->pos0)).Unit();
 
-		R3BTrackingDetector* fi3a = gSetup->GetByName("fi3a");
+		R3BTrackingDetector* fi3a = fSetup->GetByName("fi3a");
 		
 		fi3a->pos0 = TVector3(0., 0., 0.);
 		fi3a->pos1 = TVector3(5., 5., 0.);
@@ -386,21 +415,19 @@ double Chi2AllEvents(const double* xx)
 		fi3a->norm = ((fi3a->pos1 - fi3a->pos0).Cross(fi3a->pos2 - fi3a->pos0)).Unit();
 	}
 
-    for(Int_t iev = 0; iev < gThisTask->GetNEvents(); iev++)
-    //for(Int_t iev = 0; iev < 1000; iev++)
-    {
-        gSetup->TakeHitsFromBuffer(iev);
+    // The field is the same for all events, it is set before they are fitted
+    Double_t fieldScale = 1672.0 / 3584. * 1.0; // standard
+    Double_t scale = ((R3BGladFieldMap*)FairRunAna::Instance()->GetField())->GetScale();
+    Double_t field = ((R3BGladFieldMap*)FairRunAna::Instance()->GetField())->GetBy(0., 0., 240.);
+    cout << "Field:" << field << " scale: " << scale << endl;
 
-		Double_t fieldScale	= 1672.0/ 3584. * 1.0;	//standard
-		Double_t scale = ((R3BGladFieldMap *) FairRunAna::Instance()->GetField())->GetScale();
-		Double_t field = ((R3BGladFieldMap *) FairRunAna::Instance()->GetField())->GetBy(0.,0.,240.);
-		cout << "Field:" << field << " scale: " << scale << endl;
-		
-		fieldScale	= -1672.0 / 3584. / scale * xx[6];	//run395
-		cout << "Setting field to " << 	fieldScale << endl;
-		( (R3BGladFieldMap*) FairRunAna::Instance()->GetField() )->SetTrackerCorrection(fieldScale);						
-		field = ((R3BGladFieldMap *) FairRunAna::Instance()->GetField())->GetBy(0.,0.,240.);
-		cout << "Field after:" << 	field << endl;
+    fieldScale = -1672.0 / 3584. / scale * xx[6]; // run395
+    cout << "Setting field to " << fieldScale << endl;
+    ((R3BGladFieldMap*)FairRunAna::Instance()->GetField())->SetTrackerCorrection(fieldScale);
+    field = ((R3BGladFieldMap*)FairRunAna::Instance()->GetField())->GetBy(0., 0., 240.);
+    cout << "Field after:" << field << endl;
+
+    // Field per run, this needs the events fitted in order on one thread
 
 /*
 		if(fLeft)
@@ -479,32 +506,96 @@ double Chi2AllEvents(const double* xx)
 			}
 		}
 */
-        Double_t chi2 = gThisTask->Chi2();
-        //cout << "Chi2 value: " << chi2 << endl;
-        if(chi2 > 0)
+
+    fPropagator->SetVis(kFALSE);
+
+    // Start over if events were added since the last call
+    const Int_t nEvents = fNEvents;
+    if (fEventChi2.size() != (size_t)nEvents)
+    {
+        fEventChi2.assign(nEvents, -1.);
+        fEventParameters.assign(nEvents * kNParameters, 0.);
+        fEventDependence.assign(nEvents, -1);
+    }
+
+    // Only the events whose field or detectors with hits moved are fitted again
+    std::vector<Int_t> toFit;
+    for (Int_t iev = 0; iev < nEvents; iev++)
+    {
+        Bool_t unchanged = fCacheChi2 && fEventDependence[iev] >= 0;
+        for (Int_t i = 0; unchanged && i < kNParameters; i++)
         {
-            chi2_all += chi2;
-            nof++;
+            unchanged = !(fEventDependence[iev] & (1 << i)) || fEventParameters[iev * kNParameters + i] == xx[i];
+        }
+        if (!unchanged)
+        {
+            toFit.push_back(iev);
+        }
+    }
+
+    const char* const* detectors = fLeft ? kLeftDetectors : kRightDetectors;
+    std::atomic<size_t> next(0);
+    auto work = [&](R3BTrackingSetup* setup) {
+        for (size_t k = next++; k < toFit.size(); k = next++)
+        {
+            const Int_t iev = toFit[k];
+            setup->TakeHitsFromBuffer(*fSetup, iev);
+            Int_t nCand = 0;
+            fEventChi2[iev] = Chi2(setup, nCand);
+
+            // Without a fitted combination the event does not depend on any parameter
+            Int_t dependence = 0;
+            for (Int_t i = 0; nCand > 0 && i < kNParameters; i++)
+            {
+                if (!detectors[i] || setup->GetByName(detectors[i])->hits.size() > 0)
+                {
+                    dependence |= 1 << i;
+                }
+            }
+            fEventDependence[iev] = dependence;
+            std::copy(xx, xx + kNParameters, &fEventParameters[iev * kNParameters]);
         }
+    };
+
+    // Each thread fits with its own copy of the setup, they only share the buffered hits
+    const UInt_t nThreads = std::max<size_t>(1, std::min<size_t>(fNumThreads, toFit.size()));
+    while (fWorkerSetups.size() < nThreads)
+    {
+        fWorkerSetups.push_back(new R3BTrackingSetup());
+    }
+    for (UInt_t t = 0; t < nThreads; t++)
+    {
+        fWorkerSetups[t]->CopyGeometry(*fSetup);
+    }
+    std::vector<std::thread> workers;
+    for (UInt_t t = 1; t < nThreads; t++)
+    {
+        workers.emplace_back(work, fWorkerSetups[t]);
+    }
+    work(fWorkerSetups[0]);
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
 
+    // Summed up in the order of the events, the result does not depend on the number of threads
+    for (Int_t iev = 0; iev < nEvents; iev++)
+    {
+        if (fEventChi2[iev] > 0)
+        {
+            chi2_all += fEventChi2[iev];
+            nof++;
+        }
     }
     chi2_all = chi2_all / nof;
-    cout << "Chi2 all: " << chi2_all << endl;
+    cout << "Chi2 all: " << chi2_all << ", " << toFit.size() << " of " << nEvents << " events fitted" << endl;
     return chi2_all;
 }
 
-double R3BOptimizeGeometryS454::Chi2()
+Double_t R3BOptimizeGeometryS454::Chi2(R3BTrackingSetup* setup, Int_t& nCand)
 {
-	
-    fArrayFragments->Clear();
-    if (fFragments.size() > 0)
-    {
-        for (auto const& x : fFragments)
-        {
-            delete x;
-        }
-        fFragments.clear();
-    }
+    // Runs on several threads at once, only the setup belongs to this call
+    std::vector<R3BTrackingParticle*> fragments;
 
     /* this part needs to be adopted to each experiment / setup
      *
@@ -516,26 +607,19 @@ double R3BOptimizeGeometryS454::Chi2()
      * particle properties.
      */
 
-    R3BTrackingDetector* target = gSetup->GetByName("target");
-    R3BTrackingDetector* tof = gSetup->GetByName("tofd");
+    R3BTrackingDetector* target = setup->GetByName("target");
+    R3BTrackingDetector* tof = setup->GetByName("tofd");
 
-// for the moment one has to define manually the setup 
+    // The side that is optimized is the one with the hits of the event
+    R3BTrackingSetup* left = fLeft ? setup : fDetectorsLeft;
+    R3BTrackingSetup* right = fLeft ? fDetectorsRight : setup;
 
-    R3BTrackingDetector* fi3b = gSetup->GetByName("fi3b");
-    R3BTrackingDetector* fi12 = gSetup->GetByName("fi12");
-    R3BTrackingDetector* fi10 = gSetup->GetByName("fi10");
-    R3BTrackingDetector* fi3a = fDetectorsRight->GetByName("fi3a");
-    R3BTrackingDetector* fi11 = fDetectorsRight->GetByName("fi11");
-    R3BTrackingDetector* fi13 = fDetectorsRight->GetByName("fi13");
-
-/*
-    R3BTrackingDetector* fi3b = fDetectorsLeft->GetByName("fi3b");
-    R3BTrackingDetector* fi12 = fDetectorsLeft->GetByName("fi12");
-    R3BTrackingDetector* fi10 = fDetectorsLeft->GetByName("fi10");
-    R3BTrackingDetector* fi3a = gSetup->GetByName("fi3a");
-    R3BTrackingDetector* fi11 = gSetup->GetByName("fi11");
-    R3BTrackingDetector* fi13 = gSetup->GetByName("fi13");
-*/
+    R3BTrackingDetector* fi3b = left->GetByName("fi3b");
+    R3BTrackingDetector* fi12 = left->GetByName("fi12");
+    R3BTrackingDetector* fi10 = left->GetByName("fi10");
+    R3BTrackingDetector* fi3a = right->GetByName("fi3a");
+    R3BTrackingDetector* fi11 = right->GetByName("fi11");
+    R3BTrackingDetector* fi13 = right->GetByName("fi13");
 
 
     if(target->hits.size() < 1) target->hits.push_back(new R3BHit(0, 0., 0., 0., 0., 0));
@@ -564,9 +648,7 @@ double R3BOptimizeGeometryS454::Chi2()
 
     // try to fit all possible combination of hits. 
     
-    fPropagator->SetVis(kFALSE);
-
-    Int_t nCand = 0;
+    nCand = 0;
 	Double_t mChi2 = -1;
 	Double_t pChi2 = -1;
     Int_t ifi3a = 0;
@@ -615,12 +697,12 @@ double R3BOptimizeGeometryS454::Chi2()
 			Charge = tof->hits.at(i)->GetEloss();
 		}
 		
-		cout << "Charge: " << charge << " requested charge: " << charge_requested << endl;
+		LOG(DEBUG) << "Charge: " << charge << " requested charge: " << charge_requested;
 		if(charge != charge_requested)
 		//if(!(charge == 2 || charge == 6))
 			continue;
 
-		cout << "Charge accepted: " << charge << endl;
+		LOG(DEBUG) << "Charge accepted: " << charge;
 		Double_t beta0 = 0.76; // velocity could eventually be calculated from ToF
 		tof->res_t = 0.03;
 
@@ -666,26 +748,24 @@ double R3BOptimizeGeometryS454::Chi2()
 						candidate->AddHit("fi12", ifi12);
 						candidate->AddHit("fi10", ifi10);
 
-						fDetectors = fDetectorsLeft;
 						Bool_t forward = kTRUE;
 						Int_t status = 10;
 						if (forward)
 						{
-							status = fFitter->FitTrackMomentumForward(candidate, fDetectors);
+							status = fFitter->FitTrackMomentumForward(candidate, left);
 						}
 						else
 						{
-							status = fFitter->FitTrackBackward2D(candidate, fDetectors);
+							status = fFitter->FitTrackBackward2D(candidate, left);
 						}
 						nCand += 1;
 						
+						// No continue here, that would skip the increment of the hit index
 						if (TMath::IsNaN(candidate->GetMomentum().Z()))
 						{
 							delete candidate;
-							continue;
 						}
-
-						if (10 > status)
+						else if (10 > status)
 						{
 							if(forward)
 							{
@@ -709,7 +789,7 @@ double R3BOptimizeGeometryS454::Chi2()
 							{
 								// if(candidate->GetChi2() < 3.)
 								{
-									fFragments.push_back(candidate);
+									fragments.push_back(candidate);
 								}
 							}
 							else
@@ -748,26 +828,35 @@ double R3BOptimizeGeometryS454::Chi2()
 			do // fi13
 			{
 				if (ifi13 >= 0)
-					fh_eloss_fi13_mc->Fill(1000. * fi13->hits.at(ifi13)->GetEloss()); // MeV		
+				{
+					std::lock_guard<std::mutex> lock(fHistMutex);
+					fh_eloss_fi13_mc->Fill(1000. * fi13->hits.at(ifi13)->GetEloss()); // MeV
+				}
 				do // fi11
 				{
 					if (ifi11 >= 0)
+					{
+						std::lock_guard<std::mutex> lock(fHistMutex);
 						fh_eloss_fi11_mc->Fill(1000. * fi11->hits.at(ifi11)->GetEloss()); // MeV
+					}
 					do // fi3a
 					{
 						if (ifi3a >= 0)
+						{
+							std::lock_guard<std::mutex> lock(fHistMutex);
 							fh_eloss_fi3a_mc->Fill(1000. * fi3a->hits.at(ifi3a)->GetEloss()); // MeV
+						}
 
 						// Create object for particle which will be fitted
 						R3BTrackingParticle* candidate = new R3BTrackingParticle(
 							charge, 0., 0., 0., 0., 0., p0, beta0, m0); // 17.39
 						
-						cout << "right side of setup" << endl;
-						cout << "Hit Tofd # " << i << " x: " << tof->hits.at(i)->GetX() 
-							<< " y: " << tof->hits.at(i)->GetY() << endl;
-						if(ifi13 > -1) cout << "Fi13 # " <<  ifi13 << " x: "<< fi13->hits.at(ifi13)->GetX() << endl;
-						if(ifi11 > -1) cout << "Fi11 # " <<  ifi11 << " x: "<< fi11->hits.at(ifi11)->GetX() << endl;
-						cout << "Hit target # " << " x: " << target->hits.at(0)->GetX() << endl;
+						LOG(DEBUG) << "right side of setup";
+						LOG(DEBUG) << "Hit Tofd # " << i << " x: " << tof->hits.at(i)->GetX() 
+							<< " y: " << tof->hits.at(i)->GetY();
+						if(ifi13 > -1) LOG(DEBUG) << "Fi13 # " <<  ifi13 << " x: "<< fi13->hits.at(ifi13)->GetX();
+						if(ifi11 > -1) LOG(DEBUG) << "Fi11 # " <<  ifi11 << " x: "<< fi11->hits.at(ifi11)->GetX();
+						LOG(DEBUG) << "Hit target # " << " x: " << target->hits.at(0)->GetX();
 
 						candidate->AddHit("target", 0);
 						candidate->AddHit("tofd", i);
@@ -775,26 +864,24 @@ double R3BOptimizeGeometryS454::Chi2()
 						candidate->AddHit("fi11", ifi11);
 						candidate->AddHit("fi13", ifi13);
 
-						fDetectors = fDetectorsRight;
 						Bool_t forward = kTRUE;
 						Int_t status = 10;
 						if (forward)
 						{
-							status = fFitter->FitTrackMomentumForward(candidate, fDetectors);
+							status = fFitter->FitTrackMomentumForward(candidate, right);
 						}
 						else
 						{
-							status = fFitter->FitTrackBackward2D(candidate, fDetectors);
+							status = fFitter->FitTrackBackward2D(candidate, right);
 						}
 						nCand += 1;
 						
+						// No continue here, that would skip the increment of the hit index
 						if (TMath::IsNaN(candidate->GetMomentum().Z()))
 						{
 							delete candidate;
-							continue;
 						}
-
-						if (10 > status)
+						else if (10 > status)
 						{
 							if(forward)
 							{
@@ -818,7 +905,7 @@ double R3BOptimizeGeometryS454::Chi2()
 							{
 								// if(candidate->GetChi2() < 3.)
 								{
-									fFragments.push_back(candidate);
+									fragments.push_back(candidate);
 								}
 							}
 							else
@@ -852,14 +939,17 @@ double R3BOptimizeGeometryS454::Chi2()
 		
 	} // end for TofD
 
-	fh_ncand->Fill(nCand);
+	{
+		std::lock_guard<std::mutex> lock(fHistMutex);
+		fh_ncand->Fill(nCand);
+	}
 
 	R3BTrackingParticle* candidate;
 	Double_t minChi2 = 1e10;
 
-	if (fFragments.size() > 0)
+	if (fragments.size() > 0)
 	{
-		for (auto const& x : fFragments)
+		for (auto const& x : fragments)
 		{
 			if (x->GetChi2() < minChi2)
 			{
@@ -876,23 +966,27 @@ double R3BOptimizeGeometryS454::Chi2()
 		//mChi2 = candidate->GetChi2();
 		mChi2 = sqrt(candidate->GetChi2() * candidate->GetChi2() + pChi2 * pChi2);
 		//mChi2 = pChi2;
-		cout << "pchi: " << pChi2 << "  " << candidate->GetChi2() << "  " << mChi2 << endl;
-		LOG(INFO) << "Results after tracking mass:";
-		LOG(INFO) << "Position x: " << candidate->GetStartPosition().X() << 
+		LOG(DEBUG) << "pchi: " << pChi2 << "  " << candidate->GetChi2() << "  " << mChi2;
+		LOG(DEBUG) << "Results after tracking mass:";
+		LOG(DEBUG) << "Position x: " << candidate->GetStartPosition().X() << 
 			" y: " << candidate->GetStartPosition().Y() << " z: " << candidate->GetStartPosition().Z();
-		cout << "Momentum : " << candidate->GetStartMomentum().Mag() << " px : " << candidate->GetStartMomentum().X() << 
-			" py: " << candidate->GetStartMomentum().Y() << " pz: " << candidate->GetStartMomentum().Z() << endl;
-		LOG(INFO) << "Mass   : " << candidate->GetMass();
-		LOG(INFO) << "Beta   : " << candidate->GetStartBeta();
-		LOG(INFO) << "chi2: " << candidate->GetChi2() << endl;
-		LOG(INFO) << "mchi2: " << mChi2 << endl;
+		LOG(DEBUG) << "Momentum : " << candidate->GetStartMomentum().Mag() << 
+			" px : " << candidate->GetStartMomentum().X() << " py: " << candidate->GetStartMomentum().Y() << 
+			" pz: " << candidate->GetStartMomentum().Z();
+		LOG(DEBUG) << "Mass   : " << candidate->GetMass();
+		LOG(DEBUG) << "Beta   : " << candidate->GetStartBeta();
+		LOG(DEBUG) << "chi2: " << candidate->GetChi2();
+		LOG(DEBUG) << "mchi2: " << mChi2;
 		
+		std::lock_guard<std::mutex> lock(fHistMutex);
 		fh_residuals->Fill(candidate->GetStartMomentum().Mag() - p0);
-		
-			
-	}// end if(fFragments.size() > 0
+	}// end if(fragments.size() > 0
 		
     delete particle;
+    for (auto const& x : fragments)
+    {
+        delete x;
+    }
 
     if(mChi2 < 10000.)
     {
@@ -922,7 +1016,7 @@ void R3BOptimizeGeometryS454::Finish()
 
     // create funciton wrapper for minmizer
     // a IMultiGenFunction type
-    ROOT::Math::Functor fm1(&Chi2AllEvents, 9);
+    ROOT::Math::Functor fm1(this, &R3BOptimizeGeometryS454::Chi2AllEvents, kNParameters);
 	if(fLeft)
 	{
 		//Double_t variable[7] = {-95.2,  667.7,  -67.9,  583.5,  -17.7, -17.6,  0.9833};
@@ -1187,7 +1281,7 @@ void R3BOptimizeGeometryS454::Finish()
     	
     if (fVis)
     {
-        for (auto const& det : fDetectors->GetArray())
+        for (auto const& det : fSetup->GetArray())
         {
             det->Draw();
         }
@@ -16,6 +16,7 @@
 
 #include "FairTask.h"
 
+#include <mutex>
 #include <string>
 #include <vector>
 #include "Math/Factory.h"
@@ -47,7 +48,10 @@ class R3BOptimizeGeometryS454 : public FairTask
 
     virtual void Exec(const Option_t* = "");
 
-    double Chi2();
+    /** Mean chi2 of the buffered events for the geometry and field parameters xx, minimized in
+        Finish(). The events are fitted on SetNumThreads() threads, each with a copy of the setup,
+        and summed up in the order they were buffered in. **/
+    Double_t Chi2AllEvents(const Double_t* xx);
 
     virtual void Finish();
 
@@ -55,6 +59,13 @@ class R3BOptimizeGeometryS454 : public FairTask
     void SetEnergyLoss(Bool_t energyLoss) { fEnergyLoss = energyLoss; }
     void SetSimu(Int_t simu) {fSimu = simu;}
     void SetOptimizeGeometry(Int_t optimizeGeometry) {fOptimizeGeometry = optimizeGeometry;}
+    /** Number of threads fitting the buffered events, 0 means one per core. The default 1 fits
+        them on the calling thread. Needs a fitter with IsParallelSafe() **/
+    void SetNumThreads(Int_t nThreads) { fNumThreads = nThreads; }
+    /** Keeps the chi2 of an event as long as the field and the detectors with hits in it stay
+        where they are, on by default. The planes of the detectors without hits only split the
+        propagation, so moving them changes the chi2 by no more than the step precision. **/
+    void SetCacheChi2(Bool_t cache) { fCacheChi2 = cache; }
 
     inline Int_t GetNEvents() const { return fNEvents; }
 
@@ -62,13 +73,17 @@ class R3BOptimizeGeometryS454 : public FairTask
   private:
     Bool_t InitPropagator();
 
+    /** Chi2 of the best fragment of the event whose hits are in the setup, -1 without one. The
+        number of fitted hit combinations goes to nCand. **/
+    Double_t Chi2(R3BTrackingSetup* setup, Int_t& nCand);
+
     R3BFieldPar* fFieldPar;
     R3BTPropagator* fPropagator;
     TClonesArray* fArrayMCTracks; // simulation output??? To compare?
     R3BTrackingSetup* fDetectors; // array of R3BTrackingDetector
     R3BTrackingSetup* fDetectorsLeft; // array of R3BTrackingDetector
     R3BTrackingSetup* fDetectorsRight; // array of R3BTrackingDetector
-    std::vector<R3BTrackingParticle*> fFragments;
+    R3BTrackingSetup* fSetup;          // the side that is optimized, with the event buffer
     TClonesArray* fArrayFragments;
     Int_t fNEvents;
     Bool_t fVis;
@@ -83,6 +98,14 @@ class R3BOptimizeGeometryS454 : public FairTask
 	Bool_t fSimu;
 	Bool_t fOptimizeGeometry;
 	Bool_t fLeft = kTRUE;
+    Int_t fNumThreads;
+    Bool_t fCacheChi2;
+
+    std::vector<R3BTrackingSetup*> fWorkerSetups; // one per thread
+    std::vector<Double_t> fEventChi2;             // per buffered event
+    std::vector<Double_t> fEventParameters;       // the parameters each chi2 was computed with
+    std::vector<Int_t> fEventDependence;          // bit i if the chi2 depends on parameter i, -1 if not yet fitted
+    std::mutex fHistMutex;                        //! for the histograms filled in Chi2()
     Double_t fAfterGladResolution;
     Int_t eventCounter = 0;
 
@@ -123,7 +146,7 @@ class R3BOptimizeGeometryS454 : public FairTask
     
     TH2F* fh_A_overZ;
 
-    ClassDef(R3BOptimizeGeometryS454, 1)
+    ClassDef(R3BOptimizeGeometryS454, 2)
 };
 
 #endif
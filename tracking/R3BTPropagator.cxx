@@ -13,6 +13,7 @@
 
 #include "R3BTPropagator.h"
 #include "R3BGladFieldMap.h"
+#include "R3BGladTransferMap.h"
 #include "R3BTGeoPar.h"
 #include "R3BTrackingDetector.h"
 #include "R3BTrackingParticle.h"
@@ -20,15 +21,43 @@
 #include "FairLogger.h"
 #include "FairRKPropagator.h"
 
+#include "TDirectory.h"
+#include "TFile.h"
 #include "TH2F.h"
 #include "TLine.h"
 #include "TMath.h"
+#include "TRandom3.h"
+#include "TSystem.h"
 
-R3BTPropagator::R3BTPropagator(R3BGladFieldMap* field, Bool_t vis)
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace
+{
+    // Samples per term of the polynomial in the fit, and for the comparison
+    const Int_t kFitSamplesPerTerm = 10;
+    const Int_t kCompareSamples = 2000;
+    // Forward tracks for the range of the backward map, and its extra width
+    const Int_t kRangeSamples = 1000;
+    const Double_t kRangeMargin = 0.05;
+    // Distance behind the field exit where the deviation is also checked [cm]
+    const Double_t kLeverArm = 500.;
+    // A track further off the plane is not on it [cm]
+    const Double_t kOnPlane = 1e-3;
+    // Seeds of the random tracks, the comparison uses other tracks than the fit
+    const UInt_t kFitSeed = 1;
+    const UInt_t kCompareSeed = 2;
+} // namespace
+
+R3BTPropagator::R3BTPropagator(R3BGladFieldMap* field, Bool_t)
     : fFairProp(new FairRKPropagator(field))
     , fField(field)
     , fmTofGeo(NULL)
-    , fVis(vis)
+    , fVis(kFALSE)
+    , fForwardMap(NULL)
+    , fBackwardMap(NULL)
+    , fc4(NULL)
 {
     // Define magnetic field boundaries ------------------------------------
     TVector3 pos(field->GetPositionX(), field->GetPositionY(), field->GetPositionZ());
@@ -48,31 +77,45 @@ R3BTPropagator::R3BTPropagator(R3BGladFieldMap* field, Bool_t vis)
     }
     fNorm1 = ((fPlane1[1] - fPlane1[0]).Cross(fPlane1[2] - fPlane1[0])).Unit();
     fNorm2 = ((fPlane2[1] - fPlane2[0]).Cross(fPlane2[2] - fPlane2[0])).Unit();
-    //----------------------------------------------------------------------
-    fVis = kFALSE;
-    if (fVis)
-    {
-        fc4 = new TCanvas("c4", "", 50, 50, 400, 400);
-        TH2F* h3 = new TH2F("h3", "", 180, -450., 450., 180, -100., 800.);
-        h3->SetStats(kFALSE);
-        h3->Draw();
-
-        TLine* l1 = new TLine(-fPlane1[1].X(), fPlane1[1].Z(), -fPlane1[2].X(), fPlane1[2].Z());
-        l1->SetLineColor(2);
-        l1->Draw();
-        TLine* l2 = new TLine(-fPlane2[1].X(), fPlane2[1].Z(), -fPlane2[2].X(), fPlane2[2].Z());
-        l2->SetLineColor(2);
-        l2->Draw();
-        TLine* l3 = new TLine(-fPlane1[1].X(), fPlane1[1].Z(), -fPlane2[1].X(), fPlane2[1].Z());
-        l3->SetLineColor(2);
-        l3->Draw();
-        TLine* l4 = new TLine(-fPlane1[2].X(), fPlane1[2].Z(), -fPlane2[2].X(), fPlane2[2].Z());
-        l4->SetLineColor(2);
-        l4->Draw();
-    }
+    // Frames of the transfer maps, forward and backward
+    fEntry[0] = { fPlane1[0], (fPlane1[1] - fPlane1[2]).Unit(), fNorm1.Cross(fPlane1[1] - fPlane1[2]).Unit(), fNorm1 };
+    fExit[0] = { fPlane2[0], (fPlane2[1] - fPlane2[2]).Unit(), fNorm2.Cross(fPlane2[1] - fPlane2[2]).Unit(), fNorm2 };
+    fEntry[1] = { fPlane2[0], fExit[0].x, -fExit[0].y, -fNorm2 };
+    fExit[1] = { fPlane1[0], fEntry[0].x, -fEntry[0].y, -fNorm1 };
 }
 
-R3BTPropagator::~R3BTPropagator() {}
+R3BTPropagator::~R3BTPropagator()
+{
+    delete fForwardMap;
+    delete fBackwardMap;
+}
+
+void R3BTPropagator::SetVis(Bool_t vis)
+{
+    fVis = vis;
+    if (!fVis || fc4)
+    {
+        return;
+    }
+
+    fc4 = new TCanvas("c4", "", 50, 50, 400, 400);
+    TH2F* h3 = new TH2F("h3", "", 180, -450., 450., 180, -100., 800.);
+    h3->SetStats(kFALSE);
+    h3->Draw();
+
+    TLine* l1 = new TLine(-fPlane1[1].X(), fPlane1[1].Z(), -fPlane1[2].X(), fPlane1[2].Z());
+    l1->SetLineColor(2);
+    l1->Draw();
+    TLine* l2 = new TLine(-fPlane2[1].X(), fPlane2[1].Z(), -fPlane2[2].X(), fPlane2[2].Z());
+    l2->SetLineColor(2);
+    l2->Draw();
+    TLine* l3 = new TLine(-fPlane1[1].X(), fPlane1[1].Z(), -fPlane2[1].X(), fPlane2[1].Z());
+    l3->SetLineColor(2);
+    l3->Draw();
+    TLine* l4 = new TLine(-fPlane1[2].X(), fPlane1[2].Z(), -fPlane2[2].X(), fPlane2[2].Z());
+    l4->SetLineColor(2);
+    l4->Draw();
+}
 
 Bool_t R3BTPropagator::PropagateToDetector(R3BTrackingParticle* particle, R3BTrackingDetector* detector)
 {
@@ -116,7 +159,6 @@ Bool_t R3BTPropagator::PropagateToPlane(R3BTrackingParticle* particle,
         }
 
         LOG(DEBUG2) << "Propagating to entrance of magnetic field.";
-        fVis = kFALSE;
         if (fVis)
         {
             TLine* l1 = new TLine(-particle->GetX(), particle->GetZ(), -intersect.X(), intersect.Z());
@@ -150,7 +192,6 @@ Bool_t R3BTPropagator::PropagateToPlane(R3BTrackingParticle* particle,
             result = PropagateToPlaneRK(particle, v1, v2, v3);
             // particle->GetPosition().Print();
             // particle->GetMomentum().Print();
-            fVis = kFALSE;
             if (fVis)
             {
                 TLine* l1 = new TLine(-tpos.X(), tpos.Z(), -particle->GetX(), particle->GetZ());
@@ -161,8 +202,7 @@ Bool_t R3BTPropagator::PropagateToPlane(R3BTrackingParticle* particle,
 
         LOG(DEBUG2) << "Propagating to exit from magnetic field.";
         tpos = particle->GetPosition();
-        result = PropagateToPlaneRK(particle, fPlane2[0], fPlane2[1], fPlane2[2]);
-        fVis = kFALSE;
+        result = PropagateThroughField(particle, kFALSE);
         if (fVis)
         {
             TLine* l1 = new TLine(-tpos.X(), tpos.Z(), -particle->GetX(), particle->GetZ());
@@ -178,7 +218,6 @@ Bool_t R3BTPropagator::PropagateToPlane(R3BTrackingParticle* particle,
     {
 
         LOG(DEBUG2) << "Propagating to end plane. Finish.";
-        fVis = kFALSE;
         if (fVis)
         {
             TLine* l1 = new TLine(-particle->GetX(), particle->GetZ(), -intersect.X(), intersect.Z());
@@ -219,7 +258,6 @@ Bool_t R3BTPropagator::PropagateToPlaneBackward(R3BTrackingParticle* particle,
         {
             LOG(DEBUG2) << "Propagating to end-plane and stop.";
             crossed = LineIntersectPlane(particle->GetPosition(), particle->GetMomentum(), v1, norm, intersect);
-            fVis = kFALSE;
             if (fVis)
             {
                 TLine* l1 = new TLine(-particle->GetX(), particle->GetZ(), -intersect.X(), intersect.Z());
@@ -231,7 +269,6 @@ Bool_t R3BTPropagator::PropagateToPlaneBackward(R3BTrackingParticle* particle,
             return kTRUE;
         }
         LOG(DEBUG2) << "Propagating to exit of magnetic field.";
-        fVis = kFALSE;
         if (fVis)
         {
             TLine* l1 = new TLine(-particle->GetX(), particle->GetZ(), -intersect.X(), intersect.Z());
@@ -253,7 +290,6 @@ Bool_t R3BTPropagator::PropagateToPlaneBackward(R3BTrackingParticle* particle,
             LOG(DEBUG2) << "Propagating to end-plane using RK4 and stop.";
             tpos = particle->GetPosition();
             result = PropagateToPlaneRK(particle, v1, v3, v2);
-            fVis = kFALSE;
             if (fVis)
             {
                 TLine* l1 = new TLine(-tpos.X(), tpos.Z(), -particle->GetX(), particle->GetZ());
@@ -264,8 +300,7 @@ Bool_t R3BTPropagator::PropagateToPlaneBackward(R3BTrackingParticle* particle,
         }
         LOG(DEBUG2) << "Propagating to entrance of magnetic field.";
         tpos = particle->GetPosition();
-        result = PropagateToPlaneRK(particle, fPlane1[0], fPlane1[2], fPlane1[1]);
-        fVis = kFALSE;
+        result = PropagateThroughField(particle, kTRUE);
         if (fVis)
         {
             TLine* l1 = new TLine(-tpos.X(), tpos.Z(), -particle->GetX(), particle->GetZ());
@@ -282,7 +317,6 @@ Bool_t R3BTPropagator::PropagateToPlaneBackward(R3BTrackingParticle* particle,
     if (crossed)
     {
         LOG(DEBUG2) << "Propagating to end plane. Finish.";
-        fVis = kFALSE;
         if (fVis)
         {
             TLine* l1 = new TLine(-particle->GetX(), particle->GetZ(), -intersect.X(), intersect.Z());
@@ -390,5 +424,337 @@ Bool_t R3BTPropagator::LineIntersectPlane(const TVector3& pos,
     }
     return kTRUE;
 }
+Bool_t R3BTPropagator::UseTransferMaps(const char* fileName,
+                                       const Double_t* min,
+                                       const Double_t* max,
+                                       Int_t degree,
+                                       Double_t tolerance)
+{
+    delete fForwardMap;
+    delete fBackwardMap;
+    fForwardMap = NULL;
+    fBackwardMap = NULL;
+
+    if (GetFieldFactor() == 0.)
+    {
+        LOG(ERROR) << "R3BTPropagator: No transfer maps without field, using Runge-Kutta.";
+        return kFALSE;
+    }
+    Double_t backwardMin[R3BGladTransferMap::kNIn];
+    Double_t backwardMax[R3BGladTransferMap::kNIn];
+    if (!GetBackwardRange(min, max, backwardMin, backwardMax))
+    {
+        LOG(ERROR) << "R3BTPropagator: Tracks in the range of the transfer maps do not pass the field, using "
+                      "Runge-Kutta.";
+        return kFALSE;
+    }
+
+    const Double_t x = fField->GetPositionX();
+    const Double_t y = fField->GetPositionY();
+    const Double_t z = fField->GetPositionZ();
+    const Double_t angle = fField->GetYAngle();
+    const Double_t* mins[2] = { min, backwardMin };
+    const Double_t* maxs[2] = { max, backwardMax };
+    const char* names[2] = { "GladTransferForward", "GladTransferBackward" };
+    std::unique_ptr<R3BGladTransferMap> maps[2];
+
+    // Maps made before for this field and range
+    if (!gSystem->AccessPathName(fileName))
+    {
+        TDirectory::TContext context(nullptr);
+        std::unique_ptr<TFile> file(TFile::Open(fileName, "READ"));
+        for (Int_t i = 0; file && !file->IsZombie() && i < 2; i++)
+        {
+            maps[i].reset(dynamic_cast<R3BGladTransferMap*>(file->Get(names[i])));
+            Bool_t same = maps[i] && maps[i]->GetDegree() == degree &&
+                          maps[i]->IsSameField(fField->GetFileName(), x, y, z, angle) &&
+                          maps[i]->GetDeviation() >= 0. && maps[i]->GetDeviation() <= tolerance;
+            for (Int_t j = 0; same && j < R3BGladTransferMap::kNIn; j++)
+            {
+                same = TMath::Abs(maps[i]->GetMin(j) - mins[i][j]) < 1e-6 &&
+                       TMath::Abs(maps[i]->GetMax(j) - maxs[i][j]) < 1e-6;
+            }
+            if (!same)
+            {
+                maps[i].reset();
+            }
+        }
+    }
+
+    if (maps[0] && maps[1])
+    {
+        LOG(INFO) << "R3BTPropagator: Transfer maps read from " << fileName;
+    }
+    else
+    {
+        LOG(INFO) << "R3BTPropagator: Making transfer maps of degree " << degree << ", this takes a while...";
+        for (Int_t i = 0; i < 2; i++)
+        {
+            maps[i].reset(MakeTransferMap(i == 1, degree, mins[i], maxs[i], 0));
+            if (!maps[i])
+            {
+                LOG(ERROR) << "R3BTPropagator: Fit of the transfer map " << names[i] << " failed, using Runge-Kutta.";
+                return kFALSE;
+            }
+            const Double_t deviation = CompareTransferMap(maps[i].get(), i == 1, kCompareSamples);
+            maps[i]->SetDeviation(deviation);
+            if (deviation < 0. || deviation > tolerance)
+            {
+                LOG(ERROR) << "R3BTPropagator: Transfer map " << names[i] << " deviates by " << deviation
+                           << " cm from Runge-Kutta, more than " << tolerance << " cm. Using Runge-Kutta.";
+                return kFALSE;
+            }
+        }
+
+        TDirectory::TContext context(nullptr);
+        std::unique_ptr<TFile> file(TFile::Open(fileName, "RECREATE"));
+        if (file && !file->IsZombie())
+        {
+            maps[0]->Write(names[0]);
+            maps[1]->Write(names[1]);
+            LOG(INFO) << "R3BTPropagator: Transfer maps written to " << fileName;
+        }
+        else
+        {
+            LOG(WARNING) << "R3BTPropagator: Could not write the transfer maps to " << fileName;
+        }
+    }
+
+    LOG(INFO) << "R3BTPropagator: Using transfer maps through the field, largest deviation from Runge-Kutta "
+              << std::max(maps[0]->GetDeviation(), maps[1]->GetDeviation()) << " cm";
+    fForwardMap = maps[0].release();
+    fBackwardMap = maps[1].release();
+    return kTRUE;
+}
+
+Bool_t R3BTPropagator::GetFieldEntryState(const R3BTrackingParticle* particle, Double_t* state)
+{
+    R3BTrackingParticle track(*particle);
+    TVector3 intersect;
+    if (!LineIntersectPlane(track.GetPosition(), track.GetMomentum(), fEntry[0].origin, fEntry[0].n, intersect))
+    {
+        return kFALSE;
+    }
+    track.SetPosition(intersect);
+    return GetPlaneState(&track, fEntry[0], state);
+}
+
+R3BGladTransferMap* R3BTPropagator::MakeTransferMap(Bool_t backward,
+                                                    Int_t degree,
+                                                    const Double_t* min,
+                                                    const Double_t* max,
+                                                    Int_t nSamples)
+{
+    std::unique_ptr<R3BGladTransferMap> map(new R3BGladTransferMap(degree, min, max));
+    if (nSamples <= 0)
+    {
+        nSamples = kFitSamplesPerTerm * map->GetNTerms();
+    }
+
+    TRandom3 random(kFitSeed);
+    std::vector<Double_t> in, out;
+    in.reserve(nSamples * R3BGladTransferMap::kNIn);
+    out.reserve(nSamples * R3BGladTransferMap::kNOut);
+    Double_t state[R3BGladTransferMap::kNIn];
+    Double_t result[R3BGladTransferMap::kNOut];
+    for (Int_t s = 0; s < nSamples; s++)
+    {
+        for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+        {
+            state[i] = random.Uniform(min[i], max[i]);
+        }
+        if (PropagateStateRK(backward, state, result))
+        {
+            in.insert(in.end(), state, state + R3BGladTransferMap::kNIn);
+            out.insert(out.end(), result, result + R3BGladTransferMap::kNOut);
+        }
+    }
+
+    if (map->Fit(in, out) < 0.)
+    {
+        return NULL;
+    }
+    map->SetField(fField->GetFileName(),
+                  fField->GetPositionX(),
+                  fField->GetPositionY(),
+                  fField->GetPositionZ(),
+                  fField->GetYAngle());
+    return map.release();
+}
+
+Double_t R3BTPropagator::CompareTransferMap(const R3BGladTransferMap* map, Bool_t backward, Int_t nSamples)
+{
+    TRandom3 random(kCompareSeed);
+    Double_t deviation = -1.;
+    Double_t state[R3BGladTransferMap::kNIn];
+    Double_t rk[R3BGladTransferMap::kNOut];
+    Double_t fit[R3BGladTransferMap::kNOut];
+    for (Int_t s = 0; s < nSamples; s++)
+    {
+        for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+        {
+            state[i] = random.Uniform(map->GetMin(i), map->GetMax(i));
+        }
+        if (!PropagateStateRK(backward, state, rk))
+        {
+            continue;
+        }
+        map->Eval(state, fit);
+        const Double_t dx = fit[R3BGladTransferMap::kX] - rk[R3BGladTransferMap::kX];
+        const Double_t dy = fit[R3BGladTransferMap::kY] - rk[R3BGladTransferMap::kY];
+        const Double_t dtx = fit[R3BGladTransferMap::kTx] - rk[R3BGladTransferMap::kTx];
+        const Double_t dty = fit[R3BGladTransferMap::kTy] - rk[R3BGladTransferMap::kTy];
+        deviation = std::max({ deviation,
+                               TMath::Abs(dx),
+                               TMath::Abs(dy),
+                               TMath::Abs(dx + kLeverArm * dtx),
+                               TMath::Abs(dy + kLeverArm * dty) });
+    }
+    return deviation;
+}
+
+Bool_t R3BTPropagator::PropagateThroughField(R3BTrackingParticle* particle, Bool_t backward)
+{
+    const R3BGladTransferMap* map = backward ? fBackwardMap : fForwardMap;
+    Double_t in[R3BGladTransferMap::kNIn];
+    if (map && GetPlaneState(particle, fEntry[backward], in) && map->IsInside(in))
+    {
+        Double_t out[R3BGladTransferMap::kNOut];
+        map->Eval(in, out);
+        SetPlaneState(particle, fExit[backward], out);
+        particle->AddStep(out[R3BGladTransferMap::kLength]);
+        return kTRUE;
+    }
+
+    if (backward)
+    {
+        return PropagateToPlaneRK(particle, fPlane1[0], fPlane1[2], fPlane1[1]);
+    }
+    return PropagateToPlaneRK(particle, fPlane2[0], fPlane2[1], fPlane2[2]);
+}
+
+Bool_t R3BTPropagator::PropagateStateRK(Bool_t backward, const Double_t* in, Double_t* out)
+{
+    // Any charge and momentum with the same kappa take the same path
+    const Double_t p = GetFieldFactor() / in[R3BGladTransferMap::kKappa];
+    if (!TMath::Finite(p) || p == 0.)
+    {
+        return kFALSE;
+    }
+    R3BTrackingParticle particle(p > 0. ? 1. : -1., 0., 0., 0., 0., 0., 0., 0., 0.);
+    particle.SetMomentum(TMath::Abs(p) * fEntry[backward].n);
+    SetPlaneState(&particle, fEntry[backward], in);
+
+    const Bool_t reached = backward ? PropagateToPlaneRK(&particle, fPlane1[0], fPlane1[2], fPlane1[1])
+                                    : PropagateToPlaneRK(&particle, fPlane2[0], fPlane2[1], fPlane2[2]);
+    if (!reached)
+    {
+        return kFALSE;
+    }
+
+    // The steps stop close to the exit plane, the rest is a straight line
+    const FieldPlane& exit = fExit[backward];
+    const TVector3 direction = particle.GetMomentum().Unit();
+    const Double_t cosine = direction.Dot(exit.n);
+    if (cosine <= 0.)
+    {
+        return kFALSE;
+    }
+    const Double_t step = (exit.origin - particle.GetPosition()).Dot(exit.n) / cosine;
+    particle.SetPosition(particle.GetPosition() + step * direction);
+    particle.AddStep(step);
+    if (!GetPlaneState(&particle, exit, out))
+    {
+        return kFALSE;
+    }
+    out[R3BGladTransferMap::kLength] = particle.GetLength();
+    return kTRUE;
+}
+
+Bool_t R3BTPropagator::GetBackwardRange(const Double_t* min,
+                                        const Double_t* max,
+                                        Double_t* backwardMin,
+                                        Double_t* backwardMax)
+{
+    std::fill(backwardMin, backwardMin + R3BGladTransferMap::kNIn, std::numeric_limits<Double_t>::max());
+    std::fill(backwardMax, backwardMax + R3BGladTransferMap::kNIn, std::numeric_limits<Double_t>::lowest());
+
+    TRandom3 random(kFitSeed);
+    Int_t nPassed = 0;
+    Double_t state[R3BGladTransferMap::kNIn];
+    Double_t result[R3BGladTransferMap::kNOut];
+    Double_t reversed[R3BGladTransferMap::kNIn];
+    for (Int_t s = 0; s < kRangeSamples; s++)
+    {
+        for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+        {
+            state[i] = random.Uniform(min[i], max[i]);
+        }
+        if (!PropagateStateRK(kFALSE, state, result))
+        {
+            continue;
+        }
+
+        // The same track going upstream, momentum and charge reversed as in the fitters
+        const Double_t p = GetFieldFactor() / state[R3BGladTransferMap::kKappa];
+        R3BTrackingParticle particle(p > 0. ? 1. : -1., 0., 0., 0., 0., 0., 0., 0., 0.);
+        particle.SetMomentum(TMath::Abs(p) * fExit[0].n);
+        SetPlaneState(&particle, fExit[0], result);
+        particle.SetMomentum(-1. * particle.GetMomentum());
+        particle.SetCharge(-1. * particle.GetCharge());
+        if (!GetPlaneState(&particle, fEntry[1], reversed))
+        {
+            continue;
+        }
+        for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+        {
+            backwardMin[i] = std::min(backwardMin[i], reversed[i]);
+            backwardMax[i] = std::max(backwardMax[i], reversed[i]);
+        }
+        nPassed++;
+    }
+    if (nPassed == 0)
+    {
+        return kFALSE;
+    }
+
+    for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+    {
+        const Double_t margin = kRangeMargin * (backwardMax[i] - backwardMin[i]);
+        backwardMin[i] -= margin;
+        backwardMax[i] += margin;
+    }
+    return kTRUE;
+}
+
+Bool_t R3BTPropagator::GetPlaneState(const R3BTrackingParticle* particle,
+                                     const FieldPlane& plane,
+                                     Double_t* state) const
+{
+    const TVector3 r = particle->GetPosition() - plane.origin;
+    const TVector3& p = particle->GetMomentum();
+    const Double_t pn = p.Dot(plane.n);
+    if (TMath::Abs(r.Dot(plane.n)) > kOnPlane || pn <= 0.)
+    {
+        return kFALSE;
+    }
+    state[R3BGladTransferMap::kX] = r.Dot(plane.x);
+    state[R3BGladTransferMap::kY] = r.Dot(plane.y);
+    state[R3BGladTransferMap::kTx] = p.Dot(plane.x) / pn;
+    state[R3BGladTransferMap::kTy] = p.Dot(plane.y) / pn;
+    state[R3BGladTransferMap::kKappa] = particle->GetCharge() / p.Mag() * GetFieldFactor();
+    return kTRUE;
+}
+
+void R3BTPropagator::SetPlaneState(R3BTrackingParticle* particle, const FieldPlane& plane, const Double_t* state) const
+{
+    particle->SetPosition(plane.origin + state[R3BGladTransferMap::kX] * plane.x +
+                          state[R3BGladTransferMap::kY] * plane.y);
+    const TVector3 direction =
+        state[R3BGladTransferMap::kTx] * plane.x + state[R3BGladTransferMap::kTy] * plane.y + plane.n;
+    particle->SetMomentum(particle->GetMomentum().Mag() * direction.Unit());
+}
+
+Double_t R3BTPropagator::GetFieldFactor() const { return fField->GetScale() * fField->GetTrackerCorrection(); }
 
 ClassImp(R3BTPropagator)
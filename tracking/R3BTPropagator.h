@@ -19,6 +19,7 @@
 #include "TVector3.h"
 
 class R3BGladFieldMap;
+class R3BGladTransferMap;
 class FairRKPropagator;
 class R3BTGeoPar;
 class FairField;
@@ -56,12 +57,73 @@ class R3BTPropagator : public TObject
                               const TVector3& normal,
                               TVector3& intersect);
 
-    void SetVis(Bool_t vis = kTRUE) { fVis = vis; }
+    /** Propagate through GLAD with transfer maps instead of Runge-Kutta steps
+     ** where the track is inside their range, see R3BGladTransferMap. The maps
+     ** are read from fileName if they were made for this field, range and
+     ** degree. Else they are fitted to Runge-Kutta tracks, compared to
+     ** Runge-Kutta for other tracks and written to fileName.
+     ** @param min,max    Range of the tracks on the field entry plane going
+     **                   downstream, the range upstream follows from it
+     ** @param tolerance  Largest deviation from Runge-Kutta [cm]
+     ** @value kFALSE if the maps deviate more, Runge-Kutta stays in use
+     **/
+    Bool_t UseTransferMaps(const char* fileName,
+                           const Double_t* min,
+                           const Double_t* max,
+                           Int_t degree = 5,
+                           Double_t tolerance = 0.05);
+
+    /** State of a straight track on the field entry plane going downstream, as
+     ** in R3BGladTransferMap, e.g. to center the range of the maps on the beam **/
+    Bool_t GetFieldEntryState(const R3BTrackingParticle* particle, Double_t* state);
+
+    /** Fit a transfer map to nSamples Runge-Kutta tracks, 0 for ten per term of
+     ** the polynomial. NULL if the fit fails, else the caller owns the map **/
+    R3BGladTransferMap* MakeTransferMap(Bool_t backward,
+                                        Int_t degree,
+                                        const Double_t* min,
+                                        const Double_t* max,
+                                        Int_t nSamples);
+
+    /** Largest deviation of a map from Runge-Kutta for nSamples random tracks
+     ** in its range, on the field exit plane and 5 m behind it [cm] **/
+    Double_t CompareTransferMap(const R3BGladTransferMap* map, Bool_t backward, Int_t nSamples);
+
+    // Drawing the tracks is for single threaded use only, the propagation
+    // itself does not modify the propagator. The canvas is created by the
+    // first SetVis(kTRUE), the vis argument of the constructor is ignored.
+    void SetVis(Bool_t vis = kTRUE);
 
   private:
+    // Boundary plane of the field with its axes, n is the direction of travel
+    struct FieldPlane
+    {
+        TVector3 origin;
+        TVector3 x;
+        TVector3 y;
+        TVector3 n;
+    };
+
+    /** From the entry to the exit plane of the field, with a map if possible **/
+    Bool_t PropagateThroughField(R3BTrackingParticle* particle, Bool_t backward);
+
+    /** Runge-Kutta from a track on the entry plane to the exit plane, the
+     ** states as in R3BGladTransferMap **/
+    Bool_t PropagateStateRK(Bool_t backward, const Double_t* in, Double_t* out);
+
+    /** Range on the upstream entry plane of the tracks in the given range going downstream **/
+    Bool_t GetBackwardRange(const Double_t* min, const Double_t* max, Double_t* backwardMin, Double_t* backwardMax);
+
+    /** Track state of a particle on a plane, kFALSE if it is not there **/
+    Bool_t GetPlaneState(const R3BTrackingParticle* particle, const FieldPlane& plane, Double_t* state) const;
+    void SetPlaneState(R3BTrackingParticle* particle, const FieldPlane& plane, const Double_t* state) const;
+
+    /** Field scale times tracker correction **/
+    Double_t GetFieldFactor() const;
+
     FairRKPropagator* fFairProp;
 
-    FairField* fField;
+    R3BGladFieldMap* fField;
 
     R3BTGeoPar* fmTofGeo;
 
@@ -72,9 +134,16 @@ class R3BTPropagator : public TObject
     TVector3 fNorm1;
     TVector3 fNorm2;
 
+    // Index 0 going downstream, 1 going upstream
+    FieldPlane fEntry[2]; //!
+    FieldPlane fExit[2];  //!
+
+    R3BGladTransferMap* fForwardMap;  //!
+    R3BGladTransferMap* fBackwardMap; //!
+
     TCanvas* fc4;
 
-    ClassDef(R3BTPropagator, 1)
+    ClassDef(R3BTPropagator, 2)
 };
 
 #endif //! R3B_T_PROPAGATOR
@@ -25,8 +25,19 @@
 
 #include <iostream>
 
+#ifdef WITH_ATIMA
+#include "R3BAtima.h"
+#endif
+
 using namespace std;
 
+namespace
+{
+    const Double_t kAmu = 0.931494028; // GeV
+    // Largest relative difference of the particle mass from the mass number of a table times kAmu
+    const Double_t kTableMassTolerance = 0.01;
+} // namespace
+
 R3BTrackingDetector::R3BTrackingDetector(const char* detectorName,
                                          EDetectorType type,
                                          const char* geoParName,
@@ -36,6 +47,7 @@ R3BTrackingDetector::R3BTrackingDetector(const char* detectorName,
     , fDataName(hitArray)
     , section(type)
     , fArrayHits(NULL)
+    , fEnergyLossFromAtima(kFALSE)
 {
     // resolutions (for chi2)
     res_x = 1; // dummy values that allow calculating chi2
@@ -85,6 +97,8 @@ InitStatus R3BTrackingDetector::Init()
     res_x = fGeo->GetSigmaX();
     res_y = fGeo->GetSigmaY();
 
+    BuildEnergyLossTables();
+
     // get access to hit data
     if (!fDataName.EqualTo(""))
     {
@@ -134,22 +148,38 @@ void R3BTrackingDetector::CopyToBuffer()
     // LOG(info) << "------- " << events.size();
 }
 
-void R3BTrackingDetector::TakeHitsFromBuffer(Int_t iev)
+void R3BTrackingDetector::TakeHitsFromBuffer(Int_t iev) { TakeHitsFromBuffer(*this, iev); }
+
+void R3BTrackingDetector::TakeHitsFromBuffer(R3BTrackingDetector& buffer, Int_t iev)
 {
-    if (iev >= events.size())
+    if (iev >= buffer.events.size())
     {
         return;
     }
 
     hits.clear();
-    for (Int_t ihit = 0; ihit < events[iev].size(); ihit++)
+    for (Int_t ihit = 0; ihit < buffer.events[iev].size(); ihit++)
     {
-        hits.push_back(&events[iev].at(ihit));
+        hits.push_back(&buffer.events[iev].at(ihit));
     }
 
     // LOG(info) << "======= " << hits.size();
 }
 
+void R3BTrackingDetector::CopyGeometry(const R3BTrackingDetector& other)
+{
+    pos0 = other.pos0;
+    pos1 = other.pos1;
+    pos2 = other.pos2;
+    norm = other.norm;
+    fGeo = other.fGeo;
+    res_x = other.res_x;
+    res_y = other.res_y;
+    res_t = other.res_t;
+    fEnergyLossTables = other.fEnergyLossTables;
+    fEnergyLossFromAtima = other.fEnergyLossFromAtima;
+}
+
 void R3BTrackingDetector::GlobalToLocal(const TVector3& posGlobal, Double_t& x_local, Double_t& y_local)
 {
     TVector3 local = posGlobal - pos0;
@@ -172,25 +202,44 @@ void R3BTrackingDetector::LocalToGlobal(TVector3& posGlobal, Double_t x_local, D
 
 Double_t R3BTrackingDetector::GetEnergyLoss(const R3BTrackingParticle* particle)
 {
-    TVector3 mom_track = particle->GetMomentum().Unit();
+    const Double_t charge = particle->GetCharge();
+    const Double_t beta = particle->GetBeta();
+    if (!fEnergyLossTables.empty())
+    {
+        const Int_t z = TMath::Nint(TMath::Abs(charge));
+        const Int_t a = TMath::Nint(particle->GetMass() / kAmu);
+        auto it = fEnergyLossTables.find(std::make_pair(z, a));
+        const Double_t gamma = particle->GetGamma();
+        // A mass still being fitted can be anywhere between two mass numbers, it gets the formula
+        if (it != fEnergyLossTables.end() &&
+            TMath::Abs(particle->GetMass() - a * kAmu) < kTableMassTolerance * a * kAmu &&
+            it->second.IsInside(beta * gamma))
+        {
+            // Goes with the charge squared, for a fitted charge off the one of the table
+            return it->second.Eval(beta, gamma) * charge * charge / (z * z);
+        }
+    }
+    return GetEnergyLossFormula(charge, particle->GetMass(), beta);
+}
 
+Double_t R3BTrackingDetector::GetEnergyLossFormula(Double_t charge, Double_t mass, Double_t beta) const
+{
     Double_t Z2 = fGeo->GetZ();
     Double_t A2 = fGeo->GetA();
     Double_t density = fGeo->GetDensity();
     Double_t I = fGeo->GetI();
     // cout << "Ionization: " << I << endl;
-    Double_t Z1 = particle->GetCharge();
+    Double_t Z1 = charge;
     const Double_t K = 0.307075;
     const Double_t me = 0.5109989461;
-    Double_t beta = particle->GetBeta();
-    Double_t gamma = particle->GetGamma();
-    Double_t m = particle->GetMass() * 1000.;
+    Double_t gamma = TMath::Sqrt(1. / (1. - beta * beta));
+    Double_t m = mass * 1000.;
     Double_t dx = 2. * fGeo->GetDimZ() * density;
     //    Double_t Tmax = 2. * me * TMath::Power(beta * gamma, 2);
     Double_t Tmax = 2. * me * TMath::Power(beta * gamma, 2) / (1. + (2. * gamma * me) / m + TMath::Power(me / m, 2));
     // cout << "Test: " << Tmax << endl;
-    Double_t h_omega = 28.816 * 1e-6 * TMath::Sqrt(density * Z2 / A2);
     /*
+        Double_t h_omega = 28.816 * 1e-6 * TMath::Sqrt(density * Z2 / A2);
         Double_t eloss = dx * K * TMath::Power(Z1, 2) * Z2 / A2 / TMath::Power(beta, 2) *
                          (0.5 * TMath::Log(2 * me * beta * beta * gamma * gamma * Tmax / (I * I)) - beta * beta -
                           (TMath::Log(h_omega / I) + TMath::Log(beta * gamma) - 0.5));
@@ -219,6 +268,61 @@ Double_t R3BTrackingDetector::GetEnergyLoss(const R3BTrackingParticle* particle)
     return eloss;
 }
 
+void R3BTrackingDetector::AddEnergyLossTable(Int_t charge, Int_t massNumber)
+{
+    if (charge <= 0 || massNumber <= 0)
+    {
+        LOG(ERROR) << "R3BTrackingDetector::AddEnergyLossTable() no table for Z = " << charge << ", A = " << massNumber;
+        return;
+    }
+    fEnergyLossTables[std::make_pair(charge, massNumber)];
+}
+
+void R3BTrackingDetector::BuildEnergyLossTables()
+{
+    Bool_t atima = fEnergyLossFromAtima;
+#ifndef WITH_ATIMA
+    if (atima && !fEnergyLossTables.empty())
+    {
+        LOG(WARNING) << "R3BTrackingDetector::Init() " << fDetectorName
+                     << ": built without Atima, the energy loss tables are filled from the formula";
+    }
+    atima = kFALSE;
+#endif
+
+    for (auto& t : fEnergyLossTables)
+    {
+        const Int_t z = t.first.first;
+        const Int_t a = t.first.second;
+        const Double_t mass = a * kAmu;
+        const R3BEnergyLossTable::Function formula = [this, z, mass](Double_t beta, Double_t) {
+            return GetEnergyLossFormula(z, mass, beta);
+        };
+        if (atima)
+        {
+#ifdef WITH_ATIMA
+            // The material of the parameters as a single element
+            const R3BAtima::TargetMaterial material(
+                { R3BAtima::MaterialCompound(fGeo->GetA(), fGeo->GetZ()) }, fGeo->GetDensity(), kFALSE);
+            const Double_t thickness = 2. * fGeo->GetDimZ() * fGeo->GetDensity() * 1000.; // mg/cm^2
+            t.second.Fill([&](Double_t, Double_t gamma) {
+                return a * R3BAtima::Calculate(a, z, (gamma - 1.) * kAmu * 1000., material, thickness).ELoss_MeV_per_u;
+            });
+#endif
+        }
+        else
+        {
+            t.second.Fill(formula);
+        }
+
+        Double_t betaGamma = 0.;
+        const Double_t deviation = t.second.GetDeviation(formula, betaGamma);
+        LOG(INFO) << "R3BTrackingDetector::Init() " << fDetectorName << ": energy loss table of Z = " << z
+                  << ", A = " << a << (atima ? " from Atima" : "") << " deviates up to " << 100. * deviation
+                  << " % from the formula, at beta gamma = " << betaGamma;
+    }
+}
+
 void R3BTrackingDetector::SetParContainers()
 {
     // fetch geometry and position of detector
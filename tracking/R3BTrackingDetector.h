@@ -16,8 +16,10 @@
 
 #include <vector>
 #include <map>
+#include <utility>
 
 #include "FairTask.h"
+#include "R3BEnergyLossTable.h"
 #include "R3BTrackingParticle.h"
 #include "TObject.h"
 #include "TString.h"
@@ -57,6 +59,12 @@ class R3BTrackingDetector : public TObject
     
     void TakeHitsFromBuffer(Int_t iev);
 
+    /** Takes the hits of event iev from the buffer of the other detector, which keeps owning them **/
+    void TakeHitsFromBuffer(R3BTrackingDetector& buffer, Int_t iev);
+
+    /** Copies the plane, the material and the resolutions of the other detector **/
+    void CopyGeometry(const R3BTrackingDetector& other);
+
     void Draw(Option_t* option = "");
 
     void GlobalToLocal(const TVector3& posGlobal, Double_t& x_local, Double_t& y_local);
@@ -64,8 +72,21 @@ class R3BTrackingDetector : public TObject
 
     const TString& GetDetectorName() const { return fDetectorName; }
 
+    /** Energy loss [MeV] in the detector, from the table of the particle if it has one and its mass is within
+        1 % of the mass number of the table times the atomic mass unit, else from the formula **/
     Double_t GetEnergyLoss(const R3BTrackingParticle* particle);
 
+    /** Energy loss [MeV] from the Bethe-Bloch formula, the mass in GeV **/
+    Double_t GetEnergyLossFormula(Double_t charge, Double_t mass, Double_t beta) const;
+
+    /** Tabulate the energy loss of the ion with this charge and mass number at Init, where
+        the deviation of the table from the formula is reported. The tables are meant for momentum
+        fits with a fixed mass, during a mass fit most masses get the formula **/
+    void AddEnergyLossTable(Int_t charge, Int_t massNumber);
+
+    /** Fill the energy loss tables from R3BAtima instead of the formula, if built with Atima **/
+    void SetEnergyLossFromAtima(Bool_t atima) { fEnergyLossFromAtima = atima; }
+
     inline R3BTGeoPar* GetGeoPar() { return fGeo; }
 
   public:
@@ -111,6 +132,12 @@ class R3BTrackingDetector : public TObject
     // Double_t track_y;
     // TVector3 track_xyz; // same in global coordinates
 
+  private:
+    void BuildEnergyLossTables();
+
+    std::map<std::pair<Int_t, Int_t>, R3BEnergyLossTable> fEnergyLossTables; //! by charge and mass number
+    Bool_t fEnergyLossFromAtima;
+
   public:
     ClassDef(R3BTrackingDetector, 0)
 };
@@ -102,6 +102,22 @@ void R3BTrackingSetup::SetParContainers()
     }
 }
 
+void R3BTrackingSetup::AddEnergyLossTable(Int_t charge, Int_t massNumber)
+{
+    for (auto const& x : fDetectors)
+    {
+        x->AddEnergyLossTable(charge, massNumber);
+    }
+}
+
+void R3BTrackingSetup::SetEnergyLossFromAtima(Bool_t atima)
+{
+    for (auto const& x : fDetectors)
+    {
+        x->SetEnergyLossFromAtima(atima);
+    }
+}
+
 void R3BTrackingSetup::CopyHits()
 {
     for (auto const& x : fDetectors)
@@ -126,4 +142,25 @@ void R3BTrackingSetup::TakeHitsFromBuffer(Int_t iev)
     }
 }
 
+void R3BTrackingSetup::TakeHitsFromBuffer(R3BTrackingSetup& buffer, Int_t iev)
+{
+    for (auto const& x : fDetectors)
+    {
+        x->TakeHitsFromBuffer(*buffer.GetByName(x->GetDetectorName().Data()), iev);
+    }
+}
+
+void R3BTrackingSetup::CopyGeometry(R3BTrackingSetup& other)
+{
+    for (auto const& x : other.GetArray())
+    {
+        const string name = x->GetDetectorName().Data();
+        if (fMapIndex.find(name) == fMapIndex.end())
+        {
+            AddDetector(name, x->section, x->fGeoParName.Data());
+        }
+        GetByName(name)->CopyGeometry(*x);
+    }
+}
+
 ClassImp(R3BTrackingSetup)
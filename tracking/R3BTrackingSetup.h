@@ -38,12 +38,24 @@ class R3BTrackingSetup
 
     void SetParContainers();
 
+    /** Tabulate the energy loss of this ion in all detectors, see R3BTrackingDetector::AddEnergyLossTable() **/
+    void AddEnergyLossTable(Int_t charge, Int_t massNumber);
+
+    void SetEnergyLossFromAtima(Bool_t atima);
+
     void CopyHits();
     
     void CopyToBuffer();
     
     void TakeHitsFromBuffer(Int_t iev);
 
+    /** Takes the hits of event iev from the buffers of the other setup, which keeps owning them **/
+    void TakeHitsFromBuffer(R3BTrackingSetup& buffer, Int_t iev);
+
+    /** Adds the detectors of the other setup that are missing here, without their hit data, and
+        copies the geometry of all of them **/
+    void CopyGeometry(R3BTrackingSetup& other);
+
     std::vector<R3BTrackingDetector*>& GetArray() { return fDetectors; }
 
     R3BHit* GetHit(const std::string& detName, const Int_t& hitId) { return GetByName(detName)->hits[hitId]; }
@@ -19,6 +19,7 @@
 #pragma link off all classes;
 #pragma link off all functions;
 #pragma link C++ class R3BTPropagator+;
+#pragma link C++ class R3BGladTransferMap+;
 #pragma link C++ class R3BTGeoPar+;
 //#pragma link C++ class R3BFragmentTracker+;
 //#pragma link C++ class R3BFragmentTrackerS454+;
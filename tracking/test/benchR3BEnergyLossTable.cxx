@@ -0,0 +1,106 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Calls R3BTrackingDetector::GetEnergyLoss() for the fragments of
+// R3BFragmentTrackerS494 in a fiber detector, once with the formula and once
+// with energy loss tables, and compares speed and results.
+// Usage: benchR3BEnergyLossTable [number of calls, default 1e7]
+
+#include "R3BTGeoPar.h"
+#include "R3BTrackingDetector.h"
+#include "R3BTrackingParticle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Int_t kNofParticles = 1 << 12;
+
+    Double_t Run(const char* name,
+                 Long64_t n,
+                 R3BTrackingDetector& detector,
+                 std::vector<R3BTrackingParticle>& particles)
+    {
+        Double_t sum = 0.;
+        auto start = std::chrono::steady_clock::now();
+        for (Long64_t i = 0; i < n; i += kNofParticles)
+        {
+            for (auto& particle : particles)
+            {
+                sum += detector.GetEnergyLoss(&particle);
+            }
+        }
+        const Double_t s = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+        // The sum keeps the calls from being optimised away
+        std::cout << name << ": " << s << " s, " << 1e9 * s / n << " ns/call (sum " << sum << ")" << std::endl;
+        return s;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const Long64_t n = argc > 1 ? atof(argv[1]) : 1e7;
+
+    // BC400 fiber detector as in testR3BEnergyLossTable
+    R3BTGeoPar par("fi23aGeoPar");
+    par.SetPosXYZ(0., 0., 100.);
+    par.SetRotXYZ(0., 0., 0.);
+    par.SetDimXYZ(10., 10., 0.05);
+    par.SetSigmaXY(0.1, 0.1);
+    par.SetMaterial(3.5, 6.5, 1.032, 64.7e-6);
+
+    R3BTrackingDetector formula("fi23a", kTargetGlad, "fi23aGeoPar");
+    formula.fGeo = &par;
+    formula.Init();
+
+    // Fragments as in R3BFragmentTrackerS494::Init
+    R3BTrackingDetector tables("fi23a", kTargetGlad, "fi23aGeoPar");
+    tables.fGeo = &par;
+    tables.AddEnergyLossTable(8, 16);
+    tables.AddEnergyLossTable(6, 12);
+    tables.AddEnergyLossTable(2, 4);
+    tables.Init();
+
+    // 16O, 12C and 4He with the masses of R3BFragmentTrackerS494, over the beta gamma range of R3B fragments
+    const Double_t charge[3] = { 8., 6., 2. };
+    const Double_t mass[3] = { 15.0124, 11.1749, 3.7284 };
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<Int_t> ion(0, 2);
+    std::uniform_real_distribution<Double_t> betaGamma(0.5, 3.);
+    std::vector<R3BTrackingParticle> particles;
+    for (Int_t i = 0; i < kNofParticles; i++)
+    {
+        const Int_t k = ion(rng);
+        const Double_t bg = betaGamma(rng);
+        particles.emplace_back(charge[k], 0., 0., 0., 0., 0., 1., bg / std::sqrt(1. + bg * bg), mass[k]);
+    }
+
+    const Double_t tFormula = Run("formula", n, formula, particles);
+    const Double_t tTables = Run("tables ", n, tables, particles);
+    std::cout << "speedup: " << tFormula / tTables << std::endl;
+
+    Double_t maxDeviation = 0.;
+    for (auto& particle : particles)
+    {
+        maxDeviation =
+            std::max(maxDeviation, std::abs(tables.GetEnergyLoss(&particle) / formula.GetEnergyLoss(&particle) - 1.));
+    }
+    std::cout << "largest relative deviation from the formula: " << maxDeviation << std::endl;
+    return 0;
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Makes the transfer maps through the GLAD field for the range that
+// R3BFragmentTrackerS494 uses, or reads them if the file has them already.
+// The file can then be given to R3BFragmentTrackerS494::SetTransferMaps().
+// Propagates tracks from the target to a plane 4 m behind the field with
+// Runge-Kutta and with the maps and compares speed and positions.
+// Needs $VMCWORKDIR/field/magField/R3B/R3BGladMap.dat
+// Usage: benchR3BGladTransferMap [file, default GladTransferMaps.root] [degree, default 5] [tracks, default 10000]
+
+#include "R3BGladFieldMap.h"
+#include "R3BGladTransferMap.h"
+#include "R3BTPropagator.h"
+#include "R3BTrackingParticle.h"
+
+#include "TMath.h"
+#include "TVector3.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const Double_t kTolerance = 0.05;
+
+    // Tracks are compared this far behind the field exit [cm]
+    const Double_t kDistance = 400.;
+
+    Double_t Propagate(R3BTPropagator& propagator,
+                       std::vector<R3BTrackingParticle>& tracks,
+                       const TVector3& v1,
+                       const TVector3& v2,
+                       const TVector3& v3)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (auto& t : tracks)
+        {
+            propagator.PropagateToPlane(&t, v1, v2, v3);
+        }
+        return std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const char* fileName = argc > 1 ? argv[1] : "GladTransferMaps.root";
+    const Int_t degree = argc > 2 ? atoi(argv[2]) : 5;
+    const Int_t n = argc > 3 ? atof(argv[3]) : 10000;
+
+    R3BGladFieldMap field("R3BGladMap", "A");
+    field.Init();
+    field.SetTrackerCorrection(-1245. / 3584. / field.GetScale());
+    R3BTPropagator rk(&field);
+    R3BTPropagator fast(&field);
+
+    // Range as in R3BFragmentTrackerS494::InitPropagator()
+    R3BTrackingParticle beam(6., 0., 0., 0., 0., 0., 9.666, 0., 0.);
+    Double_t center[R3BGladTransferMap::kNIn];
+    if (!fast.GetFieldEntryState(&beam, center))
+    {
+        std::cout << "The beam does not reach the field" << std::endl;
+        return 1;
+    }
+    const Double_t halfWidth[R3BGladTransferMap::kNIn] = {
+        10., 10., 0.06, 0.06, 0.25 * TMath::Abs(center[R3BGladTransferMap::kKappa])
+    };
+    Double_t min[R3BGladTransferMap::kNIn];
+    Double_t max[R3BGladTransferMap::kNIn];
+    for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+    {
+        min[i] = center[i] - halfWidth[i];
+        max[i] = center[i] + halfWidth[i];
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (!fast.UseTransferMaps(fileName, min, max, degree, kTolerance))
+    {
+        return 1;
+    }
+    const Double_t tMaps = std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "maps ready after " << tMaps << " s" << std::endl;
+
+    // Plane parallel to the field exit, behind it
+    const Double_t a = field.GetYAngle() * TMath::DegToRad();
+    const TVector3 ex(std::cos(a), 0., -std::sin(a));
+    const TVector3 ez(std::sin(a), 0., std::cos(a));
+    const TVector3 v1 =
+        TVector3(field.GetPositionX(), field.GetPositionY(), field.GetPositionZ()) + (field.GetZmax() + kDistance) * ez;
+    const TVector3 v2 = v1 + ex;
+    const TVector3 v3 = v1 + TVector3(0., 1., 0.);
+
+    // Fragments from the target with rigidities around the one of the beam
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<Double_t> angle(-0.02, 0.02);
+    std::uniform_real_distribution<Double_t> momentum(0.85 * 9.666, 1.15 * 9.666);
+    std::vector<R3BTrackingParticle> tracks;
+    for (Int_t i = 0; i < n; i++)
+    {
+        const Double_t p = momentum(rng);
+        tracks.emplace_back(6., 0., 0., 0., p * angle(rng), p * angle(rng), p, 0., 0.);
+    }
+    std::vector<R3BTrackingParticle> mapped(tracks);
+
+    const Double_t tRK = Propagate(rk, tracks, v1, v2, v3);
+    const Double_t tMap = Propagate(fast, mapped, v1, v2, v3);
+    std::cout << "Runge-Kutta:   " << tRK << " s, " << 1e6 * tRK / n << " us/track" << std::endl;
+    std::cout << "transfer maps: " << tMap << " s, " << 1e6 * tMap / n << " us/track" << std::endl;
+    std::cout << "speedup: " << tRK / tMap << std::endl;
+
+    Double_t deviation = 0.;
+    Double_t lengthDeviation = 0.;
+    for (Int_t i = 0; i < n; i++)
+    {
+        deviation = std::max(deviation, (tracks[i].GetPosition() - mapped[i].GetPosition()).Mag());
+        lengthDeviation = std::max(lengthDeviation, TMath::Abs(tracks[i].GetLength() - mapped[i].GetLength()));
+    }
+    std::cout << "largest difference " << deviation << " cm in position, " << lengthDeviation << " cm in length"
+              << std::endl;
+    return deviation <= kTolerance ? 0 : 1;
+}
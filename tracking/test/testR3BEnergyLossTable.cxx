@@ -0,0 +1,101 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTGeoPar.h"
+#include "R3BTrackingDetector.h"
+#include "R3BTrackingParticle.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+    // Mass of 16O as used by the S494 tracker [GeV]
+    const Double_t kMass = 15.0124;
+
+    Double_t BetaOf(Double_t betaGamma) { return betaGamma / std::sqrt(1. + betaGamma * betaGamma); }
+
+    // A fiber detector of BC400 with 16O tabulated
+    class testEnergyLossTable : public ::testing::Test
+    {
+      protected:
+        testEnergyLossTable()
+            : fPar("fi23aGeoPar")
+            , fDetector("fi23a", kTargetGlad, "fi23aGeoPar")
+        {
+            fPar.SetPosXYZ(0., 0., 100.);
+            fPar.SetRotXYZ(0., 0., 0.);
+            fPar.SetDimXYZ(10., 10., 0.05);
+            fPar.SetSigmaXY(0.1, 0.1);
+            fPar.SetMaterial(3.5, 6.5, 1.032, 64.7e-6);
+            fDetector.fGeo = &fPar;
+            fDetector.AddEnergyLossTable(8, 16);
+            fDetector.Init();
+        }
+
+        Double_t GetEnergyLoss(Double_t charge, Double_t mass, Double_t beta)
+        {
+            R3BTrackingParticle particle(charge, 0., 0., 0., 0., 0., 1., beta, mass);
+            return fDetector.GetEnergyLoss(&particle);
+        }
+
+        R3BTGeoPar fPar;
+        R3BTrackingDetector fDetector;
+    };
+
+    TEST_F(testEnergyLossTable, FollowsTheFormula)
+    {
+        for (Double_t betaGamma = 0.1; betaGamma < 10.; betaGamma += 0.0123)
+        {
+            const Double_t beta = BetaOf(betaGamma);
+            const Double_t formula = fDetector.GetEnergyLossFormula(8., kMass, beta);
+            EXPECT_NEAR(GetEnergyLoss(8., kMass, beta) / formula, 1., 2e-4) << "beta gamma " << betaGamma;
+        }
+    }
+
+    TEST_F(testEnergyLossTable, ScalesWithTheCharge)
+    {
+        const Double_t beta = BetaOf(1.3);
+        const Double_t formula = fDetector.GetEnergyLossFormula(7.7, kMass, beta);
+        EXPECT_NEAR(GetEnergyLoss(7.7, kMass, beta) / formula, 1., 2e-4);
+        EXPECT_NEAR(GetEnergyLoss(-8., kMass, beta) / fDetector.GetEnergyLossFormula(-8., kMass, beta), 1., 2e-4);
+    }
+
+    TEST_F(testEnergyLossTable, UsesTheFormulaWithoutTable)
+    {
+        // Other ion, other mass number, beta gamma out of range
+        const Double_t beta = BetaOf(1.3);
+        EXPECT_EQ(GetEnergyLoss(6., 11.1749, beta), fDetector.GetEnergyLossFormula(6., 11.1749, beta));
+        EXPECT_EQ(GetEnergyLoss(8., 14., beta), fDetector.GetEnergyLossFormula(8., 14., beta));
+        EXPECT_EQ(GetEnergyLoss(8., kMass, BetaOf(20.)), fDetector.GetEnergyLossFormula(8., kMass, BetaOf(20.)));
+        EXPECT_EQ(GetEnergyLoss(8., kMass, BetaOf(0.05)), fDetector.GetEnergyLossFormula(8., kMass, BetaOf(0.05)));
+    }
+
+    TEST_F(testEnergyLossTable, UsesTheFormulaOffTheTableMass)
+    {
+        const Double_t beta = BetaOf(1.3);
+        // 16 * u as in R3BFragmentTrackerS494 after the mass fit, the table does not depend on the mass
+        EXPECT_EQ(GetEnergyLoss(8., 14.8951, beta), GetEnergyLoss(8., kMass, beta));
+        // Masses during a mass fit that round to A = 16
+        EXPECT_EQ(GetEnergyLoss(8., 15.3, beta), fDetector.GetEnergyLossFormula(8., 15.3, beta));
+        EXPECT_EQ(GetEnergyLoss(8., 14.6, beta), fDetector.GetEnergyLossFormula(8., 14.6, beta));
+    }
+
+    TEST_F(testEnergyLossTable, CopiesTheTables)
+    {
+        R3BTrackingDetector copy("fi23a", kTargetGlad, "fi23aGeoPar");
+        copy.CopyGeometry(fDetector);
+        R3BTrackingParticle particle(8., 0., 0., 0., 0., 0., 1., BetaOf(1.3), kMass);
+        EXPECT_EQ(copy.GetEnergyLoss(&particle), fDetector.GetEnergyLoss(&particle));
+    }
+} // namespace
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BFragmentPrefit.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace
+{
+    // GLAD rotated by -14 deg, 1 m long with 20 kG. The track turns by the kick
+    // in the mid plane and is straight elsewhere.
+    const Double_t kAngle = -14. * M_PI / 180.;
+    const Double_t kIntegral = 20. * 100.;
+    const TVector3 kCenter(0., 0., 300.);
+
+    struct Track
+    {
+        TVector3 target, fi23a, fi23b, after1, after2, tof;
+    };
+
+    // Point at distance s along a direction with angle theta to z and slope ty in y
+    TVector3 Along(const TVector3& start, Double_t theta, Double_t ty, Double_t s)
+    {
+        return start + TVector3(s * std::sin(theta), s * ty, s * std::cos(theta));
+    }
+
+    Track MakeTrack(Double_t thetaIn, Double_t ty, Double_t charge, Double_t p)
+    {
+        Track t;
+        t.target = TVector3(0.2, -0.1, 0.);
+        t.fi23a = Along(t.target, thetaIn, ty, 90.);
+        t.fi23b = Along(t.target, thetaIn, ty, 100.);
+
+        // Crossing of the mid plane, the plane through kCenter normal to the axis
+        const TVector3 axis(std::sin(kAngle), 0., std::cos(kAngle));
+        const TVector3 direction(std::sin(thetaIn), 0., std::cos(thetaIn));
+        const Double_t s = (kCenter - t.target).Dot(axis) / direction.Dot(axis);
+        const TVector3 kick = Along(t.target, thetaIn, ty, s);
+
+        // Sine of the angle to the axis changes by the kick
+        const Double_t sinOut = std::sin(thetaIn - kAngle) - 2.99792458e-4 * charge * kIntegral / p;
+        const Double_t thetaOut = std::asin(sinOut) + kAngle;
+        t.after1 = Along(kick, thetaOut, ty, 250.);
+        t.after2 = Along(kick, thetaOut, ty, 300.);
+        t.tof = Along(kick, thetaOut, ty, 500.);
+        return t;
+    }
+
+    Bool_t Check(const R3BFragmentPrefit& prefit, const Track& t, R3BFragmentPrefit::Result& result)
+    {
+        return prefit.Check(t.target, t.fi23a, t.fi23b, t.after1, t.after2, t.tof, 6., 9.666, result);
+    }
+
+    TEST(testFragmentPrefit, PassesTracksThroughTheLens)
+    {
+        R3BFragmentPrefit prefit;
+        prefit.SetField(kCenter, kAngle, kIntegral);
+        prefit.SetMaxMomentumDeviation(0.1);
+
+        R3BFragmentPrefit::Result result;
+        EXPECT_TRUE(Check(prefit, MakeTrack(0.01, 0.005, 6., 9.666), result));
+        EXPECT_NEAR(result.kick, 0., 1e-9);
+        EXPECT_NEAR(result.tofX, 0., 1e-9);
+        EXPECT_NEAR(result.tofY, 0., 1e-9);
+        EXPECT_NEAR(result.momentum, 9.666, 1e-6);
+        EXPECT_NEAR(result.score, 0., 1e-12);
+    }
+
+    TEST(testFragmentPrefit, MeasuresTheMomentum)
+    {
+        R3BFragmentPrefit prefit;
+        prefit.SetField(kCenter, kAngle, kIntegral);
+        prefit.SetMaxMomentumDeviation(0.1);
+
+        R3BFragmentPrefit::Result result;
+        EXPECT_TRUE(Check(prefit, MakeTrack(-0.02, 0., 6., 10.5), result));
+        EXPECT_NEAR(result.momentum, 10.5, 1e-6);
+        EXPECT_FALSE(Check(prefit, MakeTrack(-0.02, 0., 6., 12.), result));
+        EXPECT_NEAR(result.momentum, 12., 1e-6);
+
+        // No cut without the field integral
+        prefit.SetField(kCenter, kAngle, 0.);
+        EXPECT_TRUE(Check(prefit, MakeTrack(-0.02, 0., 6., 12.), result));
+        EXPECT_EQ(result.momentum, 0.);
+    }
+
+    TEST(testFragmentPrefit, RejectsHitsOffTheTrack)
+    {
+        R3BFragmentPrefit prefit;
+        prefit.SetField(kCenter, kAngle, kIntegral);
+        R3BFragmentPrefit::Result result;
+
+        Track t = MakeTrack(0.01, 0.005, 6., 9.666);
+        t.fi23a += TVector3(2., 0., 0.);
+        EXPECT_FALSE(Check(prefit, t, result));
+        EXPECT_GT(std::fabs(result.kick), 5.);
+
+        t = MakeTrack(0.01, 0.005, 6., 9.666);
+        t.tof += TVector3(12., 0., 0.);
+        EXPECT_FALSE(Check(prefit, t, result));
+        EXPECT_NEAR(std::fabs(result.tofX), 12. * std::cos(kAngle), 1.);
+
+        t = MakeTrack(0.01, 0.005, 6., 9.666);
+        t.tof += TVector3(0., 20., 0.);
+        EXPECT_FALSE(Check(prefit, t, result));
+        EXPECT_NEAR(result.tofY, 20., 1e-9);
+
+        // A disabled cut neither rejects nor adds to the score, the default cut added (y / 15 cm)^2
+        const Double_t scoreWithCut = result.score;
+        const Double_t tofY = result.tofY;
+        prefit.SetMaxTofY(0.);
+        EXPECT_TRUE(Check(prefit, t, result));
+        EXPECT_NEAR(result.score, scoreWithCut - (tofY / 15.) * (tofY / 15.), 1e-9);
+    }
+
+    TEST(testFragmentPrefit, ScoresWorseCombinationsHigher)
+    {
+        R3BFragmentPrefit prefit;
+        prefit.SetField(kCenter, kAngle, kIntegral);
+        R3BFragmentPrefit::Result good, bad;
+
+        Track t = MakeTrack(0.01, 0.005, 6., 9.666);
+        t.after1 += TVector3(0.1, 0., 0.);
+        Check(prefit, t, good);
+        t.after1 += TVector3(0.4, 0., 0.);
+        Check(prefit, t, bad);
+        EXPECT_GT(good.score, 0.);
+        EXPECT_GT(bad.score, good.score);
+    }
+} // namespace
@@ -0,0 +1,152 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BGladTransferMap.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // A range like the one of the S494 tracker
+    const Double_t kMin[R3BGladTransferMap::kNIn] = { -60., -10., 0.19, -0.06, -0.27 };
+    const Double_t kMax[R3BGladTransferMap::kNIn] = { -40., 10., 0.31, 0.06, -0.16 };
+
+    // A cubic in all inputs, and something smooth that is no polynomial
+    void Cubic(const Double_t* in, Double_t* out)
+    {
+        const Double_t x = in[0], y = in[1], tx = in[2], ty = in[3], k = in[4];
+        out[0] = 3. + 2. * x - 0.01 * x * x * k + 40. * tx * tx * tx;
+        out[1] = y + 150. * ty + 0.2 * y * ty * k;
+        out[2] = tx + 1.2 * k + 0.5 * k * k * k;
+        out[3] = ty - 0.001 * y * tx;
+        out[4] = 400. + 30. * tx * tx + 20. * k * k;
+    }
+
+    void Smooth(const Double_t* in, Double_t* out)
+    {
+        const Double_t angle = std::asin(0.5 * in[4]) + std::atan(in[2]);
+        out[0] = in[0] + 200. * std::tan(angle);
+        out[1] = in[1] + 200. * in[3] / std::cos(angle);
+        out[2] = std::tan(angle);
+        out[3] = in[3] / std::cos(angle);
+        out[4] = 200. / std::cos(angle);
+    }
+
+    template <typename F>
+    void Sample(F f, Int_t n, std::mt19937& rng, std::vector<Double_t>& in, std::vector<Double_t>& out)
+    {
+        in.resize(n * R3BGladTransferMap::kNIn);
+        out.resize(n * R3BGladTransferMap::kNOut);
+        for (Int_t s = 0; s < n; s++)
+        {
+            for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+            {
+                in[s * R3BGladTransferMap::kNIn + i] = std::uniform_real_distribution<Double_t>(kMin[i], kMax[i])(rng);
+            }
+            f(&in[s * R3BGladTransferMap::kNIn], &out[s * R3BGladTransferMap::kNOut]);
+        }
+    }
+
+    // Largest deviation of the map from f at n other points
+    template <typename F>
+    Double_t Deviation(const R3BGladTransferMap& map, F f, Int_t n, std::mt19937& rng)
+    {
+        std::vector<Double_t> in, out;
+        Sample(f, n, rng, in, out);
+        Double_t deviation = 0.;
+        Double_t values[R3BGladTransferMap::kNOut];
+        for (Int_t s = 0; s < n; s++)
+        {
+            map.Eval(&in[s * R3BGladTransferMap::kNIn], values);
+            for (Int_t k = 0; k < R3BGladTransferMap::kNOut; k++)
+            {
+                deviation = std::max(deviation, std::fabs(values[k] - out[s * R3BGladTransferMap::kNOut + k]));
+            }
+        }
+        return deviation;
+    }
+
+    TEST(testGladTransferMap, CountsTheTerms)
+    {
+        // Monomials of 5 variables up to total degree d: (d + 5)! / (d! 5!)
+        EXPECT_EQ(R3BGladTransferMap(1, kMin, kMax).GetNTerms(), 6);
+        EXPECT_EQ(R3BGladTransferMap(3, kMin, kMax).GetNTerms(), 56);
+        EXPECT_EQ(R3BGladTransferMap(5, kMin, kMax).GetNTerms(), 252);
+    }
+
+    TEST(testGladTransferMap, ReproducesPolynomials)
+    {
+        std::mt19937 rng(1);
+        std::vector<Double_t> in, out;
+        R3BGladTransferMap map(3, kMin, kMax);
+        Sample(Cubic, 10 * map.GetNTerms(), rng, in, out);
+
+        EXPECT_LT(map.Fit(in, out), 1e-8);
+        EXPECT_LT(Deviation(map, Cubic, 1000, rng), 1e-8);
+    }
+
+    TEST(testGladTransferMap, ConvergesForSmoothFunctions)
+    {
+        std::mt19937 rng(2);
+        std::vector<Double_t> in, out;
+        Double_t last = 1e9;
+        for (Int_t degree = 2; degree <= 5; degree++)
+        {
+            R3BGladTransferMap map(degree, kMin, kMax);
+            Sample(Smooth, 10 * map.GetNTerms(), rng, in, out);
+            const Double_t fitted = map.Fit(in, out);
+            const Double_t deviation = Deviation(map, Smooth, 1000, rng);
+            EXPECT_GE(fitted, 0.);
+            EXPECT_LT(deviation, 2. * fitted + 1e-6);
+            EXPECT_LT(deviation, last);
+            last = deviation;
+        }
+        EXPECT_LT(last, 1e-3);
+    }
+
+    TEST(testGladTransferMap, NeedsEnoughSamples)
+    {
+        std::mt19937 rng(3);
+        std::vector<Double_t> in, out;
+        R3BGladTransferMap map(3, kMin, kMax);
+        Sample(Cubic, map.GetNTerms() - 1, rng, in, out);
+        EXPECT_LT(map.Fit(in, out), 0.);
+    }
+
+    TEST(testGladTransferMap, KnowsItsRange)
+    {
+        R3BGladTransferMap map(2, kMin, kMax);
+        Double_t in[R3BGladTransferMap::kNIn];
+        for (Int_t i = 0; i < R3BGladTransferMap::kNIn; i++)
+        {
+            in[i] = 0.5 * (kMin[i] + kMax[i]);
+        }
+        EXPECT_TRUE(map.IsInside(in));
+        in[R3BGladTransferMap::kKappa] = kMax[R3BGladTransferMap::kKappa] + 0.01;
+        EXPECT_FALSE(map.IsInside(in));
+        in[R3BGladTransferMap::kKappa] = NAN;
+        EXPECT_FALSE(map.IsInside(in));
+    }
+
+    TEST(testGladTransferMap, ChecksTheField)
+    {
+        R3BGladTransferMap map(2, kMin, kMax);
+        map.SetField("R3BGladMap.dat", 0., 0., 176., -14.);
+        EXPECT_TRUE(map.IsSameField("R3BGladMap.dat", 0., 0., 176., -14.));
+        EXPECT_FALSE(map.IsSameField("R3BGladMap.dat", 0., 0., 176., -18.));
+        EXPECT_FALSE(map.IsSameField("R3BGladMap_v2.dat", 0., 0., 176., -14.));
+    }
+} // namespace